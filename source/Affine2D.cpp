@@ -0,0 +1,183 @@
+﻿/**
+ * @file Affine2D.cpp
+ * @author kota-kota
+ * @brief 2次元のアフィン変換を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Affine2D.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace my {
+    /**
+     * @brief *=演算子のオーバーロード（変換の合成）
+     * 
+     * @param [in] m 後に行う変換
+     * @return Affine2D& 自身の変換の後にmの変換を行う変換
+     */
+    Affine2D& Affine2D::operator*=(const Affine2D& m)
+    {
+        *this = *this * m;
+        return *this;
+    }
+
+    /**
+     * @brief 要素の配列を取得
+     * 
+     * @return const float* 要素の配列（列優先の6要素、シェーダへの転送に使用する）
+     */
+    const float* Affine2D::data() const { return this->m_m.data(); }
+
+    /**
+     * @brief 逆変換を取得
+     * 
+     * @return Affine2D 逆変換（逆変換が存在しない場合は恒等変換）
+     * 
+     * @par 詳細
+     *      線形部分（2x2）の逆行列を求め、移動量は逆行列で変換して符号を反転する。
+     */
+    Affine2D Affine2D::inverse() const
+    {
+        const float det = this->determinant();
+        if (!(std::fabs(det) > 0.0F)) {
+            return Affine2D::identity();
+        }
+        const float a = this->m_m[3] / det;
+        const float b = -this->m_m[1] / det;
+        const float c = -this->m_m[2] / det;
+        const float d = this->m_m[0] / det;
+        const float tx = -((a * this->m_m[4]) + (c * this->m_m[5]));
+        const float ty = -((b * this->m_m[4]) + (d * this->m_m[5]));
+        return Affine2D(a, b, c, d, tx, ty);
+    }
+
+    /**
+     * @brief 座標を変換（Z座標はそのまま）
+     * 
+     * @param [in] v 座標
+     * @return Vertex 変換後の座標
+     */
+    Vertex Affine2D::apply(const Vertex& v) const
+    {
+        const float x = (this->m_m[0] * v.x()) + (this->m_m[2] * v.y()) + this->m_m[4];
+        const float y = (this->m_m[1] * v.x()) + (this->m_m[3] * v.y()) + this->m_m[5];
+        return Vertex(x, y, v.z());
+    }
+
+    /**
+     * @brief 座標の配列を変換（Z座標はそのまま）
+     * 
+     * @param [in] in 変換前の座標の配列
+     * @param [out] out 変換後の座標の配列（inと同じ配列でもよい）
+     * @param [in] num 座標の数
+     * @param [in] grain 並列に変換する区間の最小の座標数（0は呼び出し元のスレッドで変換する）
+     * 
+     * @par 詳細
+     *      Matrix::transformPoints2D()で、命令セットに応じて複数の座標をまとめて変換する。
+     */
+    void Affine2D::apply(const Vertex* in, Vertex* out, const std::size_t num, const std::size_t grain) const
+    {
+        this->toMatrix().transformPoints2D(in, out, num, grain);
+    }
+
+    /**
+     * @brief 4x4行列に変換
+     * 
+     * @return Matrix XY平面上の変換を行う4x4行列（Zは変換しない）
+     */
+    Matrix Affine2D::toMatrix() const
+    {
+        return Matrix(std::array<float, 16>{{
+            this->m_m[0], this->m_m[2], 0.0F, this->m_m[4],
+            this->m_m[1], this->m_m[3], 0.0F, this->m_m[5],
+            0.0F, 0.0F, 1.0F, 0.0F,
+            0.0F, 0.0F, 0.0F, 1.0F,
+        }});
+    }
+
+    /**
+     * @brief 原点を中心に回転する変換を作成
+     * 
+     * @param [in] angle 回転角（X軸からY軸へ向かう向きを正とする）
+     * @return Affine2D 回転する変換
+     */
+    Affine2D Affine2D::rotate(const Radian angle)
+    {
+        const float c = std::cos(angle.rad());
+        const float s = std::sin(angle.rad());
+        return Affine2D(c, s, -s, c, 0.0F, 0.0F);
+    }
+}
+
+namespace {
+    //! 座標が許容誤差以内で一致するか判定
+    bool nearly(const my::Vertex& a, const my::Vertex& b)
+    {
+        return (std::fabs(a.x() - b.x()) <= 1.0e-4F) && (std::fabs(a.y() - b.y()) <= 1.0e-4F) && (std::fabs(a.z() - b.z()) <= 1.0e-4F);
+    }
+
+    //! コンパイル時の合成：拡大の後に平行移動する変換
+    constexpr my::Affine2D TEST_PLACE = my::Affine2D::scale({ 2.0F, 3.0F, 1.0F }) * my::Affine2D::translate({ 10.0F, 20.0F, 0.0F });
+    static_assert((TEST_PLACE[0] > 1.5F) && (TEST_PLACE[0] < 2.5F) && (TEST_PLACE[4] > 9.5F) && (TEST_PLACE[4] < 10.5F), "Affine2D::operator*");
+    static_assert((TEST_PLACE.determinant() > 5.5F) && (TEST_PLACE.determinant() < 6.5F), "Affine2D::determinant");
+}
+
+namespace my {
+    /**
+     * @brief Affine2Dクラスのテストコードを実行
+     * 
+     * @par 詳細
+     *      合成・逆変換・座標の変換を、4x4行列（Matrix）で同じ変換を行った結果と比較する。
+     */
+    bool testcode_Affine2D()
+    {
+        std::cout << "[testcode_Affine2D()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const std::string& name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+
+        const Affine2D s = Affine2D::scale({ 2.0F, 0.5F, 1.0F });
+        const Affine2D r = Affine2D::rotate(Radian(0.7F));
+        const Affine2D t = Affine2D::translate({ 30.0F, -12.0F, 0.0F });
+        const Affine2D srt = s * r * t;
+        const Vertex v(3.0F, 4.0F, 5.0F);
+
+        // 合成は順に変換した結果と一致する
+        check("compose", nearly(srt.apply(v), t.apply(r.apply(s.apply(v)))));
+        check("place", nearly((Affine2D::scale({ 2.0F, 3.0F, 1.0F }) * t).apply(v), Vertex(36.0F, 0.0F, 5.0F)));
+        // 4x4行列の変換と一致する
+        const Vector mv = srt.toMatrix().transform({ v.x(), v.y(), v.z() });
+        check("toMatrix", nearly(srt.apply(v), Vertex(mv.x(), mv.y(), mv.z())));
+        const Matrix m = s.toMatrix() * r.toMatrix() * t.toMatrix();
+        bool same = true;
+        for (std::size_t i = 0U; i < m.size(); i++) {
+            same = same && (std::fabs(m[i] - srt.toMatrix()[i]) <= 1.0e-4F);
+        }
+        check("compose toMatrix", same);
+        // 逆変換
+        const Affine2D inv = srt.inverse();
+        check("inverse", nearly(inv.apply(srt.apply(v)), v) && nearly((srt * inv).apply(v), v));
+        check("inverse singular", nearly(Affine2D::scale({ 0.0F, 1.0F, 1.0F }).inverse().apply(v), v));
+        check("determinant", std::fabs(srt.determinant() - 1.0F) <= 1.0e-4F);
+        // 座標の配列の変換は座標毎の変換と一致する
+        Vertexes in, out(37U);
+        for (std::int32_t i = 0; i < 37; i++) {
+            in.emplace_back(static_cast<float>(i), static_cast<float>(i * i) * 0.1F, static_cast<float>(-i));
+        }
+        srt.apply(in.data(), out.data(), in.size());
+        bool array = true;
+        for (std::size_t i = 0U; i < in.size(); i++) {
+            array = array && nearly(out[i], srt.apply(in[i]));
+        }
+        check("apply array", array);
+        return ok;
+    }
+}
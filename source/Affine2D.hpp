@@ -0,0 +1,160 @@
+﻿/**
+ * @file Affine2D.hpp
+ * @author kota-kota
+ * @brief 2次元のアフィン変換を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_AFFINE2D_HPP
+#define INCLUDED_AFFINE2D_HPP
+
+#include "Matrix.hpp"
+#include "Vertex.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace my {
+    /**
+     * @class Affine2D
+     * @brief XY平面上のアフィン変換（3x2行列）
+     * 
+     * @par 詳細
+     *      3x2行列を列優先の要素数6の固定長配列で表現する（GLSLのmat3x2と同じ並び）。
+     *      [0] [2] [4]
+     *      [1] [3] [5]
+     *      座標(x,y)は(x',y') = ([0]x + [2]y + [4], [1]x + [3]y + [5])に変換する。
+     *      シェーダには、[0]-[3]をvec4（mat2の列優先の並び）、[4]-[5]をvec2として渡す。
+     *      積はMatrixと同じく、a * bでaの変換の後にbの変換を行う。
+     */
+    class Affine2D {
+        std::array<float, 6>    m_m;    //!< 要素（列優先）
+
+    public:
+        //! デフォルトコンストラクタ（恒等変換）
+        constexpr Affine2D();
+        //! コンストラクタ
+        constexpr Affine2D(const float a, const float b, const float c, const float d, const float tx, const float ty);
+
+    public:
+        //! *演算子のオーバーロード（変換の合成）
+        constexpr Affine2D operator*(const Affine2D& m) const;
+        //! *=演算子のオーバーロード（変換の合成）
+        Affine2D& operator*=(const Affine2D& m);
+        //! 要素を取得
+        constexpr float operator[](const std::size_t i) const;
+
+    public:
+        //! 要素の配列を取得
+        const float* data() const;
+        //! 行列式（線形部分の拡大率）を取得
+        constexpr float determinant() const;
+        //! 逆変換を取得
+        Affine2D inverse() const;
+        //! 座標を変換（Z座標はそのまま）
+        Vertex apply(const Vertex& v) const;
+        //! 座標の配列を変換（Z座標はそのまま）
+        void apply(const Vertex* in, Vertex* out, const std::size_t num, const std::size_t grain = 0U) const;
+        //! 4x4行列に変換
+        Matrix toMatrix() const;
+
+    public:
+        //! 恒等変換を作成
+        static constexpr Affine2D identity();
+        //! (x,y)だけ平行移動する変換を作成
+        static constexpr Affine2D translate(const Vector& v);
+        //! (x,y)倍に拡大縮小する変換を作成
+        static constexpr Affine2D scale(const Vector& v);
+        //! 原点を中心に回転する変換を作成
+        static Affine2D rotate(const Radian angle);
+    };
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ（恒等変換）
+     * 
+     */
+    constexpr Affine2D::Affine2D() :
+        m_m({{ 1.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F }})
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] a 要素[0]（X軸の像のX成分）
+     * @param [in] b 要素[1]（X軸の像のY成分）
+     * @param [in] c 要素[2]（Y軸の像のX成分）
+     * @param [in] d 要素[3]（Y軸の像のY成分）
+     * @param [in] tx 要素[4]（X方向の移動量）
+     * @param [in] ty 要素[5]（Y方向の移動量）
+     */
+    constexpr Affine2D::Affine2D(const float a, const float b, const float c, const float d, const float tx, const float ty) :
+        m_m({{ a, b, c, d, tx, ty }})
+    {
+    }
+
+    /**
+     * @brief *演算子のオーバーロード（変換の合成）
+     * 
+     * @param [in] m 後に行う変換
+     * @return Affine2D 自身の変換の後にmの変換を行う変換
+     */
+    constexpr Affine2D Affine2D::operator*(const Affine2D& m) const
+    {
+        return Affine2D((m.m_m[0] * this->m_m[0]) + (m.m_m[2] * this->m_m[1]),
+                        (m.m_m[1] * this->m_m[0]) + (m.m_m[3] * this->m_m[1]),
+                        (m.m_m[0] * this->m_m[2]) + (m.m_m[2] * this->m_m[3]),
+                        (m.m_m[1] * this->m_m[2]) + (m.m_m[3] * this->m_m[3]),
+                        (m.m_m[0] * this->m_m[4]) + (m.m_m[2] * this->m_m[5]) + m.m_m[4],
+                        (m.m_m[1] * this->m_m[4]) + (m.m_m[3] * this->m_m[5]) + m.m_m[5]);
+    }
+
+    /**
+     * @brief 要素を取得
+     * 
+     * @param [in] i 要素の位置（0-5）
+     * @return float 要素
+     */
+    constexpr float Affine2D::operator[](const std::size_t i) const { return this->m_m[i]; }
+
+    /**
+     * @brief 行列式（線形部分の拡大率）を取得
+     * 
+     * @return float 行列式（負の場合は裏返す変換）
+     */
+    constexpr float Affine2D::determinant() const { return (this->m_m[0] * this->m_m[3]) - (this->m_m[2] * this->m_m[1]); }
+
+    /**
+     * @brief 恒等変換を作成
+     * 
+     * @return Affine2D 恒等変換
+     */
+    constexpr Affine2D Affine2D::identity() { return Affine2D(); }
+
+    /**
+     * @brief (x,y)だけ平行移動する変換を作成
+     * 
+     * @param [in] v 移動量のベクトル（Zは使用しない）
+     * @return Affine2D 平行移動する変換
+     */
+    constexpr Affine2D Affine2D::translate(const Vector& v) { return Affine2D(1.0F, 0.0F, 0.0F, 1.0F, v.x(), v.y()); }
+
+    /**
+     * @brief (x,y)倍に拡大縮小する変換を作成
+     * 
+     * @param [in] v 拡大縮小倍率のベクトル（Zは使用しない）
+     * @return Affine2D 拡大縮小する変換
+     */
+    constexpr Affine2D Affine2D::scale(const Vector& v) { return Affine2D(v.x(), 0.0F, 0.0F, v.y(), 0.0F, 0.0F); }
+}
+
+namespace my {
+    //! Affine2Dクラスのテストコードを実行
+    bool testcode_Affine2D();
+}
+
+#endif //INCLUDED_AFFINE2D_HPP
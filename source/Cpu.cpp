@@ -0,0 +1,191 @@
+﻿/**
+ * @file Cpu.cpp
+ * @author kota-kota
+ * @brief 実行中のCPUが対応する命令セットを判定するクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Cpu.hpp"
+#include "Simd.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(MY_SIMD_AVX2)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+    //! 指定した命令セット（未指定の場合は-1）
+    std::atomic<std::int32_t> g_forced(-1);
+
+#if defined(MY_SIMD_AVX2)
+    //! CPUID命令を実行（regs: eax, ebx, ecx, edx）
+    void cpuid(const std::uint32_t leaf, const std::uint32_t subleaf, std::uint32_t regs[4])
+    {
+#if defined(_MSC_VER)
+        int r[4] = { 0, 0, 0, 0 };
+        __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+        for (std::int32_t i = 0; i < 4; i++) {
+            regs[i] = static_cast<std::uint32_t>(r[i]);
+        }
+#else
+        regs[0] = regs[1] = regs[2] = regs[3] = 0U;
+        (void)__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+    }
+
+    //! XCR0（OSが退避・復元するレジスタの種類）を取得
+    std::uint64_t xgetbv0()
+    {
+#if defined(_MSC_VER)
+        return static_cast<std::uint64_t>(_xgetbv(0));
+#else
+        std::uint32_t eax = 0U, edx = 0U;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+    }
+
+    //! AVX2・FMAが使用可能か判定（OSがYMMレジスタを退避・復元することも確認する）
+    bool hasAvx2()
+    {
+        std::uint32_t regs[4];
+        cpuid(0U, 0U, regs);
+        if (regs[0] < 7U) {
+            return false;
+        }
+        cpuid(1U, 0U, regs);
+        const bool osxsave = ((regs[2] >> 27) & 1U) != 0U;
+        const bool avx = ((regs[2] >> 28) & 1U) != 0U;
+        const bool fma = ((regs[2] >> 12) & 1U) != 0U;
+        if (!(osxsave && avx && fma)) {
+            return false;
+        }
+        if ((xgetbv0() & 0x6U) != 0x6U) {
+            return false;
+        }
+        cpuid(7U, 0U, regs);
+        return ((regs[1] >> 5) & 1U) != 0U;
+    }
+#endif
+
+    //! 実行中のCPUが対応する最も高速な命令セットを判定
+    my::Cpu::ISA detectIsa()
+    {
+#if defined(MY_SIMD_AVX2)
+        if (hasAvx2()) {
+            return my::Cpu::ISA::AVX2;
+        }
+#endif
+#if defined(MY_SIMD_SSE2)
+        return my::Cpu::ISA::SSE2;
+#elif defined(MY_SIMD_NEON)
+        return my::Cpu::ISA::NEON;
+#else
+        return my::Cpu::ISA::SCALAR;
+#endif
+    }
+}
+
+namespace my {
+    /**
+     * @brief 実行中のCPUが対応する最も高速な命令セットを取得
+     * 
+     * @return ISA 命令セット（初回のみ判定する）
+     */
+    Cpu::ISA Cpu::detect()
+    {
+        static const ISA isa = detectIsa();
+        return isa;
+    }
+
+    /**
+     * @brief 命令セットに対応しているか判定
+     * 
+     * @param [in] isa 命令セット
+     * 
+     * @retval true 対応している
+     * @retval false 対応していない
+     * 
+     * @par 詳細
+     *      SCALARは常に対応する。SSE2・AVX2はx86、NEONはAArch64でのみ対応する。
+     */
+    bool Cpu::supports(const ISA isa)
+    {
+        const ISA best = Cpu::detect();
+        switch (isa) {
+        case ISA::SCALAR:
+            return true;
+        case ISA::SSE2:
+            return (best == ISA::SSE2) || (best == ISA::AVX2);
+        case ISA::AVX2:
+            return (best == ISA::AVX2);
+        case ISA::NEON:
+            return (best == ISA::NEON);
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief 使用する命令セットを取得
+     * 
+     * @return ISA 指定した命令セット（未指定の場合は判定結果）
+     */
+    Cpu::ISA Cpu::isa()
+    {
+        const std::int32_t forced = g_forced.load(std::memory_order_relaxed);
+        return (forced < 0) ? Cpu::detect() : static_cast<ISA>(forced);
+    }
+
+    /**
+     * @brief 使用する命令セットを指定
+     * 
+     * @param [in] isa 命令セット
+     * 
+     * @retval true 指定した
+     * @retval false 対応していないため変更しなかった
+     */
+    bool Cpu::force(const ISA isa)
+    {
+        if (!Cpu::supports(isa)) {
+            return false;
+        }
+        g_forced.store(static_cast<std::int32_t>(isa), std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief 使用する命令セットを判定結果に戻す
+     * 
+     */
+    void Cpu::reset()
+    {
+        g_forced.store(-1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 命令セットの名前を取得
+     * 
+     * @param [in] isa 命令セット
+     * 
+     * @return const char* 命令セットの名前
+     */
+    const char* Cpu::name(const ISA isa)
+    {
+        switch (isa) {
+        case ISA::SCALAR:   return "scalar";
+        case ISA::SSE2:     return "sse2";
+        case ISA::NEON:     return "neon";
+        case ISA::AVX2:     return "avx2";
+        default:            return "unknown";
+        }
+    }
+}
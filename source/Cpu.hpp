@@ -0,0 +1,47 @@
+﻿/**
+ * @file Cpu.hpp
+ * @author kota-kota
+ * @brief 実行中のCPUが対応する命令セットを判定するクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_CPU_HPP
+#define INCLUDED_CPU_HPP
+
+namespace my {
+    /**
+     * @class Cpu
+     * @brief 実行中のCPUが対応する命令セットを判定するクラス
+     * 
+     * @par 詳細
+     *      判定は初回のみ行い、結果を保持する。
+     *      テスト・性能計測のため、使用する命令セットを対応している範囲で指定し直せる。
+     */
+    class Cpu {
+    public:
+        //! 命令セット（後ろほど高速）
+        enum class ISA { SCALAR, SSE2, NEON, AVX2 };
+
+    public:
+        //! インスタンス化禁止
+        Cpu() = delete;
+
+    public:
+        //! 実行中のCPUが対応する最も高速な命令セットを取得
+        static ISA detect();
+        //! 命令セットに対応しているか判定
+        static bool supports(const ISA isa);
+        //! 使用する命令セットを取得
+        static ISA isa();
+        //! 使用する命令セットを指定（対応していない場合は変更せずfalseを返す）
+        static bool force(const ISA isa);
+        //! 使用する命令セットを判定結果に戻す
+        static void reset();
+        //! 命令セットの名前を取得
+        static const char* name(const ISA isa);
+    };
+}
+
+#endif //INCLUDED_CPU_HPP
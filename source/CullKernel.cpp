@@ -0,0 +1,780 @@
+﻿/**
+ * @file CullKernel.cpp
+ * @author kota-kota
+ * @brief 軸に平行な箱の可視判定を命令セット毎に実装した関数の実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "CullKernel.hpp"
+#include "Simd.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /**
+     * @struct PlaneArrays
+     * @brief 平面毎に、平面の法線の向きに最も進んだ箱の頂点（p-vertex）の座標の配列
+     * 
+     * @par 詳細
+     *      平面の係数の符号で最小・最大座標の配列を選ぶため、判定中に要素毎の選択は行わない。
+     *      p-vertexが平面の外側にある箱は、箱全体が平面の外側にある。
+     */
+    struct PlaneArrays {
+        const float*    x[6];   //!< X座標の配列（a > 0の場合は最大座標）
+        const float*    y[6];   //!< Y座標の配列（b > 0の場合は最大座標）
+        const float*    z[6];   //!< Z座標の配列（c > 0の場合は最大座標）
+    };
+
+    //! 平面毎のp-vertexの座標の配列を選択
+    PlaneArrays selectPlaneArrays(const my::CullArrays& b, const float* planes)
+    {
+        PlaneArrays p = {};
+        for (std::size_t k = 0U; k < 6U; k++) {
+            p.x[k] = (planes[(k * 4U) + 0U] > 0.0F) ? b.maxx : b.minx;
+            p.y[k] = (planes[(k * 4U) + 1U] > 0.0F) ? b.maxy : b.miny;
+            p.z[k] = (planes[(k * 4U) + 2U] > 0.0F) ? b.maxz : b.minz;
+        }
+        return p;
+    }
+
+    //! 4個の判定結果（下位4bit）の可視の番号を詰めて書き込み（分岐しないよう常に書き込み、可視の場合のみ進める）
+    inline std::size_t compact4(const std::uint32_t mask, const std::size_t base, std::uint32_t* out, std::size_t n)
+    {
+        const std::uint32_t i = static_cast<std::uint32_t>(base);
+        out[n] = i;         n += mask & 1U;
+        out[n] = i + 1U;    n += (mask >> 1) & 1U;
+        out[n] = i + 2U;    n += (mask >> 2) & 1U;
+        out[n] = i + 3U;    n += (mask >> 3) & 1U;
+        return n;
+    }
+
+    //! 矩形との交差判定（スカラー、[begin, num)の箱を判定してnから書き込む）
+    std::size_t rectTail(const my::CullArrays& b, const std::size_t begin, const std::size_t num, const float* view, std::uint32_t* out, std::size_t n)
+    {
+        for (std::size_t i = begin; i < num; i++) {
+            const bool in = (b.minx[i] <= view[2]) & (view[0] <= b.maxx[i]) & (b.miny[i] <= view[3]) & (view[1] <= b.maxy[i]);
+            out[n] = static_cast<std::uint32_t>(i);
+            n += in ? 1U : 0U;
+        }
+        return n;
+    }
+
+    //! 視錐台との交差判定（スカラー、[begin, num)の箱を判定してnから書き込む）
+    std::size_t frustumTail(const PlaneArrays& p, const std::size_t begin, const std::size_t num, const float* planes, std::uint32_t* out, std::size_t n)
+    {
+        for (std::size_t i = begin; i < num; i++) {
+            bool in = true;
+            for (std::size_t k = 0U; k < 6U; k++) {
+                const float* e = planes + (k * 4U);
+                in = in & (((e[0] * p.x[k][i]) + (e[1] * p.y[k][i]) + (e[2] * p.z[k][i]) + e[3]) >= 0.0F);
+            }
+            out[n] = static_cast<std::uint32_t>(i);
+            n += in ? 1U : 0U;
+        }
+        return n;
+    }
+
+    //! 矩形との交差判定（スカラー）
+    std::size_t rectScalar(const my::CullArrays& b, const std::size_t num, const float* view, std::uint32_t* out)
+    {
+        return rectTail(b, 0U, num, view, out, 0U);
+    }
+
+    //! 視錐台との交差判定（スカラー）
+    std::size_t frustumScalar(const my::CullArrays& b, const std::size_t num, const float* planes, std::uint32_t* out)
+    {
+        return frustumTail(selectPlaneArrays(b, planes), 0U, num, planes, out, 0U);
+    }
+
+    //! スカラーの判定関数の組
+    const my::CullKernel KERNEL_SCALAR = { my::Cpu::ISA::SCALAR, rectScalar, frustumScalar };
+}
+
+namespace {
+#if defined(MY_SIMD_SSE2)
+    //! 矩形との交差判定（SSE2：4個ずつ判定する）
+    std::size_t rectSse2(const my::CullArrays& b, const std::size_t num, const float* view, std::uint32_t* out)
+    {
+        const __m128 vminx = _mm_set1_ps(view[0]);
+        const __m128 vminy = _mm_set1_ps(view[1]);
+        const __m128 vmaxx = _mm_set1_ps(view[2]);
+        const __m128 vmaxy = _mm_set1_ps(view[3]);
+        const std::size_t simd = num & ~static_cast<std::size_t>(3U);
+        std::size_t n = 0U;
+        for (std::size_t i = 0U; i < simd; i += 4U) {
+            __m128 in = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(b.minx + i), vmaxx), _mm_cmple_ps(vminx, _mm_loadu_ps(b.maxx + i)));
+            in = _mm_and_ps(in, _mm_cmple_ps(_mm_loadu_ps(b.miny + i), vmaxy));
+            in = _mm_and_ps(in, _mm_cmple_ps(vminy, _mm_loadu_ps(b.maxy + i)));
+            n = compact4(static_cast<std::uint32_t>(_mm_movemask_ps(in)), i, out, n);
+        }
+        return rectTail(b, simd, num, view, out, n);
+    }
+
+    //! 視錐台との交差判定（SSE2：4個ずつ判定する）
+    std::size_t frustumSse2(const my::CullArrays& b, const std::size_t num, const float* planes, std::uint32_t* out)
+    {
+        const PlaneArrays p = selectPlaneArrays(b, planes);
+        const __m128 zero = _mm_setzero_ps();
+        const std::size_t simd = num & ~static_cast<std::size_t>(3U);
+        std::size_t n = 0U;
+        for (std::size_t i = 0U; i < simd; i += 4U) {
+            __m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (std::size_t k = 0U; k < 6U; k++) {
+                const float* e = planes + (k * 4U);
+                __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e[0]), _mm_loadu_ps(p.x[k] + i)), _mm_set1_ps(e[3]));
+                d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(e[1]), _mm_loadu_ps(p.y[k] + i)));
+                d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(e[2]), _mm_loadu_ps(p.z[k] + i)));
+                in = _mm_and_ps(in, _mm_cmpge_ps(d, zero));
+            }
+            n = compact4(static_cast<std::uint32_t>(_mm_movemask_ps(in)), i, out, n);
+        }
+        return frustumTail(p, simd, num, planes, out, n);
+    }
+
+    //! SSE2の判定関数の組
+    const my::CullKernel KERNEL_SSE2 = { my::Cpu::ISA::SSE2, rectSse2, frustumSse2 };
+#endif
+}
+
+namespace {
+#if defined(MY_SIMD_AVX2)
+    /**
+     * @struct CompactTable
+     * @brief 8個の判定結果（8bit）毎の、可視の番号の位置の並びと可視の数の表
+     */
+    struct CompactTable {
+        std::uint8_t    lanes[256][8];  //!< 可視の位置（0-7）を先頭から詰めた並び
+        std::uint8_t    count[256];     //!< 可視の数
+    };
+
+    //! 判定結果毎の表を作成
+    CompactTable makeCompactTable()
+    {
+        CompactTable t = {};
+        for (std::uint32_t mask = 0U; mask < 256U; mask++) {
+            std::uint8_t n = 0U;
+            for (std::uint8_t lane = 0U; lane < 8U; lane++) {
+                if (((mask >> lane) & 1U) != 0U) {
+                    t.lanes[mask][n] = lane;
+                    n++;
+                }
+            }
+            t.count[mask] = n;
+        }
+        return t;
+    }
+
+    //! 判定結果毎の表
+    const CompactTable COMPACT_TABLE = makeCompactTable();
+
+    //! 8個の判定結果（下位8bit）の可視の番号を、表の並びで8個まとめて詰めて書き込み
+    MY_TARGET_AVX2 inline std::size_t compact8(const std::uint32_t mask, const std::size_t base, std::uint32_t* out, const std::size_t n)
+    {
+        const __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(COMPACT_TABLE.lanes[mask])));
+        const __m256i ids = _mm256_add_epi32(_mm256_set1_epi32(static_cast<std::int32_t>(base)), lanes);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + n), ids);
+        return n + COMPACT_TABLE.count[mask];
+    }
+
+    //! 矩形との交差判定（AVX2：8個ずつ判定する）
+    MY_TARGET_AVX2 std::size_t rectAvx2(const my::CullArrays& b, const std::size_t num, const float* view, std::uint32_t* out)
+    {
+        const __m256 vminx = _mm256_set1_ps(view[0]);
+        const __m256 vminy = _mm256_set1_ps(view[1]);
+        const __m256 vmaxx = _mm256_set1_ps(view[2]);
+        const __m256 vmaxy = _mm256_set1_ps(view[3]);
+        const std::size_t simd = num & ~static_cast<std::size_t>(7U);
+        std::size_t n = 0U;
+        for (std::size_t i = 0U; i < simd; i += 8U) {
+            __m256 in = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(b.minx + i), vmaxx, _CMP_LE_OQ), _mm256_cmp_ps(vminx, _mm256_loadu_ps(b.maxx + i), _CMP_LE_OQ));
+            in = _mm256_and_ps(in, _mm256_cmp_ps(_mm256_loadu_ps(b.miny + i), vmaxy, _CMP_LE_OQ));
+            in = _mm256_and_ps(in, _mm256_cmp_ps(vminy, _mm256_loadu_ps(b.maxy + i), _CMP_LE_OQ));
+            n = compact8(static_cast<std::uint32_t>(_mm256_movemask_ps(in)), i, out, n);
+        }
+        return rectTail(b, simd, num, view, out, n);
+    }
+
+    //! 視錐台との交差判定（AVX2+FMA：8個ずつ判定する）
+    MY_TARGET_AVX2 std::size_t frustumAvx2(const my::CullArrays& b, const std::size_t num, const float* planes, std::uint32_t* out)
+    {
+        const PlaneArrays p = selectPlaneArrays(b, planes);
+        const __m256 zero = _mm256_setzero_ps();
+        const std::size_t simd = num & ~static_cast<std::size_t>(7U);
+        std::size_t n = 0U;
+        for (std::size_t i = 0U; i < simd; i += 8U) {
+            __m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (std::size_t k = 0U; k < 6U; k++) {
+                const float* e = planes + (k * 4U);
+                __m256 d = _mm256_fmadd_ps(_mm256_set1_ps(e[0]), _mm256_loadu_ps(p.x[k] + i), _mm256_set1_ps(e[3]));
+                d = _mm256_fmadd_ps(_mm256_set1_ps(e[1]), _mm256_loadu_ps(p.y[k] + i), d);
+                d = _mm256_fmadd_ps(_mm256_set1_ps(e[2]), _mm256_loadu_ps(p.z[k] + i), d);
+                in = _mm256_and_ps(in, _mm256_cmp_ps(d, zero, _CMP_GE_OQ));
+            }
+            n = compact8(static_cast<std::uint32_t>(_mm256_movemask_ps(in)), i, out, n);
+        }
+        return frustumTail(p, simd, num, planes, out, n);
+    }
+
+    //! AVX2の判定関数の組
+    const my::CullKernel KERNEL_AVX2 = { my::Cpu::ISA::AVX2, rectAvx2, frustumAvx2 };
+#endif
+}
+
+namespace {
+#if defined(MY_SIMD_NEON)
+    //! 4個の判定結果（レーン毎の全bit）を下位4bitにまとめる
+    inline std::uint32_t maskNeon(const uint32x4_t in)
+    {
+        return (vgetq_lane_u32(in, 0) & 1U) | (vgetq_lane_u32(in, 1) & 2U) | (vgetq_lane_u32(in, 2) & 4U) | (vgetq_lane_u32(in, 3) & 8U);
+    }
+
+    //! 矩形との交差判定（NEON：4個ずつ判定する）
+    std::size_t rectNeon(const my::CullArrays& b, const std::size_t num, const float* view, std::uint32_t* out)
+    {
+        const float32x4_t vminx = vdupq_n_f32(view[0]);
+        const float32x4_t vminy = vdupq_n_f32(view[1]);
+        const float32x4_t vmaxx = vdupq_n_f32(view[2]);
+        const float32x4_t vmaxy = vdupq_n_f32(view[3]);
+        const std::size_t simd = num & ~static_cast<std::size_t>(3U);
+        std::size_t n = 0U;
+        for (std::size_t i = 0U; i < simd; i += 4U) {
+            uint32x4_t in = vandq_u32(vcleq_f32(vld1q_f32(b.minx + i), vmaxx), vcleq_f32(vminx, vld1q_f32(b.maxx + i)));
+            in = vandq_u32(in, vcleq_f32(vld1q_f32(b.miny + i), vmaxy));
+            in = vandq_u32(in, vcleq_f32(vminy, vld1q_f32(b.maxy + i)));
+            n = compact4(maskNeon(in), i, out, n);
+        }
+        return rectTail(b, simd, num, view, out, n);
+    }
+
+    //! 視錐台との交差判定（NEON：4個ずつ判定する）
+    std::size_t frustumNeon(const my::CullArrays& b, const std::size_t num, const float* planes, std::uint32_t* out)
+    {
+        const PlaneArrays p = selectPlaneArrays(b, planes);
+        const float32x4_t zero = vdupq_n_f32(0.0F);
+        const std::size_t simd = num & ~static_cast<std::size_t>(3U);
+        std::size_t n = 0U;
+        for (std::size_t i = 0U; i < simd; i += 4U) {
+            uint32x4_t in = vdupq_n_u32(0xFFFFFFFFU);
+            for (std::size_t k = 0U; k < 6U; k++) {
+                const float* e = planes + (k * 4U);
+                float32x4_t d = vfmaq_n_f32(vdupq_n_f32(e[3]), vld1q_f32(p.x[k] + i), e[0]);
+                d = vfmaq_n_f32(d, vld1q_f32(p.y[k] + i), e[1]);
+                d = vfmaq_n_f32(d, vld1q_f32(p.z[k] + i), e[2]);
+                in = vandq_u32(in, vcgeq_f32(d, zero));
+            }
+            n = compact4(maskNeon(in), i, out, n);
+        }
+        return frustumTail(p, simd, num, planes, out, n);
+    }
+
+    //! NEONの判定関数の組
+    const my::CullKernel KERNEL_NEON = { my::Cpu::ISA::NEON, rectNeon, frustumNeon };
+#endif
+}
+
+namespace my {
+    /**
+     * @brief 使用する命令セット（Cpu::isa()）の判定関数の組を取得
+     * 
+     * @return const CullKernel& 判定関数の組
+     */
+    const CullKernel& CullKernel::get()
+    {
+        return CullKernel::get(Cpu::isa());
+    }
+
+    /**
+     * @brief 命令セットの判定関数の組を取得
+     * 
+     * @param [in] isa 命令セット
+     * 
+     * @return const CullKernel& 判定関数の組（実行中のCPUが対応していない場合はSCALAR）
+     */
+    const CullKernel& CullKernel::get(const Cpu::ISA isa)
+    {
+        if (!Cpu::supports(isa)) {
+            return KERNEL_SCALAR;
+        }
+        switch (isa) {
+        case Cpu::ISA::SSE2:
+#if defined(MY_SIMD_SSE2)
+            return KERNEL_SSE2;
+#else
+            return KERNEL_SCALAR;
+#endif
+        case Cpu::ISA::AVX2:
+#if defined(MY_SIMD_AVX2)
+            return KERNEL_AVX2;
+#else
+            return KERNEL_SCALAR;
+#endif
+        case Cpu::ISA::NEON:
+#if defined(MY_SIMD_NEON)
+            return KERNEL_NEON;
+#else
+            return KERNEL_SCALAR;
+#endif
+        case Cpu::ISA::SCALAR:
+        default:
+            return KERNEL_SCALAR;
+        }
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ（全ての空間を内側とする）
+     * 
+     * @par 詳細
+     *      全ての平面を(0, 0, 0, 1)とする。
+     */
+    Frustum::Frustum() :
+        m_planes()
+    {
+        for (std::size_t k = 0U; k < 6U; k++) {
+            this->m_planes[(k * 4U) + 3U] = 1.0F;
+        }
+    }
+
+    /**
+     * @brief コンストラクタ（ビュー変換行列・投影変換行列の積から作成）
+     * 
+     * @param [in] viewproj ビュー変換行列・投影変換行列の積（view * proj、行優先）
+     * 
+     * @par 詳細
+     *      クリップ座標(x, y, z, w)の各行をr0-r3として、-w <= x <= wを r3 + r0 >= 0・r3 - r0 >= 0 で表す（y, zも同様）。
+     *      判定は内側・外側の符号のみ使用するため、平面は正規化しない。
+     */
+    Frustum::Frustum(const Matrix& viewproj) :
+        m_planes()
+    {
+        for (std::size_t axis = 0U; axis < 3U; axis++) {
+            for (std::size_t side = 0U; side < 2U; side++) {
+                const float sign = (side == 0U) ? 1.0F : -1.0F;
+                const std::size_t plane = ((axis * 2U) + side) * 4U;
+                for (std::size_t j = 0U; j < 4U; j++) {
+                    this->m_planes[plane + j] = viewproj[12U + j] + (sign * viewproj[(axis * 4U) + j]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 平面の並びを取得
+     * 
+     * @return const float* 平面(a, b, c, d)の並び（左・右・下・上・近・遠の順の24要素）
+     */
+    const float* Frustum::planes() const
+    {
+        return this->m_planes.data();
+    }
+}
+
+namespace {
+    //! 判定関数（CullKernel::rect・CullKernel::frustum）
+    using CullFunc = std::size_t (*)(const my::CullArrays& boxes, const std::size_t num, const float* params, std::uint32_t* out);
+
+    //! 箱の並びを判定関数で判定（grainが0以外の場合は並列に判定する）
+    std::size_t cullRange(const CullFunc func, const my::CullArrays& boxes, const std::size_t num, const float* params, std::uint32_t* out, const std::size_t grain)
+    {
+        if (grain == 0U) {
+            return func(boxes, num, params, out);
+        }
+        // 区間毎に区間の先頭位置から詰めて書き込み（区間内の番号）、区間の可視の数を記録する
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        std::mutex mutex;
+        my::Parallel::forRange(num, grain, [&](const std::size_t begin, const std::size_t end) {
+            const my::CullArrays part = { boxes.minx + begin, boxes.miny + begin, boxes.minz + begin, boxes.maxx + begin, boxes.maxy + begin, boxes.maxz + begin };
+            const std::size_t count = func(part, end - begin, params, out + begin);
+            const std::lock_guard<std::mutex> lock(mutex);
+            ranges.emplace_back(begin, count);
+        });
+        // 区間の順に前へ詰め、区間内の番号を箱の番号に変換する（詰めた位置は常に区間の先頭位置以前）
+        std::sort(ranges.begin(), ranges.end());
+        std::size_t n = 0U;
+        for (const auto& range : ranges) {
+            const std::uint32_t base = static_cast<std::uint32_t>(range.first);
+            for (std::size_t i = 0U; i < range.second; i++) {
+                out[n + i] = out[range.first + i] + base;
+            }
+            n += range.second;
+        }
+        return n;
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    CullBoxes::CullBoxes() :
+        m_minx(), m_miny(), m_minz(), m_maxx(), m_maxy(), m_maxz()
+    {
+    }
+
+    /**
+     * @brief 全ての箱を削除
+     * 
+     */
+    void CullBoxes::clear()
+    {
+        this->m_minx.clear(); this->m_miny.clear(); this->m_minz.clear();
+        this->m_maxx.clear(); this->m_maxy.clear(); this->m_maxz.clear();
+    }
+
+    /**
+     * @brief 箱の数の領域を確保
+     * 
+     * @param [in] num 箱の数
+     */
+    void CullBoxes::reserve(const std::size_t num)
+    {
+        this->m_minx.reserve(num); this->m_miny.reserve(num); this->m_minz.reserve(num);
+        this->m_maxx.reserve(num); this->m_maxy.reserve(num); this->m_maxz.reserve(num);
+    }
+
+    /**
+     * @brief 箱を追加
+     * 
+     * @param [in] box XY平面上の矩形（空の矩形は矩形との判定で可視とならない）
+     * @param [in] minz 最小Z座標
+     * @param [in] maxz 最大Z座標
+     * @return std::uint32_t 箱の番号（追加した順）
+     */
+    std::uint32_t CullBoxes::add(const Aabb& box, const float minz, const float maxz)
+    {
+        const std::uint32_t id = static_cast<std::uint32_t>(this->m_minx.size());
+        this->m_minx.push_back(box.minx()); this->m_miny.push_back(box.miny()); this->m_minz.push_back(minz);
+        this->m_maxx.push_back(box.maxx()); this->m_maxy.push_back(box.maxy()); this->m_maxz.push_back(maxz);
+        return id;
+    }
+
+    /**
+     * @brief 箱を変更
+     * 
+     * @param [in] id 箱の番号
+     * @param [in] box XY平面上の矩形（空の矩形は矩形との判定で可視とならない）
+     * @param [in] minz 最小Z座標
+     * @param [in] maxz 最大Z座標
+     */
+    void CullBoxes::set(const std::uint32_t id, const Aabb& box, const float minz, const float maxz)
+    {
+        this->m_minx[id] = box.minx(); this->m_miny[id] = box.miny(); this->m_minz[id] = minz;
+        this->m_maxx[id] = box.maxx(); this->m_maxy[id] = box.maxy(); this->m_maxz[id] = maxz;
+    }
+
+    /**
+     * @brief 箱の数を取得
+     * 
+     * @return std::size_t 箱の数
+     */
+    std::size_t CullBoxes::size() const
+    {
+        return this->m_minx.size();
+    }
+
+    /**
+     * @brief 矩形と交差する箱の番号を判定
+     * 
+     * @param [in] view XY平面上の矩形（表示範囲）
+     * @param [out] out 判定結果（先頭から可視の箱の番号を昇順に詰める。箱の数より少ない場合は拡張し、縮小はしない）
+     * @param [in] grain 並列に判定する区間の最小の箱の数（0は呼び出し元のスレッドで判定する）
+     * @return std::size_t 可視の箱の数（outのそれ以降の要素は不定）
+     * 
+     * @par 詳細
+     *      毎フレーム同じoutを渡すと、領域の確保・初期化を繰り返さない。
+     *      多数の箱はgrainを指定し、Parallel::forRange()で区間毎に並列に判定する。
+     */
+    std::size_t CullBoxes::cull(const Aabb& view, std::vector<std::uint32_t>& out, const std::size_t grain) const
+    {
+        this->prepare(out);
+        const float rect[4] = { view.minx(), view.miny(), view.maxx(), view.maxy() };
+        return cullRange(CullKernel::get().rect, this->arrays(), this->size(), rect, out.data(), grain);
+    }
+
+    /**
+     * @brief 視錐台と交差する箱の番号を判定
+     * 
+     * @param [in] frustum 視錐台
+     * @param [out] out 判定結果（先頭から可視の箱の番号を昇順に詰める。箱の数より少ない場合は拡張し、縮小はしない）
+     * @param [in] grain 並列に判定する区間の最小の箱の数（0は呼び出し元のスレッドで判定する）
+     * @return std::size_t 可視の箱の数（outのそれ以降の要素は不定）
+     */
+    std::size_t CullBoxes::cull(const Frustum& frustum, std::vector<std::uint32_t>& out, const std::size_t grain) const
+    {
+        this->prepare(out);
+        return cullRange(CullKernel::get().frustum, this->arrays(), this->size(), frustum.planes(), out.data(), grain);
+    }
+
+    /**
+     * @brief 箱の並びを取得
+     * 
+     * @return CullArrays 軸毎の最小・最大座標の配列
+     */
+    CullArrays CullBoxes::arrays() const
+    {
+        return { this->m_minx.data(), this->m_miny.data(), this->m_minz.data(), this->m_maxx.data(), this->m_maxy.data(), this->m_maxz.data() };
+    }
+
+    /**
+     * @brief 判定結果の領域を確保
+     * 
+     * @param [out] out 判定結果（箱の数より少ない場合は拡張する）
+     */
+    void CullBoxes::prepare(std::vector<std::uint32_t>& out) const
+    {
+        if (out.size() < this->size()) {
+            out.resize(this->size());
+        }
+    }
+}
+
+
+namespace {
+    //! テスト・性能計測用の[0,1)の乱数
+    float randomUnit(std::uint32_t& seed)
+    {
+        seed = (seed * 1664525U) + 1013904223U;
+        return static_cast<float>(seed >> 8) / 16777216.0F;
+    }
+
+    //! テスト用の0.25刻みの矩形（10個に1個は空、先頭の4個は表示範囲(-64,-32)-(64,32)の境界に接する）
+    std::vector<my::Aabb> gridBoxes(std::uint32_t& seed, const std::size_t num)
+    {
+        std::vector<my::Aabb> boxes;
+        for (std::size_t i = 0U; i < num; i++) {
+            const float x = (std::floor(randomUnit(seed) * 768.0F) * 0.25F) - 96.0F;
+            const float y = (std::floor(randomUnit(seed) * 384.0F) * 0.25F) - 48.0F;
+            const float w = std::floor(randomUnit(seed) * 64.0F) * 0.25F;
+            const float h = std::floor(randomUnit(seed) * 64.0F) * 0.25F;
+            boxes.push_back(((i % 10U) == 9U) ? my::Aabb() : my::Aabb(x, y, x + w, y + h));
+        }
+        boxes[0] = my::Aabb(-80.0F, 0.0F, -64.0F, 1.0F);
+        boxes[1] = my::Aabb(64.0F, 0.0F, 70.0F, 1.0F);
+        boxes[2] = my::Aabb(0.0F, -40.0F, 1.0F, -32.0F);
+        boxes[3] = my::Aabb(0.0F, 32.25F, 1.0F, 40.0F);
+        return boxes;
+    }
+
+    //! テスト用の先頭num個の矩形の箱（Z座標は[minz, minz + depth)の乱数）
+    my::CullBoxes makeBoxes(std::uint32_t& seed, const std::vector<my::Aabb>& boxes, const std::size_t num, const float minz, const float depth)
+    {
+        my::CullBoxes out;
+        out.reserve(num);
+        for (std::size_t i = 0U; i < num; i++) {
+            const float z = minz + (randomUnit(seed) * depth);
+            (void)out.add(boxes[i], z, z + (randomUnit(seed) * 2.0F));
+        }
+        return out;
+    }
+
+    //! 判定結果の先頭count個が期待値と一致するか判定
+    bool sameIds(const std::vector<std::uint32_t>& out, const std::size_t count, const std::vector<std::uint32_t>& expect)
+    {
+        return (count == expect.size()) && std::equal(expect.begin(), expect.end(), out.begin());
+    }
+}
+
+namespace my {
+    /**
+     * @brief CullKernelのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     * 
+     * @par 詳細
+     *      各命令セット（Cpu::force）の判定結果を、Aabb::intersects・倍精度の視錐台の判定結果と比較する。
+     *      末尾の端数を確認するため、箱の数は命令セットの判定数の倍数としない。
+     */
+    bool testcode_CullKernel()
+    {
+        std::cout << "[testcode_CullKernel()] call detect:" << Cpu::name(Cpu::detect()) << std::endl;
+        bool ok = true;
+        const auto check = [&](const std::string& name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+
+        const std::size_t num = 1003U;
+        std::uint32_t seed = 3U;
+        const std::vector<Aabb> rects = gridBoxes(seed, num);
+        const Aabb view(-64.0F, -32.0F, 64.0F, 32.0F);
+
+        // 正射影の視錐台（Z方向は全ての箱を含む）は、XY平面の表示範囲と同じ判定となる
+        const Matrix ortho = Matrix::lookat(Vector(0.0F, 0.0F, 5.0F), Vector(0.0F, 0.0F, 0.0F), Vector(0.0F, 1.0F, 0.0F)) *
+            Matrix::orthogonal(-64.0F, 64.0F, -32.0F, 32.0F, 1.0F, 9.0F);
+        // 傾けた視錐台（倍精度の判定結果と比較する）
+        const Matrix oblique = Matrix::lookat(Vector(-30.0F, -20.0F, 12.0F), Vector(10.0F, 5.0F, 0.0F), Vector(0.0F, 0.0F, 1.0F)) *
+            Matrix::orthogonal(-40.0F, 40.0F, -20.0F, 20.0F, 0.5F, 40.0F);
+        const Frustum orthoFrustum(ortho);
+        const Frustum obliqueFrustum(oblique);
+
+        const Cpu::ISA isas[] = { Cpu::ISA::SCALAR, Cpu::ISA::SSE2, Cpu::ISA::NEON, Cpu::ISA::AVX2 };
+        for (const Cpu::ISA isa : isas) {
+            if (!Cpu::force(isa)) {
+                continue;
+            }
+            const std::string name = Cpu::name(isa);
+            bool rect = true, flat = true, tilted = true, all = true;
+            std::vector<std::uint32_t> out;
+            for (const std::size_t n : { static_cast<std::size_t>(0U), static_cast<std::size_t>(3U), static_cast<std::size_t>(7U), static_cast<std::size_t>(13U), num }) {
+                std::uint32_t zseed = 11U;
+                const CullBoxes boxes = makeBoxes(zseed, rects, n, -2.0F, 2.0F);
+                const CullBoxes deep = makeBoxes(zseed, rects, n, -30.0F, 40.0F);
+
+                std::vector<std::uint32_t> expect, expectTilted;
+                for (std::size_t i = 0U; i < n; i++) {
+                    if (rects[i].intersects(view)) {
+                        expect.push_back(static_cast<std::uint32_t>(i));
+                    }
+                }
+                out.assign(1U, 7U);
+                rect = rect && sameIds(out, boxes.cull(view, out), expect) && (out.size() >= n);
+                rect = rect && sameIds(out, boxes.cull(view, out, 5U), expect);
+                flat = flat && sameIds(out, boxes.cull(orthoFrustum, out), expect);
+                flat = flat && sameIds(out, boxes.cull(orthoFrustum, out, 5U), expect);
+
+                // 倍精度の判定（箱の8頂点のうち平面の内側にある頂点があれば平面の内側）
+                zseed = 11U;
+                for (std::size_t i = 0U; i < n; i++) {
+                    (void)randomUnit(zseed); (void)randomUnit(zseed);
+                }
+                for (std::size_t i = 0U; i < n; i++) {
+                    const double minz = -30.0 + (static_cast<double>(randomUnit(zseed)) * 40.0);
+                    const double maxz = minz + (static_cast<double>(randomUnit(zseed)) * 2.0);
+                    bool in = !rects[i].empty();
+                    for (std::size_t k = 0U; k < 6U; k++) {
+                        const float* e = obliqueFrustum.planes() + (k * 4U);
+                        double best = -1.0e30;
+                        for (std::int32_t c = 0; c < 8; c++) {
+                            const double x = ((c & 1) != 0) ? rects[i].maxx() : rects[i].minx();
+                            const double y = ((c & 2) != 0) ? rects[i].maxy() : rects[i].miny();
+                            const double z = ((c & 4) != 0) ? maxz : minz;
+                            best = std::max(best, (e[0] * x) + (e[1] * y) + (e[2] * z) + e[3]);
+                        }
+                        in = in && !(best < 0.0);
+                    }
+                    if (in) {
+                        expectTilted.push_back(static_cast<std::uint32_t>(i));
+                    }
+                }
+                tilted = tilted && sameIds(out, deep.cull(obliqueFrustum, out), expectTilted);
+
+                // 全ての空間を内側とする視錐台は全ての箱を可視とする
+                std::vector<std::uint32_t> every(n);
+                for (std::size_t i = 0U; i < n; i++) {
+                    every[i] = static_cast<std::uint32_t>(i);
+                }
+                all = all && sameIds(out, deep.cull(Frustum(), out), every);
+            }
+            check(name + " rect", rect);
+            check(name + " frustum ortho", flat);
+            check(name + " frustum oblique", tilted);
+            check(name + " frustum all", all);
+        }
+        Cpu::reset();
+
+        // 箱の変更・削除
+        {
+            std::uint32_t zseed = 1U;
+            CullBoxes boxes = makeBoxes(zseed, rects, 20U, 0.0F, 0.0F);
+            std::vector<std::uint32_t> out;
+            boxes.set(9U, Aabb(0.0F, 0.0F, 1.0F, 1.0F));
+            const bool set = (boxes.cull(Aabb(0.5F, 0.5F, 0.5F, 0.5F), out) >= 1U) && (std::find(out.begin(), out.end(), 9U) != out.end());
+            boxes.clear();
+            check("CullBoxes set/clear", set && (boxes.size() == 0U) && (boxes.cull(view, out) == 0U) && (boxes.add(Aabb(0.0F, 0.0F, 1.0F, 1.0F)) == 0U));
+        }
+        return ok;
+    }
+
+    /**
+     * @brief CullKernelの処理性能を計測
+     * 
+     * @par 詳細
+     *      100万個の箱を、表示範囲（全体の約1割）・視錐台で判定する時間を命令セット毎に計測する。
+     *      比較のため、Aabbの並びをAabb::intersectsで判定して番号を追加する時間も計測する。
+     */
+    void benchcode_CullKernel()
+    {
+        std::cout << "[benchcode_CullKernel()] call" << std::endl;
+        const std::size_t num = 1U << 20;
+        const std::int32_t repeat = 50;
+        std::uint32_t seed = 1U;
+        std::vector<Aabb> rects;
+        rects.reserve(num);
+        CullBoxes boxes;
+        boxes.reserve(num);
+        for (std::size_t i = 0U; i < num; i++) {
+            const float x = (randomUnit(seed) * 16384.0F) - 8192.0F;
+            const float y = (randomUnit(seed) * 16384.0F) - 8192.0F;
+            const Aabb box(x, y, x + (randomUnit(seed) * 64.0F), y + (randomUnit(seed) * 64.0F));
+            rects.push_back(box);
+            (void)boxes.add(box, -1.0F, 1.0F);
+        }
+        const Aabb view(-2560.0F, -2560.0F, 2560.0F, 2560.0F);
+        const Frustum frustum(Matrix::lookat(Vector(0.0F, 0.0F, 5.0F), Vector(0.0F, 0.0F, 0.0F), Vector(0.0F, 1.0F, 0.0F)) *
+            Matrix::orthogonal(-2560.0F, 2560.0F, -2560.0F, 2560.0F, 1.0F, 9.0F));
+        std::vector<std::uint32_t> out;
+        std::size_t sink = 0U;
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::int32_t r = 0; r < repeat; r++) {
+            out.clear();
+            for (std::size_t i = 0U; i < num; i++) {
+                if (rects[i].intersects(view)) {
+                    out.push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+            sink += out.size();
+        }
+        const double aos = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeat;
+        std::cout << "* Aabb::intersects boxes:" << num << " visible:" << out.size() << " time:" << aos << "[usec]" << std::endl;
+
+        const Cpu::ISA isas[] = { Cpu::ISA::SCALAR, Cpu::ISA::SSE2, Cpu::ISA::NEON, Cpu::ISA::AVX2 };
+        for (const Cpu::ISA isa : isas) {
+            if (!Cpu::force(isa)) {
+                continue;
+            }
+            std::size_t visible = 0U;
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                visible = boxes.cull(view, out);
+                sink += visible;
+            }
+            const double rect = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeat;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                sink += boxes.cull(frustum, out);
+            }
+            const double planes = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeat;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                sink += boxes.cull(view, out, 1U << 16);
+            }
+            const double rectPar = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeat;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                sink += boxes.cull(frustum, out, 1U << 16);
+            }
+            const double planesPar = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeat;
+
+            std::cout << "* " << Cpu::name(isa) << " visible:" << visible << " rect:" << rect << "[usec] frustum:" << planes << "[usec] rect(parallel x" << Parallel::threads() << "):" << rectPar << "[usec] frustum(parallel x" << Parallel::threads() << "):" << planesPar << "[usec] (" << sink << ")" << std::endl;
+        }
+        Cpu::reset();
+    }
+}
@@ -0,0 +1,135 @@
+﻿/**
+ * @file CullKernel.hpp
+ * @author kota-kota
+ * @brief 軸に平行な箱の可視判定を命令セット毎に実装した関数の定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_CULLKERNEL_HPP
+#define INCLUDED_CULLKERNEL_HPP
+
+#include "Cpu.hpp"
+#include "Matrix.hpp"
+#include "SpatialIndex.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @struct CullArrays
+     * @brief 軸に平行な箱の並び（軸毎の最小・最大座標の配列、SoA）
+     */
+    struct CullArrays {
+        const float*    minx;   //!< 最小X座標の配列
+        const float*    miny;   //!< 最小Y座標の配列
+        const float*    minz;   //!< 最小Z座標の配列
+        const float*    maxx;   //!< 最大X座標の配列
+        const float*    maxy;   //!< 最大Y座標の配列
+        const float*    maxz;   //!< 最大Z座標の配列
+    };
+
+    /**
+     * @struct CullKernel
+     * @brief 軸に平行な箱（SoA）の可視判定関数の組
+     * 
+     * @par 詳細
+     *      命令セット毎に1つずつ用意する（AVX2は8個ずつ、SSE2・NEONは4個ずつ判定する）。
+     *      num個の箱のうち可視の箱の番号（配列の位置）を、outの先頭から昇順に詰めて書き込み、可視の数を返す。
+     *      詰める際は判定した箱の数の範囲で可視の数を超えて書き込むため、outにはnum個の領域が必要（可視の数以降の要素は不定）。
+     *      - rect: XY平面上の矩形view(minx, miny, maxx, maxy)と交差する箱（Aabb::intersectsと同じく境界を含む）
+     *      - frustum: 6平面planes(a, b, c, dの並び、ax + by + cz + d >= 0が内側)のいずれの外側にも完全には出ていない箱
+     */
+    struct CullKernel {
+        Cpu::ISA    isa;    //!< 命令セット
+        std::size_t (*rect)(const CullArrays& boxes, const std::size_t num, const float* view, std::uint32_t* out);     //!< 矩形との交差判定
+        std::size_t (*frustum)(const CullArrays& boxes, const std::size_t num, const float* planes, std::uint32_t* out); //!< 視錐台との交差判定
+
+        //! 使用する命令セット（Cpu::isa()）の判定関数の組を取得
+        static const CullKernel& get();
+        //! 命令セットの判定関数の組を取得（対応していない場合はSCALAR）
+        static const CullKernel& get(const Cpu::ISA isa);
+    };
+}
+
+namespace my {
+    /**
+     * @class Frustum
+     * @brief 視錐台（6平面）を扱うクラス
+     * 
+     * @par 詳細
+     *      ビュー変換行列・投影変換行列の積（view * proj）のクリップ座標で-w <= x, y, z <= wとなる範囲を、
+     *      行列の行の和・差から求めた6平面で表す（左・右・下・上・近・遠の順）。
+     */
+    class Frustum {
+        std::array<float, 24>   m_planes;   //!< 平面(a, b, c, d)の並び（ax + by + cz + d >= 0が内側）
+
+    public:
+        //! デフォルトコンストラクタ（全ての空間を内側とする）
+        Frustum();
+        //! コンストラクタ（ビュー変換行列・投影変換行列の積から作成）
+        explicit Frustum(const Matrix& viewproj);
+
+    public:
+        //! 平面の並びを取得
+        const float* planes() const;
+    };
+
+    /**
+     * @class CullBoxes
+     * @brief 多数の物体の外接する箱をSoAで保持し、表示範囲・視錐台で一括して可視判定するクラス
+     * 
+     * @par 詳細
+     *      箱は軸毎の最小・最大座標の配列に分けて保持し、判定は命令セットの判定関数の組（CullKernel）で行う。
+     *      判定結果は、可視の箱の番号（追加した順）を昇順に詰めた並びとする。
+     */
+    class CullBoxes {
+        std::vector<float>  m_minx;     //!< 最小X座標の並び
+        std::vector<float>  m_miny;     //!< 最小Y座標の並び
+        std::vector<float>  m_minz;     //!< 最小Z座標の並び
+        std::vector<float>  m_maxx;     //!< 最大X座標の並び
+        std::vector<float>  m_maxy;     //!< 最大Y座標の並び
+        std::vector<float>  m_maxz;     //!< 最大Z座標の並び
+
+    public:
+        //! デフォルトコンストラクタ
+        CullBoxes();
+
+    public:
+        //! 全ての箱を削除
+        void clear();
+        //! 箱の数の領域を確保
+        void reserve(const std::size_t num);
+        //! 箱を追加
+        std::uint32_t add(const Aabb& box, const float minz = 0.0F, const float maxz = 0.0F);
+        //! 箱を変更
+        void set(const std::uint32_t id, const Aabb& box, const float minz = 0.0F, const float maxz = 0.0F);
+        //! 箱の数を取得
+        std::size_t size() const;
+
+    public:
+        //! 矩形と交差する箱の番号を判定
+        std::size_t cull(const Aabb& view, std::vector<std::uint32_t>& out, const std::size_t grain = 0U) const;
+        //! 視錐台と交差する箱の番号を判定
+        std::size_t cull(const Frustum& frustum, std::vector<std::uint32_t>& out, const std::size_t grain = 0U) const;
+
+    private:
+        //! 箱の並びを取得
+        CullArrays arrays() const;
+        //! 判定結果の領域を確保
+        void prepare(std::vector<std::uint32_t>& out) const;
+    };
+}
+
+namespace my {
+    //! CullKernelのテストコードを実行（各命令セットの結果をSCALARと比較する）
+    bool testcode_CullKernel();
+    //! CullKernelの処理性能を計測
+    void benchcode_CullKernel();
+}
+
+#endif //INCLUDED_CULLKERNEL_HPP
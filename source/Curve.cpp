@@ -0,0 +1,599 @@
+﻿/**
+ * @file Curve.cpp
+ * @author kota-kota
+ * @brief 曲線を折れ線に分割するクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Curve.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    //! 許容誤差の下限（オブジェクトの座標系）
+    constexpr float CURVE_MIN_TOLERANCE = 1.0e-4F;
+    //! 曲線1本あたりの分割数の上限
+    constexpr std::int32_t CURVE_MAX_SEGMENTS = 1024;
+    //! 楕円弧の90度あたりの分割数の下限
+    constexpr float CURVE_MIN_ARC_STEP = my::MATRIX_PI / 2.0F;
+
+    //! 分割数を上限・下限の範囲に丸める
+    std::int32_t clampSegments(const float n)
+    {
+        if (!(n < static_cast<float>(CURVE_MAX_SEGMENTS))) {
+            return CURVE_MAX_SEGMENTS;
+        }
+        return std::max(static_cast<std::int32_t>(std::ceil(n)), 1);
+    }
+
+    //! 2次元ベクトルの長さ
+    float length(const float x, const float y)
+    {
+        return std::sqrt((x * x) + (y * y));
+    }
+
+    /**
+     * @struct Cubic2
+     * @brief 3次ベジェ曲線の多項式の係数（B(t) = a*t^3 + b*t^2 + c*t + d）
+     */
+    struct Cubic2 {
+        float   ax, ay;     //!< 3次の係数
+        float   bx, by;     //!< 2次の係数
+        float   cx, cy;     //!< 1次の係数
+        float   dx, dy;     //!< 定数項
+    };
+
+    //! 制御点から多項式の係数を計算
+    Cubic2 toPolynomial(const my::CubicBezier& c)
+    {
+        Cubic2 p;
+        p.dx = c.p0().x();
+        p.dy = c.p0().y();
+        p.cx = 3.0F * (c.p1().x() - c.p0().x());
+        p.cy = 3.0F * (c.p1().y() - c.p0().y());
+        p.bx = 3.0F * ((c.p0().x() - (2.0F * c.p1().x())) + c.p2().x());
+        p.by = 3.0F * ((c.p0().y() - (2.0F * c.p1().y())) + c.p2().y());
+        p.ax = (c.p3().x() - c.p0().x()) + (3.0F * (c.p1().x() - c.p2().x()));
+        p.ay = (c.p3().y() - c.p0().y()) + (3.0F * (c.p1().y() - c.p2().y()));
+        return p;
+    }
+
+    /**
+     * @brief 3次ベジェ曲線を等間隔のパラメータで評価して出力先に追加
+     * 
+     * @param [in] curve 3次ベジェ曲線
+     * @param [in] n 分割数
+     * @param [out] out 出力先
+     * 
+     * @par 詳細
+     *      n + 1個の頂点を追加する。終点は制御点をそのまま出力する。
+     *      SIMD命令が使用可能な場合は4点ずつ評価する。
+     */
+    void evaluateCubic(const my::CubicBezier& curve, const std::int32_t n, my::Vertexes& out)
+    {
+        const Cubic2 p = toPolynomial(curve);
+        const float z = curve.p0().z();
+        const float inv = 1.0F / static_cast<float>(n);
+        std::int32_t i = 0;
+#if defined(MY_SIMD_SSE2)
+        const __m128 ax = _mm_set1_ps(p.ax), ay = _mm_set1_ps(p.ay);
+        const __m128 bx = _mm_set1_ps(p.bx), by = _mm_set1_ps(p.by);
+        const __m128 cx = _mm_set1_ps(p.cx), cy = _mm_set1_ps(p.cy);
+        const __m128 dx = _mm_set1_ps(p.dx), dy = _mm_set1_ps(p.dy);
+        const __m128 step = _mm_set1_ps(4.0F * inv);
+        __m128 t = _mm_mul_ps(_mm_set_ps(3.0F, 2.0F, 1.0F, 0.0F), _mm_set1_ps(inv));
+        alignas(16) float xs[4];
+        alignas(16) float ys[4];
+        for (; (i + 4) <= n; i += 4) {
+            const __m128 x = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(ax, t), bx), t), cx), t), dx);
+            const __m128 y = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(ay, t), by), t), cy), t), dy);
+            _mm_store_ps(xs, x);
+            _mm_store_ps(ys, y);
+            for (std::size_t k = 0U; k < 4U; k++) {
+                out.push_back({ xs[k], ys[k], z });
+            }
+            t = _mm_add_ps(t, step);
+        }
+#elif defined(MY_SIMD_NEON)
+        const float32x4_t ax = vdupq_n_f32(p.ax), ay = vdupq_n_f32(p.ay);
+        const float32x4_t bx = vdupq_n_f32(p.bx), by = vdupq_n_f32(p.by);
+        const float32x4_t cx = vdupq_n_f32(p.cx), cy = vdupq_n_f32(p.cy);
+        const float32x4_t dx = vdupq_n_f32(p.dx), dy = vdupq_n_f32(p.dy);
+        const float32x4_t step = vdupq_n_f32(4.0F * inv);
+        const float t0[4] = { 0.0F, 1.0F, 2.0F, 3.0F };
+        float32x4_t t = vmulq_n_f32(vld1q_f32(t0), inv);
+        float xs[4];
+        float ys[4];
+        for (; (i + 4) <= n; i += 4) {
+            vst1q_f32(xs, vmlaq_f32(dx, vmlaq_f32(cx, vmlaq_f32(bx, ax, t), t), t));
+            vst1q_f32(ys, vmlaq_f32(dy, vmlaq_f32(cy, vmlaq_f32(by, ay, t), t), t));
+            for (std::size_t k = 0U; k < 4U; k++) {
+                out.push_back({ xs[k], ys[k], z });
+            }
+            t = vaddq_f32(t, step);
+        }
+#endif
+        for (; i < n; i++) {
+            const float u = static_cast<float>(i) * inv;
+            out.push_back({ (((((p.ax * u) + p.bx) * u) + p.cx) * u) + p.dx, (((((p.ay * u) + p.by) * u) + p.cy) * u) + p.dy, z });
+        }
+        out.push_back(curve.p3());
+    }
+
+    /**
+     * @brief 3次ベジェ曲線の分割数を計算
+     * 
+     * @param [in] c 3次ベジェ曲線
+     * @param [in] tolerance 許容誤差（オブジェクトの座標系）
+     * 
+     * @return std::int32_t 分割数
+     * 
+     * @par 詳細
+     *      n分割の誤差はmax|B''| / (8 * n^2)以下で、max|B''|は2階差分d1、d2を用いて6 * max(|d1|, |d2|)以下となる。
+     */
+    std::int32_t cubicSegments(const my::CubicBezier& c, const float tolerance)
+    {
+        const float d1 = length((c.p0().x() - (2.0F * c.p1().x())) + c.p2().x(), (c.p0().y() - (2.0F * c.p1().y())) + c.p2().y());
+        const float d2 = length((c.p1().x() - (2.0F * c.p2().x())) + c.p3().x(), (c.p1().y() - (2.0F * c.p2().y())) + c.p3().y());
+        return clampSegments(std::sqrt(std::max(d1, d2) * 3.0F / (4.0F * tolerance)));
+    }
+
+    /**
+     * @brief 複数の3次ベジェ曲線の分割数を一括計算
+     * 
+     * @param [in] curves 3次ベジェ曲線の並び
+     * @param [in] tolerance 許容誤差（オブジェクトの座標系）
+     * @param [out] counts 分割数の並び（curves.size()個）
+     * 
+     * @par 詳細
+     *      SIMD命令が使用可能な場合は4曲線ずつ計算する。
+     */
+    void computeCubicSegments(const std::vector<my::CubicBezier>& curves, const float tolerance, std::vector<std::int32_t>& counts)
+    {
+        // cubicSegments()と同じ式
+        const float k = 3.0F / (4.0F * tolerance);
+        counts.resize(curves.size());
+        std::size_t i = 0U;
+#if defined(MY_SIMD_SSE2) || defined(MY_SIMD_NEON)
+        alignas(16) float d[4][4];
+        alignas(16) float n[4];
+        for (; (i + 4U) <= curves.size(); i += 4U) {
+            // 4曲線分の2階差分をSoA形式に並べ替える
+            for (std::size_t j = 0U; j < 4U; j++) {
+                const my::CubicBezier& c = curves[i + j];
+                d[0][j] = (c.p0().x() - (2.0F * c.p1().x())) + c.p2().x();
+                d[1][j] = (c.p0().y() - (2.0F * c.p1().y())) + c.p2().y();
+                d[2][j] = (c.p1().x() - (2.0F * c.p2().x())) + c.p3().x();
+                d[3][j] = (c.p1().y() - (2.0F * c.p2().y())) + c.p3().y();
+            }
+#if defined(MY_SIMD_SSE2)
+            const __m128 d1x = _mm_load_ps(d[0]), d1y = _mm_load_ps(d[1]);
+            const __m128 d2x = _mm_load_ps(d[2]), d2y = _mm_load_ps(d[3]);
+            const __m128 m = _mm_max_ps(_mm_add_ps(_mm_mul_ps(d1x, d1x), _mm_mul_ps(d1y, d1y)), _mm_add_ps(_mm_mul_ps(d2x, d2x), _mm_mul_ps(d2y, d2y)));
+            _mm_store_ps(n, _mm_sqrt_ps(_mm_mul_ps(_mm_sqrt_ps(m), _mm_set1_ps(k))));
+#else
+            const float32x4_t d1x = vld1q_f32(d[0]), d1y = vld1q_f32(d[1]);
+            const float32x4_t d2x = vld1q_f32(d[2]), d2y = vld1q_f32(d[3]);
+            const float32x4_t m = vmaxq_f32(vmlaq_f32(vmulq_f32(d1x, d1x), d1y, d1y), vmlaq_f32(vmulq_f32(d2x, d2x), d2y, d2y));
+            vst1q_f32(n, vsqrtq_f32(vmulq_n_f32(vsqrtq_f32(m), k)));
+#endif
+            for (std::size_t j = 0U; j < 4U; j++) {
+                counts[i + j] = clampSegments(n[j]);
+            }
+        }
+#endif
+        for (; i < curves.size(); i++) {
+            counts[i] = cubicSegments(curves[i], tolerance);
+        }
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] p0 始点
+     * @param [in] p1 制御点1
+     * @param [in] p2 制御点2
+     * @param [in] p3 終点
+     */
+    CubicBezier::CubicBezier(const Vertex& p0, const Vertex& p1, const Vertex& p2, const Vertex& p3) :
+        m_p0(p0), m_p1(p1), m_p2(p2), m_p3(p3)
+    {
+    }
+
+    /**
+     * @brief 2次ベジェ曲線から生成
+     * 
+     * @param [in] p0 始点
+     * @param [in] p1 制御点
+     * @param [in] p2 終点
+     * 
+     * @return CubicBezier 同じ形状の3次ベジェ曲線（次数上げ）
+     */
+    CubicBezier CubicBezier::fromQuadratic(const Vertex& p0, const Vertex& p1, const Vertex& p2)
+    {
+        const float k = 2.0F / 3.0F;
+        return CubicBezier(p0,
+            { p0.x() + (k * (p1.x() - p0.x())), p0.y() + (k * (p1.y() - p0.y())), p0.z() },
+            { p2.x() + (k * (p1.x() - p2.x())), p2.y() + (k * (p1.y() - p2.y())), p2.z() },
+            p2);
+    }
+
+    /**
+     * @brief 始点を取得
+     * 
+     * @return const Vertex& 始点
+     */
+    const Vertex& CubicBezier::p0() const { return this->m_p0; }
+
+    /**
+     * @brief 制御点1を取得
+     * 
+     * @return const Vertex& 制御点1
+     */
+    const Vertex& CubicBezier::p1() const { return this->m_p1; }
+
+    /**
+     * @brief 制御点2を取得
+     * 
+     * @return const Vertex& 制御点2
+     */
+    const Vertex& CubicBezier::p2() const { return this->m_p2; }
+
+    /**
+     * @brief 終点を取得
+     * 
+     * @return const Vertex& 終点
+     */
+    const Vertex& CubicBezier::p3() const { return this->m_p3; }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] tolerance 許容誤差（画面上の距離[pixel]）
+     * @param [in] scale 拡大率（オブジェクトの座標系に対するデバイス座標系の拡大率）
+     */
+    Flattener::Flattener(const float tolerance, const float scale) :
+        m_tolerance(CURVE_MIN_TOLERANCE)
+    {
+        this->setTolerance(tolerance, scale);
+    }
+
+    /**
+     * @brief 許容誤差を設定
+     * 
+     * @param [in] tolerance 許容誤差（画面上の距離[pixel]）
+     * @param [in] scale 拡大率（オブジェクトの座標系に対するデバイス座標系の拡大率）
+     */
+    void Flattener::setTolerance(const float tolerance, const float scale)
+    {
+        const float t = (scale > 0.0F) ? (tolerance / scale) : tolerance;
+        this->m_tolerance = std::max(t, CURVE_MIN_TOLERANCE);
+    }
+
+    /**
+     * @brief 許容誤差（オブジェクトの座標系）を取得
+     * 
+     * @return float 許容誤差
+     */
+    float Flattener::getTolerance() const { return this->m_tolerance; }
+
+    /**
+     * @brief 2次ベジェ曲線の分割数を取得
+     * 
+     * @param [in] p0 始点
+     * @param [in] p1 制御点
+     * @param [in] p2 終点
+     * 
+     * @return std::int32_t 分割数
+     * 
+     * @par 詳細
+     *      2階微分は一定(2 * (p0 - 2 * p1 + p2))のため、n分割の誤差は|p0 - 2 * p1 + p2| / (4 * n^2)となる。
+     */
+    std::int32_t Flattener::segments(const Vertex& p0, const Vertex& p1, const Vertex& p2) const
+    {
+        const float d = length((p0.x() - (2.0F * p1.x())) + p2.x(), (p0.y() - (2.0F * p1.y())) + p2.y());
+        return clampSegments(std::sqrt(d / (4.0F * this->m_tolerance)));
+    }
+
+    /**
+     * @brief 3次ベジェ曲線の分割数を取得
+     * 
+     * @param [in] curve 3次ベジェ曲線
+     * 
+     * @return std::int32_t 分割数
+     */
+    std::int32_t Flattener::segments(const CubicBezier& curve) const
+    {
+        return cubicSegments(curve, this->m_tolerance);
+    }
+
+    /**
+     * @brief 楕円弧の分割数を取得
+     * 
+     * @param [in] rx X軸方向の半径
+     * @param [in] ry Y軸方向の半径
+     * @param [in] sweep 弧の角度
+     * 
+     * @return std::int32_t 分割数
+     * 
+     * @par 詳細
+     *      長い方の半径の円弧で、弦と弧の距離（r * (1 - cos(θ/2))）が許容誤差以内となる角度θで分割する。
+     *      90度あたり1分割以上とする。
+     */
+    std::int32_t Flattener::segments(const float rx, const float ry, const Radian sweep) const
+    {
+        const float r = std::max(std::fabs(rx), std::fabs(ry));
+        const float s = std::fabs(sweep.rad());
+        const float lower = s / CURVE_MIN_ARC_STEP;
+        if (this->m_tolerance >= r) {
+            return clampSegments(lower);
+        }
+        const float step = 2.0F * std::acos(1.0F - (this->m_tolerance / r));
+        return clampSegments(std::max(s / step, lower));
+    }
+
+    /**
+     * @brief 2次ベジェ曲線を分割
+     * 
+     * @param [in] p0 始点
+     * @param [in] p1 制御点
+     * @param [in] p2 終点
+     * @param [out] out 出力先（分割数 + 1個の頂点を追加）
+     */
+    void Flattener::quadratic(const Vertex& p0, const Vertex& p1, const Vertex& p2, Vertexes& out) const
+    {
+        const std::int32_t n = this->segments(p0, p1, p2);
+        evaluateCubic(CubicBezier::fromQuadratic(p0, p1, p2), n, out);
+    }
+
+    /**
+     * @brief 3次ベジェ曲線を分割
+     * 
+     * @param [in] curve 3次ベジェ曲線
+     * @param [out] out 出力先（分割数 + 1個の頂点を追加）
+     */
+    void Flattener::cubic(const CubicBezier& curve, Vertexes& out) const
+    {
+        const std::int32_t n = this->segments(curve);
+        evaluateCubic(curve, n, out);
+    }
+
+    /**
+     * @brief 複数の3次ベジェ曲線を一括で分割
+     * 
+     * @param [in] curves 3次ベジェ曲線の並び
+     * @param [out] out 出力先（曲線毎に分割数 + 1個の頂点を追加）
+     * @param [out] offsets 曲線毎の出力先の先頭位置（curves.size() + 1個、末尾は出力後のout.size()）
+     * 
+     * @par 詳細
+     *      分割数を4曲線ずつ、頂点座標を曲線毎に4点ずつSIMD命令で計算する。
+     *      出力先の領域は、全曲線の分割数を求めた後に一度だけ確保する。
+     */
+    void Flattener::cubics(const std::vector<CubicBezier>& curves, Vertexes& out, std::vector<std::size_t>& offsets) const
+    {
+        std::vector<std::int32_t> counts;
+        computeCubicSegments(curves, this->m_tolerance, counts);
+
+        offsets.resize(curves.size() + 1U);
+        std::size_t total = out.size();
+        for (std::size_t i = 0U; i < curves.size(); i++) {
+            offsets[i] = total;
+            total += static_cast<std::size_t>(counts[i]) + 1U;
+        }
+        offsets[curves.size()] = total;
+
+        out.reserve(total);
+        for (std::size_t i = 0U; i < curves.size(); i++) {
+            evaluateCubic(curves[i], counts[i], out);
+        }
+    }
+
+    /**
+     * @brief 楕円弧を分割
+     * 
+     * @param [in] center 中心
+     * @param [in] rx X軸方向の半径
+     * @param [in] ry Y軸方向の半径
+     * @param [in] rotation 楕円のX軸の回転角度
+     * @param [in] start 開始角度
+     * @param [in] sweep 弧の角度（負の場合は時計回り）
+     * @param [out] out 出力先（分割数 + 1個の頂点を追加）
+     */
+    void Flattener::arc(const Vertex& center, const float rx, const float ry, const Radian rotation, const Radian start, const Radian sweep, Vertexes& out) const
+    {
+        const std::int32_t n = this->segments(rx, ry, sweep);
+        const float cr = std::cos(rotation.rad());
+        const float sr = std::sin(rotation.rad());
+        const float step = sweep.rad() / static_cast<float>(n);
+        for (std::int32_t i = 0; i <= n; i++) {
+            const float a = start.rad() + (static_cast<float>(i) * step);
+            const float x = rx * std::cos(a);
+            const float y = ry * std::sin(a);
+            out.push_back({ center.x() + ((x * cr) - (y * sr)), center.y() + ((x * sr) + (y * cr)), center.z() });
+        }
+    }
+
+    /**
+     * @brief 円を分割
+     * 
+     * @param [in] center 中心
+     * @param [in] r 半径
+     * @param [out] out 出力先（分割数個の頂点を反時計回りに追加、始点は重複させない）
+     */
+    void Flattener::circle(const Vertex& center, const float r, Vertexes& out) const
+    {
+        const std::int32_t n = this->segments(r, r, Radian(2.0F * MATRIX_PI));
+        const float step = 2.0F * MATRIX_PI / static_cast<float>(n);
+        for (std::int32_t i = 0; i < n; i++) {
+            const float a = static_cast<float>(i) * step;
+            out.push_back({ center.x() + (r * std::cos(a)), center.y() + (r * std::sin(a)), center.z() });
+        }
+    }
+}
+
+namespace {
+    //! 点と線分の距離
+    float distanceToSegment(const my::Vertex& p, const my::Vertex& a, const my::Vertex& b)
+    {
+        const float dx = b.x() - a.x();
+        const float dy = b.y() - a.y();
+        const float len2 = (dx * dx) + (dy * dy);
+        float t = (len2 > 0.0F) ? ((((p.x() - a.x()) * dx) + ((p.y() - a.y()) * dy)) / len2) : 0.0F;
+        t = std::min(std::max(t, 0.0F), 1.0F);
+        return length(p.x() - (a.x() + (t * dx)), p.y() - (a.y() + (t * dy)));
+    }
+
+    //! 曲線上の点と折れ線の距離の最大値
+    float maxDeviation(const my::Vertexes& curve, const my::Vertexes& polyline)
+    {
+        float dev = 0.0F;
+        for (const my::Vertex& p : curve) {
+            float d = 1.0e30F;
+            for (std::size_t i = 1U; i < polyline.size(); i++) {
+                d = std::min(d, distanceToSegment(p, polyline[i - 1U], polyline[i]));
+            }
+            dev = std::max(dev, d);
+        }
+        return dev;
+    }
+
+    //! 3次ベジェ曲線を細かく評価
+    my::Vertexes sampleCubic(const my::CubicBezier& c, const std::int32_t num)
+    {
+        my::Vertexes v;
+        for (std::int32_t i = 0; i <= num; i++) {
+            const float t = static_cast<float>(i) / static_cast<float>(num);
+            const float u = 1.0F - t;
+            const float b0 = u * u * u, b1 = 3.0F * u * u * t, b2 = 3.0F * u * t * t, b3 = t * t * t;
+            v.push_back({ (b0 * c.p0().x()) + (b1 * c.p1().x()) + (b2 * c.p2().x()) + (b3 * c.p3().x()),
+                          (b0 * c.p0().y()) + (b1 * c.p1().y()) + (b2 * c.p2().y()) + (b3 * c.p3().y()) });
+        }
+        return v;
+    }
+
+    //! 誤差と許容誤差を比較
+    bool expectDeviation(const char* name, const my::Vertexes& curve, const my::Vertexes& polyline, const float tolerance)
+    {
+        const float dev = maxDeviation(curve, polyline);
+        const bool ok = (dev <= (tolerance * 1.01F));
+        std::cout << "* " << name << " vertexes:" << polyline.size() << " deviation:" << dev << " tolerance:" << tolerance << (ok ? " .. OK" : " .. NG") << std::endl;
+        return ok;
+    }
+}
+
+namespace my {
+    /**
+     * @brief Flattenerクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     * 
+     * @par 詳細
+     *      分割した折れ線と、細かく評価した曲線上の点との距離が許容誤差以内であることを確認する。
+     *      また、拡大率に応じて分割数が増えることを確認する。
+     */
+    bool testcode_Flattener()
+    {
+        std::cout << "[testcode_Flattener()] call" << std::endl;
+        bool ok = true;
+        const CubicBezier s_curve({ 0.0F, 0.0F }, { 100.0F, 200.0F }, { 200.0F, -200.0F }, { 300.0F, 0.0F });
+        const float scales[] = { 0.25F, 1.0F, 4.0F };
+        std::int32_t prev = 0;
+        for (const float scale : scales) {
+            const Flattener flattener(0.5F, scale);
+            Vertexes cubic;
+            flattener.cubic(s_curve, cubic);
+            ok = expectDeviation("cubic", sampleCubic(s_curve, 2000), cubic, flattener.getTolerance()) && ok;
+            const bool more = (static_cast<std::int32_t>(cubic.size()) > prev);
+            std::cout << "* scale:" << scale << " segments:" << (cubic.size() - 1U) << (more ? " .. OK" : " .. NG") << std::endl;
+            ok = more && ok;
+            prev = static_cast<std::int32_t>(cubic.size());
+        }
+
+        const Flattener flattener(0.25F, 1.0F);
+        Vertexes quad;
+        flattener.quadratic({ 0.0F, 0.0F }, { 50.0F, 100.0F }, { 100.0F, 0.0F }, quad);
+        ok = expectDeviation("quadratic", sampleCubic(CubicBezier::fromQuadratic({ 0.0F, 0.0F }, { 50.0F, 100.0F }, { 100.0F, 0.0F }), 2000), quad, flattener.getTolerance()) && ok;
+
+        Vertexes arc, exact;
+        flattener.arc({ 10.0F, 20.0F }, 80.0F, 30.0F, Radian(0.5F), Radian(0.0F), Radian(-3.0F), arc);
+        const Flattener fine(0.001F, 1.0F);
+        fine.arc({ 10.0F, 20.0F }, 80.0F, 30.0F, Radian(0.5F), Radian(0.0F), Radian(-3.0F), exact);
+        ok = expectDeviation("arc", exact, arc, flattener.getTolerance() + fine.getTolerance()) && ok;
+
+        Vertexes circle, circle_exact;
+        flattener.circle({ 0.0F, 0.0F }, 100.0F, circle);
+        fine.circle({ 0.0F, 0.0F }, 100.0F, circle_exact);
+        circle.push_back(circle.front());
+        ok = expectDeviation("circle", circle_exact, circle, flattener.getTolerance() + fine.getTolerance()) && ok;
+
+        // 一括分割と1本ずつの分割の結果が一致すること
+        std::vector<CubicBezier> curves;
+        for (std::int32_t i = 0; i < 11; i++) {
+            const float f = static_cast<float>(i);
+            curves.push_back(CubicBezier({ f, 0.0F }, { f + 10.0F, f * 10.0F }, { f + 20.0F, -f * 5.0F }, { f + 30.0F, 1.0F }));
+        }
+        Vertexes batch;
+        std::vector<std::size_t> offsets;
+        flattener.cubics(curves, batch, offsets);
+        bool same = (offsets.size() == (curves.size() + 1U)) && (offsets.back() == batch.size());
+        for (std::size_t i = 0U; same && (i < curves.size()); i++) {
+            Vertexes single;
+            flattener.cubic(curves[i], single);
+            same = (single.size() == (offsets[i + 1U] - offsets[i]));
+            for (std::size_t j = 0U; same && (j < single.size()); j++) {
+                same = (length(single[j].x() - batch[offsets[i] + j].x(), single[j].y() - batch[offsets[i] + j].y()) < 1.0e-3F);
+            }
+        }
+        std::cout << "* batch curves:" << curves.size() << " vertexes:" << batch.size() << (same ? " .. OK" : " .. NG") << std::endl;
+        ok = same && ok;
+        return ok;
+    }
+
+    /**
+     * @brief Flattenerクラスの処理性能を計測
+     * 
+     * @par 詳細
+     *      多数の3次ベジェ曲線を1本ずつ分割した場合と、一括で分割した場合の1秒あたりの曲線数を出力する。
+     */
+    void benchcode_Flattener()
+    {
+        std::cout << "[benchcode_Flattener()] call" << std::endl;
+        std::vector<CubicBezier> curves;
+        const std::size_t num = 200000U;
+        curves.reserve(num);
+        for (std::size_t i = 0U; i < num; i++) {
+            const float f = static_cast<float>(i % 100U);
+            curves.push_back(CubicBezier({ 0.0F, 0.0F }, { 10.0F + f, 40.0F }, { 60.0F, -40.0F + f }, { 80.0F, 0.0F }));
+        }
+        const Flattener flattener(0.5F, 1.0F);
+
+        Vertexes out;
+        auto start = std::chrono::steady_clock::now();
+        for (const CubicBezier& c : curves) {
+            flattener.cubic(c, out);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double sec = std::chrono::duration<double>(end - start).count();
+        std::cout << "* single curves:" << num << " vertexes:" << out.size() << " time:" << (sec * 1000.0) << "[msec] " << (static_cast<double>(num) / sec) << "[curves/sec]" << std::endl;
+
+        out.clear();
+        out.shrink_to_fit();
+        std::vector<std::size_t> offsets;
+        start = std::chrono::steady_clock::now();
+        flattener.cubics(curves, out, offsets);
+        end = std::chrono::steady_clock::now();
+        sec = std::chrono::duration<double>(end - start).count();
+        std::cout << "* batch curves:" << num << " vertexes:" << out.size() << " time:" << (sec * 1000.0) << "[msec] " << (static_cast<double>(num) / sec) << "[curves/sec]" << std::endl;
+    }
+}
@@ -0,0 +1,101 @@
+﻿/**
+ * @file Curve.hpp
+ * @author kota-kota
+ * @brief 曲線を折れ線に分割するクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_CURVE_HPP
+#define INCLUDED_CURVE_HPP
+
+#include "Vertex.hpp"
+#include "Matrix.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class CubicBezier
+     * @brief 3次ベジェ曲線を扱うクラス
+     */
+    class CubicBezier {
+        Vertex  m_p0;   //!< 始点
+        Vertex  m_p1;   //!< 制御点1
+        Vertex  m_p2;   //!< 制御点2
+        Vertex  m_p3;   //!< 終点
+
+    public:
+        //! コンストラクタ
+        CubicBezier(const Vertex& p0, const Vertex& p1, const Vertex& p2, const Vertex& p3);
+        //! 2次ベジェ曲線から生成
+        static CubicBezier fromQuadratic(const Vertex& p0, const Vertex& p1, const Vertex& p2);
+
+    public:
+        //! 始点を取得
+        const Vertex& p0() const;
+        //! 制御点1を取得
+        const Vertex& p1() const;
+        //! 制御点2を取得
+        const Vertex& p2() const;
+        //! 終点を取得
+        const Vertex& p3() const;
+    };
+}
+
+namespace my {
+    /**
+     * @class Flattener
+     * @brief 曲線を許容誤差に応じた折れ線（頂点の並び）に分割するクラス
+     * 
+     * @par 詳細
+     *      許容誤差は画面上の距離[pixel]で指定し、拡大率で割ってオブジェクトの座標系の誤差に換算する。
+     *      分割数は、折れ線と曲線の距離が許容誤差以内となる最小の数とするため、
+     *      縮小表示では頂点数が減り、拡大表示では頂点数が増える。
+     *      各関数は、分割した頂点を出力先の末尾に追加する。
+     */
+    class Flattener {
+        float   m_tolerance;    //!< 許容誤差（オブジェクトの座標系）
+
+    public:
+        //! コンストラクタ
+        Flattener(const float tolerance, const float scale);
+
+    public:
+        //! 許容誤差を設定
+        void setTolerance(const float tolerance, const float scale);
+        //! 許容誤差（オブジェクトの座標系）を取得
+        float getTolerance() const;
+
+    public:
+        //! 2次ベジェ曲線の分割数を取得
+        std::int32_t segments(const Vertex& p0, const Vertex& p1, const Vertex& p2) const;
+        //! 3次ベジェ曲線の分割数を取得
+        std::int32_t segments(const CubicBezier& curve) const;
+        //! 楕円弧の分割数を取得
+        std::int32_t segments(const float rx, const float ry, const Radian sweep) const;
+
+    public:
+        //! 2次ベジェ曲線を分割
+        void quadratic(const Vertex& p0, const Vertex& p1, const Vertex& p2, Vertexes& out) const;
+        //! 3次ベジェ曲線を分割
+        void cubic(const CubicBezier& curve, Vertexes& out) const;
+        //! 複数の3次ベジェ曲線を一括で分割
+        void cubics(const std::vector<CubicBezier>& curves, Vertexes& out, std::vector<std::size_t>& offsets) const;
+        //! 楕円弧を分割
+        void arc(const Vertex& center, const float rx, const float ry, const Radian rotation, const Radian start, const Radian sweep, Vertexes& out) const;
+        //! 円を分割
+        void circle(const Vertex& center, const float r, Vertexes& out) const;
+    };
+}
+
+namespace my {
+    //! Flattenerクラスのテストコードを実行
+    bool testcode_Flattener();
+    //! Flattenerクラスの処理性能を計測
+    void benchcode_Flattener();
+}
+
+#endif //INCLUDED_CURVE_HPP
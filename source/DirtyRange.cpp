@@ -0,0 +1,196 @@
+﻿/**
+ * @file DirtyRange.cpp
+ * @author kota-kota
+ * @brief 更新範囲を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "DirtyRange.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <iostream>
+#include <utility>
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    DirtyRange::DirtyRange() :
+        m_first(0U), m_last(0U)
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] first 範囲の先頭の要素番号
+     * @param [in] last 範囲の末尾の次の要素番号
+     */
+    DirtyRange::DirtyRange(const std::size_t first, const std::size_t last) :
+        m_first(first), m_last(last)
+    {
+    }
+
+    /**
+     * @brief 範囲の先頭の要素番号を取得
+     * 
+     * @return std::size_t 範囲の先頭の要素番号
+     */
+    std::size_t DirtyRange::first() const { return this->m_first; }
+    /**
+     * @brief 範囲の末尾の次の要素番号を取得
+     * 
+     * @return std::size_t 範囲の末尾の次の要素番号
+     */
+    std::size_t DirtyRange::last() const { return this->m_last; }
+    /**
+     * @brief 範囲の要素数を取得
+     * 
+     * @return std::size_t 範囲の要素数
+     */
+    std::size_t DirtyRange::count() const { return this->m_last - this->m_first; }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    DirtyRanges::DirtyRanges() :
+        m_ranges()
+    {
+    }
+
+    /**
+     * @brief 更新範囲を追加
+     * 
+     * @param [in] first 更新した先頭の要素番号
+     * @param [in] count 更新した要素数
+     * 
+     * @par 詳細
+     *      追加する範囲と重なる、または隣接する既存の範囲を全て取り除き、
+     *      それらを包含する1つの範囲として挿入する。
+     */
+    void DirtyRanges::add(const std::size_t first, const std::size_t count)
+    {
+        if (count == 0U) {
+            return;
+        }
+        std::size_t f = first;
+        std::size_t l = first + count;
+
+        // 末尾が追加範囲の先頭以上となる最初の範囲（ここから結合対象となり得る）
+        auto begin = std::lower_bound(this->m_ranges.begin(), this->m_ranges.end(), f,
+            [](const DirtyRange& r, const std::size_t v) { return r.last() < v; });
+        // 先頭が追加範囲の末尾を超える最初の範囲（ここからは結合対象外）
+        auto end = begin;
+        while ((end != this->m_ranges.end()) && (end->first() <= l)) {
+            f = std::min(f, end->first());
+            l = std::max(l, end->last());
+            ++end;
+        }
+        begin = this->m_ranges.erase(begin, end);
+        (void)this->m_ranges.insert(begin, DirtyRange(f, l));
+    }
+
+    /**
+     * @brief 更新範囲を全て削除
+     * 
+     */
+    void DirtyRanges::clear() { this->m_ranges.clear(); }
+
+    /**
+     * @brief 更新範囲がないか判定
+     * 
+     * @retval true 更新範囲なし
+     * @retval false 更新範囲あり
+     */
+    bool DirtyRanges::empty() const { return this->m_ranges.empty(); }
+
+    /**
+     * @brief 更新範囲の並びを取得
+     * 
+     * @return const std::vector<DirtyRange>& 先頭の要素番号の昇順に並んだ更新範囲
+     */
+    const std::vector<DirtyRange>& DirtyRanges::ranges() const { return this->m_ranges; }
+}
+
+namespace {
+    //! 更新範囲の並びが期待値（先頭・末尾の次の要素番号の組の並び）と一致するか判定
+    bool sameRanges(const my::DirtyRanges& ranges, const std::initializer_list<std::pair<std::size_t, std::size_t>> expect)
+    {
+        if (ranges.ranges().size() != expect.size()) {
+            return false;
+        }
+        std::size_t i = 0U;
+        for (const auto& e : expect) {
+            const my::DirtyRange& r = ranges.ranges()[i];
+            if ((r.first() != e.first) || (r.last() != e.second) || (r.count() != (e.second - e.first))) {
+                return false;
+            }
+            i++;
+        }
+        return true;
+    }
+}
+
+namespace my {
+    /**
+     * @brief DirtyRangesクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     */
+    bool testcode_DirtyRange()
+    {
+        std::cout << "[testcode_DirtyRange()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const char* name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+
+        // 離れた範囲は結合せず、先頭の要素番号の昇順に保持する（要素数0は追加しない）
+        DirtyRanges r;
+        check("empty", r.empty() && sameRanges(r, {}));
+        r.add(10U, 5U);
+        r.add(30U, 2U);
+        r.add(20U, 0U);
+        check("disjoint", !r.empty() && sameRanges(r, { { 10U, 15U }, { 30U, 32U } }));
+
+        // 前後に隣接する範囲は結合する
+        r.add(15U, 3U);
+        r.add(8U, 2U);
+        check("adjacent", sameRanges(r, { { 8U, 18U }, { 30U, 32U } }));
+
+        // 重なる範囲、含まれる範囲は結合する
+        r.add(16U, 6U);
+        r.add(9U, 4U);
+        check("overlap/contained", sameRanges(r, { { 8U, 22U }, { 30U, 32U } }));
+
+        // 複数の範囲にまたがる範囲は全てを1つに結合する
+        r.add(40U, 5U);
+        r.add(20U, 21U);
+        check("span", sameRanges(r, { { 8U, 45U } }));
+
+        // 昇順でない順に追加しても昇順に保持する
+        DirtyRanges u;
+        u.add(50U, 1U);
+        u.add(0U, 1U);
+        u.add(25U, 1U);
+        u.add(51U, 1U);
+        u.add(1U, 1U);
+        check("out of order", sameRanges(u, { { 0U, 2U }, { 25U, 26U }, { 50U, 52U } }));
+
+        // 全て削除した後は空となり、再び追加できる
+        u.clear();
+        check("clear", u.empty() && sameRanges(u, {}));
+        u.add(3U, 4U);
+        check("add after clear", sameRanges(u, { { 3U, 7U } }));
+        return ok;
+    }
+}
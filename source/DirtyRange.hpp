@@ -0,0 +1,73 @@
+﻿/**
+ * @file DirtyRange.hpp
+ * @author kota-kota
+ * @brief 更新範囲を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_DIRTYRANGE_HPP
+#define INCLUDED_DIRTYRANGE_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace my {
+    /**
+     * @class DirtyRange
+     * @brief 要素の並びの中で更新された範囲[first, last)を扱うクラス
+     */
+    class DirtyRange {
+        std::size_t     m_first;    //!< 範囲の先頭の要素番号
+        std::size_t     m_last;     //!< 範囲の末尾の次の要素番号
+
+    public:
+        //! デフォルトコンストラクタ
+        DirtyRange();
+        //! コンストラクタ
+        DirtyRange(const std::size_t first, const std::size_t last);
+
+    public:
+        //! 範囲の先頭の要素番号を取得
+        std::size_t first() const;
+        //! 範囲の末尾の次の要素番号を取得
+        std::size_t last() const;
+        //! 範囲の要素数を取得
+        std::size_t count() const;
+    };
+
+    /**
+     * @class DirtyRanges
+     * @brief 更新範囲の並びを扱うクラス
+     * 
+     * @par 詳細
+     *      更新範囲を先頭の要素番号の昇順で保持する。
+     *      追加した範囲が既存の範囲と重なる、または隣接する場合は1つの範囲に結合するため、
+     *      保持する範囲の数がそのまま転送に必要な最小の回数となる。
+     */
+    class DirtyRanges {
+        std::vector<DirtyRange>     m_ranges;   //!< 更新範囲の並び
+
+    public:
+        //! デフォルトコンストラクタ
+        DirtyRanges();
+
+    public:
+        //! 更新範囲を追加
+        void add(const std::size_t first, const std::size_t count);
+        //! 更新範囲を全て削除
+        void clear();
+        //! 更新範囲がないか判定
+        bool empty() const;
+        //! 更新範囲の並びを取得
+        const std::vector<DirtyRange>& ranges() const;
+    };
+}
+
+namespace my {
+    //! DirtyRangesクラスのテストコードを実行
+    bool testcode_DirtyRange();
+}
+
+#endif //INCLUDED_DIRTYRANGE_HPP
@@ -14,13 +14,20 @@
 #include <vector>
 #include <iterator>
 
+namespace {
+    //! 頂点データ用のリングバッファのサイズ[byte]
+    constexpr GLsizeiptr STREAM_BUFFER_SIZE = 4 * 1024 * 1024;
+    //! 頂点データ用のリングバッファのセグメント数
+    constexpr std::int32_t STREAM_BUFFER_SEGMENTS = 3;
+}
+
 namespace my {
     /**
      * @brief デフォルトコンストラクタ
      * 
      */
     ShapeShader::ShapeShader() :
-        m_progid(0U), m_loc_modelview(-1), m_loc_projection(-1), m_loc_pointsize(-1), m_loc_pos(-1), m_loc_col(-1)
+        m_progid(0U), m_loc_modelview(-1), m_loc_projection(-1), m_loc_model(-1), m_loc_translation(-1), m_loc_pointsize(-1), m_loc_pos(-1), m_loc_col(-1)
     {
     }
 
@@ -30,14 +37,16 @@ namespace my {
      * @param [in] progid シェーダプログラムID
      * @param [in] loc_modelview モデルビュー変換行列のuniform位置
      * @param [in] loc_projection プロジェクション変換行列のuniform位置
+     * @param [in] loc_model モデルの配置（アフィン変換の線形部分）のuniform位置
+     * @param [in] loc_translation モデルの配置（アフィン変換の移動量）のuniform位置
      * @param [in] loc_pointsize ポイントサイズのuniform位置
      * @param [in] loc_pos 頂点のattribute位置
      * @param [in] loc_col 色のattribute位置
      */
-    ShapeShader::ShapeShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_pointsize, const GLint loc_pos, const GLint loc_col) :
-        m_progid(progid), m_loc_modelview(loc_modelview), m_loc_projection(loc_projection), m_loc_pointsize(loc_pointsize), m_loc_pos(loc_pos), m_loc_col(loc_col)
+    ShapeShader::ShapeShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_model, const GLint loc_translation, const GLint loc_pointsize, const GLint loc_pos, const GLint loc_col) :
+        m_progid(progid), m_loc_modelview(loc_modelview), m_loc_projection(loc_projection), m_loc_model(loc_model), m_loc_translation(loc_translation), m_loc_pointsize(loc_pointsize), m_loc_pos(loc_pos), m_loc_col(loc_col)
     {
-        std::cout << "[ShapeShader::ShapeShader()] progId:" << progid << " loc_modelview:" << loc_modelview << " loc_projection:" << loc_projection << " loc_pointsize:" << loc_pointsize << " loc_pos:" << loc_pos << " loc_col:" << loc_col << std::endl;
+        std::cout << "[ShapeShader::ShapeShader()] progId:" << progid << " loc_modelview:" << loc_modelview << " loc_projection:" << loc_projection << " loc_model:" << loc_model << " loc_translation:" << loc_translation << " loc_pointsize:" << loc_pointsize << " loc_pos:" << loc_pos << " loc_col:" << loc_col << std::endl;
     }
 
     /**
@@ -64,6 +73,22 @@ namespace my {
      */
     GLint ShapeShader::getProjectionLocation() const { return this->m_loc_projection; }
 
+    /**
+     * @brief モデルの配置（アフィン変換の線形部分）のunifrom位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint ShapeShader::getModelLocation() const { return this->m_loc_model; }
+
+    /**
+     * @brief モデルの配置（アフィン変換の移動量）のunifrom位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint ShapeShader::getTranslationLocation() const { return this->m_loc_translation; }
+
     /**
      * @brief ポイントサイズのunifrom位置を取得
      * 
@@ -95,7 +120,7 @@ namespace my {
      * 
      */
     TextShader::TextShader() :
-        m_progid(0U), m_loc_modelview(-1), m_loc_projection(-1), m_loc_texture(-1), m_loc_texcolor(-1), m_loc_pos(-1), m_loc_uv(-1)
+        m_progid(0U), m_loc_modelview(-1), m_loc_projection(-1), m_loc_model(-1), m_loc_translation(-1), m_loc_texture(-1), m_loc_texcolor(-1), m_loc_pos(-1), m_loc_uv(-1)
     {
     }
 
@@ -105,15 +130,17 @@ namespace my {
      * @param [in] progid シェーダプログラムID
      * @param [in] loc_modelview モデルビュー変換行列のuniform位置
      * @param [in] loc_projection プロジェクション変換行列のuniform位置
+     * @param [in] loc_model モデルの配置（アフィン変換の線形部分）のuniform位置
+     * @param [in] loc_translation モデルの配置（アフィン変換の移動量）のuniform位置
      * @param [in] loc_texture textureのuniform位置
      * @param [in] loc_texcolor texcolorのuniform位置
      * @param [in] loc_pos 頂点のattribute位置
      * @param [in] loc_uv UV座標のattribute位置
      */
-    TextShader::TextShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_texture, const GLint loc_texcolor, const GLint loc_pos, const GLint loc_uv) :
-        m_progid(progid), m_loc_modelview(loc_modelview), m_loc_projection(loc_projection), m_loc_texture(loc_texture), m_loc_texcolor(loc_texcolor), m_loc_pos(loc_pos), m_loc_uv(loc_uv)
+    TextShader::TextShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_model, const GLint loc_translation, const GLint loc_texture, const GLint loc_texcolor, const GLint loc_pos, const GLint loc_uv) :
+        m_progid(progid), m_loc_modelview(loc_modelview), m_loc_projection(loc_projection), m_loc_model(loc_model), m_loc_translation(loc_translation), m_loc_texture(loc_texture), m_loc_texcolor(loc_texcolor), m_loc_pos(loc_pos), m_loc_uv(loc_uv)
     {
-        std::cout << "[TextShader::TextShader()] progId:" << progid << " loc_modelview:" << loc_modelview << " loc_projection:" << loc_projection << " loc_texture:" << loc_texture << " loc_texcolor:" << loc_texcolor << " loc_pos:" << loc_pos << " loc_uv:" << loc_uv << std::endl;
+        std::cout << "[TextShader::TextShader()] progId:" << progid << " loc_modelview:" << loc_modelview << " loc_projection:" << loc_projection << " loc_model:" << loc_model << " loc_translation:" << loc_translation << " loc_texture:" << loc_texture << " loc_texcolor:" << loc_texcolor << " loc_pos:" << loc_pos << " loc_uv:" << loc_uv << std::endl;
     }
 
     /**
@@ -140,6 +167,22 @@ namespace my {
      */
     GLint TextShader::getProjectionLocation() const { return this->m_loc_projection; }
 
+    /**
+     * @brief モデルの配置（アフィン変換の線形部分）のunifrom位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint TextShader::getModelLocation() const { return this->m_loc_model; }
+
+    /**
+     * @brief モデルの配置（アフィン変換の移動量）のunifrom位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint TextShader::getTranslationLocation() const { return this->m_loc_translation; }
+
     /**
      * @brief textureのunifrom位置を取得
      * 
@@ -173,6 +216,99 @@ namespace my {
     GLint TextShader::getUVLocation() const { return this->m_loc_uv; }
 }
 
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    InstanceShader::InstanceShader() :
+        m_progid(0U), m_loc_modelview(-1), m_loc_projection(-1), m_loc_pos(-1), m_loc_model(-1), m_loc_translation(-1), m_loc_col(-1), m_loc_offset(-1)
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] progid シェーダプログラムID
+     * @param [in] loc_modelview モデルビュー変換行列のuniform位置
+     * @param [in] loc_projection プロジェクション変換行列のuniform位置
+     * @param [in] loc_pos 頂点のattribute位置
+     * @param [in] loc_model 配置毎のアフィン変換の線形部分のattribute位置
+     * @param [in] loc_translation 配置毎のアフィン変換の移動量のattribute位置
+     * @param [in] loc_col 配置毎の色のattribute位置
+     * @param [in] loc_offset 配置の基準点のカメラからの位置のuniform位置
+     */
+    InstanceShader::InstanceShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_pos, const GLint loc_model, const GLint loc_translation, const GLint loc_col, const GLint loc_offset) :
+        m_progid(progid), m_loc_modelview(loc_modelview), m_loc_projection(loc_projection), m_loc_pos(loc_pos), m_loc_model(loc_model), m_loc_translation(loc_translation), m_loc_col(loc_col), m_loc_offset(loc_offset)
+    {
+        std::cout << "[InstanceShader::InstanceShader()] progId:" << progid << " loc_modelview:" << loc_modelview << " loc_projection:" << loc_projection << " loc_pos:" << loc_pos << " loc_model:" << loc_model << " loc_translation:" << loc_translation << " loc_col:" << loc_col << " loc_offset:" << loc_offset << std::endl;
+    }
+
+    /**
+     * @brief シェーダプログラムを取得
+     * 
+     * @retval 0 異常
+     * @retval >0 正常
+     */
+    GLuint InstanceShader::getProgram() const { return this->m_progid; }
+
+    /**
+     * @brief モデルビュー変換行列のunifrom位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint InstanceShader::getModelViewLocation() const { return this->m_loc_modelview; }
+
+    /**
+     * @brief プロジェクション変換行列のunifrom位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint InstanceShader::getProjectionLocation() const { return this->m_loc_projection; }
+
+    /**
+     * @brief 頂点のattribute位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint InstanceShader::getPositionLocation() const { return this->m_loc_pos; }
+
+    /**
+     * @brief 配置毎のアフィン変換の線形部分のattribute位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint InstanceShader::getModelLocation() const { return this->m_loc_model; }
+
+    /**
+     * @brief 配置毎のアフィン変換の移動量のattribute位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint InstanceShader::getTranslationLocation() const { return this->m_loc_translation; }
+
+    /**
+     * @brief 配置毎の色のattribute位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint InstanceShader::getColorLocation() const { return this->m_loc_col; }
+
+    /**
+     * @brief 配置の基準点のカメラからの位置のunifrom位置を取得
+     * 
+     * @retval -1 異常
+     * @retval >=0 正常
+     */
+    GLint InstanceShader::getOffsetLocation() const { return this->m_loc_offset; }
+}
+
 namespace my {
     /**
      * @brief デフォルトコンストラクタ
@@ -181,11 +317,12 @@ namespace my {
      *      シェーダプログラムを作成する。
      */
     ShaderBuilder::ShaderBuilder() :
-        m_shape_shader(), m_text_shader()
+        m_shape_shader(), m_text_shader(), m_instance_shader()
     {
         std::cout << "[ShaderBuilder::ShaderBuilder()] call" << std::endl;
         loadShapeShader();
         loadTextShader();
+        loadInstanceShader();
     }
 
     /**
@@ -199,6 +336,7 @@ namespace my {
         std::cout << "[ShaderBuilder::~ShaderBuilder()] call" << std::endl;
         glDeleteProgram(this->m_shape_shader.getProgram());
         glDeleteProgram(this->m_text_shader.getProgram());
+        glDeleteProgram(this->m_instance_shader.getProgram());
     }
 
     /**
@@ -217,6 +355,14 @@ namespace my {
      */
     TextShader ShaderBuilder::getTextShader() const { return this->m_text_shader; }
 
+    /**
+     * @brief instanceシェーダのプログラムの取得
+     * 
+     * @par 詳細
+     *      instanceシェーダのプログラムを取得する。
+     */
+    InstanceShader ShaderBuilder::getInstanceShader() const { return this->m_instance_shader; }
+
     /**
      * @brief shapeシェーダの読み込み
      * 
@@ -230,10 +376,12 @@ namespace my {
             GLuint progid = createProgram(vsrc, fsrc);
             GLint loc_modelview = glGetUniformLocation(progid, "modelview");
             GLint loc_projection = glGetUniformLocation(progid, "projection");
+            GLint loc_model = glGetUniformLocation(progid, "model");
+            GLint loc_translation = glGetUniformLocation(progid, "translation");
             GLint loc_pointsize = glGetUniformLocation(progid, "pointSize");
             GLint loc_pos = glGetAttribLocation(progid, "position");
             GLint loc_col = glGetAttribLocation(progid, "color");
-            this->m_shape_shader = ShapeShader(progid, loc_modelview, loc_projection, loc_pointsize, loc_pos, loc_col);
+            this->m_shape_shader = ShapeShader(progid, loc_modelview, loc_projection, loc_model, loc_translation, loc_pointsize, loc_pos, loc_col);
         }
     }
 
@@ -250,11 +398,37 @@ namespace my {
             GLuint progid = createProgram(vsrc, fsrc);
             GLint loc_modelview = glGetUniformLocation(progid, "modelview");
             GLint loc_projection = glGetUniformLocation(progid, "projection");
+            GLint loc_model = glGetUniformLocation(progid, "model");
+            GLint loc_translation = glGetUniformLocation(progid, "translation");
             GLint loc_texture = glGetUniformLocation(progid, "texture");
             GLint loc_texcolor = glGetUniformLocation(progid, "texcolor");
             GLint loc_pos = glGetAttribLocation(progid, "position");
             GLint loc_uv = glGetAttribLocation(progid, "uv");
-            this->m_text_shader = TextShader(progid, loc_modelview, loc_projection, loc_texture, loc_texcolor, loc_pos, loc_uv);
+            this->m_text_shader = TextShader(progid, loc_modelview, loc_projection, loc_model, loc_translation, loc_texture, loc_texcolor, loc_pos, loc_uv);
+        }
+    }
+
+    /**
+     * @brief instanceシェーダの読み込み
+     * 
+     * @par 詳細
+     *      フラグメントシェーダはshapeシェーダと共通とする。
+     */
+    void ShaderBuilder::loadInstanceShader()
+    {
+        std::cout << "[ShaderBuilder::loadInstanceShader()] call" << std::endl;
+        const std::string vsrc = readShaderSource(".\\shader\\instance.vert");
+        const std::string fsrc = readShaderSource(".\\shader\\shape.frag");
+        if ((!vsrc.empty()) && (!fsrc.empty())) {
+            GLuint progid = createProgram(vsrc, fsrc);
+            GLint loc_modelview = glGetUniformLocation(progid, "modelview");
+            GLint loc_projection = glGetUniformLocation(progid, "projection");
+            GLint loc_pos = glGetAttribLocation(progid, "position");
+            GLint loc_model = glGetAttribLocation(progid, "model");
+            GLint loc_translation = glGetAttribLocation(progid, "translation");
+            GLint loc_col = glGetAttribLocation(progid, "color");
+            GLint loc_offset = glGetUniformLocation(progid, "offset");
+            this->m_instance_shader = InstanceShader(progid, loc_modelview, loc_projection, loc_pos, loc_model, loc_translation, loc_col, loc_offset);
         }
     }
 
@@ -621,7 +795,7 @@ namespace my {
      * 
      */
     GlobalDrawer::GlobalDrawer() :
-        m_shaderbuilder(), m_textbuilder()
+        m_shaderbuilder(), m_textbuilder(), m_streambuffer(GL_ARRAY_BUFFER, STREAM_BUFFER_SIZE, STREAM_BUFFER_SEGMENTS)
     {
         std::cout << "[GlobalDrawer::GlobalDrawer()] call" << std::endl;
     }
@@ -655,4 +829,14 @@ namespace my {
     {
         return this->m_textbuilder;
     }
+
+    /**
+     * @brief 頂点データ用のStreamBufferインスタンスを取得
+     * 
+     * @return StreamBuffer StreamBufferインスタンス
+     */
+    StreamBuffer& GlobalDrawer::getStreamBuffer()
+    {
+        return this->m_streambuffer;
+    }
 }
@@ -10,6 +10,8 @@
 #ifndef INCLUDED_GLOBALDRAWER_HPP
 #define INCLUDED_GLOBALDRAWER_HPP
 
+#include "StreamBuffer.hpp"
+
 #include <GL/glew.h>
 
 #include <ft2build.h>
@@ -31,6 +33,8 @@ namespace my {
         GLuint  m_progid;           //!< シェーダプログラムID
         GLint   m_loc_modelview;    //!< モデルビュー変換行列のunifrom位置
         GLint   m_loc_projection;   //!< プロジェクション変換行列のunifrom位置
+        GLint   m_loc_model;        //!< モデルの配置（アフィン変換の線形部分）のunifrom位置
+        GLint   m_loc_translation;  //!< モデルの配置（アフィン変換の移動量）のunifrom位置
         GLint   m_loc_pointsize;    //!< ポイントサイズのunifrom位置
         GLint   m_loc_pos;          //!< 頂点のattribute位置
         GLint   m_loc_col;          //!< 色のattribute位置
@@ -39,7 +43,7 @@ namespace my {
         //! デフォルトコンストラクタ
         ShapeShader();
         //! コンストラクタ
-        ShapeShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_pointsize, const GLint loc_pos, const GLint loc_col);
+        ShapeShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_model, const GLint loc_translation, const GLint loc_pointsize, const GLint loc_pos, const GLint loc_col);
 
     public:
         //! シェーダプログラムを取得
@@ -48,6 +52,10 @@ namespace my {
         GLint getModelViewLocation() const;
         //! プロジェクション変換行列のunifrom位置を取得
         GLint getProjectionLocation() const;
+        //! モデルの配置（アフィン変換の線形部分）のunifrom位置を取得
+        GLint getModelLocation() const;
+        //! モデルの配置（アフィン変換の移動量）のunifrom位置を取得
+        GLint getTranslationLocation() const;
         //! ポイントサイズのunifrom位置を取得
         GLint getPointSizeLocation() const;
         //! 頂点のattribute位置を取得
@@ -57,6 +65,48 @@ namespace my {
     };
 }
 
+namespace my {
+    /**
+     * @class InstanceShader
+     * @brief instanceシェーダ（単位形状を配置毎のアフィン変換・色で描画する）のプログラムを扱うクラス
+     * 
+     */
+    class InstanceShader {
+        GLuint  m_progid;           //!< シェーダプログラムID
+        GLint   m_loc_modelview;    //!< モデルビュー変換行列のunifrom位置
+        GLint   m_loc_projection;   //!< プロジェクション変換行列のunifrom位置
+        GLint   m_loc_pos;          //!< 頂点のattribute位置
+        GLint   m_loc_model;        //!< 配置毎のアフィン変換の線形部分のattribute位置
+        GLint   m_loc_translation;  //!< 配置毎のアフィン変換の移動量のattribute位置
+        GLint   m_loc_col;          //!< 配置毎の色のattribute位置
+        GLint   m_loc_offset;       //!< 配置の基準点のカメラからの位置のunifrom位置
+
+    public:
+        //! デフォルトコンストラクタ
+        InstanceShader();
+        //! コンストラクタ
+        InstanceShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_pos, const GLint loc_model, const GLint loc_translation, const GLint loc_col, const GLint loc_offset);
+
+    public:
+        //! シェーダプログラムを取得
+        GLuint getProgram() const;
+        //! モデルビュー変換行列のunifrom位置を取得
+        GLint getModelViewLocation() const;
+        //! プロジェクション変換行列のunifrom位置を取得
+        GLint getProjectionLocation() const;
+        //! 頂点のattribute位置を取得
+        GLint getPositionLocation() const;
+        //! 配置毎のアフィン変換の線形部分のattribute位置を取得
+        GLint getModelLocation() const;
+        //! 配置毎のアフィン変換の移動量のattribute位置を取得
+        GLint getTranslationLocation() const;
+        //! 配置毎の色のattribute位置を取得
+        GLint getColorLocation() const;
+        //! 配置の基準点のカメラからの位置のunifrom位置を取得
+        GLint getOffsetLocation() const;
+    };
+}
+
 namespace my {
     /**
      * @class TextShader
@@ -67,6 +117,8 @@ namespace my {
         GLuint  m_progid;           //!< シェーダプログラムID
         GLint   m_loc_modelview;    //!< モデルビュー変換行列のunifrom位置
         GLint   m_loc_projection;   //!< プロジェクション変換行列のunifrom位置
+        GLint   m_loc_model;        //!< モデルの配置（アフィン変換の線形部分）のunifrom位置
+        GLint   m_loc_translation;  //!< モデルの配置（アフィン変換の移動量）のunifrom位置
         GLint   m_loc_texture;      //!< textureのuniform位置
         GLint   m_loc_texcolor;     //!< texcolorのuniform位置
         GLint   m_loc_pos;          //!< 頂点のattribute位置
@@ -76,7 +128,7 @@ namespace my {
         //! デフォルトコンストラクタ
         TextShader();
         //! コンストラクタ
-        TextShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_texture, const GLint loc_texcolor, const GLint loc_pos, const GLint loc_uv);
+        TextShader(const GLuint progid, const GLint loc_modelview, const GLint loc_projection, const GLint loc_model, const GLint loc_translation, const GLint loc_texture, const GLint loc_texcolor, const GLint loc_pos, const GLint loc_uv);
 
     public:
         //! シェーダプログラムを取得
@@ -85,6 +137,10 @@ namespace my {
         GLint getModelViewLocation() const;
         //! プロジェクション変換行列のunifrom位置を取得
         GLint getProjectionLocation() const;
+        //! モデルの配置（アフィン変換の線形部分）のunifrom位置を取得
+        GLint getModelLocation() const;
+        //! モデルの配置（アフィン変換の移動量）のunifrom位置を取得
+        GLint getTranslationLocation() const;
         //! textureのunifrom位置を取得
         GLint getTextureLocation() const;
         //! texcolorのunifrom位置を取得
@@ -104,6 +160,7 @@ namespace my {
     class ShaderBuilder {
         ShapeShader     m_shape_shader;     //!< shapeシェーダのプログラム
         TextShader      m_text_shader;      //!< textシェーダのプログラム
+        InstanceShader  m_instance_shader;  //!< instanceシェーダのプログラム
 
     public:
         //! デフォルトコンストラクタ
@@ -120,12 +177,16 @@ namespace my {
         ShapeShader getShapeShader() const;
         //! textシェーダのプログラムの取得
         TextShader getTextShader() const;
+        //! instanceシェーダのプログラムの取得
+        InstanceShader getInstanceShader() const;
 
     private:
         //! shapeシェーダの読み込み
         void loadShapeShader();
         //! textシェーダの読み込み
         void loadTextShader();
+        //! instanceシェーダの読み込み
+        void loadInstanceShader();
 
     private:
         //! シェーダソースをファイル読み込み
@@ -207,6 +268,7 @@ namespace my {
     class GlobalDrawer {
         ShaderBuilder   m_shaderbuilder;    //!< シェーダビルダーインスタンス
         TextBuilder     m_textbuilder;      //!< テキストビルダーインスタンス
+        StreamBuffer    m_streambuffer;     //!< 毎フレーム更新する頂点データ用のリングバッファ
 
     private:
         //! デフォルトコンストラクタ
@@ -227,6 +289,8 @@ namespace my {
         ShaderBuilder& getShaderBuilder();
         //! TextBuilderインスタンスを取得
         TextBuilder& getTextBuilder();
+        //! 頂点データ用のStreamBufferインスタンスを取得
+        StreamBuffer& getStreamBuffer();
     };
 }
 
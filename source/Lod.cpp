@@ -0,0 +1,466 @@
+﻿/**
+ * @file Lod.cpp
+ * @author kota-kota
+ * @brief 形状の詳細度（LOD）を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Lod.hpp"
+#include "Matrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+namespace {
+    //! 点pと線分abの距離の2乗
+    float distance2(const my::Vertex& p, const my::Vertex& a, const my::Vertex& b)
+    {
+        const float dx = b.x() - a.x();
+        const float dy = b.y() - a.y();
+        const float len2 = (dx * dx) + (dy * dy);
+        float t = 0.0F;
+        if (len2 > 0.0F) {
+            t = std::min(std::max((((p.x() - a.x()) * dx) + ((p.y() - a.y()) * dy)) / len2, 0.0F), 1.0F);
+        }
+        const float ex = p.x() - (a.x() + (t * dx));
+        const float ey = p.y() - (a.y() + (t * dy));
+        return (ex * ex) + (ey * ey);
+    }
+
+    /**
+     * @brief Douglas-Peucker法で区間内の残す頂点に印を付ける
+     * 
+     * @param [in] v 頂点の並び
+     * @param [in] first 区間の始点の番号
+     * @param [in] last 区間の終点の番号（v.size()以上の場合は先頭に戻る）
+     * @param [in] tolerance2 許容誤差の2乗
+     * @param [in,out] keep 残す頂点の印
+     * 
+     * @par 詳細
+     *      再帰の代わりに区間のスタックを使用する。
+     */
+    void markDouglasPeucker(const my::Vertexes& v, const std::size_t first, const std::size_t last, const float tolerance2, std::vector<bool>& keep)
+    {
+        const std::size_t n = v.size();
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        stack.push_back({ first, last });
+        while (!stack.empty()) {
+            const std::pair<std::size_t, std::size_t> range = stack.back();
+            stack.pop_back();
+            const my::Vertex& a = v[range.first % n];
+            const my::Vertex& b = v[range.second % n];
+            float max_d2 = 0.0F;
+            std::size_t max_i = 0U;
+            for (std::size_t i = range.first + 1U; i < range.second; i++) {
+                const float d2 = distance2(v[i % n], a, b);
+                if (d2 > max_d2) {
+                    max_d2 = d2;
+                    max_i = i;
+                }
+            }
+            if (max_d2 > tolerance2) {
+                keep[max_i % n] = true;
+                stack.push_back({ range.first, max_i });
+                stack.push_back({ max_i, range.second });
+            }
+        }
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] tolerance 簡略化の許容誤差（オブジェクトの座標系、0は簡略化なし）
+     * @param [in] first 頂点インデックスの先頭位置
+     * @param [in] count 頂点インデックス数
+     */
+    Lod::Lod(const float tolerance, const std::size_t first, const std::size_t count) :
+        m_tolerance(tolerance), m_first(first), m_count(count)
+    {
+    }
+
+    /**
+     * @brief 簡略化の許容誤差を取得
+     * 
+     * @return float 許容誤差
+     */
+    float Lod::tolerance() const { return this->m_tolerance; }
+
+    /**
+     * @brief 頂点インデックスの先頭位置を取得
+     * 
+     * @return std::size_t 先頭位置
+     */
+    std::size_t Lod::first() const { return this->m_first; }
+
+    /**
+     * @brief 頂点インデックス数を取得
+     * 
+     * @return std::size_t 頂点インデックス数
+     */
+    std::size_t Lod::count() const { return this->m_count; }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    LodLevels::LodLevels() :
+        m_levels()
+    {
+    }
+
+    /**
+     * @brief 段を追加
+     * 
+     * @param [in] lod 段（許容誤差の昇順に追加すること）
+     */
+    void LodLevels::add(const Lod& lod) { this->m_levels.push_back(lod); }
+
+    /**
+     * @brief 段がないか判定
+     * 
+     * @retval true 段なし
+     * @retval false 段あり
+     */
+    bool LodLevels::empty() const { return this->m_levels.empty(); }
+
+    /**
+     * @brief 段数を取得
+     * 
+     * @return std::size_t 段数
+     */
+    std::size_t LodLevels::size() const { return this->m_levels.size(); }
+
+    /**
+     * @brief 段を取得
+     * 
+     * @param [in] i 段の番号
+     * 
+     * @return const Lod& 段
+     */
+    const Lod& LodLevels::at(const std::size_t i) const { return this->m_levels.at(i); }
+
+    /**
+     * @brief 拡大率に応じた段を選択
+     * 
+     * @param [in] scale 拡大率（オブジェクトの座標系に対するデバイス座標系の拡大率）
+     * @param [in] tolerance 画面上で許容する誤差[pixel]
+     * 
+     * @return const Lod& 画面上の誤差が許容誤差以内となる最も粗い段（段がない場合は例外）
+     */
+    const Lod& LodLevels::select(const float scale, const float tolerance) const
+    {
+        const float allowed = (scale > 0.0F) ? (tolerance / scale) : tolerance;
+        std::size_t level = 0U;
+        for (std::size_t i = 1U; i < this->m_levels.size(); i++) {
+            if (this->m_levels[i].tolerance() <= allowed) {
+                level = i;
+            }
+        }
+        return this->m_levels.at(level);
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] tolerance 許容誤差（オブジェクトの座標系）
+     */
+    Simplifier::Simplifier(const float tolerance) :
+        m_tolerance(tolerance)
+    {
+    }
+
+    /**
+     * @brief 折れ線を簡略化し、残す頂点の番号を取得
+     * 
+     * @param [in] polyline 折れ線の頂点の並び
+     * @param [in] closed 閉じた折れ線（多角形の外周など）の場合true
+     * 
+     * @return std::vector<std::uint32_t> 残す頂点の番号（昇順）
+     * 
+     * @par 詳細
+     *      開いた折れ線は始点と終点を必ず残す。
+     *      閉じた折れ線は、先頭の頂点と、そこから最も遠い頂点で2つに分けて簡略化する。
+     */
+    std::vector<std::uint32_t> Simplifier::simplify(const Vertexes& polyline, const bool closed) const
+    {
+        const std::size_t n = polyline.size();
+        std::vector<std::uint32_t> kept;
+        if ((n <= 2U) || (closed && (n <= 3U))) {
+            for (std::size_t i = 0U; i < n; i++) {
+                kept.push_back(static_cast<std::uint32_t>(i));
+            }
+            return kept;
+        }
+
+        const float tolerance2 = this->m_tolerance * this->m_tolerance;
+        std::vector<bool> keep(n, false);
+        keep[0] = true;
+        if (closed) {
+            std::size_t far = 0U;
+            float far_d2 = 0.0F;
+            for (std::size_t i = 1U; i < n; i++) {
+                const float d2 = distance2(polyline[i], polyline[0], polyline[0]);
+                if (d2 > far_d2) {
+                    far_d2 = d2;
+                    far = i;
+                }
+            }
+            if (far == 0U) {
+                return { 0U };
+            }
+            keep[far] = true;
+            markDouglasPeucker(polyline, 0U, far, tolerance2, keep);
+            markDouglasPeucker(polyline, far, n, tolerance2, keep);
+        }
+        else {
+            keep[n - 1U] = true;
+            markDouglasPeucker(polyline, 0U, n - 1U, tolerance2, keep);
+        }
+
+        for (std::size_t i = 0U; i < n; i++) {
+            if (keep[i]) {
+                kept.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        return kept;
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] tolerance 段1の許容誤差（オブジェクトの座標系）
+     * @param [in] ratio 段毎の許容誤差の倍率
+     * @param [in] levels 段数の上限（段0を含む）
+     */
+    LodBuilder::LodBuilder(const float tolerance, const float ratio, const std::int32_t levels) :
+        m_tolerance(tolerance), m_ratio(ratio), m_levels(levels)
+    {
+    }
+
+    /**
+     * @brief 段kの許容誤差を取得
+     * 
+     * @param [in] level 段の番号
+     * 
+     * @return float 許容誤差
+     */
+    float LodBuilder::tolerance(const std::int32_t level) const
+    {
+        return (level == 0) ? 0.0F : (this->m_tolerance * std::pow(this->m_ratio, static_cast<float>(level - 1)));
+    }
+
+    /**
+     * @brief 太線の詳細度の段を作成
+     * 
+     * @param [in] polyline 線の頂点の並び
+     * @param [in] colors 線の頂点色の並び（空の場合は黒）
+     * @param [in] closed 閉じた線の場合true
+     * @param [in] stroker 太線の変換に使用するStroker
+     * @param [out] out 全段の太線を追加する出力先（段同士は連結しない）
+     * 
+     * @return LodLevels 詳細度の段（GL_TRIANGLE_STRIPの描画範囲）
+     */
+    LodLevels LodBuilder::stroke(const Vertexes& polyline, const Colors& colors, const bool closed, const Stroker& stroker, Stroke& out) const
+    {
+        LodLevels lods;
+        std::size_t prev = polyline.size() + 1U;
+        for (std::int32_t k = 0; k < this->m_levels; k++) {
+            const float tol = this->tolerance(k);
+            const std::vector<std::uint32_t> kept = Simplifier(tol).simplify(polyline, closed);
+            if (kept.size() >= prev) {
+                break;
+            }
+            prev = kept.size();
+
+            Vertexes v;
+            Colors c;
+            v.reserve(kept.size());
+            c.reserve(kept.size());
+            for (const std::uint32_t i : kept) {
+                v.push_back(polyline[i]);
+                c.push_back((i < colors.size()) ? colors[i] : Color(0, 0, 0, 255));
+            }
+            Stroke level;
+            stroker.stroke(v, c, closed, level);
+            if (level.indexes().empty()) {
+                break;
+            }
+
+            // 段毎に独立したストリップとして追加する
+            const std::size_t first = out.indexes().size();
+            const std::uint32_t base = static_cast<std::uint32_t>(out.vertexes().size());
+            for (std::size_t i = 0U; i < level.vertexes().size(); i++) {
+                (void)out.addVertex(level.vertexes()[i], level.colors()[i]);
+            }
+            for (const Index& idx : level.indexes()) {
+                out.addIndex(base + idx.idx());
+            }
+            lods.add(Lod(tol, first, level.indexes().size()));
+            if (kept.size() <= 2U) {
+                break;
+            }
+        }
+        return lods;
+    }
+
+    /**
+     * @brief 多角形の詳細度の段を作成
+     * 
+     * @param [in] polygon 多角形
+     * @param [in] triangulator 三角形分割に使用するTriangulator
+     * @param [out] indexes 全段の頂点インデックスを追加する出力先（polygon.vertexes()の頂点番号）
+     * 
+     * @return LodLevels 詳細度の段（GL_TRIANGLESの描画範囲）
+     * 
+     * @par 詳細
+     *      外周と穴をそれぞれ簡略化して分割する。頂点は元の多角形の頂点を共有する。
+     *      頂点数が3未満となった穴は除く。
+     */
+    LodLevels LodBuilder::polygon(const Polygon& polygon, const Triangulator& triangulator, Indexes& indexes) const
+    {
+        LodLevels lods;
+        std::size_t prev = polygon.size() + 1U;
+        for (std::int32_t k = 0; k < this->m_levels; k++) {
+            const float tol = this->tolerance(k);
+            const Simplifier simplifier(tol);
+
+            // 簡略化した多角形と、その頂点番号から元の頂点番号への対応を作成する
+            std::vector<std::uint32_t> map;
+            const std::vector<std::uint32_t> outer_kept = simplifier.simplify(polygon.outer(), true);
+            if (outer_kept.size() < 3U) {
+                break;
+            }
+            Vertexes outer;
+            for (const std::uint32_t i : outer_kept) {
+                outer.push_back(polygon.outer()[i]);
+                map.push_back(i);
+            }
+            std::vector<Vertexes> holes;
+            std::uint32_t base = static_cast<std::uint32_t>(polygon.outer().size());
+            for (const Vertexes& hole : polygon.holes()) {
+                const std::vector<std::uint32_t> hole_kept = simplifier.simplify(hole, true);
+                if (hole_kept.size() >= 3U) {
+                    Vertexes h;
+                    for (const std::uint32_t i : hole_kept) {
+                        h.push_back(hole[i]);
+                        map.push_back(base + i);
+                    }
+                    holes.push_back(h);
+                }
+                base += static_cast<std::uint32_t>(hole.size());
+            }
+            if (map.size() >= prev) {
+                break;
+            }
+            prev = map.size();
+
+            const Indexes level = triangulator.triangulate(Polygon(outer, holes));
+            if (level.empty()) {
+                break;
+            }
+            const std::size_t first = indexes.size();
+            for (const Index& idx : level) {
+                indexes.push_back(Index(map[idx.idx()]));
+            }
+            lods.add(Lod(tol, first, level.size()));
+        }
+        return lods;
+    }
+}
+
+namespace {
+    //! 元の頂点と簡略化した折れ線の距離の最大値
+    float maxDeviation(const my::Vertexes& v, const std::vector<std::uint32_t>& kept, const bool closed)
+    {
+        float dev2 = 0.0F;
+        const std::size_t segs = closed ? kept.size() : (kept.size() - 1U);
+        for (std::size_t s = 0U; s < segs; s++) {
+            const std::size_t a = kept[s];
+            const std::size_t b = kept[(s + 1U) % kept.size()];
+            const std::size_t end = (b > a) ? b : (b + v.size());
+            for (std::size_t i = a; i <= end; i++) {
+                dev2 = std::max(dev2, distance2(v[i % v.size()], v[a], v[b]));
+            }
+        }
+        return std::sqrt(dev2);
+    }
+}
+
+namespace my {
+    /**
+     * @brief LodBuilderクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     * 
+     * @par 詳細
+     *      簡略化した折れ線と元の頂点の距離が許容誤差以内であること、
+     *      段が進むほど頂点インデックスが減り、拡大率が小さいほど粗い段が選択されることを確認する。
+     */
+    bool testcode_LodBuilder()
+    {
+        std::cout << "[testcode_LodBuilder()] call" << std::endl;
+        bool ok = true;
+
+        Vertexes ring;
+        for (std::int32_t i = 0; i < 2000; i++) {
+            const float a = static_cast<float>(i) * 2.0F * MATRIX_PI / 2000.0F;
+            const float r = 100.0F + (5.0F * std::sin(a * 40.0F));
+            ring.push_back({ r * std::cos(a), r * std::sin(a) });
+        }
+        const float tols[] = { 0.5F, 2.0F, 8.0F };
+        for (const float tol : tols) {
+            for (const bool closed : { false, true }) {
+                const std::vector<std::uint32_t> kept = Simplifier(tol).simplify(ring, closed);
+                const float dev = maxDeviation(ring, kept, closed);
+                const bool r = (dev <= tol);
+                std::cout << "* simplify tolerance:" << tol << " closed:" << closed << " vertexes:" << kept.size() << " deviation:" << dev << (r ? " .. OK" : " .. NG") << std::endl;
+                ok = r && ok;
+            }
+        }
+
+        const LodBuilder builder(0.5F, 4.0F, 5);
+        Indexes indexes;
+        const LodLevels lods = builder.polygon(Polygon(ring), Triangulator(1U), indexes);
+        bool decreasing = (lods.size() >= 3U) && (lods.at(0).count() == ((ring.size() - 2U) * 3U));
+        for (std::size_t i = 1U; i < lods.size(); i++) {
+            decreasing = decreasing && (lods.at(i).count() < lods.at(i - 1U).count()) && (lods.at(i).first() == (lods.at(i - 1U).first() + lods.at(i - 1U).count()));
+        }
+        decreasing = decreasing && ((lods.at(lods.size() - 1U).first() + lods.at(lods.size() - 1U).count()) == indexes.size());
+        std::cout << "* polygon levels:" << lods.size() << " indexes:" << indexes.size() << (decreasing ? " .. OK" : " .. NG") << std::endl;
+        ok = decreasing && ok;
+
+        const bool select = (&lods.select(100.0F, 1.0F) == &lods.at(0)) && (lods.select(0.01F, 1.0F).count() < lods.select(1.0F, 1.0F).count());
+        std::cout << "* select" << (select ? " .. OK" : " .. NG") << std::endl;
+        ok = select && ok;
+
+        Stroke stroke;
+        const LodLevels slods = builder.stroke(ring, Colors(ring.size(), Color(0, 0, 0, 255)), false, Stroker(2.0F, Stroker::JOIN::BEVEL, Stroker::CAP::BUTT), stroke);
+        const bool sok = (slods.size() >= 3U) && ((slods.at(slods.size() - 1U).first() + slods.at(slods.size() - 1U).count()) == stroke.indexes().size());
+        std::cout << "* stroke levels:" << slods.size() << " indexes:" << stroke.indexes().size() << (sok ? " .. OK" : " .. NG") << std::endl;
+        ok = sok && ok;
+
+        // 頂点色が空の場合は黒（Stroker::strokeと同じ）
+        Stroke nocolor;
+        const LodLevels nlods = builder.stroke(ring, Colors(), false, Stroker(2.0F, Stroker::JOIN::BEVEL, Stroker::CAP::BUTT), nocolor);
+        bool black = (nlods.size() == slods.size()) && (nocolor.indexes().size() == stroke.indexes().size()) && (nocolor.colors().size() == stroke.colors().size());
+        for (const Color& c : nocolor.colors()) {
+            black = black && (c.r() == 0U) && (c.g() == 0U) && (c.b() == 0U) && (c.a() == 255U);
+        }
+        std::cout << "* stroke empty colors" << (black ? " .. OK" : " .. NG") << std::endl;
+        ok = black && ok;
+        return ok;
+    }
+}
@@ -0,0 +1,128 @@
+﻿/**
+ * @file Lod.hpp
+ * @author kota-kota
+ * @brief 形状の詳細度（LOD）を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_LOD_HPP
+#define INCLUDED_LOD_HPP
+
+#include "Vertex.hpp"
+#include "Stroke.hpp"
+#include "Triangulator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class Lod
+     * @brief 1段分の詳細度（頂点インデックスの描画範囲）を扱うクラス
+     */
+    class Lod {
+        float           m_tolerance;    //!< 簡略化の許容誤差（オブジェクトの座標系、0は簡略化なし）
+        std::size_t     m_first;        //!< 頂点インデックスの先頭位置
+        std::size_t     m_count;        //!< 頂点インデックス数
+
+    public:
+        //! コンストラクタ
+        Lod(const float tolerance, const std::size_t first, const std::size_t count);
+
+    public:
+        //! 簡略化の許容誤差を取得
+        float tolerance() const;
+        //! 頂点インデックスの先頭位置を取得
+        std::size_t first() const;
+        //! 頂点インデックス数を取得
+        std::size_t count() const;
+    };
+
+    /**
+     * @class LodLevels
+     * @brief 詳細度の段の並び（許容誤差の昇順）を扱うクラス
+     * 
+     * @par 詳細
+     *      全ての段は1つの頂点インデックスの並びの異なる範囲を指す。
+     *      段の切り替えは描画範囲の変更のみで行う。
+     */
+    class LodLevels {
+        std::vector<Lod>    m_levels;   //!< 段の並び
+
+    public:
+        //! デフォルトコンストラクタ
+        LodLevels();
+
+    public:
+        //! 段を追加
+        void add(const Lod& lod);
+        //! 段がないか判定
+        bool empty() const;
+        //! 段数を取得
+        std::size_t size() const;
+        //! 段を取得
+        const Lod& at(const std::size_t i) const;
+        //! 拡大率に応じた段を選択
+        const Lod& select(const float scale, const float tolerance) const;
+    };
+}
+
+namespace my {
+    /**
+     * @class Simplifier
+     * @brief 折れ線を許容誤差の範囲で簡略化するクラス
+     * 
+     * @par 詳細
+     *      Douglas-Peucker法で、元の折れ線との距離が許容誤差以内となるよう頂点を間引く。
+     */
+    class Simplifier {
+        float   m_tolerance;    //!< 許容誤差（オブジェクトの座標系）
+
+    public:
+        //! コンストラクタ
+        explicit Simplifier(const float tolerance);
+
+    public:
+        //! 折れ線を簡略化し、残す頂点の番号を取得
+        std::vector<std::uint32_t> simplify(const Vertexes& polyline, const bool closed) const;
+    };
+}
+
+namespace my {
+    /**
+     * @class LodBuilder
+     * @brief 形状を簡略化して詳細度の段を作成するクラス
+     * 
+     * @par 詳細
+     *      段kの許容誤差は、基準の許容誤差 * 倍率^(k-1)とする（段0は簡略化なし）。
+     *      頂点数が減らなくなった時点で段の作成を終える。
+     */
+    class LodBuilder {
+        float           m_tolerance;    //!< 段1の許容誤差（オブジェクトの座標系）
+        float           m_ratio;        //!< 段毎の許容誤差の倍率
+        std::int32_t    m_levels;       //!< 段数の上限
+
+    public:
+        //! コンストラクタ
+        LodBuilder(const float tolerance, const float ratio, const std::int32_t levels);
+
+    public:
+        //! 太線の詳細度の段を作成
+        LodLevels stroke(const Vertexes& polyline, const Colors& colors, const bool closed, const Stroker& stroker, Stroke& out) const;
+        //! 多角形の詳細度の段を作成
+        LodLevels polygon(const Polygon& polygon, const Triangulator& triangulator, Indexes& indexes) const;
+
+    private:
+        //! 段kの許容誤差を取得
+        float tolerance(const std::int32_t level) const;
+    };
+}
+
+namespace my {
+    //! LodBuilderクラスのテストコードを実行
+    bool testcode_LodBuilder();
+}
+
+#endif //INCLUDED_LOD_HPP
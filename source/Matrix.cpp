@@ -10,156 +10,40 @@
 
 #define _USE_MATH_DEFINES
 #include "Matrix.hpp"
+#include "MatrixKernel.hpp"
+#include "Parallel.hpp"
+#include "Vertex.hpp"
+#include "Cpu.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
 
-namespace my {
-    /**
-     * @brief デフォルトコンストラクタ
-     * 
-     */
-    Degree::Degree() : m_deg(0.0F) {}
+namespace {
+    //! 座標の配列の変換関数
+    using PointsFunc = void (*)(const float* m, const float* in, float* out, const std::size_t num);
 
-    /**
-     * @brief コンストラクタ
-     * 
-     * @param [in] deg 角度[度]の値
-     */
-    Degree::Degree(const float deg) : m_deg(deg) {}
-
-    //! コンストラクタ
-    /**
-     * @brief コンストラクタ
-     * 
-     * @param [in] rad 角度[ラジアン]のインスタンス
-     */
-    Degree::Degree(const Radian rad) : m_deg(rad.degree().deg()) {}
-
-     /**
-      * @brief 角度[度]の値を取得
-      * 
-      * @return float 角度[度]の値
-      */
-    float Degree::deg() const { return this->m_deg; }
-
-    /**
-     * @brief 角度[ラジアン]のインスタンスを取得
-     * 
-     * @return Radian 角度[ラジアン]のインスタンス
-     */
-    Radian Degree::radian() const
+    //! 座標の配列を変換関数で変換（grainが0以外の場合は並列に変換する）
+    void transformPoints(const PointsFunc func, const float* m, const my::Vertex* in, my::Vertex* out, const std::size_t num, const std::size_t grain)
     {
-        float rad = this->m_deg * static_cast<float>(M_PI) / 180.0F;
-        return Radian(rad);
-    }
-
-
-    /**
-     * @brief デフォルトコンストラクタ
-     * 
-     */
-    Radian::Radian() : m_rad(0.0F) {}
-
-    /**
-     * @brief コンストラクタ
-     * 
-     * @param [in] rad 角度[ラジアン]の値
-     */
-    Radian::Radian(const float rad) : m_rad(rad) {}
-
-    /**
-     * @brief コンストラクタ
-     * 
-     * @param [in] deg 角度[度]のインスタンス
-     */
-    Radian::Radian(const Degree deg) : m_rad(deg.radian().rad()) {}
-
-    /**
-     * @brief 角度[ラジアン]の値を取得
-     * 
-     * @return float 角度[ラジアン]の値
-     */
-    float Radian::rad() const { return this->m_rad; }
-
-    /**
-     * @brief 角度[度]のインスタンスを取得
-     * 
-     * @return Degree 角度[度]のインスタンス
-     */
-    Degree Radian::degree() const
-    {
-        float deg = this->m_rad * 180.0F / static_cast<float>(M_PI);
-        return Degree(deg);
+        static_assert(sizeof(my::Vertex) == (sizeof(float) * 3U), "Vertex must be three packed floats");
+        const float* src = reinterpret_cast<const float*>(in);
+        float* dst = reinterpret_cast<float*>(out);
+        if (grain == 0U) {
+            func(m, src, dst, num);
+            return;
+        }
+        my::Parallel::forRange(num, grain, [=](const std::size_t begin, const std::size_t end) {
+            func(m, src + (begin * 3U), dst + (begin * 3U), end - begin);
+        });
     }
 }
 
 namespace my {
-    /**
-     * @brief デフォルトコンストラクタ
-     * 
-     */
-    Vector::Vector() :
-        m_x(0.0F), m_y(0.0F), m_z(0.0F)
-    {
-    }
-
-    /**
-     * @brief コンストラクタ
-     * 
-     * @param [in] x X座標
-     * @param [in] y Y座標
-     * @param [in] z Z座標
-     */
-    Vector::Vector(const float x, const float y, const float z) :
-        m_x(x), m_y(y), m_z(z)
-    {
-    }
-
-    /**
-     * @brief +演算子のオーバーロード
-     * 
-     * @param [in] v 加算するベクトル
-     * @return Vector 加算後のベクトル
-     */
-    Vector Vector::operator+(const Vector& v) const
-    {
-        Vector t;
-        t.m_x = this->m_x + v.m_x;
-        t.m_y = this->m_y + v.m_y;
-        t.m_z = this->m_z + v.m_z;
-        return t;
-    }
-
-    /**
-     * @brief -演算子のオーバーロード
-     * 
-     * @param [in] v 減算するベクトル
-     * @return Vector 減算後のベクトル
-     */
-    Vector Vector::operator-(const Vector& v) const
-    {
-        Vector t;
-        t.m_x = this->m_x - v.m_x;
-        t.m_y = this->m_y - v.m_y;
-        t.m_z = this->m_z - v.m_z;
-        return t;
-    }
-
-    /**
-     * @brief *演算子のオーバーロード
-     * 
-     * @param [in] v 乗算するベクトル
-     * @return Vector 乗算後のベクトル（外積ベクトル）
-     */
-    Vector Vector::operator*(const Vector& v) const
-    {
-        Vector t;
-        t.m_x = (this->m_y * v.m_z) - (this->m_z * v.m_y);
-        t.m_y = (this->m_z * v.m_x) - (this->m_x * v.m_z);
-        t.m_z = (this->m_x * v.m_y) - (this->m_y * v.m_x);
-        return t;
-    }
-
     /**
      * @brief +=演算子のオーバーロード
      * 
@@ -204,98 +88,28 @@ namespace my {
         return *this;
     }
 
-    /**
-     * @brief X座標を取得
-     * 
-     * @return float X座標
-     */
-    float Vector::x() const { return this->m_x; }
-    /**
-     * @brief Y座標を取得
-     * 
-     * @return float Y座標
-     */
-    float Vector::y() const { return this->m_y; }
-    /**
-     * @brief Z座標を取得
-     * 
-     * @return float Z座標
-     */
-    float Vector::z() const { return this->m_z; }
-
     /**
      * @brief ベクトルの長さを取得
      * 
      * @return float ベクトルの長さ
      */
     float Vector::len() const { return sqrtf(this->len2()); }
-
-    /**
-     * @brief ベクトルの長さの2乗を取得
-     * 
-     * @return float ベクトルの長さの2乗
-     */
-    float Vector::len2() const { return (m_x * m_x) + (m_y * m_y) + (m_z * m_z); }
 }
 
 namespace my {
-    /**
-     * @brief デフォルトコンストラクタ
-     * 
-     */
-    Matrix::Matrix() :
-        std::array<float, 16>({0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F})
-    {
-    }
-
-    /**
-     * @brief +演算子のオーバーロード
-     * 
-     * @param [in] m 加算する行列
-     * @return Matrix 加算後の行列
-     */
-    Matrix Matrix::operator+(const Matrix& m) const
-    {
-        Matrix t;
-        for (std::int32_t i = 0; i < 16; ++i) {
-            t[i] = (*this)[i] + m[i];
-        }
-        return t;
-    }
-
-    /**
-     * @brief -演算子のオーバーロード
-     * 
-     * @param [in] m 減算する行列
-     * @return Matrix 減算後の行列
-     */
-    Matrix Matrix::operator-(const Matrix& m) const
-    {
-        Matrix t;
-        for (std::int32_t i = 0; i < 16; ++i) {
-            t[i] = (*this)[i] - m[i];
-        }
-        return t;
-    }
-
     /**
      * @brief *演算子のオーバーロード
      * 
      * @param [in] m 乗算する行列
      * @return Matrix 乗算後の行列
+     * 
+     * @par 詳細
+     *      実行中のCPUに応じて選択した演算関数（MatrixKernel）で計算する。
      */
     Matrix Matrix::operator*(const Matrix& m) const
     {
         Matrix t;
-        for (std::int32_t i = 0; i < 16; ++i) {
-            const std::int32_t j = i & 3;
-            const std::int32_t k = i & ~3;
-            t[i] =
-                (*this)[ 0 + j] * m[k + 0] +
-                (*this)[ 4 + j] * m[k + 1] +
-                (*this)[ 8 + j] * m[k + 2] +
-                (*this)[12 + j] * m[k + 3];
-        }
+        MatrixKernel::get().multiply(this->data(), m.data(), t.data());
         return t;
     }
 
@@ -332,20 +146,13 @@ namespace my {
      * 
      * @param [in] m 乗算する行列
      * @return Matrix 乗算後の行列
+     * 
+     * @par 詳細
+     *      一時オブジェクトを介さず、自身に直接書き込む。
      */
     Matrix& Matrix::operator*=(const Matrix& m)
     {
-        Matrix t;
-        for (std::int32_t i = 0; i < 16; ++i) {
-            const std::int32_t j = i & 3;
-            const std::int32_t k = i & ~3;
-            t[i] =
-                (*this)[ 0 + j] * m[k + 0] +
-                (*this)[ 4 + j] * m[k + 1] +
-                (*this)[ 8 + j] * m[k + 2] +
-                (*this)[12 + j] * m[k + 3];
-        }
-        *this = t;
+        MatrixKernel::get().multiply(this->data(), m.data(), this->data());
         return *this;
     }
 
@@ -355,53 +162,99 @@ namespace my {
      */
     void Matrix::transpose()
     {
-        Matrix t;
-        t[ 0] = (*this)[ 0]; t[ 1] = (*this)[ 4]; t[ 2] = (*this)[ 8]; t[ 3] = (*this)[12];
-        t[ 4] = (*this)[ 1]; t[ 5] = (*this)[ 5]; t[ 6] = (*this)[ 9]; t[ 7] = (*this)[13];
-        t[ 8] = (*this)[ 2]; t[ 9] = (*this)[ 6]; t[10] = (*this)[10]; t[11] = (*this)[14];
-        t[12] = (*this)[ 3]; t[13] = (*this)[ 7]; t[14] = (*this)[11]; t[15] = (*this)[15];
-        *this = t;
+        MatrixKernel::get().transpose(this->data(), this->data());
     }
 
     /**
-     * @brief 単位行列を作成
+     * @brief 逆行列を取得
+     * 
+     * @return Matrix 逆行列（逆行列が存在しない場合は単位行列）
      * 
-     * @return Matrix 単位行列
+     * @par 詳細
+     *      アフィン変換の行列（最下行が(0 0 0 1)）はinverseAffine()で求める。
+     *      それ以外は余因子行列を行列式で割って求める（MatrixKernel::inverse）。
      */
-    Matrix Matrix::identity()
+    Matrix Matrix::inverse() const
     {
+        if (this->isAffine()) {
+            return this->inverseAffine();
+        }
         Matrix t;
-        t[0] = 1.0F; t[5] = 1.0F; t[10] = 1.0F; t[15] = 1.0F;
+        if (!MatrixKernel::get().inverse(this->data(), t.data())) {
+            return Matrix::identity();
+        }
         return t;
     }
 
-    //! (x,y,z)だけ平行移動する変換行列を作成
     /**
-     * @brief (x,y,z)だけ平行移動する変換行列を作成
+     * @brief アフィン変換の行列の逆行列を取得
      * 
-     * @param [in] v 移動量のベクトル
+     * @return Matrix 逆行列（逆行列が存在しない場合は単位行列）
      * 
-     * @return Matrix 平行移動する変換行列
+     * @par 詳細
+     *      最下行を(0 0 0 1)とみなし、M = [R t; 0 1] の逆行列を [R^-1 -R^-1・t; 0 1] で求める（MatrixKernel::inverseAffine）。
+     *      lookat()・orthogonal()とその積の逆行列を、一般の逆行列より少ない演算で求める。
      */
-    Matrix Matrix::translate(const Vector& v)
+    Matrix Matrix::inverseAffine() const
     {
-        Matrix t = Matrix::identity();
-        t[3] = v.x(); t[7] = v.y(); t[11] = v.z();
+        Matrix t;
+        if (!MatrixKernel::get().inverseAffine(this->data(), t.data())) {
+            return Matrix::identity();
+        }
         return t;
     }
 
     /**
-     * @brief (x,y,z)倍に拡大縮小する変換行列を作成
+     * @brief 座標を変換
      * 
-     * @param [in] v 拡大縮小倍率のベクトル
+     * @param [in] v 座標
      * 
-     * @return Matrix 拡大縮小する変換行列
+     * @return Vector 変換後の座標（同次座標のwで割った値）
      */
-    Matrix Matrix::scale(const Vector& v)
+    Vector Matrix::transform(const Vector& v) const
     {
-        Matrix t = Matrix::identity();
-        t[0] = v.x(); t[5] = v.y(); t[10] = v.z();
-        return t;
+        const float in[4] = { v.x(), v.y(), v.z(), 1.0F };
+        float out[4];
+        MatrixKernel::get().transform(this->data(), in, out);
+        const float x = out[0], y = out[1], z = out[2], w = out[3];
+        if (!(std::fabs(w) > 0.0F)) {
+            return Vector(x, y, z);
+        }
+        return Vector(x / w, y / w, z / w);
+    }
+
+    /**
+     * @brief 座標の配列を変換
+     * 
+     * @param [in] in 変換前の座標の配列
+     * @param [out] out 変換後の座標の配列（同次座標のwで割った値、inと同じ配列でもよい）
+     * @param [in] num 座標の数
+     * @param [in] grain 並列に変換する区間の最小の座標数（0は呼び出し元のスレッドで変換する）
+     * 
+     * @par 詳細
+     *      transform()を座標毎に呼び出すのと同じ結果を、命令セットに応じて4個または8個ずつまとめて計算する。
+     *      大きな配列はgrainを指定し、Parallel::forRange()で区間毎に並列に変換する。
+     */
+    void Matrix::transformPoints(const Vertex* in, Vertex* out, const std::size_t num, const std::size_t grain) const
+    {
+        ::transformPoints(MatrixKernel::get().points, this->data(), in, out, num, grain);
+    }
+
+    /**
+     * @brief 座標の配列のXY座標を2次元のアフィン変換で変換
+     * 
+     * @param [in] in 変換前の座標の配列
+     * @param [out] out 変換後の座標の配列（inと同じ配列でもよい）
+     * @param [in] num 座標の数
+     * @param [in] grain 並列に変換する区間の最小の座標数（0は呼び出し元のスレッドで変換する）
+     * 
+     * @par 詳細
+     *      行列の[0] [1] [3] / [4] [5] [7]の要素のみ使用し、XY平面上の拡大縮小・回転・平行移動として変換する。
+     *      Z座標は変換せずにそのまま出力する。
+     */
+    void Matrix::transformPoints2D(const Vertex* in, Vertex* out, const std::size_t num, const std::size_t grain) const
+    {
+        ::transformPoints(MatrixKernel::get().points2D, this->data(), in, out, num, grain);
     }
 
     /**
@@ -434,7 +287,7 @@ namespace my {
 
         Matrix t = Matrix::identity();
         t[0] = cosf(rad); t[2] = sinf(rad);
-        t[8] = sinf(rad); t[10] = cosf(rad);
+        t[8] = -sinf(rad); t[10] = cosf(rad);
         return t;
     }
 
@@ -459,15 +312,15 @@ namespace my {
      * @brief 任意の(x,y,z)軸を中心にdegree度回転する変換行列を作成
      * 
      * @param [in] degree 角度[度]のインスタンス
-     * @param [in] v 回転軸のベクトル
+     * @param [in] v 回転軸のベクトル（正規化しなくてよい）
      * 
-     * @return Matrix 回転する変換行列
+     * @return Matrix 回転する変換行列（回転軸の長さが0の場合は単位行列）
      */
     Matrix Matrix::rotate(const Degree degree, const Vector& v)
     {
         const float rad = degree.radian().rad();
         const float d = sqrtf(v.x()*v.x() + v.y()*v.y() + v.z()*v.z());
-        if (d > 0.0F) {
+        if (!(d > 0.0F)) {
             return Matrix::identity();
         }
 
@@ -511,7 +364,7 @@ namespace my {
         // s軸 = t軸 x r軸
         const Vector s = t * r;
         // s軸の長さのチェック
-        if (s.len() == 0.0f) {
+        if (!(s.len() > 0.0F)) {
             return tv;
         }
 
@@ -533,37 +386,206 @@ namespace my {
         rv[ 9] = t.y() / tlen;
         rv[10] = t.z() / tlen;
 
-        // 視点の平行移動の変換行列に視線の回転の変換行列を乗じる
-        return tv * rv;
+        // 視点の平行移動の変換行列に視線の回転の変換行列を乗じる（tv * rv。平行移動の列のみ変わるため直接求める）
+        for (std::size_t i = 0U; i < 3U; i++) {
+            rv[(i * 4U) + 3U] = (rv[(i * 4U) + 0U] * _eye.x()) + (rv[(i * 4U) + 1U] * _eye.y()) + (rv[(i * 4U) + 2U] * _eye.z());
+        }
+        return rv;
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     * @par 詳細
+     *      単位行列で初期化する。
+     */
+    GpuMatrix::GpuMatrix() :
+        m_m(Matrix::identity())
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] m 行列（行優先）
+     * 
+     * @par 詳細
+     *      転置して列優先で保持する。
+     */
+    GpuMatrix::GpuMatrix(const Matrix& m) :
+        m_m()
+    {
+        MatrixKernel::get().transpose(m.data(), this->m_m.data());
+    }
+
+    /**
+     * @brief 要素の配列（列優先）を取得
+     * 
+     * @return const float* 要素の配列の先頭
+     */
+    const float* GpuMatrix::data() const
+    {
+        return this->m_m.data();
     }
 
     /**
-     * @brief 直交投影変換行列を作成
-     * 
-     * @param [in] left 視体積の前方面の左の垂直座標
-     * @param [in] right 視体積の前方面の右の垂直座標
-     * @param [in] bottom 視体積の前方面の下の水平座標
-     * @param [in] top 視体積の前方面の上の水平座標
-     * @param [in] znear 視点から最も近い距離
-     * @param [in] zfar 視点から最も遠い距離
-    * 
-     * @return Matrix 直交投影変換行列
+     * @brief row行col列の要素を取得
+     * 
+     * @param [in] row 行（0～3）
+     * @param [in] col 列（0～3）
+     * @return float 要素
      */
-    Matrix Matrix::orthogonal(const float left, const float right, const float bottom, const float top, const float znear, const float zfar)
-    {
-        Matrix t = my::Matrix::identity();
-        const float dx = right - left;
-        const float dy = top - bottom;
-        const float dz = zfar - znear;
-        if ((dx != 0.0f) && (dy != 0.0f) && (dz != 0.0f)) {
-            t[ 0] = 2.0f / dx;
-            t[ 3] = -(right + left) / dx;
-            t[ 5] = 2.0f / dy;
-            t[ 7] = -(top + bottom) / dy;
-            t[10] = -2.0f / dz;
-            t[11] = -(zfar + znear) / dz;
+    float GpuMatrix::at(const std::size_t row, const std::size_t col) const
+    {
+        return this->m_m[(col * 4U) + row];
+    }
+}
+
+namespace {
+    //! コンパイル時のテストで値が一致するか判定（浮動小数点数の==を避けて大小比較で判定する）
+    constexpr bool same(const float a, const float b) { return !(a < b) && !(a > b); }
+
+    // 角度の単位の変換
+    static_assert(same(my::Degree(180.0F).radian().rad(), my::MATRIX_PI), "Degree::radian");
+    static_assert(same(my::Radian(my::MATRIX_PI).degree().deg(), 180.0F), "Radian::degree");
+    static_assert(same(my::Radian(my::Degree(90.0F)).rad(), my::MATRIX_PI / 2.0F), "Radian(Degree)");
+
+    // ベクトル
+    constexpr my::Vector TEST_VX(1.0F, 0.0F, 0.0F);
+    constexpr my::Vector TEST_VY(0.0F, 1.0F, 0.0F);
+    static_assert(same((TEST_VX * TEST_VY).z(), 1.0F) && same((TEST_VY * TEST_VX).z(), -1.0F), "Vector::operator*");
+    static_assert(same((TEST_VX + TEST_VY).len2(), 2.0F) && same((TEST_VX - TEST_VY).y(), -1.0F), "Vector::operator+-");
+
+    // 行列
+    constexpr my::Matrix TEST_I = my::Matrix::identity();
+    static_assert(same(TEST_I[0], 1.0F) && same(TEST_I[5], 1.0F) && same(TEST_I[10], 1.0F) && same(TEST_I[15], 1.0F), "Matrix::identity");
+    static_assert(same(TEST_I[1], 0.0F) && same(TEST_I[4], 0.0F) && same(TEST_I[3], 0.0F) && same(TEST_I[12], 0.0F), "Matrix::identity");
+    constexpr my::Matrix TEST_T = my::Matrix::translate({ 1.0F, 2.0F, 3.0F });
+    static_assert(same(TEST_T[3], 1.0F) && same(TEST_T[7], 2.0F) && same(TEST_T[11], 3.0F) && same(TEST_T[0], 1.0F), "Matrix::translate");
+    constexpr my::Matrix TEST_S = my::Matrix::scale({ 2.0F, 3.0F, 4.0F });
+    static_assert(same(TEST_S[0], 2.0F) && same(TEST_S[5], 3.0F) && same(TEST_S[10], 4.0F) && same(TEST_S[15], 1.0F), "Matrix::scale");
+    constexpr my::Matrix TEST_ADD = TEST_T + TEST_S;
+    static_assert(same(TEST_ADD[0], 3.0F) && same(TEST_ADD[3], 1.0F) && same(TEST_ADD[15], 2.0F), "Matrix::operator+");
+    constexpr my::Matrix TEST_SUB = TEST_T - TEST_S;
+    static_assert(same(TEST_SUB[0], -1.0F) && same(TEST_SUB[3], 1.0F) && same(TEST_SUB[15], 0.0F), "Matrix::operator-");
+    constexpr my::Matrix TEST_O = my::Matrix::orthogonal(0.0F, 200.0F, 0.0F, 100.0F, 1.0F, 9.0F);
+    static_assert(same(TEST_O[0], 0.01F) && same(TEST_O[3], -1.0F) && same(TEST_O[5], 0.02F) && same(TEST_O[7], -1.0F), "Matrix::orthogonal");
+    static_assert(same(TEST_O[10], -0.25F) && same(TEST_O[11], -1.25F) && same(TEST_O[15], 1.0F), "Matrix::orthogonal");
+    constexpr my::Matrix TEST_O0 = my::Matrix::orthogonal(0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 9.0F);
+    static_assert(same(TEST_O0[0], 1.0F) && same(TEST_O0[3], 0.0F), "Matrix::orthogonal (degenerate)");
+    constexpr my::Matrix TEST_Z;
+    static_assert(same(TEST_Z[0], 0.0F) && same(TEST_Z[15], 0.0F), "Matrix::Matrix");
+    static_assert(TEST_I.isAffine() && TEST_O.isAffine() && !TEST_Z.isAffine(), "Matrix::isAffine");
+}
+
+namespace {
+    //! テストの許容誤差（参照値の大きさに対する相対誤差、大きさ1未満は絶対誤差）
+    const double MATRIX_EPS = 1.0e-5;
+
+    //! 値が参照値と許容誤差以内で一致するか判定
+    bool approx(const float a, const double ref, const double eps = MATRIX_EPS)
+    {
+        return std::fabs(static_cast<double>(a) - ref) <= (eps * std::max(1.0, std::fabs(ref)));
+    }
+
+    //! ベクトルが参照値と許容誤差以内で一致するか判定
+    bool approx(const my::Vector& a, const my::Vector& ref, const double eps = MATRIX_EPS)
+    {
+        return approx(a.x(), static_cast<double>(ref.x()), eps) && approx(a.y(), static_cast<double>(ref.y()), eps) && approx(a.z(), static_cast<double>(ref.z()), eps);
+    }
+
+    //! 行列が要素毎に参照値と許容誤差以内で一致するか判定
+    bool approx(const my::Matrix& a, const std::array<double, 16>& ref, const double eps = MATRIX_EPS)
+    {
+        bool result = true;
+        for (std::size_t i = 0U; i < 16U; i++) {
+            result = result && approx(a[i], ref[i], eps);
         }
-        return t;
+        return result;
+    }
+
+    //! 行列が要素毎に許容誤差以内で一致するか判定
+    bool approx(const my::Matrix& a, const my::Matrix& ref, const double eps = MATRIX_EPS)
+    {
+        std::array<double, 16> r;
+        for (std::size_t i = 0U; i < 16U; i++) {
+            r[i] = static_cast<double>(ref[i]);
+        }
+        return approx(a, r, eps);
+    }
+
+    //! 行列の積の参照値（倍精度、aの変換の後にbの変換を行う）
+    std::array<double, 16> refMultiply(const my::Matrix& a, const my::Matrix& b)
+    {
+        std::array<double, 16> out;
+        for (std::size_t row = 0U; row < 4U; row++) {
+            for (std::size_t col = 0U; col < 4U; col++) {
+                double sum = 0.0;
+                for (std::size_t n = 0U; n < 4U; n++) {
+                    sum += static_cast<double>(b[(row * 4U) + n]) * static_cast<double>(a[(n * 4U) + col]);
+                }
+                out[(row * 4U) + col] = sum;
+            }
+        }
+        return out;
+    }
+
+    //! 座標の変換の参照値（倍精度、同次座標のwで割る）
+    my::Vector refTransform(const my::Matrix& m, const my::Vector& v)
+    {
+        const double in[4] = { static_cast<double>(v.x()), static_cast<double>(v.y()), static_cast<double>(v.z()), 1.0 };
+        double out[4] = { 0.0, 0.0, 0.0, 0.0 };
+        for (std::size_t row = 0U; row < 4U; row++) {
+            for (std::size_t col = 0U; col < 4U; col++) {
+                out[row] += static_cast<double>(m[(row * 4U) + col]) * in[col];
+            }
+        }
+        return my::Vector(static_cast<float>(out[0] / out[3]), static_cast<float>(out[1] / out[3]), static_cast<float>(out[2] / out[3]));
+    }
+
+    //! 左上3x3の行列式の参照値（倍精度）
+    double refDeterminant3(const my::Matrix& m)
+    {
+        const auto e = [&m](const std::size_t row, const std::size_t col) { return static_cast<double>(m[(row * 4U) + col]); };
+        return (e(0U, 0U) * ((e(1U, 1U) * e(2U, 2U)) - (e(1U, 2U) * e(2U, 1U))))
+             - (e(0U, 1U) * ((e(1U, 0U) * e(2U, 2U)) - (e(1U, 2U) * e(2U, 0U))))
+             + (e(0U, 2U) * ((e(1U, 0U) * e(2U, 1U)) - (e(1U, 1U) * e(2U, 0U))));
+    }
+
+    //! テスト・性能計測用の乱数（[-2,2)）
+    float randomValue(std::uint32_t& seed)
+    {
+        seed = (seed * 1664525U) + 1013904223U;
+        return (static_cast<float>(seed >> 8) / 4194304.0F) - 2.0F;
+    }
+
+    //! テスト・性能計測用の乱数の行列（対角に4を加えて逆行列の条件数を抑える）
+    my::Matrix randomMatrix(std::uint32_t& seed)
+    {
+        my::Matrix m;
+        for (std::size_t i = 0U; i < 16U; i++) {
+            m[i] = randomValue(seed) + (((i % 5U) == 0U) ? 4.0F : 0.0F);
+        }
+        return m;
+    }
+
+    //! テスト・性能計測用の乱数のアフィン変換の行列（回転・拡大縮小・平行移動）
+    my::Matrix randomAffine(std::uint32_t& seed)
+    {
+        const my::Vector axis(randomValue(seed), randomValue(seed), randomValue(seed) + 3.0F);
+        const my::Vector scale(randomValue(seed) + 3.0F, randomValue(seed) + 3.0F, randomValue(seed) + 3.0F);
+        const my::Vector move(randomValue(seed) * 100.0F, randomValue(seed) * 100.0F, randomValue(seed) * 100.0F);
+        return my::Matrix::scale(scale) * my::Matrix::rotate(randomValue(seed) * 90.0F, axis) * my::Matrix::translate(move);
+    }
+
+    //! テスト・性能計測用の乱数のベクトル（[-2,2)）
+    my::Vector randomVector(std::uint32_t& seed)
+    {
+        const float x = randomValue(seed);
+        const float y = randomValue(seed);
+        return my::Vector(x, y, randomValue(seed));
     }
 }
 
@@ -571,29 +593,297 @@ namespace my {
     /**
      * @brief Matrixクラスのテストコードを実行
      * 
+     * @return true 全ての確認が一致した
+     * 
+     * @par 詳細
+     *      角度・ベクトル・行列の全ての演算を、倍精度で計算した参照値または既知の値と比較する。
+     *      演算関数の組（MatrixKernel）を使用する演算は、対応する命令セット毎に切り替えて確認する。
      */
     bool testcode_Matrix()
     {
-        float deg = 0.0F, rad = 0.0F;
-        Degree degree(45.0F);
-        Radian radian = degree.radian();
-        deg = radian.degree().deg();
-        rad = radian.rad();
-
-        Matrix m1 ,m2;
-        m1 = Matrix::scale({5.0F, 10.0F, 15.0F});
-        m2 = Matrix::scale({20.0F, 3.0F, 2.0F});
-        Matrix add = m1 + m2;
-        Matrix del = m1 - m2;
-        Matrix mul = m1 * m2;
-
-        Matrix add_eq = m1;
-        add_eq += m2;
-        Matrix del_eq = m1;
-        del_eq -= m2;
-        Matrix mul_eq = m1;
-        mul_eq *= m2;
-
-        return true;
-    }
-}
\ No newline at end of file
+        std::cout << "[testcode_Matrix()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const std::string& name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+
+        // 角度の単位の変換
+        check("Degree::radian", approx(Degree(90.0F).radian().rad(), M_PI / 2.0));
+        check("Radian::degree", approx(Radian(static_cast<float>(M_PI / 4.0)).degree().deg(), 45.0));
+        check("Degree(Radian)", approx(Degree(Radian(static_cast<float>(M_PI))).deg(), 180.0) && approx(Radian(Degree(-30.0F)).rad(), -M_PI / 6.0));
+
+        // ベクトル（*は外積）
+        const Vector va(1.0F, 2.0F, 3.0F);
+        const Vector vb(-4.0F, 5.0F, 0.5F);
+        check("Vector::operator+", approx(va + vb, { -3.0F, 7.0F, 3.5F }));
+        check("Vector::operator-", approx(va - vb, { 5.0F, -3.0F, 2.5F }));
+        check("Vector::operator*", approx(va * vb, { -14.0F, -12.5F, 13.0F }) && approx(vb * va, { 14.0F, 12.5F, -13.0F }));
+        Vector vc = va;
+        vc += vb;
+        check("Vector::operator+=", approx(vc, va + vb));
+        vc -= vb;
+        check("Vector::operator-=", approx(vc, va));
+        vc *= vb;
+        check("Vector::operator*=", approx(vc, va * vb));
+        check("Vector::len", approx(va.len2(), 14.0) && approx(va.len(), std::sqrt(14.0)) && approx(Vector().len(), 0.0));
+
+        // 行列の要素毎の演算
+        std::uint32_t seed = 7U;
+        const Matrix ma = randomMatrix(seed);
+        const Matrix mb = randomMatrix(seed);
+        std::array<double, 16> add, sub;
+        for (std::size_t i = 0U; i < 16U; i++) {
+            add[i] = static_cast<double>(ma[i]) + static_cast<double>(mb[i]);
+            sub[i] = static_cast<double>(ma[i]) - static_cast<double>(mb[i]);
+        }
+        check("Matrix::operator+", approx(ma + mb, add));
+        check("Matrix::operator-", approx(ma - mb, sub));
+        Matrix mc = ma;
+        mc += mb;
+        check("Matrix::operator+=", approx(mc, add));
+        mc = ma;
+        mc -= mb;
+        check("Matrix::operator-=", approx(mc, sub));
+
+        // 行列の作成
+        const Vector v(3.0F, -4.0F, 5.0F);
+        check("Matrix::identity", approx(Matrix::identity().transform(v), v));
+        check("Matrix::translate", approx(Matrix::translate({ 10.0F, 20.0F, 30.0F }).transform(v), { 13.0F, 16.0F, 35.0F }));
+        check("Matrix::scale", approx(Matrix::scale({ 2.0F, 3.0F, -1.0F }).transform(v), { 6.0F, -12.0F, -5.0F }));
+        // 回転は右手系で、軸の正の向きから見て反時計回りを正とする
+        const Vector ex(1.0F, 0.0F, 0.0F), ey(0.0F, 1.0F, 0.0F), ez(0.0F, 0.0F, 1.0F);
+        check("Matrix::rotate_x", approx(Matrix::rotate_x(90.0F).transform(ey), ez) && approx(Matrix::rotate_x(90.0F).transform(ez), { 0.0F, -1.0F, 0.0F }));
+        check("Matrix::rotate_y", approx(Matrix::rotate_y(90.0F).transform(ez), ex) && approx(Matrix::rotate_y(90.0F).transform(ex), { 0.0F, 0.0F, -1.0F }));
+        check("Matrix::rotate_z", approx(Matrix::rotate_z(90.0F).transform(ex), ey) && approx(Matrix::rotate_z(90.0F).transform(ey), { -1.0F, 0.0F, 0.0F }));
+        bool orthonormal = true;
+        const Matrix rotations[] = { Matrix::rotate_x(37.0F), Matrix::rotate_y(37.0F), Matrix::rotate_z(37.0F), Matrix::rotate(37.0F, { 1.0F, 2.0F, 3.0F }) };
+        for (const Matrix& r : rotations) {
+            Matrix rt = r;
+            rt.transpose();
+            orthonormal = orthonormal && approx(r * rt, Matrix::identity()) && (std::fabs(refDeterminant3(r) - 1.0) <= MATRIX_EPS);
+        }
+        check("rotation orthonormal", orthonormal);
+        // 任意軸の回転は、座標軸の場合は各軸の回転と一致し、軸の長さによらない
+        check("Matrix::rotate axis", approx(Matrix::rotate(37.0F, ex), Matrix::rotate_x(37.0F)) && approx(Matrix::rotate(37.0F, ey), Matrix::rotate_y(37.0F)) && approx(Matrix::rotate(37.0F, { 0.0F, 0.0F, 2.0F }), Matrix::rotate_z(37.0F)));
+        const Vector axis(1.0F, 2.0F, 3.0F);
+        check("Matrix::rotate fixed axis", approx(Matrix::rotate(123.0F, axis).transform(axis), axis) && approx(Matrix::rotate(123.0F, axis) * Matrix::rotate(-123.0F, axis), Matrix::identity()));
+        check("Matrix::rotate zero axis", approx(Matrix::rotate(37.0F, Vector()), Matrix::identity()));
+        // ビュー変換は視点を原点に、目標点を-Z軸上に、上方向を+Y側に移す
+        const Matrix view = Matrix::lookat({ 10.0F, 20.0F, 30.0F }, { 10.0F, 20.0F, 0.0F }, ey);
+        check("Matrix::lookat", approx(view.transform({ 10.0F, 20.0F, 30.0F }), Vector()) && approx(view.transform({ 10.0F, 20.0F, 0.0F }), { 0.0F, 0.0F, -30.0F }) && approx(view.transform({ 10.0F, 21.0F, 30.0F }), ey));
+        const Vector eye(3.0F, -4.0F, 5.0F), center(1.0F, 2.0F, -1.0F);
+        const Matrix oblique = Matrix::lookat(eye, center, ez);
+        const Vector up = oblique.transform(eye + ez);
+        check("Matrix::lookat oblique", approx(oblique.transform(eye), Vector()) && approx(oblique.transform(center), { 0.0F, 0.0F, -(eye - center).len() }) && (up.y() > 0.0F) && approx(up.x(), 0.0));
+        check("Matrix::lookat degenerate", approx(Matrix::lookat(eye, { 3.0F, -4.0F, 0.0F }, ez), Matrix::translate({ -3.0F, 4.0F, -5.0F })));
+        // 直交投影は表示範囲の角を(-1,-1,-1)・(1,1,1)に移す
+        const Matrix ortho = Matrix::orthogonal(-320.0F, 640.0F, -240.0F, 480.0F, 1.0F, 100.0F);
+        check("Matrix::orthogonal", approx(ortho.transform({ -320.0F, -240.0F, -1.0F }), { -1.0F, -1.0F, -1.0F }) && approx(ortho.transform({ 640.0F, 480.0F, -100.0F }), { 1.0F, 1.0F, 1.0F }));
+        check("Matrix::isAffine", view.isAffine() && ortho.isAffine() && (view * ortho).isAffine() && !ma.isAffine());
+
+        // 演算関数の組を使用する演算（命令セット毎）
+        const Cpu::ISA isas[] = { Cpu::ISA::SCALAR, Cpu::ISA::SSE2, Cpu::ISA::NEON, Cpu::ISA::AVX2 };
+        for (const Cpu::ISA isa : isas) {
+            if (!Cpu::force(isa)) {
+                continue;
+            }
+            const std::string name = std::string(Cpu::name(isa)) + " ";
+            // 積はaの変換の後にbの変換を行う
+            bool mul = true, mul_eq = true, xform = true;
+            std::uint32_t s = 11U;
+            for (std::int32_t i = 0; i < 16; i++) {
+                const Matrix a = randomMatrix(s);
+                const Matrix b = randomMatrix(s);
+                const Vector p = randomVector(s);
+                mul = mul && approx(a * b, refMultiply(a, b), 1.0e-4);
+                Matrix c = a;
+                c *= b;
+                mul_eq = mul_eq && approx(c, a * b, 0.0);
+                c = a;
+                c *= c;
+                mul_eq = mul_eq && approx(c, a * a, 0.0);
+                xform = xform && approx(a.transform(p), refTransform(a, p), 1.0e-4);
+            }
+            check(name + "Matrix::operator*", mul && approx((ma * mb).transform(v), mb.transform(ma.transform(v)), 1.0e-4));
+            check(name + "Matrix::operator*=", mul_eq);
+            check(name + "Matrix::transform", xform);
+            Matrix w0 = Matrix::identity();
+            w0[15] = 0.0F;
+            check(name + "Matrix::transform w=0", approx(w0.transform(v), v));
+            Matrix mt = ma;
+            mt.transpose();
+            bool trans = true;
+            for (std::size_t row = 0U; row < 4U; row++) {
+                for (std::size_t col = 0U; col < 4U; col++) {
+                    trans = trans && approx(mt[(row * 4U) + col], static_cast<double>(ma[(col * 4U) + row]), 0.0);
+                }
+            }
+            check(name + "Matrix::transpose", trans);
+            // 逆行列
+            bool inv = true, inv_affine = true;
+            for (std::int32_t i = 0; i < 16; i++) {
+                const Matrix a = randomMatrix(s);
+                inv = inv && approx(a * a.inverse(), Matrix::identity(), 1.0e-4);
+                const Matrix f = randomAffine(s);
+                inv_affine = inv_affine && approx(f * f.inverse(), Matrix::identity(), 1.0e-4) && approx(f.inverseAffine(), f.inverse(), 0.0);
+            }
+            check(name + "Matrix::inverse", inv && approx((view * ortho).inverse().transform((view * ortho).transform(v)), v, 1.0e-4));
+            check(name + "Matrix::inverseAffine", inv_affine);
+            check(name + "Matrix::inverse singular", approx(Matrix::scale({ 1.0F, 0.0F, 1.0F }).inverse(), Matrix::identity()) && approx(Matrix().inverse(), Matrix::identity()));
+            // 座標の配列の変換は座標毎の変換と一致する（命令セットの幅で割り切れない数とする）
+            Vertexes in, out(37U), out2D(37U), par(37U);
+            for (std::int32_t i = 0; i < 37; i++) {
+                const Vector p = randomVector(s);
+                in.emplace_back(p.x(), p.y(), p.z());
+            }
+            const Matrix proj = ma;
+            proj.transformPoints(in.data(), out.data(), in.size());
+            proj.transformPoints(in.data(), par.data(), in.size(), 8U);
+            const Matrix place = Matrix::rotate_z(30.0F) * Matrix::translate({ 5.0F, -6.0F, 0.0F });
+            place.transformPoints2D(in.data(), out2D.data(), in.size());
+            bool points = true, points2D = true;
+            for (std::size_t i = 0U; i < in.size(); i++) {
+                const Vector p(in[i].x(), in[i].y(), in[i].z());
+                const Vector q = proj.transform(p);
+                points = points && approx({ out[i].x(), out[i].y(), out[i].z() }, q, 1.0e-4) && approx({ par[i].x(), par[i].y(), par[i].z() }, q, 1.0e-4);
+                const Vector r = place.transform({ p.x(), p.y(), 0.0F });
+                points2D = points2D && approx({ out2D[i].x(), out2D[i].y(), out2D[i].z() }, { r.x(), r.y(), p.z() }, 1.0e-4);
+            }
+            check(name + "Matrix::transformPoints", points);
+            check(name + "Matrix::transformPoints2D", points2D);
+        }
+        Cpu::reset();
+
+        std::cout << "[testcode_Matrix()] " << (ok ? "OK" : "NG") << std::endl;
+        return ok;
+    }
+
+    /**
+     * @brief Matrixクラスの処理性能を計測
+     * 
+     * @par 詳細
+     *      積・座標の変換・逆行列・行列の作成の1回あたりの時間[nsec]を出力する。
+     *      演算関数の組（MatrixKernel）を使用する演算は、対応する命令セット毎に切り替えて計測する。
+     */
+    void benchcode_Matrix()
+    {
+        std::cout << "[benchcode_Matrix()] call" << std::endl;
+        const std::size_t num = 1024U;
+        const std::int32_t repeat = 1000;
+        const double ops = static_cast<double>(num) * repeat;
+        std::vector<Matrix> general(num), affine(num), out(num);
+        std::vector<Vector> points(num), pout(num);
+        std::vector<float> angles(num);
+        std::uint32_t seed = 5U;
+        for (std::size_t i = 0U; i < num; i++) {
+            general[i] = randomMatrix(seed);
+            affine[i] = randomAffine(seed);
+            points[i] = randomVector(seed);
+            angles[i] = randomValue(seed) * 90.0F;
+        }
+        const Matrix b = randomMatrix(seed);
+        float sink = 0.0F;
+        // 1回あたりの時間[nsec]を計測
+        const auto measure = [&](const auto& body) {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                for (std::size_t i = 0U; i < num; i++) {
+                    body(i);
+                }
+                sink += out[static_cast<std::size_t>(r) % num][static_cast<std::size_t>(r) % 16U] + pout[static_cast<std::size_t>(r) % num].x();
+            }
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+        };
+
+        const Cpu::ISA isas[] = { Cpu::ISA::SCALAR, Cpu::ISA::SSE2, Cpu::ISA::NEON, Cpu::ISA::AVX2 };
+        for (const Cpu::ISA isa : isas) {
+            if (!Cpu::force(isa)) {
+                continue;
+            }
+            const double mul = measure([&](const std::size_t i) { out[i] = general[i] * b; });
+            const double xform = measure([&](const std::size_t i) { pout[i] = general[i].transform(points[i]); });
+            const double inv = measure([&](const std::size_t i) { out[i] = general[i].inverse(); });
+            const double inv_affine = measure([&](const std::size_t i) { out[i] = affine[i].inverse(); });
+            const double lookat = measure([&](const std::size_t i) { out[i] = Matrix::lookat(points[i], points[(i + 1U) % num], { 0.0F, 1.0F, 0.0F }); });
+            std::cout << "* " << Cpu::name(isa) << " multiply:" << mul << "[nsec] transform:" << xform << "[nsec] inverse:" << inv << "[nsec] inverse(affine):" << inv_affine << "[nsec] lookat:" << lookat << "[nsec]" << std::endl;
+        }
+        Cpu::reset();
+
+        // 演算関数の組を使用しない行列の作成
+        const double translate = measure([&](const std::size_t i) { out[i] = Matrix::translate(points[i]); });
+        const double scale = measure([&](const std::size_t i) { out[i] = Matrix::scale(points[i]); });
+        const double rotate_x = measure([&](const std::size_t i) { out[i] = Matrix::rotate_x(angles[i]); });
+        const double rotate_y = measure([&](const std::size_t i) { out[i] = Matrix::rotate_y(angles[i]); });
+        const double rotate_z = measure([&](const std::size_t i) { out[i] = Matrix::rotate_z(angles[i]); });
+        const double rotate = measure([&](const std::size_t i) { out[i] = Matrix::rotate(angles[i], points[i]); });
+        const double ortho = measure([&](const std::size_t i) { out[i] = Matrix::orthogonal(-points[i].x(), points[i].x(), -points[i].y(), points[i].y(), 1.0F, 10.0F); });
+        std::cout << "* factory translate:" << translate << "[nsec] scale:" << scale << "[nsec] rotate_x:" << rotate_x << "[nsec] rotate_y:" << rotate_y << "[nsec] rotate_z:" << rotate_z << "[nsec] rotate:" << rotate << "[nsec] orthogonal:" << ortho << "[nsec] (" << sink << ")" << std::endl;
+    }
+
+    /**
+     * @brief GpuMatrixクラスのテストコードを実行
+     * 
+     * @par 詳細
+     *      格納順と乗算の規約を、シェーダーでの計算を模して通しで確認する。
+     */
+    bool testcode_GpuMatrix()
+    {
+        std::cout << "[testcode_GpuMatrix()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const std::string& name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+        const auto nearly = [](const Vector& a, const Vector& b) {
+            return (a - b).len2() <= 1.0e-8F;
+        };
+        // GLSLのmat4 * vec4（列優先の要素を列毎に読む）を模した変換
+        const auto glsl = [](const GpuMatrix& m, const Vector& v) {
+            const float* e = m.data();
+            const float in[4] = { v.x(), v.y(), v.z(), 1.0F };
+            float out[4] = { 0.0F, 0.0F, 0.0F, 0.0F };
+            for (std::size_t col = 0U; col < 4U; col++) {
+                for (std::size_t row = 0U; row < 4U; row++) {
+                    out[row] += e[(col * 4U) + row] * in[col];
+                }
+            }
+            return Vector(out[0] / out[3], out[1] / out[3], out[2] / out[3]);
+        };
+
+        // 格納順：GpuMatrixは行優先のMatrixの転置
+        const Matrix t = Matrix::rotate_z(30.0F) * Matrix::translate({ 10.0F, 20.0F, 30.0F });
+        const GpuMatrix g(t);
+        bool order = true;
+        for (std::size_t row = 0U; row < 4U; row++) {
+            for (std::size_t col = 0U; col < 4U; col++) {
+                order = order && !(g.at(row, col) < t[(row * 4U) + col]) && !(g.at(row, col) > t[(row * 4U) + col]);
+            }
+        }
+        check("storage order", order);
+        check("translation column", !(g.data()[12] < 10.0F) && !(g.data()[12] > 10.0F) && !(g.data()[14] < 30.0F) && !(g.data()[14] > 30.0F));
+        check("default identity", nearly(glsl(GpuMatrix(), { 1.0F, 2.0F, 3.0F }), { 1.0F, 2.0F, 3.0F }));
+
+        // 乗算の規約：A * Bは左側の行列の変換を先に行う
+        const Vector v(3.0F, -4.0F, 5.0F);
+        const Matrix a = Matrix::scale({ 2.0F, 3.0F, 1.0F });
+        const Matrix b = Matrix::translate({ 10.0F, 0.0F, 0.0F });
+        check("multiply order", nearly((a * b).transform(v), b.transform(a.transform(v))) && nearly((a * b).transform(v), { 16.0F, -12.0F, 5.0F }));
+
+        // シェーダーの projection * modelview * position が view * proj の変換と一致する
+        const Matrix view = Matrix::lookat({ 100.0F, 50.0F, 10.0F }, { 100.0F, 50.0F, 0.0F }, { 0.0F, 1.0F, 0.0F });
+        const Matrix proj = Matrix::orthogonal(-320.0F, 320.0F, -240.0F, 240.0F, 1.0F, 100.0F);
+        const GpuMatrix gpu_view(view);
+        const GpuMatrix gpu_proj(proj);
+        const Vector world(132.0F, 74.0F, 0.0F);
+        const Vector ndc = glsl(gpu_proj, glsl(gpu_view, world));
+        check("shader pipeline", nearly(ndc, (view * proj).transform(world)));
+        check("shader ndc", nearly(ndc, { 0.1F, 0.1F, -81.0F / 99.0F }));
+
+        // 逆変換（Picker::unprojectと同じ順序）で元の座標に戻る
+        check("unproject", nearly((view * proj).inverse().transform(ndc), world));
+
+        std::cout << "[testcode_GpuMatrix()] " << (ok ? "OK" : "NG") << std::endl;
+        return ok;
+    }
+}
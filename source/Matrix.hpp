@@ -11,10 +11,16 @@
 #define INCLUDED_MATRIX_HPP
 
 #include <array>
+#include <cstddef>
+#include <utility>
 
 namespace my {
     class Degree;
     class Radian;
+    class Vertex;
+
+    //! 円周率（角度の単位の変換で使用）
+    constexpr float MATRIX_PI = 3.14159265358979323846F;
 
     /**
      * @class Degree
@@ -25,16 +31,16 @@ namespace my {
         float   m_deg;  //!< 角度[度]
     public:
         //! デフォルトコンストラクタ
-        Degree();
+        constexpr Degree();
         //! コンストラクタ
-        Degree(const float deg);
+        constexpr Degree(const float deg);
         //! コンストラクタ
-        Degree(const Radian rad);
+        constexpr Degree(const Radian rad);
     public:
         //! 角度[度]の値を取得
-        float deg() const;
+        constexpr float deg() const;
         //! 角度[ラジアン]のインスタンスを取得
-        Radian radian() const;
+        constexpr Radian radian() const;
     };
 
     /**
@@ -46,19 +52,89 @@ namespace my {
         float   m_rad;  //!< 角度[ラジアン]
     public:
         //! デフォルトコンストラクタ
-        Radian();
+        constexpr Radian();
         //! コンストラクタ
-        Radian(const float rad);
+        constexpr Radian(const float rad);
         //! コンストラクタ
-        Radian(const Degree deg);
+        constexpr Radian(const Degree deg);
     public:
         //! 角度[ラジアン]の値を取得
-        float rad() const;
+        constexpr float rad() const;
         //! 角度[度]のインスタンスを取得
-        Degree degree() const;
+        constexpr Degree degree() const;
     };
 }
 
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    constexpr Degree::Degree() : m_deg(0.0F) {}
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] deg 角度[度]の値
+     */
+    constexpr Degree::Degree(const float deg) : m_deg(deg) {}
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] rad 角度[ラジアン]のインスタンス
+     */
+    constexpr Degree::Degree(const Radian rad) : m_deg(rad.degree().deg()) {}
+
+    /**
+     * @brief 角度[度]の値を取得
+     * 
+     * @return float 角度[度]の値
+     */
+    constexpr float Degree::deg() const { return this->m_deg; }
+
+    /**
+     * @brief 角度[ラジアン]のインスタンスを取得
+     * 
+     * @return Radian 角度[ラジアン]のインスタンス
+     */
+    constexpr Radian Degree::radian() const { return Radian(this->m_deg * MATRIX_PI / 180.0F); }
+
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    constexpr Radian::Radian() : m_rad(0.0F) {}
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] rad 角度[ラジアン]の値
+     */
+    constexpr Radian::Radian(const float rad) : m_rad(rad) {}
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] deg 角度[度]のインスタンス
+     */
+    constexpr Radian::Radian(const Degree deg) : m_rad(deg.radian().rad()) {}
+
+    /**
+     * @brief 角度[ラジアン]の値を取得
+     * 
+     * @return float 角度[ラジアン]の値
+     */
+    constexpr float Radian::rad() const { return this->m_rad; }
+
+    /**
+     * @brief 角度[度]のインスタンスを取得
+     * 
+     * @return Degree 角度[度]のインスタンス
+     */
+    constexpr Degree Radian::degree() const { return Degree(this->m_rad * 180.0F / MATRIX_PI); }
+}
+
 namespace my {
     /**
      * @class Vector
@@ -72,17 +148,17 @@ namespace my {
 
     public:
         //! デフォルトコンストラクタ
-        Vector();
+        constexpr Vector();
         //! コンストラクタ
-        Vector(const float x, const float y, const float z);
+        constexpr Vector(const float x, const float y, const float z);
 
     public:
         //! +演算子のオーバーロード
-        Vector operator+(const Vector& m) const;
+        constexpr Vector operator+(const Vector& m) const;
         //! -演算子のオーバーロード
-        Vector operator-(const Vector& m) const;
+        constexpr Vector operator-(const Vector& m) const;
         //! *演算子のオーバーロード
-        Vector operator*(const Vector& m) const;
+        constexpr Vector operator*(const Vector& m) const;
         //! +=演算子のオーバーロード
         Vector& operator+=(const Vector& m);
         //! -=演算子のオーバーロード
@@ -92,20 +168,104 @@ namespace my {
 
     public:
         //! X座標を取得
-        float x() const;
+        constexpr float x() const;
         //! Y座標を取得
-        float y() const;
+        constexpr float y() const;
         //! Z座標を取得
-        float z() const;
+        constexpr float z() const;
 
     public:
         //! ベクトルの長さを取得
         float len() const;
         //! ベクトルの長さの2乗を取得
-        float len2() const;
+        constexpr float len2() const;
     };
 }
 
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    constexpr Vector::Vector() :
+        m_x(0.0F), m_y(0.0F), m_z(0.0F)
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] x X座標
+     * @param [in] y Y座標
+     * @param [in] z Z座標
+     */
+    constexpr Vector::Vector(const float x, const float y, const float z) :
+        m_x(x), m_y(y), m_z(z)
+    {
+    }
+
+    /**
+     * @brief +演算子のオーバーロード
+     * 
+     * @param [in] v 加算するベクトル
+     * @return Vector 加算後のベクトル
+     */
+    constexpr Vector Vector::operator+(const Vector& v) const
+    {
+        return Vector(this->m_x + v.m_x, this->m_y + v.m_y, this->m_z + v.m_z);
+    }
+
+    /**
+     * @brief -演算子のオーバーロード
+     * 
+     * @param [in] v 減算するベクトル
+     * @return Vector 減算後のベクトル
+     */
+    constexpr Vector Vector::operator-(const Vector& v) const
+    {
+        return Vector(this->m_x - v.m_x, this->m_y - v.m_y, this->m_z - v.m_z);
+    }
+
+    /**
+     * @brief *演算子のオーバーロード
+     * 
+     * @param [in] v 乗算するベクトル
+     * @return Vector 乗算後のベクトル（外積ベクトル）
+     */
+    constexpr Vector Vector::operator*(const Vector& v) const
+    {
+        return Vector((this->m_y * v.m_z) - (this->m_z * v.m_y),
+                      (this->m_z * v.m_x) - (this->m_x * v.m_z),
+                      (this->m_x * v.m_y) - (this->m_y * v.m_x));
+    }
+
+    /**
+     * @brief X座標を取得
+     * 
+     * @return float X座標
+     */
+    constexpr float Vector::x() const { return this->m_x; }
+    /**
+     * @brief Y座標を取得
+     * 
+     * @return float Y座標
+     */
+    constexpr float Vector::y() const { return this->m_y; }
+    /**
+     * @brief Z座標を取得
+     * 
+     * @return float Z座標
+     */
+    constexpr float Vector::z() const { return this->m_z; }
+
+    /**
+     * @brief ベクトルの長さの2乗を取得
+     * 
+     * @return float ベクトルの長さの2乗
+     */
+    constexpr float Vector::len2() const { return (this->m_x * this->m_x) + (this->m_y * this->m_y) + (this->m_z * this->m_z); }
+}
+
 namespace my {
     /**
      * @class Matrix
@@ -122,13 +282,15 @@ namespace my {
     class Matrix : public std::array<float, 16> {
     public:
         //! デフォルトコンストラクタ
-        Matrix();
+        constexpr Matrix();
+        //! コンストラクタ
+        constexpr explicit Matrix(const std::array<float, 16>& a);
 
     public:
         //! +演算子のオーバーロード
-        Matrix operator+(const Matrix& m) const;
+        constexpr Matrix operator+(const Matrix& m) const;
         //! -演算子のオーバーロード
-        Matrix operator-(const Matrix& m) const;
+        constexpr Matrix operator-(const Matrix& m) const;
         //! *演算子のオーバーロード
         Matrix operator*(const Matrix& m) const;
         //! +=演算子のオーバーロード
@@ -141,14 +303,26 @@ namespace my {
     public:
         //! 転置
         void transpose();
+        //! 逆行列を取得
+        Matrix inverse() const;
+        //! アフィン変換の行列の逆行列を取得
+        Matrix inverseAffine() const;
+        //! アフィン変換の行列（最下行が(0 0 0 1)）か判定
+        constexpr bool isAffine() const;
+        //! 座標を変換
+        Vector transform(const Vector& v) const;
+        //! 座標の配列を変換
+        void transformPoints(const Vertex* in, Vertex* out, const std::size_t num, const std::size_t grain = 0U) const;
+        //! 座標の配列のXY座標を2次元のアフィン変換で変換
+        void transformPoints2D(const Vertex* in, Vertex* out, const std::size_t num, const std::size_t grain = 0U) const;
 
     public:
         //! 単位行列を作成
-        static Matrix identity();
+        static constexpr Matrix identity();
         //! (x,y,z)だけ平行移動する変換行列を作成
-        static Matrix translate(const Vector& v);
+        static constexpr Matrix translate(const Vector& v);
         //! (x,y,z)倍に拡大縮小する変換行列を作成
-        static Matrix scale(const Vector& v);
+        static constexpr Matrix scale(const Vector& v);
         //! X軸を中心にdegree度回転する変換行列を作成
         static Matrix rotate_x(const Degree degree);
         //! Y軸を中心にdegree度回転する変換行列を作成
@@ -164,13 +338,195 @@ namespace my {
 
     public:
         //! 直交投影変換行列を作成
-        static Matrix orthogonal(const float left, const float right, const float bottom, const float top, const float znear, const float zfar);
+        static constexpr Matrix orthogonal(const float left, const float right, const float bottom, const float top, const float znear, const float zfar);
+
+    private:
+        //! 要素毎の加算（index_sequenceで16要素を展開する）
+        template<std::size_t... I>
+        static constexpr Matrix add(const Matrix& a, const Matrix& b, const float sign, std::index_sequence<I...>);
+    };
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    constexpr Matrix::Matrix() :
+        std::array<float, 16>({{0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F}})
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] a 要素の配列（行優先）
+     */
+    constexpr Matrix::Matrix(const std::array<float, 16>& a) :
+        std::array<float, 16>(a)
+    {
+    }
+
+    /**
+     * @brief 要素毎の加算
+     * 
+     * @param [in] a 行列
+     * @param [in] b 加算する行列
+     * @param [in] sign bに乗じる符号（1:加算、-1:減算）
+     * @return Matrix 加算後の行列
+     */
+    template<std::size_t... I>
+    constexpr Matrix Matrix::add(const Matrix& a, const Matrix& b, const float sign, std::index_sequence<I...>)
+    {
+        return Matrix(std::array<float, 16>{{ (a[I] + (sign * b[I]))... }});
+    }
+
+    /**
+     * @brief +演算子のオーバーロード
+     * 
+     * @param [in] m 加算する行列
+     * @return Matrix 加算後の行列
+     */
+    constexpr Matrix Matrix::operator+(const Matrix& m) const
+    {
+        return Matrix::add(*this, m, 1.0F, std::make_index_sequence<16>());
+    }
+
+    /**
+     * @brief -演算子のオーバーロード
+     * 
+     * @param [in] m 減算する行列
+     * @return Matrix 減算後の行列
+     */
+    constexpr Matrix Matrix::operator-(const Matrix& m) const
+    {
+        return Matrix::add(*this, m, -1.0F, std::make_index_sequence<16>());
+    }
+
+    /**
+     * @brief アフィン変換の行列（最下行が(0 0 0 1)）か判定
+     * 
+     * @retval true アフィン変換の行列
+     * @retval false 射影変換を含む行列
+     */
+    constexpr bool Matrix::isAffine() const
+    {
+        const Matrix& m = *this;
+        return !((m[12] < 0.0F) || (m[12] > 0.0F) || (m[13] < 0.0F) || (m[13] > 0.0F) ||
+                 (m[14] < 0.0F) || (m[14] > 0.0F) || (m[15] < 1.0F) || (m[15] > 1.0F));
+    }
+
+    /**
+     * @brief 単位行列を作成
+     * 
+     * @return Matrix 単位行列
+     */
+    constexpr Matrix Matrix::identity()
+    {
+        return Matrix::scale(Vector(1.0F, 1.0F, 1.0F));
+    }
+
+    /**
+     * @brief (x,y,z)だけ平行移動する変換行列を作成
+     * 
+     * @param [in] v 移動量のベクトル
+     * 
+     * @return Matrix 平行移動する変換行列
+     */
+    constexpr Matrix Matrix::translate(const Vector& v)
+    {
+        return Matrix(std::array<float, 16>{{
+            1.0F, 0.0F, 0.0F, v.x(),
+            0.0F, 1.0F, 0.0F, v.y(),
+            0.0F, 0.0F, 1.0F, v.z(),
+            0.0F, 0.0F, 0.0F, 1.0F,
+        }});
+    }
+
+    /**
+     * @brief (x,y,z)倍に拡大縮小する変換行列を作成
+     * 
+     * @param [in] v 拡大縮小倍率のベクトル
+     * 
+     * @return Matrix 拡大縮小する変換行列
+     */
+    constexpr Matrix Matrix::scale(const Vector& v)
+    {
+        return Matrix(std::array<float, 16>{{
+            v.x(), 0.0F, 0.0F, 0.0F,
+            0.0F, v.y(), 0.0F, 0.0F,
+            0.0F, 0.0F, v.z(), 0.0F,
+            0.0F, 0.0F, 0.0F, 1.0F,
+        }});
+    }
+
+    /**
+     * @brief 直交投影変換行列を作成
+     * 
+     * @param [in] left 視体積の前方面の左の垂直座標
+     * @param [in] right 視体積の前方面の右の垂直座標
+     * @param [in] bottom 視体積の前方面の下の水平座標
+     * @param [in] top 視体積の前方面の上の水平座標
+     * @param [in] znear 視点から最も近い距離
+     * @param [in] zfar 視点から最も遠い距離
+     * 
+     * @return Matrix 直交投影変換行列（視体積の幅・高さ・奥行きのいずれかが0の場合は単位行列）
+     */
+    constexpr Matrix Matrix::orthogonal(const float left, const float right, const float bottom, const float top, const float znear, const float zfar)
+    {
+        const float dx = right - left;
+        const float dy = top - bottom;
+        const float dz = zfar - znear;
+        if (!(((dx < 0.0F) || (dx > 0.0F)) && ((dy < 0.0F) || (dy > 0.0F)) && ((dz < 0.0F) || (dz > 0.0F)))) {
+            return Matrix::identity();
+        }
+        return Matrix(std::array<float, 16>{{
+            2.0F / dx, 0.0F, 0.0F, -(right + left) / dx,
+            0.0F, 2.0F / dy, 0.0F, -(top + bottom) / dy,
+            0.0F, 0.0F, -2.0F / dz, -(zfar + znear) / dz,
+            0.0F, 0.0F, 0.0F, 1.0F,
+        }});
+    }
+}
+
+namespace my {
+    /**
+     * @class GpuMatrix
+     * @brief GPUへ転送する列優先の4x4行列
+     * 
+     * @par 詳細
+     *      Matrixは行優先で格納し、列ベクトルに左から乗じる（transform(v) = M・v）。
+     *      GLSLのmat4は列優先のため、生成時に1回だけ転置した要素を保持する。
+     *      data()はglUniformMatrix4fv(loc, 1, GL_FALSE, data())へそのまま渡せる。
+     *      [ 0] [ 4] [ 8] [12]
+     *      [ 1] [ 5] [ 9] [13]
+     *      [ 2] [ 6] [10] [14]
+     *      [ 3] [ 7] [11] [15]
+     */
+    class GpuMatrix {
+        std::array<float, 16>   m_m;    //!< 要素の配列（列優先）
+
+    public:
+        //! デフォルトコンストラクタ
+        GpuMatrix();
+        //! コンストラクタ
+        explicit GpuMatrix(const Matrix& m);
+
+    public:
+        //! 要素の配列（列優先）を取得
+        const float* data() const;
+        //! row行col列の要素を取得
+        float at(const std::size_t row, const std::size_t col) const;
     };
 }
 
 namespace my {
     //! Matrixクラスのテストコードを実行
     bool testcode_Matrix();
+    //! Matrixクラスの処理性能を計測
+    void benchcode_Matrix();
+    //! GpuMatrixクラスのテストコードを実行
+    bool testcode_GpuMatrix();
 }
 
 #endif //INCLUDED_MATRIX_HPP
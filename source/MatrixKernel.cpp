@@ -0,0 +1,1023 @@
+﻿/**
+ * @file MatrixKernel.cpp
+ * @author kota-kota
+ * @brief 4x4行列の演算を命令セット毎に実装した関数の実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "MatrixKernel.hpp"
+#include "Matrix.hpp"
+#include "Parallel.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    //! 行列の積（スカラー）
+    void multiplyScalar(const float* a, const float* b, float* out)
+    {
+        float t[16];
+        for (std::int32_t k = 0; k < 16; k += 4) {
+            for (std::int32_t j = 0; j < 4; j++) {
+                t[k + j] = (a[0 + j] * b[k + 0]) + (a[4 + j] * b[k + 1]) + (a[8 + j] * b[k + 2]) + (a[12 + j] * b[k + 3]);
+            }
+        }
+        std::copy(t, t + 16, out);
+    }
+
+    //! 行列とベクトルの積（スカラー）
+    void transformScalar(const float* m, const float* v, float* out)
+    {
+        float t[4];
+        for (std::int32_t i = 0; i < 4; i++) {
+            t[i] = (m[(i * 4) + 0] * v[0]) + (m[(i * 4) + 1] * v[1]) + (m[(i * 4) + 2] * v[2]) + (m[(i * 4) + 3] * v[3]);
+        }
+        std::copy(t, t + 4, out);
+    }
+
+    //! 転置（スカラー）
+    void transposeScalar(const float* m, float* out)
+    {
+        float t[16];
+        for (std::int32_t i = 0; i < 4; i++) {
+            for (std::int32_t j = 0; j < 4; j++) {
+                t[(j * 4) + i] = m[(i * 4) + j];
+            }
+        }
+        std::copy(t, t + 16, out);
+    }
+
+    //! 逆行列（スカラー：余因子行列を行列式で割る）
+    bool inverseScalar(const float* m, float* out)
+    {
+        float t[16];
+        t[ 0] =  m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+        t[ 4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+        t[ 8] =  m[4] * m[ 9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[ 9];
+        t[12] = -m[4] * m[ 9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[ 9];
+        t[ 1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+        t[ 5] =  m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+        t[ 9] = -m[0] * m[ 9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[ 9];
+        t[13] =  m[0] * m[ 9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[ 9];
+        t[ 2] =  m[1] * m[ 6] * m[15] - m[1] * m[ 7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[ 7] - m[13] * m[3] * m[ 6];
+        t[ 6] = -m[0] * m[ 6] * m[15] + m[0] * m[ 7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[ 7] + m[12] * m[3] * m[ 6];
+        t[10] =  m[0] * m[ 5] * m[15] - m[0] * m[ 7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[ 7] - m[12] * m[3] * m[ 5];
+        t[14] = -m[0] * m[ 5] * m[14] + m[0] * m[ 6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[ 6] + m[12] * m[2] * m[ 5];
+        t[ 3] = -m[1] * m[ 6] * m[11] + m[1] * m[ 7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[ 9] * m[2] * m[ 7] + m[ 9] * m[3] * m[ 6];
+        t[ 7] =  m[0] * m[ 6] * m[11] - m[0] * m[ 7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[ 8] * m[2] * m[ 7] - m[ 8] * m[3] * m[ 6];
+        t[11] = -m[0] * m[ 5] * m[11] + m[0] * m[ 7] * m[ 9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[ 9] - m[ 8] * m[1] * m[ 7] + m[ 8] * m[3] * m[ 5];
+        t[15] =  m[0] * m[ 5] * m[10] - m[0] * m[ 6] * m[ 9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[ 9] + m[ 8] * m[1] * m[ 6] - m[ 8] * m[2] * m[ 5];
+
+        const float det = m[0] * t[0] + m[1] * t[4] + m[2] * t[8] + m[3] * t[12];
+        if (!(std::fabs(det) > 0.0F)) {
+            return false;
+        }
+        const float rdet = 1.0F / det;
+        for (std::int32_t i = 0; i < 16; i++) {
+            out[i] = t[i] * rdet;
+        }
+        return true;
+    }
+
+    //! アフィン変換の行列の逆行列（スカラー：左上3x3の逆行列の列を行の外積から求める）
+    bool inverseAffineScalar(const float* m, float* out)
+    {
+        // 左上3x3の行r0 r1 r2に対し、逆行列の第j列は (r1×r2, r2×r0, r0×r1)[j] / det
+        const float c0x = (m[5] * m[10]) - (m[6] * m[9]);
+        const float c0y = (m[6] * m[8]) - (m[4] * m[10]);
+        const float c0z = (m[4] * m[9]) - (m[5] * m[8]);
+        const float c1x = (m[9] * m[2]) - (m[10] * m[1]);
+        const float c1y = (m[10] * m[0]) - (m[8] * m[2]);
+        const float c1z = (m[8] * m[1]) - (m[9] * m[0]);
+        const float c2x = (m[1] * m[6]) - (m[2] * m[5]);
+        const float c2y = (m[2] * m[4]) - (m[0] * m[6]);
+        const float c2z = (m[0] * m[5]) - (m[1] * m[4]);
+        const float det = (m[0] * c0x) + (m[1] * c0y) + (m[2] * c0z);
+        if (!(std::fabs(det) > 0.0F)) {
+            return false;
+        }
+        const float rdet = 1.0F / det;
+        const float tx = m[3], ty = m[7], tz = m[11];
+        out[ 0] = c0x * rdet; out[ 1] = c1x * rdet; out[ 2] = c2x * rdet; out[ 3] = -((c0x * tx) + (c1x * ty) + (c2x * tz)) * rdet;
+        out[ 4] = c0y * rdet; out[ 5] = c1y * rdet; out[ 6] = c2y * rdet; out[ 7] = -((c0y * tx) + (c1y * ty) + (c2y * tz)) * rdet;
+        out[ 8] = c0z * rdet; out[ 9] = c1z * rdet; out[10] = c2z * rdet; out[11] = -((c0z * tx) + (c1z * ty) + (c2z * tz)) * rdet;
+        out[12] = 0.0F; out[13] = 0.0F; out[14] = 0.0F; out[15] = 1.0F;
+        return true;
+    }
+
+    //! 座標の配列の変換（スカラー）
+    void pointsScalar(const float* m, const float* in, float* out, const std::size_t num)
+    {
+        for (std::size_t i = 0U; i < (num * 3U); i += 3U) {
+            const float x = in[i + 0U], y = in[i + 1U], z = in[i + 2U];
+            float ox = (m[0] * x) + (m[1] * y) + (m[2] * z) + m[3];
+            float oy = (m[4] * x) + (m[5] * y) + (m[6] * z) + m[7];
+            float oz = (m[8] * x) + (m[9] * y) + (m[10] * z) + m[11];
+            const float w = (m[12] * x) + (m[13] * y) + (m[14] * z) + m[15];
+            if (std::fabs(w) > 0.0F) {
+                ox /= w; oy /= w; oz /= w;
+            }
+            out[i + 0U] = ox; out[i + 1U] = oy; out[i + 2U] = oz;
+        }
+    }
+
+    //! XY座標の配列の2次元アフィン変換（スカラー）
+    void points2DScalar(const float* m, const float* in, float* out, const std::size_t num)
+    {
+        for (std::size_t i = 0U; i < (num * 3U); i += 3U) {
+            const float x = in[i + 0U], y = in[i + 1U];
+            out[i + 0U] = (m[0] * x) + (m[1] * y) + m[3];
+            out[i + 1U] = (m[4] * x) + (m[5] * y) + m[7];
+            out[i + 2U] = in[i + 2U];
+        }
+    }
+
+    //! スカラーの演算関数の組
+    const my::MatrixKernel KERNEL_SCALAR = { my::Cpu::ISA::SCALAR, multiplyScalar, transformScalar, transposeScalar, inverseScalar, inverseAffineScalar, pointsScalar, points2DScalar };
+
+#if defined(MY_SIMD_SSE2)
+    //! 4行を転置（r0..r3の第i要素を第i行に並べ替える）
+    inline void transpose4(__m128& r0, __m128& r1, __m128& r2, __m128& r3)
+    {
+        const __m128 t0 = _mm_unpacklo_ps(r0, r1);
+        const __m128 t1 = _mm_unpacklo_ps(r2, r3);
+        const __m128 t2 = _mm_unpackhi_ps(r0, r1);
+        const __m128 t3 = _mm_unpackhi_ps(r2, r3);
+        r0 = _mm_movelh_ps(t0, t1);
+        r1 = _mm_movehl_ps(t1, t0);
+        r2 = _mm_movelh_ps(t2, t3);
+        r3 = _mm_movehl_ps(t3, t2);
+    }
+
+    //! 行列の積（SSE2：出力の1行をaの4行の線形結合として計算する）
+    void multiplySse2(const float* a, const float* b, float* out)
+    {
+        const __m128 a0 = _mm_loadu_ps(a + 0);
+        const __m128 a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8);
+        const __m128 a3 = _mm_loadu_ps(a + 12);
+        for (std::int32_t k = 0; k < 4; k++) {
+            const __m128 bk = _mm_loadu_ps(b + (k * 4));
+            const __m128 r01 = _mm_add_ps(_mm_mul_ps(a0, _mm_shuffle_ps(bk, bk, 0x00)), _mm_mul_ps(a1, _mm_shuffle_ps(bk, bk, 0x55)));
+            const __m128 r23 = _mm_add_ps(_mm_mul_ps(a2, _mm_shuffle_ps(bk, bk, 0xAA)), _mm_mul_ps(a3, _mm_shuffle_ps(bk, bk, 0xFF)));
+            // bの第k行は読み込み済みのため、出力先がbでも書き込んでよい
+            _mm_storeu_ps(out + (k * 4), _mm_add_ps(r01, r23));
+        }
+    }
+
+    //! 転置（SSE2）
+    void transposeSse2(const float* m, float* out)
+    {
+        __m128 r0 = _mm_loadu_ps(m + 0);
+        __m128 r1 = _mm_loadu_ps(m + 4);
+        __m128 r2 = _mm_loadu_ps(m + 8);
+        __m128 r3 = _mm_loadu_ps(m + 12);
+        transpose4(r0, r1, r2, r3);
+        _mm_storeu_ps(out + 0, r0);
+        _mm_storeu_ps(out + 4, r1);
+        _mm_storeu_ps(out + 8, r2);
+        _mm_storeu_ps(out + 12, r3);
+    }
+
+    //! 4要素の並べ替え（_MM_SHUFFLEと同じく、第1引数が出力の第3要素）
+    template<std::int32_t W, std::int32_t Z, std::int32_t Y, std::int32_t X>
+    inline __m128 swizzle(const __m128 v)
+    {
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+    }
+
+    //! 2x2行列（[a b; c d]を4要素で表現）の積 A * B
+    inline __m128 mat2Mul(const __m128 a, const __m128 b)
+    {
+        return _mm_add_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(swizzle<2, 3, 0, 1>(a), swizzle<1, 2, 1, 2>(b)));
+    }
+
+    //! 2x2行列の余因子行列との積 adj(A) * B
+    inline __m128 mat2AdjMul(const __m128 a, const __m128 b)
+    {
+        return _mm_sub_ps(_mm_mul_ps(swizzle<0, 0, 3, 3>(a), b), _mm_mul_ps(swizzle<2, 2, 1, 1>(a), swizzle<1, 0, 3, 2>(b)));
+    }
+
+    //! 2x2行列と余因子行列の積 A * adj(B)
+    inline __m128 mat2MulAdj(const __m128 a, const __m128 b)
+    {
+        return _mm_sub_ps(_mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(swizzle<2, 3, 0, 1>(a), swizzle<1, 2, 1, 2>(b)));
+    }
+
+    //! 逆行列（SSE2：2x2の小行列A B C Dに分け、小行列の余因子行列から逆行列の小行列を求める）
+    bool inverseSse2(const float* m, float* out)
+    {
+        const __m128 r0 = _mm_loadu_ps(m + 0);
+        const __m128 r1 = _mm_loadu_ps(m + 4);
+        const __m128 r2 = _mm_loadu_ps(m + 8);
+        const __m128 r3 = _mm_loadu_ps(m + 12);
+        // 小行列 M = [A B; C D]
+        const __m128 a = _mm_movelh_ps(r0, r1);
+        const __m128 b = _mm_movehl_ps(r1, r0);
+        const __m128 c = _mm_movelh_ps(r2, r3);
+        const __m128 d = _mm_movehl_ps(r3, r2);
+        // 小行列の行列式 (|A| |B| |C| |D|)
+        const __m128 det_sub = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+        const __m128 det_a = swizzle<0, 0, 0, 0>(det_sub);
+        const __m128 det_b = swizzle<1, 1, 1, 1>(det_sub);
+        const __m128 det_c = swizzle<2, 2, 2, 2>(det_sub);
+        const __m128 det_d = swizzle<3, 3, 3, 3>(det_sub);
+
+        // 逆行列 = 1/|M| * [adj(X) adj(Y); adj(Z) adj(W)]
+        const __m128 dc = mat2AdjMul(d, c);
+        const __m128 ab = mat2AdjMul(a, b);
+        __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2Mul(b, dc));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2Mul(c, ab));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2MulAdj(d, ab));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2MulAdj(a, dc));
+
+        // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+        __m128 tr = _mm_mul_ps(ab, swizzle<3, 1, 2, 0>(dc));
+        tr = _mm_add_ps(tr, swizzle<2, 3, 0, 1>(tr));
+        tr = _mm_add_ps(tr, swizzle<1, 0, 3, 2>(tr));
+        const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), tr);
+        if (!(std::fabs(_mm_cvtss_f32(det)) > 0.0F)) {
+            return false;
+        }
+        // 余因子行列の符号 (+ - - +) を含めて行列式で割る
+        const __m128 rdet = _mm_div_ps(_mm_setr_ps(1.0F, -1.0F, -1.0F, 1.0F), det);
+        x = _mm_mul_ps(x, rdet);
+        y = _mm_mul_ps(y, rdet);
+        z = _mm_mul_ps(z, rdet);
+        w = _mm_mul_ps(w, rdet);
+
+        // 余因子行列への並べ替えと小行列の結合をまとめて行う
+        _mm_storeu_ps(out + 0, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+        return true;
+    }
+
+    //! 3次元の外積（第3要素は0となる）
+    inline __m128 cross3(const __m128 a, const __m128 b)
+    {
+        return _mm_sub_ps(_mm_mul_ps(swizzle<3, 0, 2, 1>(a), swizzle<3, 1, 0, 2>(b)), _mm_mul_ps(swizzle<3, 1, 0, 2>(a), swizzle<3, 0, 2, 1>(b)));
+    }
+
+    //! アフィン変換の行列の逆行列（SSE2：外積で求めた列と移動量を転置して逆行列の行とする）
+    bool inverseAffineSse2(const float* m, float* out)
+    {
+        const __m128 r0 = _mm_loadu_ps(m + 0);
+        const __m128 r1 = _mm_loadu_ps(m + 4);
+        const __m128 r2 = _mm_loadu_ps(m + 8);
+        // 左上3x3の逆行列の列（行列式を掛けた値）
+        __m128 c0 = cross3(r1, r2);
+        __m128 c1 = cross3(r2, r0);
+        __m128 c2 = cross3(r0, r1);
+        const float det = _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(_mm_mul_ss(r0, c0), _mm_mul_ss(swizzle<1, 1, 1, 1>(r0), swizzle<1, 1, 1, 1>(c0))), _mm_mul_ss(swizzle<2, 2, 2, 2>(r0), swizzle<2, 2, 2, 2>(c0))));
+        if (!(std::fabs(det) > 0.0F)) {
+            return false;
+        }
+        // 移動量 -(c0 * tx + c1 * ty + c2 * tz)
+        const __m128 zero = _mm_setzero_ps();
+        __m128 t = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, swizzle<3, 3, 3, 3>(r0)), _mm_mul_ps(c1, swizzle<3, 3, 3, 3>(r1))), _mm_mul_ps(c2, swizzle<3, 3, 3, 3>(r2))));
+        // 列(c0 c1 c2 t)を転置すると逆行列の行となる
+        transpose4(c0, c1, c2, t);
+        const __m128 rdet = _mm_set1_ps(1.0F / det);
+        _mm_storeu_ps(out + 0, _mm_mul_ps(c0, rdet));
+        _mm_storeu_ps(out + 4, _mm_mul_ps(c1, rdet));
+        _mm_storeu_ps(out + 8, _mm_mul_ps(c2, rdet));
+        _mm_storeu_ps(out + 12, _mm_setr_ps(0.0F, 0.0F, 0.0F, 1.0F));
+        return true;
+    }
+
+    //! 座標4個（XYZの並び12要素）を読み込み、軸毎の4要素に並べ替える
+    inline void loadPoints4(const float* p, __m128& x, __m128& y, __m128& z)
+    {
+        const __m128 a = _mm_loadu_ps(p + 0);   // x0 y0 z0 x1
+        const __m128 b = _mm_loadu_ps(p + 4);   // y1 z1 x2 y2
+        const __m128 c = _mm_loadu_ps(p + 8);   // z2 x3 y3 z3
+        const __m128 bc = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2));    // x2 y2 z2 x3
+        const __m128 ab = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 2, 1));    // y0 z0 y1 y1
+        const __m128 bc2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 0, 3, 1));   // z1 y2 z2 y3
+        const __m128 ab2 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));   // z0 z0 z1 z1
+        x = _mm_shuffle_ps(a, bc, _MM_SHUFFLE(3, 0, 3, 0));
+        y = _mm_shuffle_ps(ab, bc2, _MM_SHUFFLE(3, 1, 2, 0));
+        z = _mm_shuffle_ps(ab2, c, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    //! 軸毎の4要素を座標4個（XYZの並び12要素）に並べ替えて書き込む
+    inline void storePoints4(float* p, const __m128 x, const __m128 y, const __m128 z)
+    {
+        const __m128 xy0 = _mm_unpacklo_ps(x, y);                           // x0 y0 x1 y1
+        const __m128 xy1 = _mm_unpackhi_ps(x, y);                           // x2 y2 x3 y3
+        const __m128 zx0 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));   // z0 z0 x1 x1
+        const __m128 yz0 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(2, 1, 2, 1));   // y1 y2 z1 z2
+        const __m128 zx1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));   // z2 z2 x3 x3
+        const __m128 yz1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));   // y3 y3 z3 z3
+        _mm_storeu_ps(p + 0, _mm_shuffle_ps(xy0, zx0, _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(p + 4, _mm_shuffle_ps(yz0, xy1, _MM_SHUFFLE(1, 0, 2, 0)));
+        _mm_storeu_ps(p + 8, _mm_shuffle_ps(zx1, yz1, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    //! 行列の1行と軸毎の4要素の積
+    inline __m128 dotRow4(const float* r, const __m128 x, const __m128 y, const __m128 z)
+    {
+        const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(r[0]), x), _mm_mul_ps(_mm_set1_ps(r[1]), y));
+        return _mm_add_ps(xy, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(r[2]), z), _mm_set1_ps(r[3])));
+    }
+
+    /**
+     * @brief 座標の配列の変換（SSE2）
+     * 
+     * @par 詳細
+     *      座標4個毎に軸毎の4要素（SoA）に並べ替え、4個を同時に変換する。端数はスカラーで変換する。
+     *      wが0の要素は1で割る（スカラーと同じくwで割らない）。
+     */
+    void pointsSse2(const float* m, const float* in, float* out, const std::size_t num)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0F);
+        std::size_t i = 0U;
+        for (; (i + 4U) <= num; i += 4U) {
+            __m128 x, y, z;
+            loadPoints4(in + (i * 3U), x, y, z);
+            const __m128 w = dotRow4(m + 12, x, y, z);
+            const __m128 nz = _mm_cmpneq_ps(w, zero);
+            const __m128 rw = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(nz, w), _mm_andnot_ps(nz, one)));
+            storePoints4(out + (i * 3U), _mm_mul_ps(dotRow4(m + 0, x, y, z), rw), _mm_mul_ps(dotRow4(m + 4, x, y, z), rw), _mm_mul_ps(dotRow4(m + 8, x, y, z), rw));
+        }
+        pointsScalar(m, in + (i * 3U), out + (i * 3U), num - i);
+    }
+
+    //! XY座標の配列の2次元アフィン変換（SSE2：座標4個毎に軸毎の4要素に並べ替えて変換する）
+    void points2DSse2(const float* m, const float* in, float* out, const std::size_t num)
+    {
+        const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m3 = _mm_set1_ps(m[3]);
+        const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m7 = _mm_set1_ps(m[7]);
+        std::size_t i = 0U;
+        for (; (i + 4U) <= num; i += 4U) {
+            __m128 x, y, z;
+            loadPoints4(in + (i * 3U), x, y, z);
+            const __m128 ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), m3);
+            const __m128 oy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m4, x), _mm_mul_ps(m5, y)), m7);
+            storePoints4(out + (i * 3U), ox, oy, z);
+        }
+        points2DScalar(m, in + (i * 3U), out + (i * 3U), num - i);
+    }
+
+    //! SSE2の演算関数の組
+    const my::MatrixKernel KERNEL_SSE2 = { my::Cpu::ISA::SSE2, multiplySse2, transformScalar, transposeSse2, inverseSse2, inverseAffineSse2, pointsSse2, points2DSse2 };
+#endif
+
+#if defined(MY_SIMD_AVX2)
+    /**
+     * @brief 行列の積（AVX2+FMA）
+     * 
+     * @par 詳細
+     *      aの各行を256bitの上下に複製し、bの2行分（8要素）からレーン内で要素を複製して、出力の2行を同時に計算する。
+     */
+    MY_TARGET_AVX2 void multiplyAvx2(const float* a, const float* b, float* out)
+    {
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 0));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+        const __m256 b01 = _mm256_loadu_ps(b + 0);
+        const __m256 b23 = _mm256_loadu_ps(b + 8);
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+        r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+        r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+        r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xAA), r01);
+        r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xAA), r23);
+        r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xFF), r01);
+        r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xFF), r23);
+        _mm256_storeu_ps(out + 0, r01);
+        _mm256_storeu_ps(out + 8, r23);
+    }
+
+    //! 座標8個を読み込み、軸毎の8要素に並べ替える
+    MY_TARGET_AVX2 inline void loadPoints8(const float* p, __m256& x, __m256& y, __m256& z)
+    {
+        __m128 x0, y0, z0, x1, y1, z1;
+        loadPoints4(p + 0, x0, y0, z0);
+        loadPoints4(p + 12, x1, y1, z1);
+        x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+        y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+        z = _mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1);
+    }
+
+    //! 軸毎の8要素を座標8個に並べ替えて書き込む
+    MY_TARGET_AVX2 inline void storePoints8(float* p, const __m256 x, const __m256 y, const __m256 z)
+    {
+        storePoints4(p + 0, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+        storePoints4(p + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+    }
+
+    //! 行列の1行と軸毎の8要素の積
+    MY_TARGET_AVX2 inline __m256 dotRow8(const float* r, const __m256 x, const __m256 y, const __m256 z)
+    {
+        const __m256 t = _mm256_fmadd_ps(_mm256_set1_ps(r[2]), z, _mm256_set1_ps(r[3]));
+        return _mm256_fmadd_ps(_mm256_set1_ps(r[0]), x, _mm256_fmadd_ps(_mm256_set1_ps(r[1]), y, t));
+    }
+
+    //! 座標の配列の変換（AVX2+FMA：座標8個毎に変換し、端数はSSE2で変換する）
+    MY_TARGET_AVX2 void pointsAvx2(const float* m, const float* in, float* out, const std::size_t num)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0F);
+        std::size_t i = 0U;
+        for (; (i + 8U) <= num; i += 8U) {
+            __m256 x, y, z;
+            loadPoints8(in + (i * 3U), x, y, z);
+            const __m256 w = dotRow8(m + 12, x, y, z);
+            const __m256 rw = _mm256_div_ps(one, _mm256_blendv_ps(one, w, _mm256_cmp_ps(w, zero, _CMP_NEQ_OQ)));
+            storePoints8(out + (i * 3U), _mm256_mul_ps(dotRow8(m + 0, x, y, z), rw), _mm256_mul_ps(dotRow8(m + 4, x, y, z), rw), _mm256_mul_ps(dotRow8(m + 8, x, y, z), rw));
+        }
+        pointsSse2(m, in + (i * 3U), out + (i * 3U), num - i);
+    }
+
+    //! XY座標の配列の2次元アフィン変換（AVX2+FMA：座標8個毎に変換し、端数はSSE2で変換する）
+    MY_TARGET_AVX2 void points2DAvx2(const float* m, const float* in, float* out, const std::size_t num)
+    {
+        const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m3 = _mm256_set1_ps(m[3]);
+        const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m7 = _mm256_set1_ps(m[7]);
+        std::size_t i = 0U;
+        for (; (i + 8U) <= num; i += 8U) {
+            __m256 x, y, z;
+            loadPoints8(in + (i * 3U), x, y, z);
+            const __m256 ox = _mm256_fmadd_ps(m0, x, _mm256_fmadd_ps(m1, y, m3));
+            const __m256 oy = _mm256_fmadd_ps(m4, x, _mm256_fmadd_ps(m5, y, m7));
+            storePoints8(out + (i * 3U), ox, oy, z);
+        }
+        points2DSse2(m, in + (i * 3U), out + (i * 3U), num - i);
+    }
+
+    //! AVX2の演算関数の組（行列とベクトルの積・転置・逆行列は128bitで足りるためSSE2と共通）
+    const my::MatrixKernel KERNEL_AVX2 = { my::Cpu::ISA::AVX2, multiplyAvx2, transformScalar, transposeSse2, inverseSse2, inverseAffineSse2, pointsAvx2, points2DAvx2 };
+#endif
+
+#if defined(MY_SIMD_NEON)
+    //! 行列の積（NEON：出力の1行をaの4行の線形結合として計算する）
+    void multiplyNeon(const float* a, const float* b, float* out)
+    {
+        const float32x4_t a0 = vld1q_f32(a + 0);
+        const float32x4_t a1 = vld1q_f32(a + 4);
+        const float32x4_t a2 = vld1q_f32(a + 8);
+        const float32x4_t a3 = vld1q_f32(a + 12);
+        float32x4_t r[4];
+        for (std::int32_t k = 0; k < 4; k++) {
+            const float32x4_t bk = vld1q_f32(b + (k * 4));
+            float32x4_t t = vmulq_laneq_f32(a0, bk, 0);
+            t = vfmaq_laneq_f32(t, a1, bk, 1);
+            t = vfmaq_laneq_f32(t, a2, bk, 2);
+            r[k] = vfmaq_laneq_f32(t, a3, bk, 3);
+        }
+        for (std::int32_t k = 0; k < 4; k++) {
+            vst1q_f32(out + (k * 4), r[k]);
+        }
+    }
+
+    //! 転置（NEON：4要素おきの読み込みで列を取り出す）
+    void transposeNeon(const float* m, float* out)
+    {
+        const float32x4x4_t t = vld4q_f32(m);
+        vst1q_f32(out + 0, t.val[0]);
+        vst1q_f32(out + 4, t.val[1]);
+        vst1q_f32(out + 8, t.val[2]);
+        vst1q_f32(out + 12, t.val[3]);
+    }
+
+    //! 行列の1行と軸毎の4要素の積
+    inline float32x4_t dotRowNeon(const float* r, const float32x4_t x, const float32x4_t y, const float32x4_t z)
+    {
+        const float32x4_t t = vfmaq_n_f32(vdupq_n_f32(r[3]), z, r[2]);
+        return vfmaq_n_f32(vfmaq_n_f32(t, y, r[1]), x, r[0]);
+    }
+
+    //! 座標の配列の変換（NEON：3要素おきの読み込みで座標4個を軸毎の4要素に並べ替えて変換する）
+    void pointsNeon(const float* m, const float* in, float* out, const std::size_t num)
+    {
+        const float32x4_t one = vdupq_n_f32(1.0F);
+        std::size_t i = 0U;
+        for (; (i + 4U) <= num; i += 4U) {
+            const float32x4x3_t p = vld3q_f32(in + (i * 3U));
+            const float32x4_t w = dotRowNeon(m + 12, p.val[0], p.val[1], p.val[2]);
+            const float32x4_t rw = vdivq_f32(one, vbslq_f32(vceqzq_f32(w), one, w));
+            float32x4x3_t o;
+            o.val[0] = vmulq_f32(dotRowNeon(m + 0, p.val[0], p.val[1], p.val[2]), rw);
+            o.val[1] = vmulq_f32(dotRowNeon(m + 4, p.val[0], p.val[1], p.val[2]), rw);
+            o.val[2] = vmulq_f32(dotRowNeon(m + 8, p.val[0], p.val[1], p.val[2]), rw);
+            vst3q_f32(out + (i * 3U), o);
+        }
+        pointsScalar(m, in + (i * 3U), out + (i * 3U), num - i);
+    }
+
+    //! XY座標の配列の2次元アフィン変換（NEON）
+    void points2DNeon(const float* m, const float* in, float* out, const std::size_t num)
+    {
+        std::size_t i = 0U;
+        for (; (i + 4U) <= num; i += 4U) {
+            float32x4x3_t p = vld3q_f32(in + (i * 3U));
+            const float32x4_t ox = vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(m[3]), p.val[1], m[1]), p.val[0], m[0]);
+            const float32x4_t oy = vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(m[7]), p.val[1], m[5]), p.val[0], m[4]);
+            p.val[0] = ox;
+            p.val[1] = oy;
+            vst3q_f32(out + (i * 3U), p);
+        }
+        points2DScalar(m, in + (i * 3U), out + (i * 3U), num - i);
+    }
+
+    //! NEONの演算関数の組（逆行列・アフィン変換の行列の逆行列はスカラーと共通）
+    const my::MatrixKernel KERNEL_NEON = { my::Cpu::ISA::NEON, multiplyNeon, transformScalar, transposeNeon, inverseScalar, inverseAffineScalar, pointsNeon, points2DNeon };
+#endif
+}
+
+namespace my {
+    /**
+     * @brief 使用する命令セット（Cpu::isa()）の演算関数の組を取得
+     * 
+     * @return const MatrixKernel& 演算関数の組
+     */
+    const MatrixKernel& MatrixKernel::get()
+    {
+        return MatrixKernel::get(Cpu::isa());
+    }
+
+    /**
+     * @brief 命令セットの演算関数の組を取得
+     * 
+     * @param [in] isa 命令セット
+     * 
+     * @return const MatrixKernel& 演算関数の組（実行中のCPUが対応していない場合はSCALAR）
+     */
+    const MatrixKernel& MatrixKernel::get(const Cpu::ISA isa)
+    {
+        if (!Cpu::supports(isa)) {
+            return KERNEL_SCALAR;
+        }
+        switch (isa) {
+        case Cpu::ISA::SSE2:
+#if defined(MY_SIMD_SSE2)
+            return KERNEL_SSE2;
+#else
+            return KERNEL_SCALAR;
+#endif
+        case Cpu::ISA::AVX2:
+#if defined(MY_SIMD_AVX2)
+            return KERNEL_AVX2;
+#else
+            return KERNEL_SCALAR;
+#endif
+        case Cpu::ISA::NEON:
+#if defined(MY_SIMD_NEON)
+            return KERNEL_NEON;
+#else
+            return KERNEL_SCALAR;
+#endif
+        case Cpu::ISA::SCALAR:
+        default:
+            return KERNEL_SCALAR;
+        }
+    }
+}
+
+namespace {
+    //! 逆行列の許容誤差（倍精度の逆行列に対する相対誤差を条件数で割った値）
+    const double INVERSE_EPS = 4.0e-7;
+
+    //! テスト・性能計測用の[-2,2)の乱数の行列
+    void randomMatrix(std::uint32_t& seed, float* m)
+    {
+        for (std::int32_t i = 0; i < 16; i++) {
+            seed = (seed * 1664525U) + 1013904223U;
+            m[i] = (static_cast<float>(seed >> 8) / 4194304.0F) - 2.0F;
+        }
+    }
+
+    //! テスト・性能計測用の透視変換の行列（wが[3,5)となるよう最下行を調整する）
+    void randomProjection(std::uint32_t& seed, float* m)
+    {
+        randomMatrix(seed, m);
+        m[12] *= 0.1F; m[13] *= 0.1F; m[14] *= 0.1F; m[15] = 4.0F;
+    }
+
+    //! テスト・性能計測用の[-2,2)の乱数の座標（XYZの並び）
+    std::vector<float> randomPoints(std::uint32_t& seed, const std::size_t num)
+    {
+        std::vector<float> p(num * 3U);
+        for (float& v : p) {
+            seed = (seed * 1664525U) + 1013904223U;
+            v = (static_cast<float>(seed >> 8) / 4194304.0F) - 2.0F;
+        }
+        return p;
+    }
+
+    //! テスト用の倍精度の逆行列（部分ピボット選択付きのGauss-Jordan法、逆行列がない場合はfalse）
+    bool inverseDouble(const float* m, double* out)
+    {
+        double a[4][8];
+        for (std::int32_t i = 0; i < 4; i++) {
+            for (std::int32_t j = 0; j < 4; j++) {
+                a[i][j] = static_cast<double>(m[(i * 4) + j]);
+                a[i][j + 4] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+        for (std::int32_t c = 0; c < 4; c++) {
+            std::int32_t p = c;
+            for (std::int32_t r = c + 1; r < 4; r++) {
+                if (std::fabs(a[r][c]) > std::fabs(a[p][c])) {
+                    p = r;
+                }
+            }
+            if (!(std::fabs(a[p][c]) > 0.0)) {
+                return false;
+            }
+            std::swap(a[c], a[p]);
+            const double d = a[c][c];
+            for (double& v : a[c]) {
+                v /= d;
+            }
+            for (std::int32_t r = 0; r < 4; r++) {
+                if (r == c) {
+                    continue;
+                }
+                const double f = a[r][c];
+                for (std::int32_t j = 0; j < 8; j++) {
+                    a[r][j] -= f * a[c][j];
+                }
+            }
+        }
+        for (std::int32_t i = 0; i < 4; i++) {
+            for (std::int32_t j = 0; j < 4; j++) {
+                out[(i * 4) + j] = a[i][j + 4];
+            }
+        }
+        return true;
+    }
+
+    //! 行列の最大値ノルム（行の絶対値の和の最大値）
+    template<typename T>
+    double normInf(const T* m)
+    {
+        double n = 0.0;
+        for (std::int32_t i = 0; i < 4; i++) {
+            double r = 0.0;
+            for (std::int32_t j = 0; j < 4; j++) {
+                r += std::fabs(static_cast<double>(m[(i * 4) + j]));
+            }
+            n = std::max(n, r);
+        }
+        return n;
+    }
+
+    //! 逆行列の倍精度の逆行列に対する相対誤差（条件数で割った値、逆行列がない場合は0）
+    double inverseError(const float* m, const float* inv)
+    {
+        double ref[16];
+        if (!inverseDouble(m, ref)) {
+            return 0.0;
+        }
+        double err = 0.0;
+        for (std::int32_t i = 0; i < 16; i++) {
+            err = std::max(err, std::fabs(static_cast<double>(inv[i]) - ref[i]));
+        }
+        const double ref_norm = normInf(ref);
+        return err / ref_norm / (normInf(m) * ref_norm);
+    }
+
+    //! 配列の要素が許容誤差以内で一致するか判定
+    bool nearly(const float* a, const float* b, const std::size_t num, const float eps)
+    {
+        for (std::size_t i = 0U; i < num; i++) {
+            if (!(std::fabs(a[i] - b[i]) <= eps)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace my {
+    /**
+     * @brief MatrixKernelのテストコードを実行
+     * 
+     * @par 詳細
+     *      実行中のCPUが対応する命令セット毎に、乱数の行列の演算結果をSCALARと比較する。
+     *      加算の順序・FMAの有無で丸め誤差が異なるため、許容誤差以内であれば一致とする。
+     *      出力先を入力と同じ配列とした場合も確認する。
+     */
+    bool testcode_MatrixKernel()
+    {
+        std::cout << "[testcode_MatrixKernel()] call detect:" << Cpu::name(Cpu::detect()) << std::endl;
+        bool ok = true;
+        const auto check = [&](const std::string& name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+        const float eps = 1.0e-4F;
+
+        // 逆行列（SCALAR）は倍精度の逆行列と一致し、逆行列がない場合はfalseを返して出力を変更しない
+        {
+            std::uint32_t seed = 5U;
+            bool inv = true;
+            bool affine = true;
+            for (std::int32_t n = 0; n < 1000; n++) {
+                float m[16], out[16];
+                randomMatrix(seed, m);
+                inv = inv && inverseScalar(m, out) && (inverseError(m, out) <= INVERSE_EPS);
+                m[12] = 0.0F; m[13] = 0.0F; m[14] = 0.0F; m[15] = 1.0F;
+                affine = affine && inverseAffineScalar(m, out) && (inverseError(m, out) <= INVERSE_EPS);
+            }
+            check("SCALAR inverse", inv);
+            check("SCALAR inverseAffine", affine);
+            float m[16], out[16];
+            randomMatrix(seed, m);
+            std::fill(m + 8, m + 12, 0.0F);
+            std::fill(out, out + 16, 7.0F);
+            const float keep[16] = { 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F, 7.0F };
+            bool singular = !inverseScalar(m, out) && !inverseAffineScalar(m, out) && nearly(keep, out, 16, 0.0F);
+            for (const Cpu::ISA isa : { Cpu::ISA::SSE2, Cpu::ISA::NEON, Cpu::ISA::AVX2 }) {
+                const MatrixKernel& k = MatrixKernel::get(isa);
+                singular = singular && (!Cpu::supports(isa) || (!k.inverse(m, out) && !k.inverseAffine(m, out) && nearly(keep, out, 16, 0.0F)));
+            }
+            check("inverse singular", singular);
+        }
+
+        // Matrixのアフィン変換の行列の逆行列（lookat・orthogonalの積、乱数のアフィン変換）と一般の逆行列からの振り分け
+        {
+            std::uint32_t seed = 9U;
+            bool affine = true, dispatch = true;
+            for (std::int32_t n = 0; n < 1000; n++) {
+                float r[16];
+                randomMatrix(seed, r);
+                Matrix m = Matrix::identity();
+                for (std::size_t i = 0U; i < 12U; i++) {
+                    m[i] = r[i];
+                }
+                if ((n % 4) == 0) {
+                    const Vector eye(r[0] * 1000.0F, r[1] * 1000.0F, 5.0F + r[2]);
+                    m = Matrix::lookat(eye, { eye.x(), eye.y(), 0.0F }, { 0.0F, 1.0F, 0.0F }) *
+                        Matrix::orthogonal(-320.0F * (r[3] + 3.0F), 320.0F * (r[3] + 3.0F), -240.0F, 240.0F, 1.0F, 10.0F);
+                }
+                const Matrix inv = m.inverseAffine();
+                affine = affine && m.isAffine() && (inverseError(m.data(), inv.data()) <= INVERSE_EPS);
+                const Matrix gen = m.inverse();
+                dispatch = dispatch && nearly(inv.data(), gen.data(), 16, 0.0F);
+            }
+            check("inverseAffine", affine);
+            check("inverse affine dispatch", dispatch);
+            float p[16];
+            randomProjection(seed, p);
+            Matrix proj;
+            std::copy(p, p + 16, proj.begin());
+            float ref[16];
+            (void)MatrixKernel::get().inverse(p, ref);
+            check("inverse projective", !proj.isAffine() && nearly(ref, proj.inverse().data(), 16, 0.0F));
+        }
+
+        const Cpu::ISA isas[] = { Cpu::ISA::SSE2, Cpu::ISA::NEON, Cpu::ISA::AVX2 };
+        for (const Cpu::ISA isa : isas) {
+            if (!Cpu::supports(isa)) {
+                continue;
+            }
+            const MatrixKernel& k = MatrixKernel::get(isa);
+            const std::string name = Cpu::name(isa);
+            check(name + " get", k.isa == isa);
+            std::uint32_t seed = 7U;
+            bool mul = true, xform = true, trans = true, inv = true, affine = true, alias = true;
+            for (std::int32_t n = 0; n < 1000; n++) {
+                float a[16], b[16], ref[16], out[16];
+                randomMatrix(seed, a);
+                randomMatrix(seed, b);
+                multiplyScalar(a, b, ref);
+                k.multiply(a, b, out);
+                mul = mul && nearly(ref, out, 16, eps);
+                float v[4] = { a[0], b[1], a[2], 1.0F };
+                float vref[4], vout[4];
+                transformScalar(a, v, vref);
+                k.transform(a, v, vout);
+                xform = xform && nearly(vref, vout, 4, eps);
+                k.transform(a, v, v);
+                xform = xform && nearly(vref, v, 4, eps);
+                transposeScalar(a, ref);
+                k.transpose(a, out);
+                trans = trans && nearly(ref, out, 16, 0.0F);
+                // 出力先が入力と同じ配列
+                float a2[16], b2[16];
+                std::copy(a, a + 16, a2);
+                std::copy(b, b + 16, b2);
+                multiplyScalar(a, b, ref);
+                k.multiply(a2, b, a2);
+                k.multiply(a, b2, b2);
+                alias = alias && nearly(ref, a2, 16, eps) && nearly(ref, b2, 16, eps);
+                std::copy(a, a + 16, a2);
+                transposeScalar(a, ref);
+                k.transpose(a2, a2);
+                alias = alias && nearly(ref, a2, 16, 0.0F);
+                // 逆行列（倍精度の逆行列との誤差は条件数に比例するため、条件数で割って判定する）
+                inv = inv && k.inverse(a, out) && (inverseError(a, out) <= INVERSE_EPS);
+                std::copy(a, a + 16, a2);
+                alias = alias && k.inverse(a2, a2) && nearly(out, a2, 16, 0.0F);
+                // アフィン変換の行列の逆行列
+                a[12] = 0.0F; a[13] = 0.0F; a[14] = 0.0F; a[15] = 1.0F;
+                affine = affine && k.inverseAffine(a, out) && (inverseError(a, out) <= INVERSE_EPS);
+                std::copy(a, a + 16, a2);
+                alias = alias && k.inverseAffine(a2, a2) && nearly(out, a2, 16, 0.0F);
+            }
+            check(name + " multiply", mul);
+            check(name + " transform", xform);
+            check(name + " transpose", trans);
+            check(name + " inverse", inv);
+            check(name + " inverseAffine", affine);
+            check(name + " alias", alias);
+
+            // 座標の配列の変換（4個・8個ずつの計算と端数の計算の境界を含む個数）
+            bool pts = true, pts2d = true, palias = true;
+            for (std::size_t num = 0U; num < 40U; num++) {
+                float m[16];
+                randomProjection(seed, m);
+                const std::vector<float> in = randomPoints(seed, num);
+                std::vector<float> ref(in.size()), out(in.size());
+                pointsScalar(m, in.data(), ref.data(), num);
+                k.points(m, in.data(), out.data(), num);
+                pts = pts && nearly(ref.data(), out.data(), ref.size(), eps);
+                std::vector<float> io = in;
+                k.points(m, io.data(), io.data(), num);
+                palias = palias && nearly(ref.data(), io.data(), ref.size(), eps);
+                points2DScalar(m, in.data(), ref.data(), num);
+                k.points2D(m, in.data(), out.data(), num);
+                pts2d = pts2d && nearly(ref.data(), out.data(), ref.size(), eps);
+                io = in;
+                k.points2D(m, io.data(), io.data(), num);
+                palias = palias && nearly(ref.data(), io.data(), ref.size(), eps);
+            }
+            check(name + " points", pts);
+            check(name + " points2D", pts2d);
+            check(name + " points alias", palias);
+
+            // wが0の座標はwで割らない
+            float m0[16];
+            randomMatrix(seed, m0);
+            m0[12] = 0.0F; m0[13] = 0.0F; m0[14] = 0.0F; m0[15] = 0.0F;
+            const std::vector<float> in0 = randomPoints(seed, 9U);
+            std::vector<float> ref0(in0.size()), out0(in0.size());
+            pointsScalar(m0, in0.data(), ref0.data(), 9U);
+            k.points(m0, in0.data(), out0.data(), 9U);
+            check(name + " points w=0", nearly(ref0.data(), out0.data(), ref0.size(), eps));
+        }
+
+        // 区間に分割して並列に変換した結果は、一括で変換した結果と一致する
+        {
+            const MatrixKernel& k = MatrixKernel::get();
+            std::uint32_t seed = 11U;
+            float m[16];
+            randomProjection(seed, m);
+            const std::size_t num = 10007U;
+            const std::vector<float> in = randomPoints(seed, num);
+            std::vector<float> ref(in.size()), out(in.size());
+            k.points(m, in.data(), ref.data(), num);
+            Parallel::forRange(num, 1000U, [&](const std::size_t begin, const std::size_t end) {
+                k.points(m, in.data() + (begin * 3U), out.data() + (begin * 3U), end - begin);
+            });
+            check("parallel points", nearly(ref.data(), out.data(), ref.size(), eps));
+            bool covered = true;
+            std::vector<std::int32_t> hits(num, 0);
+            Parallel::forRange(num, 7U, [&](const std::size_t begin, const std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    hits[i]++;
+                }
+            });
+            for (const std::int32_t h : hits) {
+                covered = covered && (h == 1);
+            }
+            check("parallel range", covered);
+        }
+        // 対応していない命令セットはSCALARとなる
+        check("unsupported", Cpu::supports(Cpu::ISA::NEON) || (MatrixKernel::get(Cpu::ISA::NEON).isa == Cpu::ISA::SCALAR));
+        check("force", Cpu::force(Cpu::ISA::SCALAR) && (MatrixKernel::get().isa == Cpu::ISA::SCALAR));
+        Cpu::reset();
+        check("reset", Cpu::isa() == Cpu::detect());
+        return ok;
+    }
+
+    /**
+     * @brief MatrixKernelの処理性能を計測
+     * 
+     * @par 詳細
+     *      実行中のCPUが対応する命令セット毎に、1024個の行列に対する各演算の1回あたりの時間を出力する。
+     */
+    void benchcode_MatrixKernel()
+    {
+        std::cout << "[benchcode_MatrixKernel()] call" << std::endl;
+        const std::size_t num = 1024U;
+        const std::int32_t repeat = 2000;
+        std::vector<float> a(num * 16U), out(num * 16U);
+        float b[16];
+        std::uint32_t seed = 1U;
+        for (std::size_t i = 0U; i < num; i++) {
+            randomMatrix(seed, &a[i * 16U]);
+        }
+        randomMatrix(seed, b);
+        const Cpu::ISA isas[] = { Cpu::ISA::SCALAR, Cpu::ISA::SSE2, Cpu::ISA::NEON, Cpu::ISA::AVX2 };
+        for (const Cpu::ISA isa : isas) {
+            if (!Cpu::supports(isa)) {
+                continue;
+            }
+            const MatrixKernel& k = MatrixKernel::get(isa);
+            const double ops = static_cast<double>(num) * repeat;
+            float sink = 0.0F;
+
+            auto start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                for (std::size_t i = 0U; i < num; i++) {
+                    k.multiply(&a[i * 16U], b, &out[i * 16U]);
+                }
+                sink += out[static_cast<std::size_t>(r) % out.size()];
+            }
+            const double mul = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                for (std::size_t i = 0U; i < num; i++) {
+                    k.transform(&a[i * 16U], b, &out[i * 4U]);
+                }
+                sink += out[static_cast<std::size_t>(r) % out.size()];
+            }
+            const double xform = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                for (std::size_t i = 0U; i < num; i++) {
+                    k.transpose(&a[i * 16U], &out[i * 16U]);
+                }
+                sink += out[static_cast<std::size_t>(r) % out.size()];
+            }
+            const double trans = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                for (std::size_t i = 0U; i < num; i++) {
+                    (void)k.inverse(&a[i * 16U], &out[i * 16U]);
+                }
+                sink += out[static_cast<std::size_t>(r) % out.size()];
+            }
+            const double inv = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < repeat; r++) {
+                for (std::size_t i = 0U; i < num; i++) {
+                    (void)k.inverseAffine(&a[i * 16U], &out[i * 16U]);
+                }
+                sink += out[static_cast<std::size_t>(r) % out.size()];
+            }
+            const double affine = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+
+            std::cout << "* " << Cpu::name(isa) << " multiply:" << mul << "[nsec] transform:" << xform << "[nsec] transpose:" << trans << "[nsec] inverse:" << inv << "[nsec] inverseAffine:" << affine << "[nsec] (" << sink << ")" << std::endl;
+        }
+
+        // 座標の配列の変換（1座標あたりの時間）
+        const std::size_t points = 1U << 20;
+        const std::int32_t prepeat = 20;
+        std::uint32_t pseed = 3U;
+        float m[16];
+        randomProjection(pseed, m);
+        const std::vector<float> in = randomPoints(pseed, points);
+        std::vector<float> pout(in.size());
+        const double pops = static_cast<double>(points) * prepeat;
+        for (const Cpu::ISA isa : isas) {
+            if (!Cpu::supports(isa)) {
+                continue;
+            }
+            const MatrixKernel& k = MatrixKernel::get(isa);
+            auto start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < prepeat; r++) {
+                k.points(m, in.data(), pout.data(), points);
+            }
+            const double pts = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / pops;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < prepeat; r++) {
+                k.points2D(m, in.data(), pout.data(), points);
+            }
+            const double pts2d = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / pops;
+
+            start = std::chrono::steady_clock::now();
+            for (std::int32_t r = 0; r < prepeat; r++) {
+                Parallel::forRange(points, 1U << 16, [&](const std::size_t begin, const std::size_t end) {
+                    k.points(m, in.data() + (begin * 3U), pout.data() + (begin * 3U), end - begin);
+                });
+            }
+            const double ppar = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / pops;
+
+            std::cout << "* " << Cpu::name(isa) << " points:" << pts << "[nsec] points2D:" << pts2d << "[nsec] points(parallel x" << Parallel::threads() << "):" << ppar << "[nsec] (" << pout[points / 2U] << ")" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+﻿/**
+ * @file MatrixKernel.hpp
+ * @author kota-kota
+ * @brief 4x4行列の演算を命令セット毎に実装した関数の定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_MATRIXKERNEL_HPP
+#define INCLUDED_MATRIXKERNEL_HPP
+
+#include "Cpu.hpp"
+
+#include <cstddef>
+
+namespace my {
+    /**
+     * @struct MatrixKernel
+     * @brief 4x4行列（行優先の要素数16の配列）の演算関数の組
+     * 
+     * @par 詳細
+     *      命令セット毎に1つずつ用意し、Matrixクラスは実行時に選択した組を使用する。
+     *      出力先は入力と同じ配列でもよい（入力を全て読み込んでから書き込む）。
+     *      - multiply: out[k*4+j] = Σn b[k*4+n] * a[n*4+j]（Matrix::operator*と同じ。aの変換の後にbの変換を行う）
+     *      - transform: out[i] = Σj m[i*4+j] * v[j]（vは同次座標の4要素。1個のベクトルはSIMDの転置・水平加算の分だけ遅くなるため、全ての組でスカラーの実装とする）
+     *      - transpose: out[j*4+i] = m[i*4+j]
+     *      - inverse: mの逆行列（行列式が0の場合はfalseを返し、outは変更しない）
+     *      - inverseAffine: 最下行を(0 0 0 1)とみなしたmの逆行列（左上3x3の行列式が0の場合はfalseを返し、outは変更しない）
+     *      - points: XYZの並びのnum個の座標をtransformと同じく変換し、wで割る（wが0の場合は割らない）
+     *      - points2D: XYZの並びのnum個の座標のXYを(m[0] m[1] m[3]; m[4] m[5] m[7])で変換する（Zはそのまま）
+     */
+    struct MatrixKernel {
+        Cpu::ISA    isa;                                                    //!< 命令セット
+        void        (*multiply)(const float* a, const float* b, float* out); //!< 行列の積
+        void        (*transform)(const float* m, const float* v, float* out); //!< 行列とベクトルの積
+        void        (*transpose)(const float* m, float* out);               //!< 転置
+        bool        (*inverse)(const float* m, float* out);                 //!< 逆行列
+        bool        (*inverseAffine)(const float* m, float* out);           //!< アフィン変換の行列の逆行列
+        void        (*points)(const float* m, const float* in, float* out, const std::size_t num);   //!< 座標の配列の変換
+        void        (*points2D)(const float* m, const float* in, float* out, const std::size_t num); //!< XY座標の配列の2次元アフィン変換
+
+        //! 使用する命令セット（Cpu::isa()）の演算関数の組を取得
+        static const MatrixKernel& get();
+        //! 命令セットの演算関数の組を取得（対応していない場合はSCALAR）
+        static const MatrixKernel& get(const Cpu::ISA isa);
+    };
+}
+
+namespace my {
+    //! MatrixKernelのテストコードを実行（各命令セットの結果をSCALARと比較する）
+    bool testcode_MatrixKernel();
+    //! MatrixKernelの処理性能を計測
+    void benchcode_MatrixKernel();
+}
+
+#endif //INCLUDED_MATRIXKERNEL_HPP
@@ -0,0 +1,409 @@
+﻿/**
+ * @file MeshOptimizer.cpp
+ * @author kota-kota
+ * @brief 三角形の並びを描画効率の良い順に並べ替えるクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    //! 参照されない頂点の並び替え先
+    constexpr std::uint32_t UNUSED = 0xFFFFFFFFU;
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] cache_size 頂点キャッシュの大きさ（頂点数）
+     */
+    MeshOptimizer::MeshOptimizer(const std::uint32_t cache_size) :
+        m_cache_size(std::max(cache_size, 3U))
+    {
+    }
+
+    /**
+     * @brief 三角形の並びを頂点キャッシュの局所性が高い順に並べ替え
+     * 
+     * @param [in,out] indexes 頂点インデックスの並び（3個で1つの三角形）
+     * @param [in] vertex_num 頂点数
+     */
+    void MeshOptimizer::optimizeCache(Indexes& indexes, const std::size_t vertex_num) const
+    {
+        this->optimizeCache(indexes, vertex_num, 0U, indexes.size());
+    }
+
+    /**
+     * @brief 範囲内の三角形の並びを頂点キャッシュの局所性が高い順に並べ替え
+     * 
+     * @param [in,out] indexes 頂点インデックスの並び（3個で1つの三角形）
+     * @param [in] vertex_num 頂点数
+     * @param [in] first 範囲の先頭位置
+     * @param [in] count 範囲の頂点インデックス数（3の倍数）
+     * 
+     * @par 詳細
+     *      Tipsify法（Sander et al. 2007）で並べ替える。
+     *      扇の中心とする頂点を選び、その頂点を使う未出力の三角形を全て出力する。
+     *      次の中心は、直前に出力した頂点のうちキャッシュに残っていると見込める頂点から選ぶ。
+     *      該当する頂点がない場合は、最近出力した頂点、入力順の頂点の順に未出力の三角形を持つ頂点を探す。
+     *      三角形内の頂点の順序（表裏の向き）は変えない。詳細度の段のように範囲毎に並べ替えることができる。
+     */
+    void MeshOptimizer::optimizeCache(Indexes& indexes, const std::size_t vertex_num, const std::size_t first, const std::size_t count) const
+    {
+        const std::size_t tri_num = count / 3U;
+        if ((tri_num < 2U) || ((first + count) > indexes.size())) {
+            return;
+        }
+        const auto vertexOf = [&](const std::size_t t, const std::size_t k) { return indexes[first + (t * 3U) + k].idx(); };
+
+        // 頂点毎の三角形の一覧（連続した配列に格納する）
+        std::vector<std::uint32_t> live(vertex_num, 0U);
+        for (std::size_t t = 0U; t < tri_num; t++) {
+            for (std::size_t k = 0U; k < 3U; k++) {
+                live[vertexOf(t, k)]++;
+            }
+        }
+        std::vector<std::uint32_t> adj_first(vertex_num + 1U, 0U);
+        for (std::size_t v = 0U; v < vertex_num; v++) {
+            adj_first[v + 1U] = adj_first[v] + live[v];
+        }
+        std::vector<std::uint32_t> adj(adj_first[vertex_num]);
+        std::vector<std::uint32_t> cursor(adj_first.begin(), adj_first.end() - 1);
+        for (std::size_t t = 0U; t < tri_num; t++) {
+            for (std::size_t k = 0U; k < 3U; k++) {
+                adj[cursor[vertexOf(t, k)]++] = static_cast<std::uint32_t>(t);
+            }
+        }
+
+        const std::int64_t cache = static_cast<std::int64_t>(this->m_cache_size);
+        std::vector<std::int64_t> cache_time(vertex_num, 0);
+        std::vector<bool> emitted(tri_num, false);
+        std::vector<std::uint32_t> dead_end;
+        std::vector<std::uint32_t> candidates;
+        Indexes out;
+        out.reserve(tri_num * 3U);
+        std::int64_t time = cache + 1;
+        std::size_t scan = 0U;
+
+        std::int64_t fan = static_cast<std::int64_t>(vertexOf(0U, 0U));
+        while (fan >= 0) {
+            // 扇の中心の頂点を使う未出力の三角形を全て出力する
+            candidates.clear();
+            const std::size_t f = static_cast<std::size_t>(fan);
+            for (std::uint32_t a = adj_first[f]; a < adj_first[f + 1U]; a++) {
+                const std::size_t t = adj[a];
+                if (emitted[t]) {
+                    continue;
+                }
+                for (std::size_t k = 0U; k < 3U; k++) {
+                    const std::uint32_t v = vertexOf(t, k);
+                    out.push_back(v);
+                    dead_end.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    if ((time - cache_time[v]) > cache) {
+                        cache_time[v] = time;
+                        time++;
+                    }
+                }
+                emitted[t] = true;
+            }
+
+            // 次の中心：出力後もキャッシュに残る頂点のうち、最も古くキャッシュに入った頂点
+            fan = -1;
+            std::int64_t best = -1;
+            for (const std::uint32_t v : candidates) {
+                if (live[v] == 0U) {
+                    continue;
+                }
+                std::int64_t priority = 0;
+                if (((time - cache_time[v]) + (2 * static_cast<std::int64_t>(live[v]))) <= cache) {
+                    priority = time - cache_time[v];
+                }
+                if (priority > best) {
+                    best = priority;
+                    fan = static_cast<std::int64_t>(v);
+                }
+            }
+            if (fan >= 0) {
+                continue;
+            }
+            // 行き止まり：最近出力した頂点、入力順の頂点の順に探す
+            while (!dead_end.empty()) {
+                const std::uint32_t v = dead_end.back();
+                dead_end.pop_back();
+                if (live[v] > 0U) {
+                    fan = static_cast<std::int64_t>(v);
+                    break;
+                }
+            }
+            while ((fan < 0) && (scan < tri_num)) {
+                for (std::size_t k = 0U; k < 3U; k++) {
+                    if (live[vertexOf(scan, k)] > 0U) {
+                        fan = static_cast<std::int64_t>(vertexOf(scan, k));
+                    }
+                }
+                if (fan < 0) {
+                    scan++;
+                }
+            }
+        }
+        std::copy(out.begin(), out.end(), indexes.begin() + static_cast<std::ptrdiff_t>(first));
+    }
+
+    /**
+     * @brief 頂点の参照順の並び替え表を作成
+     * 
+     * @param [in] indexes 頂点インデックスの並び
+     * @param [in] vertex_num 頂点数
+     * 
+     * @return std::vector<std::uint32_t> 並び替え前の頂点番号から並び替え後の頂点番号への表
+     * 
+     * @par 詳細
+     *      参照されない頂点は、参照される頂点の後に元の順で並べる。
+     */
+    std::vector<std::uint32_t> MeshOptimizer::remapTable(const Indexes& indexes, const std::size_t vertex_num) const
+    {
+        std::vector<std::uint32_t> remap(vertex_num, UNUSED);
+        std::uint32_t next = 0U;
+        for (const Index& i : indexes) {
+            if (remap[i.idx()] == UNUSED) {
+                remap[i.idx()] = next++;
+            }
+        }
+        for (std::uint32_t& r : remap) {
+            if (r == UNUSED) {
+                r = next++;
+            }
+        }
+        return remap;
+    }
+
+    /**
+     * @brief 頂点を参照順に並べ替え、頂点インデックスを付け替え
+     * 
+     * @param [in,out] vertexes 頂点座標の並び
+     * @param [in,out] indexes 頂点インデックスの並び
+     */
+    void MeshOptimizer::optimizeFetch(Vertexes& vertexes, Indexes& indexes) const
+    {
+        Colors colors;
+        this->optimizeFetch(vertexes, colors, indexes);
+    }
+
+    /**
+     * @brief 頂点・頂点色を参照順に並べ替え、頂点インデックスを付け替え
+     * 
+     * @param [in,out] vertexes 頂点座標の並び
+     * @param [in,out] colors 頂点色の並び（頂点数と異なる場合は並べ替えない）
+     * @param [in,out] indexes 頂点インデックスの並び
+     * 
+     * @par 詳細
+     *      頂点キャッシュ最適化の後に実行する（三角形の順序から頂点の順序を決めるため）。
+     */
+    void MeshOptimizer::optimizeFetch(Vertexes& vertexes, Colors& colors, Indexes& indexes) const
+    {
+        const std::vector<std::uint32_t> remap = this->remapTable(indexes, vertexes.size());
+        Vertexes sorted_vertexes(vertexes.size());
+        for (std::size_t v = 0U; v < vertexes.size(); v++) {
+            sorted_vertexes[remap[v]] = vertexes[v];
+        }
+        vertexes.swap(sorted_vertexes);
+        if (colors.size() == vertexes.size()) {
+            Colors sorted_colors(colors.size());
+            for (std::size_t v = 0U; v < colors.size(); v++) {
+                sorted_colors[remap[v]] = colors[v];
+            }
+            colors.swap(sorted_colors);
+        }
+        for (Index& i : indexes) {
+            i = Index(remap[i.idx()]);
+        }
+    }
+
+    /**
+     * @brief 三角形あたりの平均キャッシュミス数（ACMR）を取得
+     * 
+     * @param [in] indexes 頂点インデックスの並び（3個で1つの三角形）
+     * @param [in] vertex_num 頂点数
+     * 
+     * @return float ACMR（0.5〜3.0、小さいほど良い）
+     */
+    float MeshOptimizer::acmr(const Indexes& indexes, const std::size_t vertex_num) const
+    {
+        return this->acmr(indexes, vertex_num, 0U, indexes.size());
+    }
+
+    /**
+     * @brief 範囲内の三角形あたりの平均キャッシュミス数（ACMR）を取得
+     * 
+     * @param [in] indexes 頂点インデックスの並び（3個で1つの三角形）
+     * @param [in] vertex_num 頂点数
+     * @param [in] first 範囲の先頭位置
+     * @param [in] count 範囲の頂点インデックス数
+     * 
+     * @return float ACMR（三角形がない場合は0）
+     * 
+     * @par 詳細
+     *      頂点キャッシュをFIFOで模擬し、キャッシュにない頂点の参照数を三角形数で割る。
+     */
+    float MeshOptimizer::acmr(const Indexes& indexes, const std::size_t vertex_num, const std::size_t first, const std::size_t count) const
+    {
+        const std::size_t tri_num = count / 3U;
+        if ((tri_num == 0U) || ((first + count) > indexes.size())) {
+            return 0.0F;
+        }
+        // 頂点がキャッシュに入った時刻（FIFOのため、時刻の差がキャッシュの大きさ以内ならキャッシュにある）
+        std::vector<std::int64_t> cache_time(vertex_num, -static_cast<std::int64_t>(this->m_cache_size) - 1);
+        std::int64_t time = 0;
+        std::size_t misses = 0U;
+        for (std::size_t i = first; i < (first + (tri_num * 3U)); i++) {
+            const std::uint32_t v = indexes[i].idx();
+            if ((time - cache_time[v]) > static_cast<std::int64_t>(this->m_cache_size)) {
+                cache_time[v] = time;
+                time++;
+                misses++;
+            }
+        }
+        return static_cast<float>(misses) / static_cast<float>(tri_num);
+    }
+}
+
+namespace {
+    //! 格子状の三角形の並びを作成（三角形の順序は行の順を入れ替えて局所性を下げる）
+    void makeGridMesh(const std::int32_t n, my::Vertexes& vertexes, my::Indexes& indexes)
+    {
+        for (std::int32_t y = 0; y <= n; y++) {
+            for (std::int32_t x = 0; x <= n; x++) {
+                vertexes.push_back({ static_cast<float>(x), static_cast<float>(y) });
+            }
+        }
+        const std::uint32_t stride = static_cast<std::uint32_t>(n + 1);
+        for (std::int32_t r = 0; r < n; r++) {
+            // 行を飛び飛びに並べる
+            const std::uint32_t y = static_cast<std::uint32_t>((r * 7) % n);
+            for (std::uint32_t x = 0U; x < static_cast<std::uint32_t>(n); x++) {
+                const std::uint32_t v = (y * stride) + x;
+                indexes.insert(indexes.end(), { v, v + 1U, v + stride, v + 1U, v + stride + 1U, v + stride });
+            }
+        }
+    }
+
+    //! 三角形の並びを座標で正規化した一覧（表裏の向きを保つよう頂点を巡回させる）
+    std::vector<std::vector<float>> triangleSet(const my::Vertexes& vertexes, const my::Indexes& indexes)
+    {
+        std::vector<std::vector<float>> set;
+        for (std::size_t i = 0U; (i + 2U) < indexes.size(); i += 3U) {
+            std::vector<float> tri;
+            std::size_t start = 0U;
+            for (std::size_t k = 1U; k < 3U; k++) {
+                const my::Vertex& a = vertexes[indexes[i + k].idx()];
+                const my::Vertex& b = vertexes[indexes[i + start].idx()];
+                if ((a.x() < b.x()) || (!(a.x() > b.x()) && (a.y() < b.y()))) {
+                    start = k;
+                }
+            }
+            for (std::size_t k = 0U; k < 3U; k++) {
+                const my::Vertex& v = vertexes[indexes[i + ((start + k) % 3U)].idx()];
+                tri.push_back(v.x());
+                tri.push_back(v.y());
+            }
+            set.push_back(tri);
+        }
+        std::sort(set.begin(), set.end());
+        return set;
+    }
+}
+
+namespace my {
+    /**
+     * @brief MeshOptimizerクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     * 
+     * @par 詳細
+     *      並べ替えの前後で三角形の集合（頂点座標・表裏の向き）が変わらず、ACMRが下がることを確認する。
+     */
+    bool testcode_MeshOptimizer()
+    {
+        std::cout << "[testcode_MeshOptimizer()] call" << std::endl;
+        bool ok = true;
+        Vertexes vertexes;
+        Indexes indexes;
+        makeGridMesh(64, vertexes, indexes);
+        const std::vector<std::vector<float>> before_set = triangleSet(vertexes, indexes);
+
+        const MeshOptimizer optimizer;
+        const float before = optimizer.acmr(indexes, vertexes.size());
+        optimizer.optimizeCache(indexes, vertexes.size());
+        const float after = optimizer.acmr(indexes, vertexes.size());
+        Colors colors(vertexes.size());
+        for (std::size_t i = 0U; i < colors.size(); i++) {
+            colors[i] = Color(static_cast<std::uint8_t>(vertexes[i].x()), static_cast<std::uint8_t>(vertexes[i].y()), 0, 255);
+        }
+        optimizer.optimizeFetch(vertexes, colors, indexes);
+
+        const bool acmr_ok = (after < before);
+        std::cout << "* acmr before:" << before << " after:" << after << (acmr_ok ? " .. OK" : " .. NG") << std::endl;
+        ok = acmr_ok && ok;
+
+        const bool same = (triangleSet(vertexes, indexes) == before_set);
+        std::cout << "* triangles" << (same ? " .. OK" : " .. NG") << std::endl;
+        ok = same && ok;
+
+        // 頂点は参照順に並び、頂点色も頂点と同じ順に並べ替わる
+        bool ordered = true;
+        std::uint32_t next = 0U;
+        for (const Index& i : indexes) {
+            ordered = (i.idx() <= next) && ordered;
+            next = std::max(next, i.idx() + 1U);
+        }
+        for (std::size_t i = 0U; i < colors.size(); i++) {
+            ordered = (colors[i].r() == static_cast<std::uint8_t>(vertexes[i].x())) && (colors[i].g() == static_cast<std::uint8_t>(vertexes[i].y())) && ordered;
+        }
+        std::cout << "* fetch order" << (ordered ? " .. OK" : " .. NG") << std::endl;
+        ok = ordered && ok;
+
+        // 範囲外の指定では並べ替えない
+        Indexes small = { 0U, 1U, 2U, 2U, 1U, 3U };
+        const Indexes small_org = small;
+        optimizer.optimizeCache(small, 4U, 3U, 6U);
+        const bool range_ok = (small.size() == small_org.size()) && std::equal(small.begin(), small.end(), small_org.begin(), [](const Index& a, const Index& b) { return a.idx() == b.idx(); });
+        std::cout << "* out of range" << (range_ok ? " .. OK" : " .. NG") << std::endl;
+        ok = range_ok && ok;
+        return ok;
+    }
+
+    /**
+     * @brief MeshOptimizerクラスの処理性能を計測
+     * 
+     * @par 詳細
+     *      約100万個の三角形を並べ替える時間と、並べ替え前後のACMRを計測する。
+     */
+    void benchcode_MeshOptimizer()
+    {
+        std::cout << "[benchcode_MeshOptimizer()] call" << std::endl;
+        Vertexes vertexes;
+        Indexes indexes;
+        makeGridMesh(708, vertexes, indexes);
+        const MeshOptimizer optimizer;
+        const float before = optimizer.acmr(indexes, vertexes.size());
+        auto start = std::chrono::steady_clock::now();
+        optimizer.optimizeCache(indexes, vertexes.size());
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "* optimizeCache triangles:" << (indexes.size() / 3U) << " time:" << (std::chrono::duration<double>(end - start).count() * 1000.0) << "[msec]" << std::endl;
+        start = std::chrono::steady_clock::now();
+        optimizer.optimizeFetch(vertexes, indexes);
+        end = std::chrono::steady_clock::now();
+        std::cout << "* optimizeFetch vertexes:" << vertexes.size() << " time:" << (std::chrono::duration<double>(end - start).count() * 1000.0) << "[msec]" << std::endl;
+        std::cout << "* acmr before:" << before << " after:" << optimizer.acmr(indexes, vertexes.size()) << std::endl;
+    }
+}
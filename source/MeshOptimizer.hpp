@@ -0,0 +1,64 @@
+﻿/**
+ * @file MeshOptimizer.hpp
+ * @author kota-kota
+ * @brief 三角形の並びを描画効率の良い順に並べ替えるクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_MESHOPTIMIZER_HPP
+#define INCLUDED_MESHOPTIMIZER_HPP
+
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class MeshOptimizer
+     * @brief 三角形（GL_TRIANGLES）の頂点インデックスの並びを描画効率の良い順に並べ替えるクラス
+     * 
+     * @par 詳細
+     *      頂点キャッシュ最適化は、Tipsify法で三角形の順序を並べ替え、変換済み頂点の再利用率を上げる。
+     *      頂点フェッチ最適化は、頂点を頂点インデックスから最初に参照される順に並べ替え、メモリアクセスを連続させる。
+     *      読み込み時に1回実行することを想定する。
+     */
+    class MeshOptimizer {
+        std::uint32_t   m_cache_size;   //!< 頂点キャッシュの大きさ（頂点数）
+
+    public:
+        //! コンストラクタ
+        explicit MeshOptimizer(const std::uint32_t cache_size = 16U);
+
+    public:
+        //! 三角形の並びを頂点キャッシュの局所性が高い順に並べ替え
+        void optimizeCache(Indexes& indexes, const std::size_t vertex_num) const;
+        //! 範囲内の三角形の並びを頂点キャッシュの局所性が高い順に並べ替え
+        void optimizeCache(Indexes& indexes, const std::size_t vertex_num, const std::size_t first, const std::size_t count) const;
+        //! 頂点を参照順に並べ替え、頂点インデックスを付け替え
+        void optimizeFetch(Vertexes& vertexes, Indexes& indexes) const;
+        //! 頂点・頂点色を参照順に並べ替え、頂点インデックスを付け替え
+        void optimizeFetch(Vertexes& vertexes, Colors& colors, Indexes& indexes) const;
+
+    public:
+        //! 三角形あたりの平均キャッシュミス数（ACMR）を取得
+        float acmr(const Indexes& indexes, const std::size_t vertex_num) const;
+        //! 範囲内の三角形あたりの平均キャッシュミス数（ACMR）を取得
+        float acmr(const Indexes& indexes, const std::size_t vertex_num, const std::size_t first, const std::size_t count) const;
+
+    private:
+        //! 頂点の参照順の並び替え表を作成
+        std::vector<std::uint32_t> remapTable(const Indexes& indexes, const std::size_t vertex_num) const;
+    };
+}
+
+namespace my {
+    //! MeshOptimizerクラスのテストコードを実行
+    bool testcode_MeshOptimizer();
+    //! MeshOptimizerクラスの処理性能を計測
+    void benchcode_MeshOptimizer();
+}
+
+#endif //INCLUDED_MESHOPTIMIZER_HPP
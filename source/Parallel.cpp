@@ -0,0 +1,60 @@
+﻿/**
+ * @file Parallel.cpp
+ * @author kota-kota
+ * @brief 範囲を分割して並列に処理する関数の実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace my {
+    /**
+     * @brief 使用するスレッド数を取得
+     * 
+     * @return std::size_t スレッド数（論理コア数、取得できない場合は1）
+     */
+    std::size_t Parallel::threads()
+    {
+        static const std::size_t num = std::max<std::size_t>(1U, std::thread::hardware_concurrency());
+        return num;
+    }
+
+    /**
+     * @brief 範囲[0, num)を分割して並列に処理（全ての区間の処理が終わるまで待つ）
+     * 
+     * @param [in] num 範囲の要素数
+     * @param [in] grain 区間の最小の要素数（0は1とみなす）
+     * @param [in] body 区間[begin, end)の処理関数
+     * 
+     * @par 詳細
+     *      区間数はスレッド数とnum / grainの小さい方とし、要素数が均等になるよう分割する。
+     *      最後の区間は呼び出し元のスレッドで処理し、それ以外の区間毎にスレッドを生成する。
+     */
+    void Parallel::forRange(const std::size_t num, const std::size_t grain, const Body& body)
+    {
+        if (num == 0U) {
+            return;
+        }
+        const std::size_t parts = std::min(Parallel::threads(), std::max<std::size_t>(1U, num / std::max<std::size_t>(1U, grain)));
+        if (parts <= 1U) {
+            body(0U, num);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(parts - 1U);
+        for (std::size_t i = 0U; (i + 1U) < parts; i++) {
+            workers.emplace_back(body, (num * i) / parts, (num * (i + 1U)) / parts);
+        }
+        body((num * (parts - 1U)) / parts, num);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+}
@@ -0,0 +1,43 @@
+﻿/**
+ * @file Parallel.hpp
+ * @author kota-kota
+ * @brief 範囲を分割して並列に処理する関数の定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_PARALLEL_HPP
+#define INCLUDED_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace my {
+    /**
+     * @class Parallel
+     * @brief 範囲[0, num)を分割し、複数のスレッドで並列に処理するクラス
+     * 
+     * @par 詳細
+     *      範囲はgrain個以上の連続した区間に分割し、区間毎に処理関数を1回呼び出す。
+     *      区間は重ならないため、処理関数は区間毎に異なる要素のみ書き込めば排他制御は不要。
+     *      区間が1つの場合（num < grain * 2、またはスレッドが1つの場合）は、呼び出し元のスレッドで処理する。
+     */
+    class Parallel {
+    public:
+        //! 区間[begin, end)の処理関数
+        using Body = std::function<void(const std::size_t begin, const std::size_t end)>;
+
+    public:
+        //! インスタンスの生成禁止
+        Parallel() = delete;
+
+    public:
+        //! 使用するスレッド数を取得
+        static std::size_t threads();
+        //! 範囲[0, num)を分割して並列に処理（全ての区間の処理が終わるまで待つ）
+        static void forRange(const std::size_t num, const std::size_t grain, const Body& body);
+    };
+}
+
+#endif //INCLUDED_PARALLEL_HPP
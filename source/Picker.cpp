@@ -0,0 +1,532 @@
+﻿/**
+ * @file Picker.cpp
+ * @author kota-kota
+ * @brief 画面上の位置にある描画物を判定するクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Picker.hpp"
+#include "Affine2D.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    //! 格子の列数・行数の上限
+    constexpr std::int32_t MAX_CELLS = 2048;
+    //! 図形要素あたりの格子数の目安（図形要素数に対する格子数の比率）
+    constexpr float CELL_RATIO = 0.5F;
+    //! プリミティブリスタートの頂点インデックス
+    constexpr std::uint32_t RESTART = 0xFFFFFFFFU;
+
+    //! 2次元の外積（b-a と c-a）
+    float cross(const float ax, const float ay, const float bx, const float by, const float cx, const float cy)
+    {
+        return ((bx - ax) * (cy - ay)) - ((by - ay) * (cx - ax));
+    }
+
+    //! 点が三角形の内側（辺上を含む）にあるか判定（頂点の並びの向きは問わない）
+    bool inTriangle(const float* x, const float* y, const float px, const float py)
+    {
+        const float d0 = cross(x[0], y[0], x[1], y[1], px, py);
+        const float d1 = cross(x[1], y[1], x[2], y[2], px, py);
+        const float d2 = cross(x[2], y[2], x[0], y[0], px, py);
+        const bool neg = (d0 < 0.0F) || (d1 < 0.0F) || (d2 < 0.0F);
+        const bool pos = (d0 > 0.0F) || (d1 > 0.0F) || (d2 > 0.0F);
+        return !(neg && pos);
+    }
+
+    //! 点と線分の距離の2乗
+    float distance2(const float ax, const float ay, const float bx, const float by, const float px, const float py)
+    {
+        const float dx = bx - ax;
+        const float dy = by - ay;
+        const float len2 = (dx * dx) + (dy * dy);
+        float t = 0.0F;
+        if (len2 > 0.0F) {
+            t = std::min(std::max((((px - ax) * dx) + ((py - ay) * dy)) / len2, 0.0F), 1.0F);
+        }
+        const float ex = (ax + (t * dx)) - px;
+        const float ey = (ay + (t * dy)) - py;
+        return (ex * ex) + (ey * ey);
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    Picker::Picker() :
+        m_primitives(), m_bounds(), m_nx(0), m_ny(0), m_cellw(0.0F), m_cellh(0.0F), m_cell_first(), m_cell_items()
+    {
+    }
+
+    /**
+     * @brief 全ての図形要素を削除
+     * 
+     */
+    void Picker::clear()
+    {
+        this->m_primitives.clear();
+        this->m_bounds = Aabb();
+        this->m_nx = 0;
+        this->m_ny = 0;
+        this->m_cell_first.clear();
+        this->m_cell_items.clear();
+    }
+
+    /**
+     * @brief 描画物の図形要素を追加
+     * 
+     * @param [in] id 描画物の番号
+     * @param [in] topology 頂点インデックスの並びの解釈
+     * @param [in] vertexes 頂点座標の並び（オブジェクトの座標系）
+     * @param [in] indexes 頂点インデックスの並び
+     * @param [in] pos 描画位置
+     * @param [in] scale 描画スケール
+     * 
+     * @par 詳細
+     *      頂点座標は描画スケールで拡大した後に描画位置へ移動する（add(id, topology, vertexes, indexes, model)）。
+     */
+    void Picker::add(const std::uint32_t id, const TOPOLOGY topology, const Vertexes& vertexes, const Indexes& indexes, const Vector& pos, const Vector& scale)
+    {
+        this->add(id, topology, vertexes, indexes, Affine2D::scale(scale) * Affine2D::translate(pos));
+    }
+
+    /**
+     * @brief 描画物の図形要素をアフィン変換して追加
+     * 
+     * @param [in] id 描画物の番号
+     * @param [in] topology 頂点インデックスの並びの解釈
+     * @param [in] vertexes 頂点座標の並び（オブジェクトの座標系）
+     * @param [in] indexes 頂点インデックスの並び
+     * @param [in] model ワールド座標系への配置
+     * 
+     * @par 詳細
+     *      頂点座標はアフィン変換し、ワールド座標系で保持する。
+     *      座標の変換は頂点座標の並び全体に対してまとめて行う（Affine2D::apply()）。
+     *      面積のない三角形（三角形ストリップの縮退三角形など）は追加しない。
+     *      プリミティブリスタートの頂点インデックス（0xFFFFFFFF）で並びを区切る。
+     *      追加後はbuild()を呼ぶまで判定に反映しない。
+     */
+    void Picker::add(const std::uint32_t id, const TOPOLOGY topology, const Vertexes& vertexes, const Indexes& indexes, const Affine2D& model)
+    {
+        Vertexes world(vertexes.size());
+        model.apply(vertexes.data(), world.data(), world.size());
+
+        // プリミティブリスタートで区切った範囲毎に図形要素を追加する
+        std::size_t first = 0U;
+        while (first < indexes.size()) {
+            std::size_t last = first;
+            while ((last < indexes.size()) && (indexes[last].idx() != RESTART)) {
+                last++;
+            }
+            this->addRun(id, topology, world, indexes, first, last - first);
+            first = last + 1U;
+        }
+    }
+
+    /**
+     * @brief リスタートを含まない範囲の図形要素を追加
+     * 
+     * @param [in] id 描画物の番号
+     * @param [in] topology 頂点インデックスの並びの解釈
+     * @param [in] world 頂点座標の並び（ワールド座標系）
+     * @param [in] indexes 頂点インデックスの並び
+     * @param [in] first 範囲の先頭位置
+     * @param [in] n 範囲の頂点インデックス数
+     */
+    void Picker::addRun(const std::uint32_t id, const TOPOLOGY topology, const Vertexes& world, const Indexes& indexes, const std::size_t first, const std::size_t n)
+    {
+        const auto at = [&](const std::size_t i) {
+            return world[indexes[first + i].idx()];
+        };
+        switch (topology) {
+        case TOPOLOGY::POINTS:
+            for (std::size_t i = 0U; i < n; i++) {
+                this->push(id, KIND::POINT, at(i), at(i), at(i));
+            }
+            break;
+        case TOPOLOGY::LINES:
+            for (std::size_t i = 0U; (i + 1U) < n; i += 2U) {
+                this->push(id, KIND::SEGMENT, at(i), at(i + 1U), at(i + 1U));
+            }
+            break;
+        case TOPOLOGY::LINE_STRIP:
+        case TOPOLOGY::LINE_LOOP:
+            for (std::size_t i = 0U; (i + 1U) < n; i++) {
+                this->push(id, KIND::SEGMENT, at(i), at(i + 1U), at(i + 1U));
+            }
+            if ((topology == TOPOLOGY::LINE_LOOP) && (n > 2U)) {
+                this->push(id, KIND::SEGMENT, at(n - 1U), at(0U), at(0U));
+            }
+            break;
+        case TOPOLOGY::TRIANGLES:
+            for (std::size_t i = 0U; (i + 2U) < n; i += 3U) {
+                this->push(id, KIND::TRIANGLE, at(i), at(i + 1U), at(i + 2U));
+            }
+            break;
+        case TOPOLOGY::TRIANGLE_STRIP:
+            for (std::size_t i = 0U; (i + 2U) < n; i++) {
+                this->push(id, KIND::TRIANGLE, at(i), at(i + 1U), at(i + 2U));
+            }
+            break;
+        case TOPOLOGY::TRIANGLE_FAN:
+            for (std::size_t i = 1U; (i + 1U) < n; i++) {
+                this->push(id, KIND::TRIANGLE, at(0U), at(i), at(i + 1U));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    /**
+     * @brief 図形要素を追加
+     * 
+     * @param [in] id 描画物の番号
+     * @param [in] kind 種別
+     * @param [in] a 頂点1
+     * @param [in] b 頂点2（点の場合は頂点1と同じ）
+     * @param [in] c 頂点3（点・線分の場合は頂点2と同じ）
+     */
+    void Picker::push(const std::uint32_t id, const KIND kind, const Vertex& a, const Vertex& b, const Vertex& c)
+    {
+        if (kind == KIND::TRIANGLE) {
+            const float area = cross(a.x(), a.y(), b.x(), b.y(), c.x(), c.y());
+            if (!(std::fabs(area) > 0.0F)) {
+                return;
+            }
+        }
+        this->m_primitives.push_back({ { a.x(), b.x(), c.x() }, { a.y(), b.y(), c.y() }, id, kind });
+    }
+
+    /**
+     * @brief 格子を構築
+     * 
+     * @par 詳細
+     *      全図形要素の外接矩形を、図形要素数に応じた数の格子に分割する。
+     *      図形要素は外接矩形と重なる全ての格子に登録し、格子毎の登録先は連続した配列に格納する。
+     */
+    void Picker::build()
+    {
+        this->m_bounds = Aabb();
+        for (const Primitive& p : this->m_primitives) {
+            this->m_bounds.extend(Aabb(std::min({ p.x[0], p.x[1], p.x[2] }), std::min({ p.y[0], p.y[1], p.y[2] }),
+                                       std::max({ p.x[0], p.x[1], p.x[2] }), std::max({ p.y[0], p.y[1], p.y[2] })));
+        }
+        this->m_cell_first.clear();
+        this->m_cell_items.clear();
+        if (this->m_primitives.empty()) {
+            this->m_nx = 0;
+            this->m_ny = 0;
+            return;
+        }
+
+        // 格子の分割数（格子がなるべく正方形になるよう縦横比で配分する）
+        const float w = std::max(this->m_bounds.maxx() - this->m_bounds.minx(), 1.0F);
+        const float h = std::max(this->m_bounds.maxy() - this->m_bounds.miny(), 1.0F);
+        const float cells = std::max(static_cast<float>(this->m_primitives.size()) * CELL_RATIO, 1.0F);
+        this->m_nx = std::min(std::max(static_cast<std::int32_t>(std::ceil(std::sqrt(cells * w / h))), 1), MAX_CELLS);
+        this->m_ny = std::min(std::max(static_cast<std::int32_t>(std::ceil(cells / static_cast<float>(this->m_nx))), 1), MAX_CELLS);
+        this->m_cellw = w / static_cast<float>(this->m_nx);
+        this->m_cellh = h / static_cast<float>(this->m_ny);
+
+        // 1回目：格子毎の登録数を数える
+        const std::size_t num = static_cast<std::size_t>(this->m_nx) * static_cast<std::size_t>(this->m_ny);
+        this->m_cell_first.assign(num + 1U, 0U);
+        const auto range = [&](const Primitive& p, std::int32_t& x0, std::int32_t& y0, std::int32_t& x1, std::int32_t& y1) {
+            this->cell(std::min({ p.x[0], p.x[1], p.x[2] }), std::min({ p.y[0], p.y[1], p.y[2] }), x0, y0);
+            this->cell(std::max({ p.x[0], p.x[1], p.x[2] }), std::max({ p.y[0], p.y[1], p.y[2] }), x1, y1);
+        };
+        for (const Primitive& p : this->m_primitives) {
+            std::int32_t x0, y0, x1, y1;
+            range(p, x0, y0, x1, y1);
+            for (std::int32_t cy = y0; cy <= y1; cy++) {
+                for (std::int32_t cx = x0; cx <= x1; cx++) {
+                    this->m_cell_first[static_cast<std::size_t>((cy * this->m_nx) + cx) + 1U]++;
+                }
+            }
+        }
+        for (std::size_t i = 0U; i < num; i++) {
+            this->m_cell_first[i + 1U] += this->m_cell_first[i];
+        }
+
+        // 2回目：格子毎に図形要素の番号を格納する
+        this->m_cell_items.resize(this->m_cell_first[num]);
+        std::vector<std::uint32_t> cursor(this->m_cell_first.begin(), this->m_cell_first.end() - 1);
+        for (std::size_t i = 0U; i < this->m_primitives.size(); i++) {
+            std::int32_t x0, y0, x1, y1;
+            range(this->m_primitives[i], x0, y0, x1, y1);
+            for (std::int32_t cy = y0; cy <= y1; cy++) {
+                for (std::int32_t cx = x0; cx <= x1; cx++) {
+                    this->m_cell_items[cursor[static_cast<std::size_t>((cy * this->m_nx) + cx)]++] = static_cast<std::uint32_t>(i);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 座標を含む格子の列・行を取得
+     * 
+     * @param [in] x X座標
+     * @param [in] y Y座標
+     * @param [out] cx 格子の列（範囲外は端の列）
+     * @param [out] cy 格子の行（範囲外は端の行）
+     */
+    void Picker::cell(const float x, const float y, std::int32_t& cx, std::int32_t& cy) const
+    {
+        const float fx = std::floor((x - this->m_bounds.minx()) / this->m_cellw);
+        const float fy = std::floor((y - this->m_bounds.miny()) / this->m_cellh);
+        cx = static_cast<std::int32_t>(std::min(std::max(fx, 0.0F), static_cast<float>(this->m_nx - 1)));
+        cy = static_cast<std::int32_t>(std::min(std::max(fy, 0.0F), static_cast<float>(this->m_ny - 1)));
+    }
+
+    /**
+     * @brief 位置にある描画物を判定
+     * 
+     * @param [in] point 位置（ワールド座標系）
+     * @param [in] tolerance 点・線分と一致とみなす距離（ワールド座標系）
+     * @param [out] id 一致した描画物の番号（複数一致した場合は最大の番号）
+     * 
+     * @retval true 一致した描画物あり
+     * @retval false 一致した描画物なし
+     */
+    bool Picker::pick(const Vertex& point, const float tolerance, std::uint32_t& id) const
+    {
+        const Aabb area(point.x() - tolerance, point.y() - tolerance, point.x() + tolerance, point.y() + tolerance);
+        if (this->m_cell_first.empty() || !this->m_bounds.intersects(area)) {
+            return false;
+        }
+        const float px = point.x();
+        const float py = point.y();
+        const float tol2 = tolerance * tolerance;
+
+        bool found = false;
+        std::int32_t x0, y0, x1, y1;
+        this->cell(area.minx(), area.miny(), x0, y0);
+        this->cell(area.maxx(), area.maxy(), x1, y1);
+        for (std::int32_t cy = y0; cy <= y1; cy++) {
+            for (std::int32_t cx = x0; cx <= x1; cx++) {
+                const std::size_t c = static_cast<std::size_t>((cy * this->m_nx) + cx);
+                for (std::uint32_t i = this->m_cell_first[c]; i < this->m_cell_first[c + 1U]; i++) {
+                    const Primitive& p = this->m_primitives[this->m_cell_items[i]];
+                    // 一致済みの描画物より前に描画する描画物は判定しない
+                    if (found && (p.id <= id)) {
+                        continue;
+                    }
+                    bool hit = false;
+                    switch (p.kind) {
+                    case KIND::POINT:
+                        hit = (((p.x[0] - px) * (p.x[0] - px)) + ((p.y[0] - py) * (p.y[0] - py))) <= tol2;
+                        break;
+                    case KIND::SEGMENT:
+                        hit = distance2(p.x[0], p.y[0], p.x[1], p.y[1], px, py) <= tol2;
+                        break;
+                    case KIND::TRIANGLE:
+                        hit = inTriangle(p.x, p.y, px, py);
+                        break;
+                    default:
+                        break;
+                    }
+                    if (hit) {
+                        id = p.id;
+                        found = true;
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief 図形要素の数を取得
+     * 
+     * @return std::size_t 図形要素の数
+     */
+    std::size_t Picker::size() const { return this->m_primitives.size(); }
+
+    /**
+     * @brief ウィンドウ座標をワールド座標に変換
+     * 
+     * @param [in] view ビュー変換行列
+     * @param [in] proj 投影変換行列
+     * @param [in] x ウィンドウ座標のX座標（左端が0）
+     * @param [in] y ウィンドウ座標のY座標（上端が0）
+     * @param [in] width ウィンドウの幅
+     * @param [in] height ウィンドウの高さ
+     * 
+     * @return Vertex ワールド座標（投影面の奥行き0の位置）
+     * 
+     * @par 詳細
+     *      ウィンドウ座標を正規化デバイス座標に変換し、ビュー変換・投影変換の逆変換を行う。
+     */
+    Vertex Picker::unproject(const Matrix& view, const Matrix& proj, const float x, const float y, const float width, const float height)
+    {
+        const Vector ndc(((2.0F * x) / width) - 1.0F, 1.0F - ((2.0F * y) / height), 0.0F);
+        // 乗算は左側の行列の変換を先に行う（ビュー変換→投影変換）
+        const Vector world = (view * proj).inverse().transform(ndc);
+        return Vertex(world.x(), world.y());
+    }
+}
+
+namespace {
+    //! 格子状に並べた三角形（四角形を2分割）を作成
+    void makeGridTriangles(const std::int32_t nx, const std::int32_t ny, const float pitch, my::Vertexes& vertexes, my::Indexes& indexes)
+    {
+        for (std::int32_t y = 0; y < ny; y++) {
+            for (std::int32_t x = 0; x < nx; x++) {
+                // 隙間を空けて配置する
+                const float px = static_cast<float>(x) * pitch;
+                const float py = static_cast<float>(y) * pitch;
+                const float s = pitch * 0.8F;
+                const std::uint32_t base = static_cast<std::uint32_t>(vertexes.size());
+                vertexes.push_back({ px, py });
+                vertexes.push_back({ px + s, py });
+                vertexes.push_back({ px, py + s });
+                vertexes.push_back({ px + s, py + s });
+                indexes.insert(indexes.end(), { base, base + 1U, base + 2U, base + 1U, base + 3U, base + 2U });
+            }
+        }
+    }
+
+    //! 三角形の並びを総当たりで判定
+    bool pickBruteForce(const my::Vertexes& vertexes, const my::Indexes& indexes, const float px, const float py, std::uint32_t& id)
+    {
+        bool found = false;
+        for (std::size_t i = 0U; (i + 2U) < indexes.size(); i += 3U) {
+            const my::Vertex& a = vertexes[indexes[i].idx()];
+            const my::Vertex& b = vertexes[indexes[i + 1U].idx()];
+            const my::Vertex& c = vertexes[indexes[i + 2U].idx()];
+            const float x[3] = { a.x(), b.x(), c.x() };
+            const float y[3] = { a.y(), b.y(), c.y() };
+            if (inTriangle(x, y, px, py)) {
+                id = static_cast<std::uint32_t>(i / 3U);
+                found = true;
+            }
+        }
+        return found;
+    }
+}
+
+namespace my {
+    /**
+     * @brief Pickerクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     */
+    bool testcode_Picker()
+    {
+        std::cout << "[testcode_Picker()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const char* name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+        const Vector origin(0.0F, 0.0F, 0.0F);
+        const Vector one(1.0F, 1.0F, 1.0F);
+
+        // 三角形・線分・点
+        Picker picker;
+        picker.add(1U, Picker::TOPOLOGY::TRIANGLES, { { 0.0F, 0.0F }, { 10.0F, 0.0F }, { 0.0F, 10.0F } }, { 0U, 1U, 2U }, origin, one);
+        picker.add(2U, Picker::TOPOLOGY::TRIANGLE_FAN, { { 0.0F, 0.0F }, { 4.0F, 0.0F }, { 4.0F, 4.0F }, { 0.0F, 4.0F } }, { 0U, 1U, 2U, 3U }, { 2.0F, 2.0F, 0.0F }, one);
+        picker.add(3U, Picker::TOPOLOGY::LINE_STRIP, { { 20.0F, 0.0F }, { 30.0F, 0.0F }, { 30.0F, 10.0F } }, { 0U, 1U, 2U }, origin, one);
+        picker.add(4U, Picker::TOPOLOGY::POINTS, { { 1.0F, 1.0F } }, { 0U }, { 40.0F, 0.0F, 0.0F }, { 2.0F, 2.0F, 1.0F });
+        // 縮退三角形を含む三角形ストリップ（縮退三角形は追加しない）
+        picker.add(5U, Picker::TOPOLOGY::TRIANGLE_STRIP, { { 0.0F, 20.0F }, { 1.0F, 20.0F }, { 0.0F, 21.0F }, { 0.0F, 21.0F } }, { 0U, 1U, 2U, 3U }, origin, one);
+        // プリミティブリスタートで区切った線（区切りの前後は連結しない）
+        picker.add(6U, Picker::TOPOLOGY::LINE_STRIP, { { 50.0F, 0.0F }, { 60.0F, 0.0F }, { 50.0F, 10.0F }, { 60.0F, 10.0F } }, { 0U, 1U, RESTART, 2U, 3U }, origin, one);
+        picker.build();
+        check("size", picker.size() == (1U + 2U + 2U + 1U + 1U + 2U));
+
+        std::uint32_t id = 0U;
+        check("triangle", picker.pick({ 8.0F, 1.0F }, 0.5F, id) && (id == 1U));
+        check("overlap", picker.pick({ 3.0F, 3.0F }, 0.5F, id) && (id == 2U));
+        check("outside", !picker.pick({ 9.0F, 9.0F }, 0.5F, id));
+        check("segment", picker.pick({ 30.4F, 5.0F }, 0.5F, id) && (id == 3U));
+        check("segment far", !picker.pick({ 31.0F, 5.0F }, 0.5F, id));
+        check("point", picker.pick({ 42.0F, 2.3F }, 0.5F, id) && (id == 4U));
+        check("out of bounds", !picker.pick({ -100.0F, -100.0F }, 0.5F, id));
+        check("restart", picker.pick({ 55.0F, 10.0F }, 0.5F, id) && (id == 6U) && !picker.pick({ 55.0F, 5.0F }, 0.5F, id));
+
+        // 格子の判定結果が総当たりと一致する
+        Vertexes vertexes;
+        Indexes indexes;
+        makeGridTriangles(50, 40, 3.0F, vertexes, indexes);
+        Picker grid;
+        for (std::size_t i = 0U; i < indexes.size(); i += 3U) {
+            grid.add(static_cast<std::uint32_t>(i / 3U), Picker::TOPOLOGY::TRIANGLES, vertexes, { indexes[i], indexes[i + 1U], indexes[i + 2U] }, origin, one);
+        }
+        grid.build();
+        bool same = true;
+        for (std::int32_t i = 0; i < 2000; i++) {
+            const float px = static_cast<float>((i * 37) % 1600) / 10.0F - 5.0F;
+            const float py = static_cast<float>((i * 53) % 1300) / 10.0F - 5.0F;
+            std::uint32_t a = 0U, b = 0U;
+            const bool fa = grid.pick({ px, py }, 0.0F, a);
+            const bool fb = pickBruteForce(vertexes, indexes, px, py, b);
+            same = (fa == fb) && (!fa || (a == b)) && same;
+        }
+        check("grid vs brute force", same);
+
+        // 画面中央・左上の逆変換
+        const float w = 1280.0F, h = 720.0F, scale = 2.0F;
+        const Matrix view = Matrix::lookat({ w / 2.0F, h / 2.0F, 5.0F }, { w / 2.0F, h / 2.0F, 0.0F }, { 0.0F, 1.0F, 0.0F });
+        const Matrix proj = Matrix::orthogonal(-w / scale / 2.0F, w / scale / 2.0F, -h / scale / 2.0F, h / scale / 2.0F, 1.0F, 10.0F);
+        const Vertex center = Picker::unproject(view, proj, w / 2.0F, h / 2.0F, w, h);
+        const Vertex corner = Picker::unproject(view, proj, 0.0F, 0.0F, w, h);
+        check("unproject center", (std::fabs(center.x() - (w / 2.0F)) < 0.01F) && (std::fabs(center.y() - (h / 2.0F)) < 0.01F));
+        check("unproject corner", (std::fabs(corner.x() - (w / 4.0F)) < 0.01F) && (std::fabs(corner.y() - (h * 3.0F / 4.0F)) < 0.01F));
+        return ok;
+    }
+
+    /**
+     * @brief Pickerクラスの処理性能を計測
+     * 
+     * @par 詳細
+     *      100万個の三角形に対して判定を繰り返し、総当たりの判定と時間を比較する。
+     */
+    void benchcode_Picker()
+    {
+        std::cout << "[benchcode_Picker()] call" << std::endl;
+        Vertexes vertexes;
+        Indexes indexes;
+        makeGridTriangles(1000, 500, 3.0F, vertexes, indexes);
+        Picker picker;
+        auto start = std::chrono::steady_clock::now();
+        picker.add(0U, Picker::TOPOLOGY::TRIANGLES, vertexes, indexes, { 0.0F, 0.0F, 0.0F }, { 1.0F, 1.0F, 1.0F });
+        picker.build();
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "* build primitives:" << picker.size() << " time:" << (std::chrono::duration<double>(end - start).count() * 1000.0) << "[msec]" << std::endl;
+
+        std::int32_t loop = 100000;
+        std::size_t hits = 0U;
+        start = std::chrono::steady_clock::now();
+        for (std::int32_t i = 0; i < loop; i++) {
+            std::uint32_t id = 0U;
+            const float px = static_cast<float>((i * 37) % 30000) / 10.0F;
+            const float py = static_cast<float>((i * 53) % 15000) / 10.0F;
+            hits += picker.pick({ px, py }, 1.0F, id) ? 1U : 0U;
+        }
+        end = std::chrono::steady_clock::now();
+        std::cout << "* pick hits:" << hits << " time:" << (std::chrono::duration<double>(end - start).count() * 1000.0 / loop) << "[msec/pick]" << std::endl;
+
+        loop = 10;
+        hits = 0U;
+        start = std::chrono::steady_clock::now();
+        for (std::int32_t i = 0; i < loop; i++) {
+            std::uint32_t id = 0U;
+            const float px = static_cast<float>((i * 37) % 30000) / 10.0F;
+            const float py = static_cast<float>((i * 53) % 15000) / 10.0F;
+            hits += pickBruteForce(vertexes, indexes, px, py, id) ? 1U : 0U;
+        }
+        end = std::chrono::steady_clock::now();
+        std::cout << "* brute force hits:" << hits << " time:" << (std::chrono::duration<double>(end - start).count() * 1000.0 / loop) << "[msec/pick]" << std::endl;
+    }
+}
@@ -0,0 +1,100 @@
+﻿/**
+ * @file Picker.hpp
+ * @author kota-kota
+ * @brief 画面上の位置にある描画物を判定するクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_PICKER_HPP
+#define INCLUDED_PICKER_HPP
+
+#include "Vertex.hpp"
+#include "Matrix.hpp"
+#include "Affine2D.hpp"
+#include "SpatialIndex.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class Picker
+     * @brief 描画物の図形要素（点・線分・三角形）から、指定した位置にある描画物を判定するクラス
+     * 
+     * @par 詳細
+     *      図形要素はワールド座標系で保持し、外接矩形で一様格子に登録する。
+     *      判定は、指定した位置の格子に登録された図形要素のみ厳密に判定する。
+     *      点・線分は指定した距離以内、三角形は内側（辺上を含む）にある場合に一致とする。
+     *      複数の描画物が一致した場合は、番号の大きい描画物（後から描画する描画物）を返す。
+     */
+    class Picker {
+    public:
+        //! 頂点インデックスの並びの解釈
+        enum class TOPOLOGY { POINTS, LINES, LINE_STRIP, LINE_LOOP, TRIANGLES, TRIANGLE_STRIP, TRIANGLE_FAN };
+
+    private:
+        //! 図形要素の種別
+        enum class KIND : std::uint8_t { POINT, SEGMENT, TRIANGLE };
+
+        /**
+         * @struct Primitive
+         * @brief 図形要素（ワールド座標系のXY座標）
+         */
+        struct Primitive {
+            float           x[3];   //!< 頂点のX座標
+            float           y[3];   //!< 頂点のY座標
+            std::uint32_t   id;     //!< 描画物の番号
+            KIND            kind;   //!< 種別
+        };
+
+        std::vector<Primitive>      m_primitives;   //!< 図形要素の並び
+        Aabb                        m_bounds;       //!< 全図形要素の外接矩形
+        std::int32_t                m_nx;           //!< 格子の列数
+        std::int32_t                m_ny;           //!< 格子の行数
+        float                       m_cellw;        //!< 格子の幅
+        float                       m_cellh;        //!< 格子の高さ
+        std::vector<std::uint32_t>  m_cell_first;   //!< 格子毎の先頭位置（m_cell_itemsの位置、末尾は番兵）
+        std::vector<std::uint32_t>  m_cell_items;   //!< 格子に登録した図形要素の番号の並び
+
+    public:
+        //! デフォルトコンストラクタ
+        Picker();
+
+    public:
+        //! 全ての図形要素を削除
+        void clear();
+        //! 描画物の図形要素を追加
+        void add(const std::uint32_t id, const TOPOLOGY topology, const Vertexes& vertexes, const Indexes& indexes, const Vector& pos, const Vector& scale);
+        //! 描画物の図形要素をアフィン変換して追加
+        void add(const std::uint32_t id, const TOPOLOGY topology, const Vertexes& vertexes, const Indexes& indexes, const Affine2D& model);
+        //! 格子を構築
+        void build();
+        //! 位置にある描画物を判定
+        bool pick(const Vertex& point, const float tolerance, std::uint32_t& id) const;
+        //! 図形要素の数を取得
+        std::size_t size() const;
+
+    public:
+        //! ウィンドウ座標をワールド座標に変換
+        static Vertex unproject(const Matrix& view, const Matrix& proj, const float x, const float y, const float width, const float height);
+
+    private:
+        //! リスタートを含まない範囲の図形要素を追加
+        void addRun(const std::uint32_t id, const TOPOLOGY topology, const Vertexes& world, const Indexes& indexes, const std::size_t first, const std::size_t n);
+        //! 図形要素を追加
+        void push(const std::uint32_t id, const KIND kind, const Vertex& a, const Vertex& b, const Vertex& c);
+        //! 座標を含む格子の列・行を取得
+        void cell(const float x, const float y, std::int32_t& cx, std::int32_t& cy) const;
+    };
+}
+
+namespace my {
+    //! Pickerクラスのテストコードを実行
+    bool testcode_Picker();
+    //! Pickerクラスの処理性能を計測
+    void benchcode_Picker();
+}
+
+#endif //INCLUDED_PICKER_HPP
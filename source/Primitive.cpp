@@ -0,0 +1,462 @@
+﻿/**
+ * @file Primitive.cpp
+ * @author kota-kota
+ * @brief 基本図形（円・角丸矩形・矢印など）の単位形状を生成するクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Primitive.hpp"
+#include "Matrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <tuple>
+
+namespace {
+    //! 分割段0の円周の分割数
+    constexpr std::uint32_t PRIMITIVE_BASE_SEGMENTS = 8U;
+    //! 形状パラメータの比の下限
+    constexpr float PRIMITIVE_MIN_RATIO = 0.01F;
+    //! 角丸矩形の縦横比の上限
+    constexpr float PRIMITIVE_MAX_ASPECT = 100.0F;
+    //! 星形の頂点数の範囲
+    constexpr std::uint32_t PRIMITIVE_MIN_POINTS = 3U;
+    constexpr std::uint32_t PRIMITIVE_MAX_POINTS = 64U;
+
+    //! 値を範囲に丸める
+    float clampf(const float v, const float lo, const float hi)
+    {
+        return std::min(std::max(v, lo), hi);
+    }
+
+    //! 円周の分割数を取得
+    std::uint32_t segments(const std::uint32_t level)
+    {
+        return PRIMITIVE_BASE_SEGMENTS << level;
+    }
+
+    //! 中心の頂点（先頭）と周上の頂点の並びから、扇形に三角形を追加
+    void fan(const std::uint32_t num, my::Indexes& out)
+    {
+        for (std::uint32_t i = 0U; i < num; i++) {
+            out.push_back(0U);
+            out.push_back(1U + i);
+            out.push_back(1U + ((i + 1U) % num));
+        }
+    }
+
+    //! 円弧上の頂点を追加（始点・終点を含むsegments + 1個）
+    void arc(const float cx, const float cy, const float r, const float start, const std::uint32_t segments, my::Vertexes& out)
+    {
+        const float step = (my::MATRIX_PI / 2.0F) / static_cast<float>(std::max(segments, 1U));
+        for (std::uint32_t i = 0U; i <= segments; i++) {
+            const float t = start + (step * static_cast<float>(i));
+            out.push_back({ cx + (r * std::cos(t)), cy + (r * std::sin(t)) });
+        }
+    }
+}
+
+namespace my {
+    //! 分割段の上限（円周の分割数512）
+    const std::uint32_t PrimitiveKey::MAX_LEVEL = 6U;
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] kind 図形の種類
+     * @param [in] level 分割段
+     * @param [in] count 星形の頂点数
+     * @param [in] a 形状パラメータ1
+     * @param [in] b 形状パラメータ2
+     */
+    PrimitiveKey::PrimitiveKey(const KIND kind, const std::uint32_t level, const std::uint32_t count, const float a, const float b) :
+        m_kind(kind), m_level(std::min(level, MAX_LEVEL)), m_count(count), m_a(a), m_b(b)
+    {
+    }
+
+    /**
+     * @brief 円（半径1）
+     * 
+     * @param [in] level 分割段
+     * 
+     * @return PrimitiveKey キー
+     */
+    PrimitiveKey PrimitiveKey::circle(const std::uint32_t level)
+    {
+        return PrimitiveKey(KIND::CIRCLE, level, 0U, 0.0F, 0.0F);
+    }
+
+    /**
+     * @brief 楕円（半径1の円。配置時に縦横の拡大率で形を決める）
+     * 
+     * @param [in] level 分割段
+     * 
+     * @return PrimitiveKey キー（円と同じ）
+     */
+    PrimitiveKey PrimitiveKey::ellipse(const std::uint32_t level)
+    {
+        return PrimitiveKey::circle(level);
+    }
+
+    /**
+     * @brief 円環（外径1、内径inner）
+     * 
+     * @param [in] inner 内径（外径に対する比、0.01～1に丸める）
+     * @param [in] level 分割段
+     * 
+     * @return PrimitiveKey キー
+     */
+    PrimitiveKey PrimitiveKey::ring(const float inner, const std::uint32_t level)
+    {
+        return PrimitiveKey(KIND::RING, level, 0U, clampf(inner, PRIMITIVE_MIN_RATIO, 1.0F), 0.0F);
+    }
+
+    /**
+     * @brief 角丸矩形（幅2 * aspect、高さ2、角の半径radius）
+     * 
+     * @param [in] aspect 縦横比（幅 / 高さ、0.01～100に丸める）
+     * @param [in] radius 角の半径（高さの半分に対する比、0～1かつ縦横比以下に丸める）
+     * @param [in] level 分割段（角の半径が0の場合は0）
+     * 
+     * @return PrimitiveKey キー
+     */
+    PrimitiveKey PrimitiveKey::roundedRect(const float aspect, const float radius, const std::uint32_t level)
+    {
+        const float w = clampf(aspect, PRIMITIVE_MIN_RATIO, PRIMITIVE_MAX_ASPECT);
+        const float r = clampf(radius, 0.0F, std::min(w, 1.0F));
+        return PrimitiveKey(KIND::ROUNDED_RECT, (r > 0.0F) ? level : 0U, 0U, w, r);
+    }
+
+    /**
+     * @brief 矢印（(-1,0)から(1,0)へ向かう。矢尻の幅2、軸の幅2 * shaft、矢尻の長さhead）
+     * 
+     * @param [in] shaft 軸の太さ（矢尻の幅に対する比、0.01～1に丸める）
+     * @param [in] head 矢尻の長さ（0.01～2に丸める）
+     * 
+     * @return PrimitiveKey キー
+     */
+    PrimitiveKey PrimitiveKey::arrow(const float shaft, const float head)
+    {
+        return PrimitiveKey(KIND::ARROW, 0U, 0U, clampf(shaft, PRIMITIVE_MIN_RATIO, 1.0F), clampf(head, PRIMITIVE_MIN_RATIO, 2.0F));
+    }
+
+    /**
+     * @brief 星形（外径1、内径inner、頂点数count）
+     * 
+     * @param [in] count 頂点数（3～64に丸める）
+     * @param [in] inner 内径（外径に対する比、0.01～1に丸める）
+     * 
+     * @return PrimitiveKey キー
+     */
+    PrimitiveKey PrimitiveKey::star(const std::uint32_t count, const float inner)
+    {
+        const std::uint32_t n = std::min(std::max(count, PRIMITIVE_MIN_POINTS), PRIMITIVE_MAX_POINTS);
+        return PrimitiveKey(KIND::STAR, 0U, n, clampf(inner, PRIMITIVE_MIN_RATIO, 1.0F), 0.0F);
+    }
+
+    /**
+     * @brief 画面上の半径と許容誤差から分割段を選択
+     * 
+     * @param [in] radius 画面上の半径[pixel]
+     * @param [in] tolerance 円周と折れ線の許容誤差[pixel]
+     * 
+     * @return std::uint32_t 許容誤差に収まる最小の分割段（上限はMAX_LEVEL）
+     * 
+     * @par 詳細
+     *      分割数nの正多角形と円の最大誤差 r * (1 - cos(π / n)) で判定する。
+     */
+    std::uint32_t PrimitiveKey::level(const float radius, const float tolerance)
+    {
+        for (std::uint32_t l = 0U; l < MAX_LEVEL; l++) {
+            const float n = static_cast<float>(segments(l));
+            if ((radius * (1.0F - std::cos(MATRIX_PI / n))) <= tolerance) {
+                return l;
+            }
+        }
+        return MAX_LEVEL;
+    }
+
+    /**
+     * @brief 図形の種類を取得
+     * 
+     * @return KIND 図形の種類
+     */
+    PrimitiveKey::KIND PrimitiveKey::kind() const { return this->m_kind; }
+
+    /**
+     * @brief 分割段を取得
+     * 
+     * @return std::uint32_t 分割段
+     */
+    std::uint32_t PrimitiveKey::level() const { return this->m_level; }
+
+    /**
+     * @brief 星形の頂点数を取得
+     * 
+     * @return std::uint32_t 星形の頂点数（星形以外は0）
+     */
+    std::uint32_t PrimitiveKey::count() const { return this->m_count; }
+
+    /**
+     * @brief 形状パラメータ1を取得
+     * 
+     * @return float 形状パラメータ1
+     */
+    float PrimitiveKey::a() const { return this->m_a; }
+
+    /**
+     * @brief 形状パラメータ2を取得
+     * 
+     * @return float 形状パラメータ2
+     */
+    float PrimitiveKey::b() const { return this->m_b; }
+
+    /**
+     * @brief 分割段のみ変えたキーを取得
+     * 
+     * @param [in] level 分割段
+     * 
+     * @return PrimitiveKey キー（曲線を含まない図形は変えない）
+     */
+    PrimitiveKey PrimitiveKey::withLevel(const std::uint32_t level) const
+    {
+        PrimitiveKey key = *this;
+        if ((this->m_kind == KIND::CIRCLE) || (this->m_kind == KIND::RING) || ((this->m_kind == KIND::ROUNDED_RECT) && (this->m_b > 0.0F))) {
+            key.m_level = std::min(level, MAX_LEVEL);
+        }
+        return key;
+    }
+
+    /**
+     * @brief <演算子のオーバーロード（キャッシュのキーとして比較する）
+     * 
+     * @param [in] key 比較するキー
+     * 
+     * @return bool 種類・分割段・頂点数・形状パラメータの順に比較して小さい場合true
+     */
+    bool PrimitiveKey::operator<(const PrimitiveKey& key) const
+    {
+        return std::tie(this->m_kind, this->m_level, this->m_count, this->m_a, this->m_b) < std::tie(key.m_kind, key.m_level, key.m_count, key.m_a, key.m_b);
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    PrimitiveMesh::PrimitiveMesh() :
+        m_vertexes(), m_indexes()
+    {
+    }
+
+    /**
+     * @brief キーの単位形状を生成
+     * 
+     * @param [in] key キー
+     * 
+     * @return PrimitiveMesh 単位形状
+     * 
+     * @par 詳細
+     *      円・角丸矩形・星形は、中心の頂点から周上の頂点へ扇形に三角形を張る。
+     *      円環は外周と内周の頂点を交互に結ぶ。
+     */
+    PrimitiveMesh PrimitiveMesh::build(const PrimitiveKey& key)
+    {
+        PrimitiveMesh mesh;
+        Vertexes& v = mesh.m_vertexes;
+        Indexes& idx = mesh.m_indexes;
+        const std::uint32_t n = segments(key.level());
+        const float step = (2.0F * MATRIX_PI) / static_cast<float>(n);
+
+        switch (key.kind()) {
+        case PrimitiveKey::KIND::CIRCLE:
+            v.push_back({ 0.0F, 0.0F });
+            for (std::uint32_t i = 0U; i < n; i++) {
+                const float t = step * static_cast<float>(i);
+                v.push_back({ std::cos(t), std::sin(t) });
+            }
+            fan(n, idx);
+            break;
+        case PrimitiveKey::KIND::RING:
+            // 外周[0,n)、内周[n,2n)
+            for (std::uint32_t i = 0U; i < n; i++) {
+                const float t = step * static_cast<float>(i);
+                v.push_back({ std::cos(t), std::sin(t) });
+            }
+            for (std::uint32_t i = 0U; i < n; i++) {
+                const float t = step * static_cast<float>(i);
+                v.push_back({ key.a() * std::cos(t), key.a() * std::sin(t) });
+            }
+            for (std::uint32_t i = 0U; i < n; i++) {
+                const std::uint32_t j = (i + 1U) % n;
+                idx.insert(idx.end(), { i, j, n + j, i, n + j, n + i });
+            }
+            break;
+        case PrimitiveKey::KIND::ROUNDED_RECT:
+        {
+            // 右上・左上・左下・右下の角の順に、角毎に円周の1/4を分割する
+            const float w = key.a() - key.b();
+            const float h = 1.0F - key.b();
+            const std::uint32_t m = (key.b() > 0.0F) ? (n / 4U) : 0U;
+            v.push_back({ 0.0F, 0.0F });
+            arc(w, h, key.b(), 0.0F, m, v);
+            arc(-w, h, key.b(), MATRIX_PI / 2.0F, m, v);
+            arc(-w, -h, key.b(), MATRIX_PI, m, v);
+            arc(w, -h, key.b(), MATRIX_PI * 1.5F, m, v);
+            fan(static_cast<std::uint32_t>(v.size() - 1U), idx);
+            break;
+        }
+        case PrimitiveKey::KIND::ARROW:
+        {
+            // 軸の下辺 → 矢尻 → 軸の上辺の順（反時計回り）
+            const float s = key.a();
+            const float x = 1.0F - key.b();
+            v = { { -1.0F, -s }, { x, -s }, { x, -1.0F }, { 1.0F, 0.0F }, { x, 1.0F }, { x, s }, { -1.0F, s } };
+            idx = { 0U, 1U, 5U, 0U, 5U, 6U, 2U, 3U, 4U };
+            break;
+        }
+        case PrimitiveKey::KIND::STAR:
+        {
+            // 上向きの頂点から、外周・内周の頂点を交互に並べる
+            const std::uint32_t points = key.count() * 2U;
+            const float half = MATRIX_PI / static_cast<float>(key.count());
+            v.push_back({ 0.0F, 0.0F });
+            for (std::uint32_t i = 0U; i < points; i++) {
+                const float t = (MATRIX_PI / 2.0F) + (half * static_cast<float>(i));
+                const float r = ((i % 2U) == 0U) ? 1.0F : key.a();
+                v.push_back({ r * std::cos(t), r * std::sin(t) });
+            }
+            fan(points, idx);
+            break;
+        }
+        default:
+            break;
+        }
+        return mesh;
+    }
+
+    /**
+     * @brief 頂点座標の並びを取得
+     * 
+     * @return const Vertexes& 頂点座標の並び
+     */
+    const Vertexes& PrimitiveMesh::vertexes() const { return this->m_vertexes; }
+
+    /**
+     * @brief 頂点インデックスの並びを取得
+     * 
+     * @return const Indexes& 頂点インデックスの並び（GL_TRIANGLES）
+     */
+    const Indexes& PrimitiveMesh::indexes() const { return this->m_indexes; }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    PrimitiveCache::PrimitiveCache() :
+        m_meshes()
+    {
+    }
+
+    /**
+     * @brief 単位形状を取得（未生成の場合は生成する）
+     * 
+     * @param [in] key キー
+     * 
+     * @return const PrimitiveMesh& 単位形状（同じキーには同じ参照を返す）
+     */
+    const PrimitiveMesh& PrimitiveCache::get(const PrimitiveKey& key)
+    {
+        std::unique_ptr<PrimitiveMesh>& mesh = this->m_meshes[key];
+        if (!mesh) {
+            mesh.reset(new PrimitiveMesh(PrimitiveMesh::build(key)));
+        }
+        return *mesh;
+    }
+
+    /**
+     * @brief 生成済みの単位形状の数を取得
+     * 
+     * @return std::size_t 生成済みの単位形状の数
+     */
+    std::size_t PrimitiveCache::size() const { return this->m_meshes.size(); }
+
+    /**
+     * @brief 生成済みの単位形状を全て破棄
+     * 
+     */
+    void PrimitiveCache::clear() { this->m_meshes.clear(); }
+}
+
+namespace my {
+    /**
+     * @brief PrimitiveMesh, PrimitiveCacheクラスのテストコードを実行
+     * 
+     * @par 詳細
+     *      各図形の三角形の符号付き面積の合計（全て反時計回りであること）を理論値と比較する。
+     */
+    bool testcode_Primitive()
+    {
+        std::cout << "[testcode_Primitive()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const char* name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+        // 三角形が全て反時計回りであれば面積の合計を返し、そうでなければ-1を返す
+        const auto area = [](const PrimitiveMesh& mesh) {
+            const Vertexes& v = mesh.vertexes();
+            const Indexes& idx = mesh.indexes();
+            float sum = 0.0F;
+            for (std::size_t i = 0U; (i + 2U) < idx.size(); i += 3U) {
+                const Vertex& a = v[idx[i].idx()];
+                const Vertex& b = v[idx[i + 1U].idx()];
+                const Vertex& c = v[idx[i + 2U].idx()];
+                const float s = (((b.x() - a.x()) * (c.y() - a.y())) - ((b.y() - a.y()) * (c.x() - a.x()))) / 2.0F;
+                if (!(s > 0.0F)) {
+                    return -1.0F;
+                }
+                sum += s;
+            }
+            return sum;
+        };
+        const auto near = [](const float a, const float b) { return std::fabs(a - b) < 1.0e-3F; };
+
+        // 円：n / 2 * sin(2π / n)
+        const PrimitiveMesh circle = PrimitiveMesh::build(PrimitiveKey::circle(2U));
+        const float n = 32.0F;
+        const float polygon = (n / 2.0F) * std::sin((2.0F * MATRIX_PI) / n);
+        check("circle", (circle.vertexes().size() == 33U) && (circle.indexes().size() == 96U) && near(area(circle), polygon));
+        // 円環：円 * (1 - inner^2)
+        check("ring", near(area(PrimitiveMesh::build(PrimitiveKey::ring(0.5F, 2U))), polygon * 0.75F));
+        // 角丸矩形：矩形 - 角の正方形 + 角の1/4円（m分割）
+        const float m = 8.0F;
+        const float quarter = (m / 2.0F) * std::sin((MATRIX_PI / 2.0F) / m);
+        check("rounded rect", near(area(PrimitiveMesh::build(PrimitiveKey::roundedRect(2.0F, 0.5F, 2U))), (8.0F - 1.0F) + (4.0F * quarter * 0.25F)));
+        check("rect", near(area(PrimitiveMesh::build(PrimitiveKey::roundedRect(1.5F, 0.0F, 5U))), 6.0F));
+        // 矢印：軸 2s(2 - h) + 矢尻 h
+        check("arrow", near(area(PrimitiveMesh::build(PrimitiveKey::arrow(0.25F, 0.75F))), (0.5F * 1.25F) + 0.75F));
+        // 星形：count * inner * sin(π / count)
+        check("star", near(area(PrimitiveMesh::build(PrimitiveKey::star(5U, 0.4F))), 5.0F * 0.4F * std::sin(MATRIX_PI / 5.0F)));
+
+        // キャッシュ：同じキーは同じ単位形状を共有する
+        PrimitiveCache cache;
+        const PrimitiveMesh& c1 = cache.get(PrimitiveKey::circle(1U));
+        const PrimitiveMesh& c2 = cache.get(PrimitiveKey::ellipse(1U));
+        const PrimitiveMesh& c3 = cache.get(PrimitiveKey::circle(2U));
+        check("cache", (&c1 == &c2) && (&c1 != &c3) && (cache.size() == 2U));
+        const PrimitiveKey star = PrimitiveKey::star(5U, 0.4F);
+        check("level", (&cache.get(star) == &cache.get(star.withLevel(4U))) && (cache.size() == 3U) &&
+                       (PrimitiveKey::level(1.0F, 0.5F) == 0U) && (PrimitiveKey::level(100.0F, 0.25F) == 3U) &&
+                       (PrimitiveKey::level(1.0e6F, 0.25F) == PrimitiveKey::MAX_LEVEL));
+        cache.clear();
+        check("clear", cache.size() == 0U);
+        return ok;
+    }
+}
@@ -0,0 +1,137 @@
+﻿/**
+ * @file Primitive.hpp
+ * @author kota-kota
+ * @brief 基本図形（円・角丸矩形・矢印など）の単位形状を生成するクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_PRIMITIVE_HPP
+#define INCLUDED_PRIMITIVE_HPP
+
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+
+namespace my {
+    /**
+     * @class PrimitiveKey
+     * @brief 基本図形の種類・分割段・形状パラメータの組を扱うクラス
+     * 
+     * @par 詳細
+     *      単位形状のキャッシュのキーとする。生成関数で値を有効な範囲に丸める。
+     *      曲線を含まない図形（矢印・星形）は分割段を持たず、常に0とする。
+     *      楕円は円の単位形状を縦横異なる拡大率で配置して描画するため、円と同じキーとする。
+     */
+    class PrimitiveKey {
+    public:
+        //! 図形の種類
+        enum class KIND { CIRCLE, RING, ROUNDED_RECT, ARROW, STAR };
+        //! 分割段の上限
+        static const std::uint32_t MAX_LEVEL;
+
+    private:
+        KIND            m_kind;     //!< 図形の種類
+        std::uint32_t   m_level;    //!< 分割段（円周の分割数は8 * 2^段）
+        std::uint32_t   m_count;    //!< 星形の頂点数
+        float           m_a;        //!< 形状パラメータ1（円環:内径の比、角丸矩形:縦横比、矢印:軸の太さの比、星形:内径の比）
+        float           m_b;        //!< 形状パラメータ2（角丸矩形:角の半径の比、矢印:矢尻の長さの比）
+
+    private:
+        //! コンストラクタ
+        PrimitiveKey(const KIND kind, const std::uint32_t level, const std::uint32_t count, const float a, const float b);
+
+    public:
+        //! 円（半径1）
+        static PrimitiveKey circle(const std::uint32_t level);
+        //! 楕円（半径1の円。配置時に縦横の拡大率で形を決める）
+        static PrimitiveKey ellipse(const std::uint32_t level);
+        //! 円環（外径1、内径inner）
+        static PrimitiveKey ring(const float inner, const std::uint32_t level);
+        //! 角丸矩形（幅2 * aspect、高さ2、角の半径radius）
+        static PrimitiveKey roundedRect(const float aspect, const float radius, const std::uint32_t level);
+        //! 矢印（(-1,0)から(1,0)へ向かう。矢尻の幅2、軸の幅2 * shaft、矢尻の長さhead）
+        static PrimitiveKey arrow(const float shaft, const float head);
+        //! 星形（外径1、内径inner、頂点数count）
+        static PrimitiveKey star(const std::uint32_t count, const float inner);
+        //! 画面上の半径と許容誤差から分割段を選択
+        static std::uint32_t level(const float radius, const float tolerance);
+
+    public:
+        //! 図形の種類を取得
+        KIND kind() const;
+        //! 分割段を取得
+        std::uint32_t level() const;
+        //! 星形の頂点数を取得
+        std::uint32_t count() const;
+        //! 形状パラメータ1を取得
+        float a() const;
+        //! 形状パラメータ2を取得
+        float b() const;
+        //! 分割段のみ変えたキーを取得
+        PrimitiveKey withLevel(const std::uint32_t level) const;
+        //! <演算子のオーバーロード（キャッシュのキーとして比較する）
+        bool operator<(const PrimitiveKey& key) const;
+    };
+}
+
+namespace my {
+    /**
+     * @class PrimitiveMesh
+     * @brief 基本図形の単位形状（GL_TRIANGLESの頂点データ）を扱うクラス
+     * 
+     * @par 詳細
+     *      原点を中心とし、概ね[-1,1]の範囲に収まる形状とする（角丸矩形のみX方向はaspect倍）。
+     *      三角形は反時計回りとする。頂点色は持たず、配置毎の色で描画する。
+     */
+    class PrimitiveMesh {
+        Vertexes    m_vertexes;     //!< 頂点座標の並び
+        Indexes     m_indexes;      //!< 頂点インデックスの並び（GL_TRIANGLES）
+
+    public:
+        //! デフォルトコンストラクタ
+        PrimitiveMesh();
+        //! キーの単位形状を生成
+        static PrimitiveMesh build(const PrimitiveKey& key);
+
+    public:
+        //! 頂点座標の並びを取得
+        const Vertexes& vertexes() const;
+        //! 頂点インデックスの並びを取得
+        const Indexes& indexes() const;
+    };
+
+    /**
+     * @class PrimitiveCache
+     * @brief 基本図形の単位形状をキー毎に1つだけ生成して共有するクラス
+     * 
+     * @par 詳細
+     *      取得した単位形状の参照は、clear()するまで有効とする。
+     *      描画スレッドからのみ使用する（排他制御は行わない）。
+     */
+    class PrimitiveCache {
+        std::map<PrimitiveKey, std::unique_ptr<PrimitiveMesh>>  m_meshes;   //!< 生成済みの単位形状
+
+    public:
+        //! デフォルトコンストラクタ
+        PrimitiveCache();
+
+    public:
+        //! 単位形状を取得（未生成の場合は生成する）
+        const PrimitiveMesh& get(const PrimitiveKey& key);
+        //! 生成済みの単位形状の数を取得
+        std::size_t size() const;
+        //! 生成済みの単位形状を全て破棄
+        void clear();
+    };
+}
+
+namespace my {
+    //! PrimitiveMesh, PrimitiveCacheクラスのテストコードを実行
+    bool testcode_Primitive();
+}
+
+#endif //INCLUDED_PRIMITIVE_HPP
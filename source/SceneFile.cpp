@@ -0,0 +1,774 @@
+﻿/**
+ * @file SceneFile.cpp
+ * @author kota-kota
+ * @brief シーンファイル（バイナリ形式）を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "SceneFile.hpp"
+#include "StripBatch.hpp"
+#include "VertexCodec.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * シーンファイルの形式（リトルエンディアン）
+ * 
+ *  FileHeader
+ *  SectionHeader x section_num
+ *  セクションの並び（先頭はSECTION_ALIGNの倍数の位置）
+ *      VERTEXES    : Vertex(float x3)の並び
+ *      COLORS      : Color(uint8 x4)の並び（VERTEXESと同数）
+ *      INDEXES16   : uint16の頂点インデックスの並び
+ *      INDEXES32   : uint32の頂点インデックスの並び
+ *      SHAPES      : ShapeRecordの並び
+ *      STRINGS     : 終端文字付きの文字列の並び
+ *      ENCODED     : 圧縮した形状の頂点座標・頂点色・頂点インデックスの並び（版数2以降）
+ * 
+ *  圧縮した形状（ShapeRecord::flagsにFLAG_ENCODED）は、ENCODEDセクションのvertex_first[byte]から
+ *  encoded_size[byte]に、VertexCodecの頂点座標・頂点色、IndexCodecの頂点インデックスを順に格納する。
+ */
+namespace {
+    //! ファイル識別子
+    constexpr char MAGIC[4] = { 'M', 'Y', 'S', 'C' };
+    //! エンディアン確認用の値
+    constexpr std::uint32_t ENDIAN = 0x01020304U;
+    //! セクションの配置境界[byte]
+    constexpr std::uint64_t SECTION_ALIGN = 16U;
+
+    //! セクションの種別
+    enum SECTION : std::uint32_t { VERTEXES = 1U, COLORS, INDEXES16, INDEXES32, SHAPES, STRINGS, ENCODED, SECTION_NUM = ENCODED };
+
+    //! 形状のフラグ：圧縮した形状
+    constexpr std::uint32_t FLAG_ENCODED = 0x01U;
+    //! 形状のフラグ：頂点インデックスを三角形の並びとして圧縮した
+    constexpr std::uint32_t FLAG_TRIANGLES = 0x02U;
+    //! 描画モード：三角形の並び（GL_TRIANGLESの値）
+    constexpr std::uint32_t MODE_TRIANGLES = 0x0004U;
+
+    /**
+     * @struct FileHeader
+     * @brief ファイルヘッダ
+     */
+    struct FileHeader {
+        char            magic[4];       //!< ファイル識別子
+        std::uint32_t   version;        //!< 版数
+        std::uint32_t   endian;         //!< エンディアン確認用の値
+        std::uint32_t   section_num;    //!< セクション数
+    };
+
+    /**
+     * @struct SectionHeader
+     * @brief セクションヘッダ
+     */
+    struct SectionHeader {
+        std::uint32_t   type;       //!< 種別
+        std::uint32_t   reserved;   //!< 予約
+        std::uint64_t   offset;     //!< ファイル先頭からの位置[byte]
+        std::uint64_t   size;       //!< サイズ[byte]
+    };
+
+    /**
+     * @struct ShapeRecord
+     * @brief 形状ごとの情報
+     */
+    struct ShapeRecord {
+        std::uint32_t   mode;           //!< 描画モード（GLenumの値）
+        std::uint32_t   name;           //!< 名前の位置（STRINGSセクション内[byte]）
+        std::uint32_t   vertex_first;   //!< 先頭の頂点の位置（VERTEXES/COLORSセクション内[個]、圧縮した形状はENCODEDセクション内[byte]）
+        std::uint32_t   vertex_num;     //!< 頂点数
+        std::uint32_t   index_size;     //!< 頂点インデックス1個のバイト数（2:INDEXES16 4:INDEXES32、圧縮した形状は復号後のバイト数）
+        std::uint32_t   index_first;    //!< 先頭の頂点インデックスの位置（セクション内[個]、圧縮した形状は0）
+        std::uint32_t   index_num;      //!< 頂点インデックス数
+        std::uint32_t   flags;          //!< フラグ（FLAG_ENCODED、FLAG_TRIANGLES、版数1では0）
+        float           pos[3];         //!< 描画位置
+        std::uint32_t   encoded_size;   //!< 圧縮したデータのサイズ[byte]（圧縮した形状のみ）
+    };
+
+    //! 配置境界に切り上げ
+    std::uint64_t alignUp(const std::uint64_t value)
+    {
+        return (value + SECTION_ALIGN - 1U) & ~(SECTION_ALIGN - 1U);
+    }
+
+    //! 範囲が[0, size)に収まるか判定（オーバーフローしない判定）
+    bool inRange(const std::uint64_t first, const std::uint64_t num, const std::uint64_t size)
+    {
+        return (first <= size) && (num <= (size - first));
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    MappedFile::MappedFile() :
+        m_data(nullptr), m_size(0U),
+#ifdef _WIN32
+        m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr)
+#else
+        m_fd(-1)
+#endif
+    {
+    }
+
+    /**
+     * @brief デストラクタ
+     * 
+     */
+    MappedFile::~MappedFile()
+    {
+        this->close();
+    }
+
+    /**
+     * @brief ファイルをマッピング
+     * 
+     * @param [in] path ファイルパス
+     * 
+     * @retval true 成功
+     * @retval false 失敗（ファイルがない、空のファイルなど）
+     */
+    bool MappedFile::open(const std::string& path)
+    {
+        this->close();
+#ifdef _WIN32
+        this->m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (this->m_file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if ((GetFileSizeEx(this->m_file, &size) == FALSE) || (size.QuadPart <= 0)) {
+            this->close();
+            return false;
+        }
+        this->m_mapping = CreateFileMappingA(this->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (this->m_mapping == nullptr) {
+            this->close();
+            return false;
+        }
+        const void* data = MapViewOfFile(this->m_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr) {
+            this->close();
+            return false;
+        }
+        this->m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+        this->m_fd = ::open(path.c_str(), O_RDONLY);
+        if (this->m_fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if ((fstat(this->m_fd, &st) != 0) || (st.st_size <= 0)) {
+            this->close();
+            return false;
+        }
+        void* data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, this->m_fd, 0);
+        if (data == MAP_FAILED) {
+            this->close();
+            return false;
+        }
+        this->m_size = static_cast<std::size_t>(st.st_size);
+#endif
+        this->m_data = static_cast<const std::uint8_t*>(data);
+        return true;
+    }
+
+    /**
+     * @brief マッピングを解除
+     * 
+     */
+    void MappedFile::close()
+    {
+#ifdef _WIN32
+        if (this->m_data != nullptr) {
+            UnmapViewOfFile(this->m_data);
+        }
+        if (this->m_mapping != nullptr) {
+            CloseHandle(this->m_mapping);
+        }
+        if (this->m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(this->m_file);
+        }
+        this->m_mapping = nullptr;
+        this->m_file = INVALID_HANDLE_VALUE;
+#else
+        if (this->m_data != nullptr) {
+            munmap(const_cast<std::uint8_t*>(this->m_data), this->m_size);
+        }
+        if (this->m_fd >= 0) {
+            ::close(this->m_fd);
+        }
+        this->m_fd = -1;
+#endif
+        this->m_data = nullptr;
+        this->m_size = 0U;
+    }
+
+    /**
+     * @brief マッピングした先頭アドレスを取得
+     * 
+     * @return const std::uint8_t* 先頭アドレス（マッピングしていない場合はnullptr）
+     */
+    const std::uint8_t* MappedFile::data() const { return this->m_data; }
+
+    /**
+     * @brief ファイルサイズを取得
+     * 
+     * @return std::size_t ファイルサイズ[byte]
+     */
+    std::size_t MappedFile::size() const { return this->m_size; }
+
+    /**
+     * @brief マッピングした全ページを読み込み
+     * 
+     * @par 詳細
+     *      ページ毎に1byteずつ読み、ページフォルトを呼び出し元のスレッドで発生させる。
+     *      描画スレッドで転送する前にワーカースレッドで呼ぶと、転送時の読み込み待ちを避けられる。
+     */
+    void MappedFile::prefetch() const
+    {
+        constexpr std::size_t PAGE_SIZE = 4096U;
+        volatile std::uint8_t sum = 0U;
+        for (std::size_t i = 0U; i < this->m_size; i += PAGE_SIZE) {
+            sum = static_cast<std::uint8_t>(sum + this->m_data[i]);
+        }
+        (void)sum;
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] name 形状の名前
+     * @param [in] mode 描画モード（GLenumの値）
+     * @param [in] vertexes 頂点座標の並び
+     * @param [in] colors 頂点色の並び
+     * @param [in] vertex_num 頂点数
+     * @param [in] indexes 頂点インデックスの並び
+     * @param [in] index_num 頂点インデックス数
+     * @param [in] index_size 頂点インデックス1個のバイト数
+     * @param [in] pos 描画位置
+     */
+    SceneShape::SceneShape(const char* name, const std::uint32_t mode, const Vertex* vertexes, const Color* colors, const std::size_t vertex_num,
+                           const void* indexes, const std::size_t index_num, const std::uint32_t index_size, const Vector& pos) :
+        m_name(name), m_mode(mode), m_vertexes(vertexes), m_colors(colors), m_vertex_num(vertex_num),
+        m_indexes(indexes), m_index_num(index_num), m_index_size(index_size), m_pos(pos)
+    {
+    }
+
+    /**
+     * @brief 形状の名前を取得
+     * 
+     * @return const char* 形状の名前
+     */
+    const char* SceneShape::name() const { return this->m_name; }
+
+    /**
+     * @brief 描画モード（GLenumの値）を取得
+     * 
+     * @return std::uint32_t 描画モード
+     */
+    std::uint32_t SceneShape::mode() const { return this->m_mode; }
+
+    /**
+     * @brief 頂点座標の並びを取得
+     * 
+     * @return const Vertex* 頂点座標の並び
+     */
+    const Vertex* SceneShape::vertexes() const { return this->m_vertexes; }
+
+    /**
+     * @brief 頂点色の並びを取得
+     * 
+     * @return const Color* 頂点色の並び
+     */
+    const Color* SceneShape::colors() const { return this->m_colors; }
+
+    /**
+     * @brief 頂点数を取得
+     * 
+     * @return std::size_t 頂点数
+     */
+    std::size_t SceneShape::vertexNum() const { return this->m_vertex_num; }
+
+    /**
+     * @brief 頂点インデックスの並びを取得
+     * 
+     * @return const void* 頂点インデックスの並び（indexSize()のバイト数毎）
+     */
+    const void* SceneShape::indexes() const { return this->m_indexes; }
+
+    /**
+     * @brief 頂点インデックス数を取得
+     * 
+     * @return std::size_t 頂点インデックス数
+     */
+    std::size_t SceneShape::indexNum() const { return this->m_index_num; }
+
+    /**
+     * @brief 頂点インデックス1個のバイト数を取得
+     * 
+     * @return std::uint32_t バイト数（2または4）
+     */
+    std::uint32_t SceneShape::indexSize() const { return this->m_index_size; }
+
+    /**
+     * @brief 描画位置を取得
+     * 
+     * @return const Vector& 描画位置
+     */
+    const Vector& SceneShape::pos() const { return this->m_pos; }
+}
+
+namespace my {
+    const std::uint32_t SceneFile::VERSION = 2U;
+
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    SceneFile::SceneFile() :
+        m_file(), m_shapes(), m_decoded()
+    {
+    }
+
+    /**
+     * @brief ファイルを開く
+     * 
+     * @param [in] path ファイルパス
+     * 
+     * @retval true 成功
+     * @retval false 失敗（ファイルがない、形式・版数が異なる、範囲外を指す、圧縮したデータが壊れているなど）
+     * 
+     * @par 詳細
+     *      圧縮した形状は、呼び出し元のスレッドで復号し、転送できる形式で保持する。
+     *      タイル毎にワーカースレッドから呼ぶため、ログは失敗時の理由のみ出力する。
+     */
+    bool SceneFile::open(const std::string& path)
+    {
+        this->close();
+        if (!this->m_file.open(path)) {
+            std::cerr << "[SceneFile::open()] cannot map " << path << std::endl;
+            return false;
+        }
+        const std::uint8_t* data = this->m_file.data();
+        const std::uint64_t size = this->m_file.size();
+        const auto fail = [&](const char* reason) {
+            std::cerr << "[SceneFile::open()] " << reason << " " << path << std::endl;
+            this->close();
+            return false;
+        };
+
+        // ファイルヘッダ
+        FileHeader header;
+        if (size < sizeof(header)) {
+            return fail("too small");
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            return fail("not a scene file");
+        }
+        if ((header.version == 0U) || (header.version > VERSION) || (header.endian != ENDIAN)) {
+            return fail("unsupported version or endian");
+        }
+        if (!inRange(sizeof(header), static_cast<std::uint64_t>(header.section_num) * sizeof(SectionHeader), size)) {
+            return fail("broken section table");
+        }
+
+        // セクション表（種別毎の位置とサイズ）
+        const std::uint8_t* sections[SECTION_NUM + 1U] = {};
+        std::uint64_t sizes[SECTION_NUM + 1U] = {};
+        for (std::uint32_t i = 0U; i < header.section_num; i++) {
+            SectionHeader section;
+            std::memcpy(&section, data + sizeof(header) + (i * sizeof(SectionHeader)), sizeof(section));
+            if (!inRange(section.offset, section.size, size) || ((section.offset % SECTION_ALIGN) != 0U)) {
+                return fail("broken section");
+            }
+            // 未知の種別は読み飛ばす
+            if ((section.type >= VERTEXES) && (section.type <= SECTION_NUM)) {
+                sections[section.type] = data + section.offset;
+                sizes[section.type] = section.size;
+            }
+        }
+
+        // 形状
+        const std::uint64_t vertex_num = sizes[VERTEXES] / sizeof(Vertex);
+        if ((sizes[COLORS] / sizeof(Color)) < vertex_num) {
+            return fail("missing colors");
+        }
+        const std::uint64_t shape_num = sizes[SHAPES] / sizeof(ShapeRecord);
+        this->m_shapes.reserve(static_cast<std::size_t>(shape_num));
+        const char* strings = reinterpret_cast<const char*>(sections[STRINGS]);
+        for (std::uint64_t i = 0U; i < shape_num; i++) {
+            ShapeRecord r;
+            std::memcpy(&r, sections[SHAPES] + (i * sizeof(ShapeRecord)), sizeof(r));
+            if ((r.name >= sizes[STRINGS]) || (std::memchr(strings + r.name, '\0', static_cast<std::size_t>(sizes[STRINGS] - r.name)) == nullptr)) {
+                return fail("broken shape");
+            }
+            if ((r.flags & FLAG_ENCODED) != 0U) {
+                // 圧縮した形状は復号して保持する
+                // 頂点は3byte以上、頂点インデックスは三角形毎に1byte以上となるため、圧縮したデータより多い数は確保前に失敗とする
+                if (((r.index_size != 2U) && (r.index_size != 4U)) || !inRange(r.vertex_first, r.encoded_size, sizes[ENCODED]) ||
+                    (r.vertex_num > r.encoded_size) || (r.index_num > (static_cast<std::uint64_t>(r.encoded_size) * 3U))) {
+                    return fail("broken shape");
+                }
+                std::unique_ptr<Decoded> d(new Decoded{ Vertexes(r.vertex_num), Colors(r.vertex_num),
+                                                        std::vector<std::uint8_t>(static_cast<std::size_t>(r.index_num) * r.index_size) });
+                const std::uint8_t* last = sections[ENCODED] + r.vertex_first + r.encoded_size;
+                const std::uint8_t* p = VertexCodec::decode(sections[ENCODED] + r.vertex_first, last, d->vertexes.data(), r.vertex_num);
+                p = (p == nullptr) ? nullptr : VertexCodec::decodeColors(p, last, d->colors.data(), r.vertex_num);
+                if ((r.flags & FLAG_TRIANGLES) != 0U) {
+                    p = (p == nullptr) ? nullptr : IndexCodec::decodeTriangles(p, last, d->indexes.data(), r.index_num, r.index_size, r.vertex_num);
+                }
+                else {
+                    p = (p == nullptr) ? nullptr : IndexCodec::decodeSequence(p, last, d->indexes.data(), r.index_num, r.index_size, r.vertex_num);
+                }
+                if (p == nullptr) {
+                    return fail("broken encoded shape");
+                }
+                this->m_shapes.push_back(SceneShape(strings + r.name, r.mode, d->vertexes.data(), d->colors.data(), r.vertex_num,
+                                                    d->indexes.data(), r.index_num, r.index_size, Vector(r.pos[0], r.pos[1], r.pos[2])));
+                this->m_decoded.push_back(std::move(d));
+                continue;
+            }
+            const SECTION isection = (r.index_size == 2U) ? INDEXES16 : INDEXES32;
+            if (((r.index_size != 2U) && (r.index_size != 4U)) ||
+                !inRange(r.vertex_first, r.vertex_num, vertex_num) ||
+                !inRange(r.index_first, r.index_num, sizes[isection] / r.index_size)) {
+                return fail("broken shape");
+            }
+            this->m_shapes.push_back(SceneShape(
+                strings + r.name, r.mode,
+                reinterpret_cast<const Vertex*>(sections[VERTEXES]) + r.vertex_first,
+                reinterpret_cast<const Color*>(sections[COLORS]) + r.vertex_first, r.vertex_num,
+                sections[isection] + (static_cast<std::uint64_t>(r.index_first) * r.index_size), r.index_num, r.index_size,
+                Vector(r.pos[0], r.pos[1], r.pos[2])));
+        }
+        return true;
+    }
+
+    /**
+     * @brief ファイルを閉じる
+     * 
+     */
+    void SceneFile::close()
+    {
+        this->m_shapes.clear();
+        this->m_decoded.clear();
+        this->m_file.close();
+    }
+
+    /**
+     * @brief 頂点データを事前に読み込み
+     * 
+     */
+    void SceneFile::prefetch() const { this->m_file.prefetch(); }
+
+    /**
+     * @brief 形状の数を取得
+     * 
+     * @return std::size_t 形状の数
+     */
+    std::size_t SceneFile::size() const { return this->m_shapes.size(); }
+
+    /**
+     * @brief 形状を取得
+     * 
+     * @param [in] i 形状の位置
+     * 
+     * @return const SceneShape& 形状
+     */
+    const SceneShape& SceneFile::at(const std::size_t i) const { return this->m_shapes.at(i); }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    SceneWriter::SceneWriter() :
+        m_entries(), m_bits(0U)
+    {
+    }
+
+    /**
+     * @brief 圧縮を設定
+     * 
+     * @param [in] bits 頂点座標の量子化のビット数（1～24、0は圧縮しない）
+     * 
+     * @par 詳細
+     *      三角形の並び（GL_TRIANGLES）は、頂点を参照順に並べ替えておくと圧縮率が高くなる。
+     */
+    void SceneWriter::setCompression(const std::uint32_t bits) { this->m_bits = bits; }
+
+    /**
+     * @brief 形状を追加
+     * 
+     * @param [in] name 形状の名前
+     * @param [in] mode 描画モード（GLenumの値）
+     * @param [in] vertexes 頂点座標の並び
+     * @param [in] indexes 頂点インデックスの並び（リスタート値は0xFFFFFFFF）
+     * @param [in] colors 頂点色の並び（頂点座標と同数）
+     * @param [in] pos 描画位置
+     * 
+     * @retval true 成功
+     * @retval false 失敗（頂点色の数が異なる、頂点インデックスが範囲外）
+     */
+    bool SceneWriter::add(const std::string& name, const std::uint32_t mode, const Vertexes& vertexes, const Indexes& indexes, const Colors& colors, const Vector& pos)
+    {
+        if (vertexes.size() != colors.size()) {
+            std::cerr << "[SceneWriter::add()] colors mismatch " << name << std::endl;
+            return false;
+        }
+        for (const Index& i : indexes) {
+            if ((i.idx() >= vertexes.size()) && (i.idx() != StripBatch::RESTART32)) {
+                std::cerr << "[SceneWriter::add()] index out of range " << name << std::endl;
+                return false;
+            }
+        }
+        this->m_entries.push_back({ name, mode, vertexes, indexes, colors, pos });
+        return true;
+    }
+
+    /**
+     * @brief ファイルに書き込み
+     * 
+     * @param [in] path ファイルパス
+     * 
+     * @retval true 成功
+     * @retval false 失敗
+     */
+    bool SceneWriter::write(const std::string& path) const
+    {
+        // セクションの内容を作成する
+        Vertexes vertexes;
+        Colors colors;
+        Indexes16 indexes16;
+        std::vector<std::uint32_t> indexes32;
+        std::vector<ShapeRecord> shapes;
+        std::string strings;
+        std::vector<std::uint8_t> encoded;
+        for (const Entry& e : this->m_entries) {
+            ShapeRecord r = {};
+            r.mode = e.mode;
+            r.name = static_cast<std::uint32_t>(strings.size());
+            r.vertex_first = static_cast<std::uint32_t>(vertexes.size());
+            r.vertex_num = static_cast<std::uint32_t>(e.vertexes.size());
+            r.index_num = static_cast<std::uint32_t>(e.indexes.size());
+            if (this->m_bits != 0U) {
+                // 頂点座標・頂点色・頂点インデックスの順に圧縮する
+                r.flags = FLAG_ENCODED;
+                r.vertex_first = static_cast<std::uint32_t>(encoded.size());
+                r.index_size = StripBatch::fits16(e.vertexes.size()) ? 2U : 4U;
+                VertexCodec(this->m_bits).encode(e.vertexes, encoded);
+                VertexCodec::encodeColors(e.colors, encoded);
+                if ((e.mode == MODE_TRIANGLES) && IndexCodec::encodeTriangles(e.indexes, encoded)) {
+                    r.flags |= FLAG_TRIANGLES;
+                }
+                else {
+                    IndexCodec::encodeSequence(e.indexes, encoded);
+                }
+                r.encoded_size = static_cast<std::uint32_t>(encoded.size() - r.vertex_first);
+            }
+            else if (StripBatch::fits16(e.vertexes.size())) {
+                const Indexes16 narrow = StripBatch::narrow(e.indexes);
+                r.index_size = 2U;
+                r.index_first = static_cast<std::uint32_t>(indexes16.size());
+                indexes16.insert(indexes16.end(), narrow.begin(), narrow.end());
+            }
+            else {
+                r.index_size = 4U;
+                r.index_first = static_cast<std::uint32_t>(indexes32.size());
+                for (const Index& i : e.indexes) {
+                    indexes32.push_back(i.idx());
+                }
+            }
+            r.pos[0] = e.pos.x();
+            r.pos[1] = e.pos.y();
+            r.pos[2] = e.pos.z();
+            if ((r.flags & FLAG_ENCODED) == 0U) {
+                vertexes.insert(vertexes.end(), e.vertexes.begin(), e.vertexes.end());
+                colors.insert(colors.end(), e.colors.begin(), e.colors.end());
+            }
+            strings.append(e.name);
+            strings.push_back('\0');
+            shapes.push_back(r);
+        }
+
+        const std::pair<const void*, std::uint64_t> contents[SECTION_NUM] = {
+            { vertexes.data(), vertexes.size() * sizeof(Vertex) },
+            { colors.data(), colors.size() * sizeof(Color) },
+            { indexes16.data(), indexes16.size() * sizeof(std::uint16_t) },
+            { indexes32.data(), indexes32.size() * sizeof(std::uint32_t) },
+            { shapes.data(), shapes.size() * sizeof(ShapeRecord) },
+            { strings.data(), strings.size() },
+            { encoded.data(), encoded.size() },
+        };
+
+        // ヘッダ・セクション表の後ろに、配置境界に揃えてセクションを並べる
+        const FileHeader header = { { MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3] }, SceneFile::VERSION, ENDIAN, SECTION_NUM };
+        SectionHeader table[SECTION_NUM];
+        std::uint64_t offset = alignUp(sizeof(header) + sizeof(table));
+        for (std::uint32_t i = 0U; i < SECTION_NUM; i++) {
+            table[i] = { i + 1U, 0U, offset, contents[i].second };
+            offset = alignUp(offset + contents[i].second);
+        }
+
+        std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+        if (!ofs) {
+            std::cerr << "[SceneWriter::write()] cannot open " << path << std::endl;
+            return false;
+        }
+        const char zeros[SECTION_ALIGN] = {};
+        std::uint64_t written = sizeof(header) + sizeof(table);
+        ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<const char*>(&table[0]), sizeof(table));
+        for (std::uint32_t i = 0U; i < SECTION_NUM; i++) {
+            ofs.write(&zeros[0], static_cast<std::streamsize>(table[i].offset - written));
+            ofs.write(static_cast<const char*>(contents[i].first), static_cast<std::streamsize>(contents[i].second));
+            written = table[i].offset + contents[i].second;
+        }
+        return static_cast<bool>(ofs);
+    }
+}
+
+namespace my {
+    /**
+     * @brief SceneFileクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     * 
+     * @par 詳細
+     *      書き込んだファイルを読み込み、形状の内容が一致することを確認する。
+     */
+    bool testcode_SceneFile()
+    {
+        std::cout << "[testcode_SceneFile()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const char* name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+        const std::string path = "testcode_SceneFile.bin";
+
+        // 16bit・32bitの頂点インデックスの形状
+        const Vertexes small_v = { { 0.0F, 0.0F }, { 1.0F, 0.0F }, { 0.0F, 1.0F } };
+        const Colors small_c = { { 255, 0, 0, 255 }, { 0, 255, 0, 255 }, { 0, 0, 255, 255 } };
+        const Indexes small_i = { 0U, 1U, 2U, StripBatch::RESTART32, 2U, 1U };
+        Vertexes large_v;
+        Indexes large_i;
+        for (std::uint32_t i = 0U; i < 70000U; i++) {
+            large_v.push_back({ static_cast<float>(i), 0.0F });
+            large_i.push_back(69999U - i);
+        }
+        const Colors large_c(large_v.size(), Color(1, 2, 3, 4));
+
+        SceneWriter writer;
+        check("add", writer.add("small", 5U, small_v, small_i, small_c, { 10.0F, 20.0F, 0.0F }) && writer.add("large", 3U, large_v, large_i, large_c, { 0.0F, 0.0F, 0.0F }));
+        check("add invalid", !writer.add("broken", 4U, small_v, { 0U, 3U, 1U }, small_c, { 0.0F, 0.0F, 0.0F }));
+        check("write", writer.write(path));
+
+        SceneFile scene;
+        check("open", scene.open(path) && (scene.size() == 2U));
+        if (scene.size() == 2U) {
+            const SceneShape& s = scene.at(0U);
+            const std::uint16_t* i16 = static_cast<const std::uint16_t*>(s.indexes());
+            check("small", (std::string(s.name()) == "small") && (s.mode() == 5U) && (s.vertexNum() == 3U) && (s.indexSize() == 2U) && (s.indexNum() == 6U) &&
+                           (i16[3] == StripBatch::RESTART16) && (i16[5] == 1U) && !(s.vertexes()[1].x() < 1.0F) && !(s.vertexes()[1].x() > 1.0F) &&
+                           (s.colors()[2].b() == 255U) && !(s.pos().y() < 20.0F) && !(s.pos().y() > 20.0F));
+            const SceneShape& l = scene.at(1U);
+            const std::uint32_t* i32 = static_cast<const std::uint32_t*>(l.indexes());
+            check("large", (std::string(l.name()) == "large") && (l.indexSize() == 4U) && (l.vertexNum() == 70000U) && (i32[0] == 69999U) &&
+                           !(l.vertexes()[69999].x() < 69999.0F) && (l.colors()[123].a() == 4U));
+            // 頂点データは4byte境界に配置される（glBufferDataへ直接渡せる）
+            check("aligned", ((reinterpret_cast<std::uintptr_t>(s.vertexes()) % 4U) == 0U) && ((reinterpret_cast<std::uintptr_t>(l.indexes()) % 4U) == 0U));
+        }
+        scene.close();
+
+        // 圧縮した形状：頂点座標は量子化の誤差以内、頂点色・頂点インデックスは一致する
+        const Vertexes tri_v = { { 0.0F, 0.0F }, { 1.0F, 0.0F }, { 0.0F, 1.0F }, { 1.0F, 1.0F } };
+        const Colors tri_c = { { 1, 2, 3, 4 }, { 5, 6, 7, 8 }, { 9, 10, 11, 12 }, { 13, 14, 15, 16 } };
+        SceneWriter compressed;
+        compressed.setCompression(16U);
+        check("add compressed", compressed.add("triangles", 4U, tri_v, { 0U, 1U, 2U, 2U, 1U, 3U }, tri_c, { 1.0F, 2.0F, 0.0F }) &&
+                                compressed.add("strips", 5U, small_v, small_i, small_c, { 0.0F, 0.0F, 0.0F }));
+        check("write compressed", compressed.write(path));
+        check("open compressed", scene.open(path) && (scene.size() == 2U));
+        if (scene.size() == 2U) {
+            const SceneShape& t = scene.at(0U);
+            const std::uint16_t* i16 = static_cast<const std::uint16_t*>(t.indexes());
+            check("triangles", (std::string(t.name()) == "triangles") && (t.vertexNum() == 4U) && (t.indexNum() == 6U) && (t.indexSize() == 2U) &&
+                               (std::abs(t.vertexes()[3].x() - 1.0F) < 1.0e-4F) && (t.colors()[3].a() == 16U) &&
+                               (std::max(std::max(i16[0], i16[1]), i16[2]) == 2U) && (std::max(std::max(i16[3], i16[4]), i16[5]) == 3U));
+            const SceneShape& st = scene.at(1U);
+            const std::uint16_t* s16 = static_cast<const std::uint16_t*>(st.indexes());
+            check("strips", (st.indexNum() == 6U) && (s16[3] == StripBatch::RESTART16) && (s16[5] == 1U) && (st.colors()[1].g() == 255U));
+        }
+        scene.close();
+
+        // 圧縮した形状の頂点数・頂点インデックス数が壊れたファイル（領域の確保前に失敗とする）
+        {
+            std::vector<char> bytes;
+            {
+                std::ifstream ifs(path, std::ios::binary);
+                bytes.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+            }
+            FileHeader header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            std::uint64_t shapes = 0U;
+            for (std::uint32_t i = 0U; i < header.section_num; i++) {
+                SectionHeader section;
+                std::memcpy(&section, bytes.data() + sizeof(header) + (i * sizeof(SectionHeader)), sizeof(section));
+                shapes = (section.type == SHAPES) ? section.offset : shapes;
+            }
+            const auto corrupt = [&](const std::size_t field, const std::uint32_t value) {
+                std::vector<char> broken = bytes;
+                std::memcpy(broken.data() + shapes + field, &value, sizeof(value));
+                std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+                ofs.write(broken.data(), static_cast<std::streamsize>(broken.size()));
+            };
+            corrupt(offsetof(ShapeRecord, vertex_num), 0xFFFFFFFFU);
+            bool huge = !scene.open(path);
+            corrupt(offsetof(ShapeRecord, index_num), 0xFFFFFFFFU);
+            huge = huge && !scene.open(path);
+            check("broken encoded shape", huge);
+        }
+
+        // 壊れたファイル
+        {
+            std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+            ofs << "MYSC broken";
+        }
+        check("broken", !scene.open(path));
+        std::remove(path.c_str());
+        check("missing", !scene.open(path));
+        return ok;
+    }
+}
@@ -0,0 +1,201 @@
+﻿/**
+ * @file SceneFile.hpp
+ * @author kota-kota
+ * @brief シーンファイル（バイナリ形式）を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_SCENEFILE_HPP
+#define INCLUDED_SCENEFILE_HPP
+
+#include "Vertex.hpp"
+#include "Matrix.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace my {
+    /**
+     * @class MappedFile
+     * @brief 読み込み専用でメモリにマッピングしたファイルを扱うクラス
+     * 
+     * @par 詳細
+     *      Windowsではファイルマッピングオブジェクト、それ以外ではmmap()でマッピングする。
+     */
+    class MappedFile {
+        const std::uint8_t* m_data;     //!< マッピングした先頭アドレス
+        std::size_t         m_size;     //!< ファイルサイズ[byte]
+#ifdef _WIN32
+        void*               m_file;     //!< ファイルハンドル
+        void*               m_mapping;  //!< ファイルマッピングオブジェクトのハンドル
+#else
+        int                 m_fd;       //!< ファイルディスクリプタ
+#endif
+
+    public:
+        //! デフォルトコンストラクタ
+        MappedFile();
+        //! デストラクタ
+        ~MappedFile();
+        //! コピーコンストラクタによるコピー禁止
+        MappedFile(const MappedFile& org) = delete;
+        //! 代入によるコピー禁止
+        MappedFile& operator=(const MappedFile& org) = delete;
+
+    public:
+        //! ファイルをマッピング
+        bool open(const std::string& path);
+        //! マッピングを解除
+        void close();
+        //! マッピングした先頭アドレスを取得
+        const std::uint8_t* data() const;
+        //! ファイルサイズを取得
+        std::size_t size() const;
+        //! マッピングした全ページを読み込み
+        void prefetch() const;
+    };
+}
+
+namespace my {
+    /**
+     * @class SceneShape
+     * @brief シーンファイル内の形状（マッピングしたデータを参照する）
+     * 
+     * @par 詳細
+     *      頂点座標・頂点色・頂点インデックスはマッピングしたファイルを直接指す。
+     *      参照先はSceneFileを閉じるまで有効。
+     */
+    class SceneShape {
+        const char*     m_name;         //!< 形状の名前
+        std::uint32_t   m_mode;         //!< 描画モード（GLenumの値）
+        const Vertex*   m_vertexes;     //!< 頂点座標の並び
+        const Color*    m_colors;       //!< 頂点色の並び
+        std::size_t     m_vertex_num;   //!< 頂点数
+        const void*     m_indexes;      //!< 頂点インデックスの並び
+        std::size_t     m_index_num;    //!< 頂点インデックス数
+        std::uint32_t   m_index_size;   //!< 頂点インデックス1個のバイト数（2または4）
+        Vector          m_pos;          //!< 描画位置
+
+    public:
+        //! コンストラクタ
+        SceneShape(const char* name, const std::uint32_t mode, const Vertex* vertexes, const Color* colors, const std::size_t vertex_num,
+                   const void* indexes, const std::size_t index_num, const std::uint32_t index_size, const Vector& pos);
+
+    public:
+        //! 形状の名前を取得
+        const char* name() const;
+        //! 描画モード（GLenumの値）を取得
+        std::uint32_t mode() const;
+        //! 頂点座標の並びを取得
+        const Vertex* vertexes() const;
+        //! 頂点色の並びを取得
+        const Color* colors() const;
+        //! 頂点数を取得
+        std::size_t vertexNum() const;
+        //! 頂点インデックスの並びを取得
+        const void* indexes() const;
+        //! 頂点インデックス数を取得
+        std::size_t indexNum() const;
+        //! 頂点インデックス1個のバイト数を取得
+        std::uint32_t indexSize() const;
+        //! 描画位置を取得
+        const Vector& pos() const;
+    };
+
+    /**
+     * @class SceneFile
+     * @brief シーンファイルを読み込むクラス
+     * 
+     * @par 詳細
+     *      ファイルをマッピングし、ヘッダ・セクション表・形状の範囲のみ検証する。
+     *      頂点データはコピーせず、SceneShapeからマッピングしたデータを直接参照する。
+     *      頂点インデックスの値（頂点数未満であること）は検証しない。
+     *      圧縮した形状は開く際に復号・検証し、SceneShapeから復号したデータを参照する。
+     */
+    class SceneFile {
+        /**
+         * @struct Decoded
+         * @brief 復号した形状の頂点データ
+         */
+        struct Decoded {
+            Vertexes                    vertexes;   //!< 頂点座標の並び
+            Colors                      colors;     //!< 頂点色の並び
+            std::vector<std::uint8_t>   indexes;    //!< 頂点インデックスの並び（2byteまたは4byte）
+        };
+
+        MappedFile              m_file;     //!< マッピングしたファイル
+        std::vector<SceneShape> m_shapes;   //!< 形状の並び
+        std::vector<std::unique_ptr<Decoded>>   m_decoded;  //!< 復号した頂点データ（圧縮した形状のみ）
+
+    public:
+        //! ファイル形式の版数
+        static const std::uint32_t VERSION;
+
+    public:
+        //! デフォルトコンストラクタ
+        SceneFile();
+
+    public:
+        //! ファイルを開く
+        bool open(const std::string& path);
+        //! ファイルを閉じる
+        void close();
+        //! 頂点データを事前に読み込み
+        void prefetch() const;
+        //! 形状の数を取得
+        std::size_t size() const;
+        //! 形状を取得
+        const SceneShape& at(const std::size_t i) const;
+    };
+}
+
+namespace my {
+    /**
+     * @class SceneWriter
+     * @brief シーンファイルを書き込むクラス
+     * 
+     * @par 詳細
+     *      頂点数が16bitに収まる形状は、頂点インデックスを16bitで書き込む。
+     *      圧縮を指定した場合は、頂点座標を量子化し、頂点データをVertexCodec・IndexCodecで圧縮して書き込む。
+     */
+    class SceneWriter {
+        /**
+         * @struct Entry
+         * @brief 書き込む形状
+         */
+        struct Entry {
+            std::string     name;       //!< 形状の名前
+            std::uint32_t   mode;       //!< 描画モード（GLenumの値）
+            Vertexes        vertexes;   //!< 頂点座標の並び
+            Indexes         indexes;    //!< 頂点インデックスの並び
+            Colors          colors;     //!< 頂点色の並び
+            Vector          pos;        //!< 描画位置
+        };
+
+        std::vector<Entry>  m_entries;  //!< 形状の並び
+        std::uint32_t       m_bits;     //!< 圧縮時の頂点座標の量子化のビット数（0は圧縮しない）
+
+    public:
+        //! デフォルトコンストラクタ
+        SceneWriter();
+
+    public:
+        //! 圧縮を設定（頂点座標の量子化のビット数、0は圧縮しない）
+        void setCompression(const std::uint32_t bits);
+        //! 形状を追加
+        bool add(const std::string& name, const std::uint32_t mode, const Vertexes& vertexes, const Indexes& indexes, const Colors& colors, const Vector& pos);
+        //! ファイルに書き込み
+        bool write(const std::string& path) const;
+    };
+}
+
+namespace my {
+    //! SceneFileクラスのテストコードを実行
+    bool testcode_SceneFile();
+}
+
+#endif //INCLUDED_SCENEFILE_HPP
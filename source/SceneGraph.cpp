@@ -0,0 +1,300 @@
+﻿/**
+ * @file SceneGraph.cpp
+ * @author kota-kota
+ * @brief 描画物の配置の階層を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "SceneGraph.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace my {
+    //! 根の節点の番号
+    const std::uint32_t SceneGraph::ROOT = 0U;
+
+    /**
+     * @brief デフォルトコンストラクタ（根のみ）
+     * 
+     * @par 詳細
+     *      根の配置は恒等変換とする。
+     */
+    SceneGraph::SceneGraph() :
+        m_local({ Affine2D::identity() }), m_world({ Affine2D::identity() }), m_parent({ 0U }), m_span({ 1U }),
+        m_dirty({ 0U }), m_ids({ ROOT }), m_pos({ 0U }), m_changed(false)
+    {
+    }
+
+    /**
+     * @brief 節点を追加
+     * 
+     * @param [in] parent 親の節点の番号
+     * @param [in] local 親からの相対的な配置
+     * 
+     * @return std::uint32_t 追加した節点の番号
+     * 
+     * @par 詳細
+     *      親の部分木の末尾に挿入し、深さ優先順を保つ。
+     *      末尾の部分木に追加する場合は配列の末尾への追加となり、それ以外は後ろの節点をずらす。
+     *      ワールド座標系の配置はupdate()で計算する。
+     */
+    std::uint32_t SceneGraph::add(const std::uint32_t parent, const Affine2D& local)
+    {
+        const std::uint32_t ppos = this->m_pos[parent];
+        const std::uint32_t at = ppos + this->m_span[ppos];
+        const std::uint32_t id = static_cast<std::uint32_t>(this->m_pos.size());
+
+        // 挿入位置以降の親の位置をずらす
+        for (std::size_t i = at; i < this->m_parent.size(); i++) {
+            if (this->m_parent[i] >= at) {
+                this->m_parent[i]++;
+            }
+        }
+        this->m_local.insert(this->m_local.begin() + at, local);
+        this->m_world.insert(this->m_world.begin() + at, local);
+        this->m_parent.insert(this->m_parent.begin() + at, ppos);
+        this->m_span.insert(this->m_span.begin() + at, 1U);
+        this->m_dirty.insert(this->m_dirty.begin() + at, 1U);
+        this->m_ids.insert(this->m_ids.begin() + at, id);
+        this->m_pos.push_back(at);
+        for (std::size_t i = at + 1U; i < this->m_ids.size(); i++) {
+            this->m_pos[this->m_ids[i]] = static_cast<std::uint32_t>(i);
+        }
+
+        // 祖先の部分木の節点数を増やす
+        std::uint32_t p = ppos;
+        while (true) {
+            this->m_span[p]++;
+            if (p == 0U) {
+                break;
+            }
+            p = this->m_parent[p];
+        }
+        this->m_changed = true;
+        return id;
+    }
+
+    /**
+     * @brief 親からの相対的な配置を変更
+     * 
+     * @param [in] id 節点の番号
+     * @param [in] local 親からの相対的な配置
+     */
+    void SceneGraph::setLocal(const std::uint32_t id, const Affine2D& local)
+    {
+        const std::uint32_t pos = this->m_pos[id];
+        this->m_local[pos] = local;
+        this->m_dirty[pos] = 1U;
+        this->m_changed = true;
+    }
+
+    /**
+     * @brief 変更した節点とその子孫のワールド座標系の配置を計算し直す
+     * 
+     * @param [out] changed ワールド座標系の配置を計算し直した節点の番号を追加する並び（深さ優先順）
+     * 
+     * @par 詳細
+     *      親は子より前にあるため、配列を先頭から1回走査し、親が変更済みの節点を変更済みとして伝播させる。
+     *      変更がない場合は走査しない。
+     */
+    void SceneGraph::update(std::vector<std::uint32_t>& changed)
+    {
+        if (!this->m_changed) {
+            return;
+        }
+        if (this->m_dirty[0] != 0U) {
+            this->m_world[0] = this->m_local[0];
+            changed.push_back(this->m_ids[0]);
+        }
+        const std::size_t num = this->m_local.size();
+        for (std::size_t i = 1U; i < num; i++) {
+            const std::uint32_t p = this->m_parent[i];
+            if ((this->m_dirty[i] | this->m_dirty[p]) == 0U) {
+                continue;
+            }
+            this->m_dirty[i] = 1U;
+            this->m_world[i] = this->m_local[i] * this->m_world[p];
+            changed.push_back(this->m_ids[i]);
+        }
+        std::fill(this->m_dirty.begin(), this->m_dirty.end(), static_cast<std::uint8_t>(0U));
+        this->m_changed = false;
+    }
+
+    /**
+     * @brief 親からの相対的な配置を取得
+     * 
+     * @param [in] id 節点の番号
+     * @return const Affine2D& 親からの相対的な配置
+     */
+    const Affine2D& SceneGraph::local(const std::uint32_t id) const
+    {
+        return this->m_local[this->m_pos[id]];
+    }
+
+    /**
+     * @brief ワールド座標系の配置を取得
+     * 
+     * @param [in] id 節点の番号
+     * @return const Affine2D& ワールド座標系の配置（update()後の値）
+     */
+    const Affine2D& SceneGraph::world(const std::uint32_t id) const
+    {
+        return this->m_world[this->m_pos[id]];
+    }
+
+    /**
+     * @brief 親の節点の番号を取得
+     * 
+     * @param [in] id 節点の番号
+     * @return std::uint32_t 親の節点の番号（根の場合は根）
+     */
+    std::uint32_t SceneGraph::parent(const std::uint32_t id) const
+    {
+        return this->m_ids[this->m_parent[this->m_pos[id]]];
+    }
+
+    /**
+     * @brief 節点数を取得
+     * 
+     * @return std::size_t 根を含む節点数
+     */
+    std::size_t SceneGraph::size() const
+    {
+        return this->m_ids.size();
+    }
+}
+
+namespace {
+    //! テスト用の座標の比較
+    bool nearly(const my::Vertex& a, const my::Vertex& b)
+    {
+        return (std::fabs(a.x() - b.x()) <= 1.0e-3F) && (std::fabs(a.y() - b.y()) <= 1.0e-3F);
+    }
+
+    //! テスト・性能計測用の子の配置（格子状に並べ、子毎に回転させる）
+    my::Affine2D childLocal(const std::int32_t i)
+    {
+        const my::Vector pos(static_cast<float>(i % 100) * 4.0F, static_cast<float>(i / 100) * 4.0F, 0.0F);
+        return my::Affine2D::scale({ 1.5F, 1.5F, 1.0F }) * my::Affine2D::rotate(my::Radian(static_cast<float>(i) * 0.01F)) * my::Affine2D::translate(pos);
+    }
+}
+
+namespace my {
+    /**
+     * @brief SceneGraphクラスのテストコードを実行
+     * 
+     */
+    bool testcode_SceneGraph()
+    {
+        std::cout << "[testcode_SceneGraph()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const std::string& name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+
+        // 根 - a - b - c、根 - d の階層に、後からaの子eを追加する（dより前に挿入される）
+        SceneGraph graph;
+        const std::uint32_t a = graph.add(SceneGraph::ROOT, Affine2D::translate({ 10.0F, 0.0F, 0.0F }));
+        const std::uint32_t b = graph.add(a, Affine2D::scale({ 2.0F, 2.0F, 1.0F }));
+        const std::uint32_t c = graph.add(b, Affine2D::translate({ 1.0F, 1.0F, 0.0F }));
+        const std::uint32_t d = graph.add(SceneGraph::ROOT, Affine2D::translate({ 0.0F, 5.0F, 0.0F }));
+        const std::uint32_t e = graph.add(a, Affine2D::translate({ 0.0F, -3.0F, 0.0F }));
+        check("ids", (a == 1U) && (b == 2U) && (c == 3U) && (d == 4U) && (e == 5U) && (graph.size() == 6U));
+        check("parent", (graph.parent(c) == b) && (graph.parent(e) == a) && (graph.parent(d) == SceneGraph::ROOT) && (graph.parent(SceneGraph::ROOT) == SceneGraph::ROOT));
+
+        std::vector<std::uint32_t> changed;
+        graph.update(changed);
+        check("update all", changed.size() == 5U);
+        // cの配置：(1,0) -> 移動(1,1) -> 拡大2倍 -> 移動(10,0) = (14,2)
+        const Vertex v(1.0F, 0.0F, 0.0F);
+        check("world", nearly(graph.world(c).apply(v), Vertex(14.0F, 2.0F, 0.0F)) && nearly(graph.world(e).apply(v), Vertex(11.0F, -3.0F, 0.0F)) &&
+                       nearly(graph.world(d).apply(v), Vertex(1.0F, 5.0F, 0.0F)));
+        check("local", nearly(graph.local(c).apply(v), Vertex(2.0F, 1.0F, 0.0F)));
+
+        // 変更がない場合は計算し直さない
+        changed.clear();
+        graph.update(changed);
+        check("update clean", changed.empty());
+
+        // 親を変更した場合は子孫のみ計算し直す
+        graph.setLocal(a, Affine2D::translate({ -10.0F, 0.0F, 0.0F }));
+        changed.clear();
+        graph.update(changed);
+        check("update subtree", (changed.size() == 4U) && (std::find(changed.begin(), changed.end(), d) == changed.end()));
+        check("world moved", nearly(graph.world(c).apply(v), Vertex(-6.0F, 2.0F, 0.0F)) && nearly(graph.world(e).apply(v), Vertex(-9.0F, -3.0F, 0.0F)));
+        graph.setLocal(c, Affine2D::identity());
+        changed.clear();
+        graph.update(changed);
+        check("update leaf", (changed.size() == 1U) && (changed[0] == c) && nearly(graph.world(c).apply(v), Vertex(-8.0F, 0.0F, 0.0F)));
+
+        // 多数の子を持つ節点の移動は、子の配置を作り直さず親との合成のみ行う
+        const std::uint32_t group = graph.add(d, Affine2D::identity());
+        const std::int32_t children = 10000;
+        for (std::int32_t i = 0; i < children; i++) {
+            (void)graph.add(group, childLocal(i));
+        }
+        changed.clear();
+        graph.update(changed);
+        const Affine2D moved = Affine2D::rotate(Radian(0.5F)) * Affine2D::translate({ 100.0F, -50.0F, 0.0F });
+        graph.setLocal(group, moved);
+        changed.clear();
+        graph.update(changed);
+        bool all = changed.size() == static_cast<std::size_t>(children + 1);
+        for (std::int32_t i = 0; i < children; i += 997) {
+            const std::uint32_t id = group + 1U + static_cast<std::uint32_t>(i);
+            all = all && nearly(graph.world(id).apply(v), (childLocal(i) * moved * graph.world(d)).apply(v));
+        }
+        check("group move", all);
+        return ok;
+    }
+
+    /**
+     * @brief SceneGraphクラスの処理性能を計測
+     * 
+     * @par 詳細
+     *      10000個の子を持つ節点を移動した場合の更新時間を、子の配置を毎回作り直す場合と比較する。
+     */
+    void benchcode_SceneGraph()
+    {
+        std::cout << "[benchcode_SceneGraph()] call" << std::endl;
+        const std::int32_t children = 10000;
+        const std::int32_t loop = 100;
+        SceneGraph graph;
+        const std::uint32_t group = graph.add(SceneGraph::ROOT, Affine2D::identity());
+        for (std::int32_t i = 0; i < children; i++) {
+            (void)graph.add(group, childLocal(i));
+        }
+        std::vector<std::uint32_t> changed;
+        graph.update(changed);
+
+        float sink = 0.0F;
+        auto start = std::chrono::steady_clock::now();
+        for (std::int32_t n = 0; n < loop; n++) {
+            graph.setLocal(group, Affine2D::translate({ static_cast<float>(n), 0.0F, 0.0F }));
+            changed.clear();
+            graph.update(changed);
+            sink += graph.world(group + 1U)[4];
+        }
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "* move group children:" << children << " time:" << (std::chrono::duration<double, std::micro>(end - start).count() / loop) << "[usec]" << std::endl;
+
+        std::vector<Affine2D> world(static_cast<std::size_t>(children));
+        start = std::chrono::steady_clock::now();
+        for (std::int32_t n = 0; n < loop; n++) {
+            const Affine2D parent = Affine2D::translate({ static_cast<float>(n), 0.0F, 0.0F });
+            for (std::int32_t i = 0; i < children; i++) {
+                world[static_cast<std::size_t>(i)] = childLocal(i) * parent;
+            }
+            sink += world[0][4];
+        }
+        end = std::chrono::steady_clock::now();
+        std::cout << "* rebuild children:" << children << " time:" << (std::chrono::duration<double, std::micro>(end - start).count() / loop) << "[usec] (" << sink << ")" << std::endl;
+    }
+}
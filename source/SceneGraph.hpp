@@ -0,0 +1,76 @@
+﻿/**
+ * @file SceneGraph.hpp
+ * @author kota-kota
+ * @brief 描画物の配置の階層を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_SCENEGRAPH_HPP
+#define INCLUDED_SCENEGRAPH_HPP
+
+#include "Affine2D.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class SceneGraph
+     * @brief 節点（親からの相対的な配置）の階層と、ワールド座標系の配置を扱うクラス
+     * 
+     * @par 詳細
+     *      節点は深さ優先順（親は子より前、部分木は連続）の配列で保持する。
+     *      節点の番号は追加順に割り当て、配列の位置が変わっても変わらない。番号0は根とする。
+     *      ワールド座標系の配置は「自身の配置 * 親のワールド座標系の配置」とし、
+     *      配置を変更した節点とその子孫のみ、update()で配列の先頭から順に計算し直す。
+     *      子を持つ節点の配置を変更した場合、子孫は親のワールド座標系の配置との合成のみ行う。
+     */
+    class SceneGraph {
+    public:
+        //! 根の節点の番号
+        static const std::uint32_t ROOT;
+
+    private:
+        std::vector<Affine2D>       m_local;    //!< 親からの相対的な配置（深さ優先順）
+        std::vector<Affine2D>       m_world;    //!< ワールド座標系の配置（深さ優先順）
+        std::vector<std::uint32_t>  m_parent;   //!< 親の位置（深さ優先順、根は自身）
+        std::vector<std::uint32_t>  m_span;     //!< 自身を含む部分木の節点数（深さ優先順）
+        std::vector<std::uint8_t>   m_dirty;    //!< 配置を変更した場合1（深さ優先順）
+        std::vector<std::uint32_t>  m_ids;      //!< 節点の番号（深さ優先順）
+        std::vector<std::uint32_t>  m_pos;      //!< 節点の番号毎の配列の位置
+        bool                        m_changed;  //!< update()後に配置を変更した場合true
+
+    public:
+        //! デフォルトコンストラクタ（根のみ）
+        SceneGraph();
+
+    public:
+        //! 節点を追加
+        std::uint32_t add(const std::uint32_t parent, const Affine2D& local);
+        //! 親からの相対的な配置を変更
+        void setLocal(const std::uint32_t id, const Affine2D& local);
+        //! 変更した節点とその子孫のワールド座標系の配置を計算し直す
+        void update(std::vector<std::uint32_t>& changed);
+
+    public:
+        //! 親からの相対的な配置を取得
+        const Affine2D& local(const std::uint32_t id) const;
+        //! ワールド座標系の配置を取得（update()後の値）
+        const Affine2D& world(const std::uint32_t id) const;
+        //! 親の節点の番号を取得（根の場合は根）
+        std::uint32_t parent(const std::uint32_t id) const;
+        //! 節点数を取得
+        std::size_t size() const;
+    };
+}
+
+namespace my {
+    //! SceneGraphクラスのテストコードを実行
+    bool testcode_SceneGraph();
+    //! SceneGraphクラスの処理性能を計測
+    void benchcode_SceneGraph();
+}
+
+#endif //INCLUDED_SCENEGRAPH_HPP
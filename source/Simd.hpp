@@ -0,0 +1,37 @@
+﻿/**
+ * @file Simd.hpp
+ * @author kota-kota
+ * @brief SIMD命令セットの判定の定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_SIMD_HPP
+#define INCLUDED_SIMD_HPP
+
+//! SSE2が使用可能な場合に定義（x64は常に使用可能）
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define MY_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+//! x86でAVX2(+FMA)の関数を個別に生成できる場合に定義
+//! MY_TARGET_AVX2を付けた関数は、実行時にCPUが対応していることを確認してから呼び出すこと（Cpu::supports()）
+#if defined(MY_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define MY_SIMD_AVX2
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define MY_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define MY_TARGET_AVX2
+#endif
+#endif
+
+//! NEON(AArch64)が使用可能な場合に定義
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define MY_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#endif //INCLUDED_SIMD_HPP
@@ -0,0 +1,426 @@
+﻿/**
+ * @file SpatialIndex.cpp
+ * @author kota-kota
+ * @brief 矩形の空間索引を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "SpatialIndex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace {
+    //! 節点あたりの子の数の上限
+    constexpr std::size_t NODE_CAPACITY = 16U;
+
+    /**
+     * @struct Entry
+     * @brief 構築中の要素（矩形と、矩形または節点の番号）
+     */
+    struct Entry {
+        my::Aabb        box;    //!< 外接矩形
+        std::uint32_t   id;     //!< 矩形または節点の番号
+    };
+
+    //! 矩形の中心のX座標（2倍）
+    float centerx(const my::Aabb& box) { return box.minx() + box.maxx(); }
+    //! 矩形の中心のY座標（2倍）
+    float centery(const my::Aabb& box) { return box.miny() + box.maxy(); }
+
+    /**
+     * @brief STR法で要素を節点単位のグループに並べ替え
+     * 
+     * @param [in,out] entries 要素の並び（グループ順に並べ替える）
+     * 
+     * @par 詳細
+     *      要素をX座標でsqrt(節点数)個の縦長の帯に分け、帯の中をY座標で並べる。
+     *      並べ替え後の先頭からNODE_CAPACITY個ずつが1つの節点となる。
+     */
+    void sortTileRecursive(std::vector<Entry>& entries)
+    {
+        const std::size_t n = entries.size();
+        const std::size_t pages = (n + NODE_CAPACITY - 1U) / NODE_CAPACITY;
+        const std::size_t slices = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(pages))));
+        const std::size_t slice_size = slices * NODE_CAPACITY;
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return centerx(a.box) < centerx(b.box); });
+        for (std::size_t i = 0U; i < n; i += slice_size) {
+            const auto first = entries.begin() + static_cast<std::ptrdiff_t>(i);
+            const auto last = entries.begin() + static_cast<std::ptrdiff_t>(std::min(i + slice_size, n));
+            std::sort(first, last, [](const Entry& a, const Entry& b) { return centery(a.box) < centery(b.box); });
+        }
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    Aabb::Aabb() :
+        m_minx(std::numeric_limits<float>::max()), m_miny(std::numeric_limits<float>::max()),
+        m_maxx(-std::numeric_limits<float>::max()), m_maxy(-std::numeric_limits<float>::max())
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] minx 最小X座標
+     * @param [in] miny 最小Y座標
+     * @param [in] maxx 最大X座標
+     * @param [in] maxy 最大Y座標
+     */
+    Aabb::Aabb(const float minx, const float miny, const float maxx, const float maxy) :
+        m_minx(minx), m_miny(miny), m_maxx(maxx), m_maxy(maxy)
+    {
+    }
+
+    /**
+     * @brief 頂点の並びの外接矩形を生成
+     * 
+     * @param [in] vertexes 頂点の並び
+     * 
+     * @return Aabb 外接矩形（頂点がない場合は空）
+     */
+    Aabb Aabb::of(const Vertexes& vertexes)
+    {
+        return Aabb::of(vertexes.data(), vertexes.size());
+    }
+
+    /**
+     * @brief 頂点の配列の外接矩形を生成
+     * 
+     * @param [in] vertexes 頂点の配列の先頭
+     * @param [in] num 頂点数
+     * 
+     * @return Aabb 外接矩形（頂点がない場合は空）
+     */
+    Aabb Aabb::of(const Vertex* vertexes, const std::size_t num)
+    {
+        Aabb box;
+        for (std::size_t i = 0U; i < num; i++) {
+            const Vertex& v = vertexes[i];
+            box.m_minx = std::min(box.m_minx, v.x());
+            box.m_miny = std::min(box.m_miny, v.y());
+            box.m_maxx = std::max(box.m_maxx, v.x());
+            box.m_maxy = std::max(box.m_maxy, v.y());
+        }
+        return box;
+    }
+
+    /**
+     * @brief 最小X座標を取得
+     * 
+     * @return float 最小X座標
+     */
+    float Aabb::minx() const { return this->m_minx; }
+
+    /**
+     * @brief 最小Y座標を取得
+     * 
+     * @return float 最小Y座標
+     */
+    float Aabb::miny() const { return this->m_miny; }
+
+    /**
+     * @brief 最大X座標を取得
+     * 
+     * @return float 最大X座標
+     */
+    float Aabb::maxx() const { return this->m_maxx; }
+
+    /**
+     * @brief 最大Y座標を取得
+     * 
+     * @return float 最大Y座標
+     */
+    float Aabb::maxy() const { return this->m_maxy; }
+
+    /**
+     * @brief 空か判定
+     * 
+     * @retval true 空
+     * @retval false 空でない
+     */
+    bool Aabb::empty() const
+    {
+        return (this->m_minx > this->m_maxx) || (this->m_miny > this->m_maxy);
+    }
+
+    /**
+     * @brief 矩形を含むよう拡張
+     * 
+     * @param [in] box 矩形
+     */
+    void Aabb::extend(const Aabb& box)
+    {
+        this->m_minx = std::min(this->m_minx, box.m_minx);
+        this->m_miny = std::min(this->m_miny, box.m_miny);
+        this->m_maxx = std::max(this->m_maxx, box.m_maxx);
+        this->m_maxy = std::max(this->m_maxy, box.m_maxy);
+    }
+
+    /**
+     * @brief 拡大・移動した矩形を取得
+     * 
+     * @param [in] pos 移動量
+     * @param [in] scale 拡大率
+     * 
+     * @return Aabb 拡大した後に移動した矩形（空の場合は空）
+     */
+    Aabb Aabb::transform(const Vector& pos, const Vector& scale) const
+    {
+        if (this->empty()) {
+            return *this;
+        }
+        const float x0 = (this->m_minx * scale.x()) + pos.x();
+        const float x1 = (this->m_maxx * scale.x()) + pos.x();
+        const float y0 = (this->m_miny * scale.y()) + pos.y();
+        const float y1 = (this->m_maxy * scale.y()) + pos.y();
+        return Aabb(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1));
+    }
+
+    /**
+     * @brief アフィン変換した矩形の外接矩形を取得
+     * 
+     * @param [in] model アフィン変換
+     * 
+     * @return Aabb 4隅を変換した座標の外接矩形（空の場合は空）
+     */
+    Aabb Aabb::transform(const Affine2D& model) const
+    {
+        if (this->empty()) {
+            return *this;
+        }
+        const Vertex corners[] = {
+            model.apply({ this->m_minx, this->m_miny }), model.apply({ this->m_maxx, this->m_miny }),
+            model.apply({ this->m_maxx, this->m_maxy }), model.apply({ this->m_minx, this->m_maxy }),
+        };
+        return Aabb::of(corners, 4U);
+    }
+
+    /**
+     * @brief 矩形と交差するか判定
+     * 
+     * @param [in] box 矩形
+     * 
+     * @retval true 交差する（辺が接する場合を含む）
+     * @retval false 交差しない
+     */
+    bool Aabb::intersects(const Aabb& box) const
+    {
+        return (this->m_minx <= box.m_maxx) && (box.m_minx <= this->m_maxx) &&
+            (this->m_miny <= box.m_maxy) && (box.m_miny <= this->m_maxy);
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    SpatialIndex::SpatialIndex() :
+        m_nodes(), m_items(), m_boxes()
+    {
+    }
+
+    /**
+     * @brief 矩形の並びから索引を構築
+     * 
+     * @param [in] boxes 矩形の並び
+     * 
+     * @par 詳細
+     *      葉から根へ向かって、1段ずつSTR法で節点を作成する。
+     *      m_itemsは、葉の場合は矩形の番号、それ以外は子の節点の番号を格納する。
+     */
+    void SpatialIndex::build(const std::vector<Aabb>& boxes)
+    {
+        this->m_boxes = boxes;
+        this->m_nodes.clear();
+        this->m_items.clear();
+        if (boxes.empty()) {
+            return;
+        }
+
+        std::vector<Entry> entries;
+        entries.reserve(boxes.size());
+        for (std::size_t i = 0U; i < boxes.size(); i++) {
+            entries.push_back({ boxes[i], static_cast<std::uint32_t>(i) });
+        }
+
+        bool leaf = true;
+        while (true) {
+            sortTileRecursive(entries);
+            std::vector<Entry> parents;
+            for (std::size_t i = 0U; i < entries.size(); i += NODE_CAPACITY) {
+                const std::size_t end = std::min(i + NODE_CAPACITY, entries.size());
+                Node node = { Aabb(), static_cast<std::uint32_t>(this->m_items.size()), static_cast<std::uint32_t>(end - i), leaf };
+                for (std::size_t j = i; j < end; j++) {
+                    node.box.extend(entries[j].box);
+                    this->m_items.push_back(entries[j].id);
+                }
+                parents.push_back({ node.box, static_cast<std::uint32_t>(this->m_nodes.size()) });
+                this->m_nodes.push_back(node);
+            }
+            if (parents.size() == 1U) {
+                break;
+            }
+            entries.swap(parents);
+            leaf = false;
+        }
+    }
+
+    /**
+     * @brief 矩形と交差する矩形の番号を検索
+     * 
+     * @param [in] box 検索範囲の矩形
+     * @param [out] out 交差する矩形の番号（末尾に追加、順序は不定）
+     */
+    void SpatialIndex::query(const Aabb& box, std::vector<std::uint32_t>& out) const
+    {
+        if (this->m_nodes.empty()) {
+            return;
+        }
+        std::vector<std::uint32_t> stack;
+        stack.push_back(static_cast<std::uint32_t>(this->m_nodes.size() - 1U));
+        while (!stack.empty()) {
+            const Node& node = this->m_nodes[stack.back()];
+            stack.pop_back();
+            if (!node.box.intersects(box)) {
+                continue;
+            }
+            for (std::uint32_t i = node.first; i < (node.first + node.count); i++) {
+                const std::uint32_t id = this->m_items[i];
+                if (!node.leaf) {
+                    stack.push_back(id);
+                }
+                else if (this->m_boxes[id].intersects(box)) {
+                    out.push_back(id);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 矩形の数を取得
+     * 
+     * @return std::size_t 矩形の数
+     */
+    std::size_t SpatialIndex::size() const { return this->m_boxes.size(); }
+}
+
+namespace {
+    //! 格子状に並べた矩形を作成
+    std::vector<my::Aabb> makeGridBoxes(const std::int32_t num, const float pitch, const float size)
+    {
+        std::vector<my::Aabb> boxes;
+        for (std::int32_t y = 0; y < num; y++) {
+            for (std::int32_t x = 0; x < num; x++) {
+                // 大きさにばらつきを持たせる
+                const float s = size * (1.0F + static_cast<float>((x * 7 + y * 13) % 5));
+                const float px = static_cast<float>(x) * pitch;
+                const float py = static_cast<float>(y) * pitch;
+                boxes.push_back(my::Aabb(px, py, px + s, py + s));
+            }
+        }
+        return boxes;
+    }
+}
+
+namespace my {
+    /**
+     * @brief SpatialIndexクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     * 
+     * @par 詳細
+     *      検索結果が、全ての矩形と総当たりで判定した結果と一致することを確認する。
+     */
+    bool testcode_SpatialIndex()
+    {
+        std::cout << "[testcode_SpatialIndex()] call" << std::endl;
+        bool ok = true;
+        const std::vector<Aabb> boxes = makeGridBoxes(100, 10.0F, 3.0F);
+        SpatialIndex index;
+        index.build(boxes);
+
+        const Aabb views[] = { Aabb(0.0F, 0.0F, 50.0F, 50.0F), Aabb(333.0F, 512.0F, 640.0F, 700.0F), Aabb(-100.0F, -100.0F, -1.0F, -1.0F), Aabb(-1.0F, -1.0F, 2000.0F, 2000.0F), Aabb() };
+        for (const Aabb& view : views) {
+            std::vector<std::uint32_t> found;
+            index.query(view, found);
+            std::sort(found.begin(), found.end());
+            std::vector<std::uint32_t> expected;
+            for (std::size_t i = 0U; i < boxes.size(); i++) {
+                if (boxes[i].intersects(view)) {
+                    expected.push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+            const bool same = (found == expected);
+            std::cout << "* query found:" << found.size() << " expected:" << expected.size() << (same ? " .. OK" : " .. NG") << std::endl;
+            ok = same && ok;
+        }
+
+        const Aabb moved = Aabb(0.0F, 0.0F, 2.0F, 1.0F).transform({ 10.0F, 20.0F, 0.0F }, { -2.0F, 3.0F, 1.0F });
+        const bool tr = (moved.minx() <= 6.0F) && (moved.minx() >= 6.0F) && (moved.maxx() <= 10.0F) && (moved.maxx() >= 10.0F) && (moved.miny() <= 20.0F) && (moved.maxy() >= 23.0F) && (moved.maxy() <= 23.0F);
+        std::cout << "* transform" << (tr ? " .. OK" : " .. NG") << std::endl;
+        ok = tr && ok;
+
+        // 90度回転した後に移動した矩形の外接矩形
+        const Aabb rotated = Aabb(0.0F, 0.0F, 2.0F, 1.0F).transform(Affine2D(0.0F, 1.0F, -1.0F, 0.0F, 10.0F, 20.0F));
+        const bool ar = (std::fabs(rotated.minx() - 9.0F) <= 1.0e-5F) && (std::fabs(rotated.maxx() - 10.0F) <= 1.0e-5F) &&
+                        (std::fabs(rotated.miny() - 20.0F) <= 1.0e-5F) && (std::fabs(rotated.maxy() - 22.0F) <= 1.0e-5F) && Aabb().transform(Affine2D()).empty();
+        std::cout << "* transform affine" << (ar ? " .. OK" : " .. NG") << std::endl;
+        ok = ar && ok;
+        return ok;
+    }
+
+    /**
+     * @brief SpatialIndexクラスの処理性能を計測
+     * 
+     * @par 詳細
+     *      多数の矩形に対して画面サイズ程度の範囲を検索し、総当たりの判定と時間を比較する。
+     */
+    void benchcode_SpatialIndex()
+    {
+        std::cout << "[benchcode_SpatialIndex()] call" << std::endl;
+        const std::vector<Aabb> boxes = makeGridBoxes(1000, 10.0F, 3.0F);
+        SpatialIndex index;
+        auto start = std::chrono::steady_clock::now();
+        index.build(boxes);
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "* build boxes:" << boxes.size() << " time:" << (std::chrono::duration<double>(end - start).count() * 1000.0) << "[msec]" << std::endl;
+
+        const std::int32_t loop = 1000;
+        std::vector<std::uint32_t> found;
+        std::size_t total = 0U;
+        start = std::chrono::steady_clock::now();
+        for (std::int32_t i = 0; i < loop; i++) {
+            const float x = static_cast<float>(i * 7 % 8000);
+            found.clear();
+            index.query(Aabb(x, x, x + 1280.0F, x + 720.0F), found);
+            total += found.size();
+        }
+        end = std::chrono::steady_clock::now();
+        std::cout << "* query found:" << total << " time:" << (std::chrono::duration<double>(end - start).count() * 1000.0 / loop) << "[msec/query]" << std::endl;
+
+        total = 0U;
+        start = std::chrono::steady_clock::now();
+        for (std::int32_t i = 0; i < loop; i++) {
+            const float x = static_cast<float>(i * 7 % 8000);
+            const Aabb view(x, x, x + 1280.0F, x + 720.0F);
+            for (const Aabb& box : boxes) {
+                total += box.intersects(view) ? 1U : 0U;
+            }
+        }
+        end = std::chrono::steady_clock::now();
+        std::cout << "* brute force found:" << total << " time:" << (std::chrono::duration<double>(end - start).count() * 1000.0 / loop) << "[msec/query]" << std::endl;
+    }
+}
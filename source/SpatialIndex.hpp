@@ -0,0 +1,114 @@
+﻿/**
+ * @file SpatialIndex.hpp
+ * @author kota-kota
+ * @brief 矩形の空間索引を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_SPATIALINDEX_HPP
+#define INCLUDED_SPATIALINDEX_HPP
+
+#include "Vertex.hpp"
+#include "Matrix.hpp"
+#include "Affine2D.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class Aabb
+     * @brief XY平面上の軸に平行な矩形（外接矩形）を扱うクラス
+     * 
+     * @par 詳細
+     *      デフォルトコンストラクタで生成した矩形は空とし、どの矩形とも交差しない。
+     */
+    class Aabb {
+        float   m_minx;     //!< 最小X座標
+        float   m_miny;     //!< 最小Y座標
+        float   m_maxx;     //!< 最大X座標
+        float   m_maxy;     //!< 最大Y座標
+
+    public:
+        //! デフォルトコンストラクタ
+        Aabb();
+        //! コンストラクタ
+        Aabb(const float minx, const float miny, const float maxx, const float maxy);
+        //! 頂点の並びの外接矩形を生成
+        static Aabb of(const Vertexes& vertexes);
+        //! 頂点の配列の外接矩形を生成
+        static Aabb of(const Vertex* vertexes, const std::size_t num);
+
+    public:
+        //! 最小X座標を取得
+        float minx() const;
+        //! 最小Y座標を取得
+        float miny() const;
+        //! 最大X座標を取得
+        float maxx() const;
+        //! 最大Y座標を取得
+        float maxy() const;
+        //! 空か判定
+        bool empty() const;
+
+    public:
+        //! 矩形を含むよう拡張
+        void extend(const Aabb& box);
+        //! 拡大・移動した矩形を取得
+        Aabb transform(const Vector& pos, const Vector& scale) const;
+        //! アフィン変換した矩形の外接矩形を取得
+        Aabb transform(const Affine2D& model) const;
+        //! 矩形と交差するか判定
+        bool intersects(const Aabb& box) const;
+    };
+}
+
+namespace my {
+    /**
+     * @class SpatialIndex
+     * @brief 矩形の並びに対する空間索引（R-tree）を扱うクラス
+     * 
+     * @par 詳細
+     *      STR(Sort-Tile-Recursive)法で一括構築し、構築後は変更しない。
+     *      検索は、指定した矩形と交差する矩形の番号（構築時の並びの位置）を返す。
+     */
+    class SpatialIndex {
+        /**
+         * @struct Node
+         * @brief R-treeの節点
+         */
+        struct Node {
+            Aabb            box;        //!< 子の外接矩形
+            std::uint32_t   first;      //!< 子の先頭位置（葉の場合はm_itemsの位置）
+            std::uint32_t   count;      //!< 子の数
+            bool            leaf;       //!< 葉の場合true
+        };
+
+        std::vector<Node>           m_nodes;    //!< 節点の並び（根は末尾）
+        std::vector<std::uint32_t>  m_items;    //!< 葉から参照する矩形の番号の並び
+        std::vector<Aabb>           m_boxes;    //!< 矩形の並び
+
+    public:
+        //! デフォルトコンストラクタ
+        SpatialIndex();
+
+    public:
+        //! 矩形の並びから索引を構築
+        void build(const std::vector<Aabb>& boxes);
+        //! 矩形と交差する矩形の番号を検索
+        void query(const Aabb& box, std::vector<std::uint32_t>& out) const;
+        //! 矩形の数を取得
+        std::size_t size() const;
+    };
+}
+
+namespace my {
+    //! SpatialIndexクラスのテストコードを実行
+    bool testcode_SpatialIndex();
+    //! SpatialIndexクラスの処理性能を計測
+    void benchcode_SpatialIndex();
+}
+
+#endif //INCLUDED_SPATIALINDEX_HPP
@@ -0,0 +1,187 @@
+﻿/**
+ * @file StreamBuffer.cpp
+ * @author kota-kota
+ * @brief 毎フレーム更新するデータを転送するリングバッファの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "StreamBuffer.hpp"
+
+#include <iostream>
+#include <cstring>
+
+namespace {
+    //! フェンスオブジェクトの待ち時間[nsec]
+    constexpr GLuint64 FENCE_TIMEOUT = 1000000000U;
+
+    //! 書き込み位置をアライメントに合わせて切り上げ
+    GLsizeiptr alignHead(const GLsizeiptr head, const GLsizeiptr align)
+    {
+        const GLsizeiptr a = (align > 0) ? align : 1;
+        return ((head + a - 1) / a) * a;
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] target バッファオブジェクトのターゲット（GL_ARRAY_BUFFER等）
+     * @param [in] size バッファオブジェクト全体のサイズ[byte]
+     * @param [in] segnum セグメント数（GPUが同時に参照し得るフレーム数以上を指定する）
+     * 
+     * @par 詳細
+     *      バッファオブジェクトを確保する。
+     *      確保した領域は、フレーム毎に1セグメントずつ循環して使用する。
+     */
+    StreamBuffer::StreamBuffer(const GLenum target, const GLsizeiptr size, const std::int32_t segnum) :
+        m_target(target), m_vbo(0U), m_segsize(size / ((segnum > 0) ? segnum : 1)), m_segment(0), m_head(0), m_frame(0U),
+        m_fences(static_cast<std::size_t>((segnum > 0) ? segnum : 1), nullptr)
+    {
+        std::cout << "[StreamBuffer::StreamBuffer()] call" << std::endl;
+        glGenBuffers(1, &this->m_vbo);
+        glBindBuffer(this->m_target, this->m_vbo);
+        glBufferData(this->m_target, this->m_segsize * static_cast<GLsizeiptr>(this->m_fences.size()), nullptr, GL_STREAM_DRAW);
+        glBindBuffer(this->m_target, 0);
+        std::cout << "* VBO(Stream) id:" << m_vbo << " segment size:" << m_segsize << " segment num:" << m_fences.size() << std::endl;
+    }
+
+    /**
+     * @brief デストラクタ
+     * 
+     * @par 詳細
+     *      フェンスオブジェクトおよびバッファオブジェクトを破棄する。
+     */
+    StreamBuffer::~StreamBuffer()
+    {
+        std::cout << "[StreamBuffer::~StreamBuffer()] call" << std::endl;
+        for (GLsync fence : this->m_fences) {
+            if (fence != nullptr) {
+                glDeleteSync(fence);
+            }
+        }
+        glDeleteBuffers(1, &this->m_vbo);
+    }
+
+    /**
+     * @brief フレームを開始
+     * 
+     * @par 詳細
+     *      次のセグメントへ進み、そのセグメントを参照するGPUの描画が完了するまで待つ。
+     *      通常はセグメント数分前のフレームの描画であるため、待ちは発生しない。
+     */
+    void StreamBuffer::beginFrame()
+    {
+        this->m_frame++;
+        this->m_segment = (this->m_segment + 1) % static_cast<std::int32_t>(this->m_fences.size());
+        this->m_head = 0;
+
+        GLsync& fence = this->m_fences[static_cast<std::size_t>(this->m_segment)];
+        if (fence != nullptr) {
+            GLenum ret = glClientWaitSync(fence, 0, 0);
+            while ((ret != GL_ALREADY_SIGNALED) && (ret != GL_CONDITION_SATISFIED)) {
+                if (ret == GL_WAIT_FAILED) {
+                    std::cerr << "* glClientWaitSync() segment:" << m_segment << " .. NG" << std::endl;
+                    break;
+                }
+                ret = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    /**
+     * @brief フレームを終了
+     * 
+     * @par 詳細
+     *      現在のセグメントを参照する描画コマンドの後にフェンスオブジェクトを挿入する。
+     */
+    void StreamBuffer::endFrame()
+    {
+        GLsync& fence = this->m_fences[static_cast<std::size_t>(this->m_segment)];
+        if (fence != nullptr) {
+            glDeleteSync(fence);
+        }
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    /**
+     * @brief 複数のデータを続けて書き込めるか判定
+     * 
+     * @param [in] blocks 書き込むデータの並び（first:サイズ[byte], second:書き込み位置のアライメント[byte]）
+     * 
+     * @retval true 全てのデータを現在のセグメントに書き込める
+     * @retval false セグメントの空き不足
+     * 
+     * @par 詳細
+     *      並びの順にwrite()した場合の書き込み位置を、アライメントを含めて計算する。
+     *      一部だけ書き込まれてセグメントを無駄に消費しないよう、write()の前に判定する。
+     */
+    bool StreamBuffer::fits(const std::initializer_list<std::pair<GLsizeiptr, GLsizeiptr>> blocks) const
+    {
+        GLsizeiptr head = this->m_head;
+        for (const std::pair<GLsizeiptr, GLsizeiptr>& block : blocks) {
+            head = alignHead(head, block.second);
+            if ((block.first <= 0) || ((head + block.first) > this->m_segsize)) {
+                return false;
+            }
+            head += block.first;
+        }
+        return true;
+    }
+
+    /**
+     * @brief データを書き込み
+     * 
+     * @param [in] data 書き込むデータ
+     * @param [in] size 書き込むデータのサイズ[byte]
+     * @param [in] align 書き込み位置のアライメント[byte]
+     * 
+     * @retval -1 書き込み失敗（セグメントの空き不足）
+     * @retval >=0 書き込み成功（バッファオブジェクト内のオフセット[byte]）
+     * 
+     * @par 詳細
+     *      現在のセグメントの空き領域を同期なしでマップし、データを書き込む。
+     *      書き込んだ領域は、endFrame()を呼ぶまでに発行した描画コマンドからのみ参照すること。
+     */
+    GLintptr StreamBuffer::write(const void* data, const GLsizeiptr size, const GLsizeiptr align)
+    {
+        const GLsizeiptr head = alignHead(this->m_head, align);
+        if ((size <= 0) || ((head + size) > this->m_segsize)) {
+            std::cerr << "[StreamBuffer::write()] segment overflow size:" << size << " head:" << head << std::endl;
+            return -1;
+        }
+
+        const GLintptr offset = (this->m_segsize * this->m_segment) + head;
+        glBindBuffer(this->m_target, this->m_vbo);
+        void* dst = glMapBufferRange(this->m_target, offset, size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        if (dst == nullptr) {
+            std::cerr << "* glMapBufferRange() offset:" << offset << " size:" << size << " .. NG" << std::endl;
+            glBindBuffer(this->m_target, 0);
+            return -1;
+        }
+        (void)std::memcpy(dst, data, static_cast<std::size_t>(size));
+        (void)glUnmapBuffer(this->m_target);
+        glBindBuffer(this->m_target, 0);
+
+        this->m_head = head + size;
+        return offset;
+    }
+
+    /**
+     * @brief バッファオブジェクトを取得
+     * 
+     * @return GLuint バッファオブジェクト
+     */
+    GLuint StreamBuffer::getBuffer() const { return this->m_vbo; }
+
+    /**
+     * @brief フレーム番号を取得
+     * 
+     * @return std::uint32_t beginFrame()毎に増加するフレーム番号
+     */
+    std::uint32_t StreamBuffer::getFrame() const { return this->m_frame; }
+}
@@ -0,0 +1,71 @@
+﻿/**
+ * @file StreamBuffer.hpp
+ * @author kota-kota
+ * @brief 毎フレーム更新するデータを転送するリングバッファの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_STREAMBUFFER_HPP
+#define INCLUDED_STREAMBUFFER_HPP
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace my {
+    /**
+     * @class StreamBuffer
+     * @brief 毎フレーム更新するデータを転送するリングバッファを扱うクラス
+     * 
+     * @par 詳細
+     *      1つの大きなバッファオブジェクトをセグメントに等分し、1フレームに1セグメントを割り当てる。
+     *      セグメントへの書き込みは同期なしのglMapBufferRangeで行い、GPUとの競合は
+     *      セグメント毎のフェンスオブジェクトで防ぐ。
+     *      使い方は、以下。
+     *          beginFrame() でフレームを開始する
+     *          write() でフレーム内のデータを書き込み、バッファ内のオフセットを受け取る
+     *          描画コマンドを発行した後、endFrame() でフレームを終了する
+     */
+    class StreamBuffer {
+        GLenum              m_target;       //!< バッファオブジェクトのターゲット
+        GLuint              m_vbo;          //!< バッファオブジェクト
+        GLsizeiptr          m_segsize;      //!< 1セグメントのサイズ[byte]
+        std::int32_t        m_segment;      //!< 現在のセグメント番号
+        GLsizeiptr          m_head;         //!< 現在のセグメント内の書き込み位置[byte]
+        std::uint32_t       m_frame;        //!< フレーム番号
+        std::vector<GLsync> m_fences;       //!< セグメント毎のフェンスオブジェクト
+
+    public:
+        //! コンストラクタ
+        StreamBuffer(const GLenum target, const GLsizeiptr size, const std::int32_t segnum);
+        //! デストラクタ
+        ~StreamBuffer();
+        //! コピーコンストラクタによるコピー禁止
+        StreamBuffer(const StreamBuffer& org) = delete;
+        //! 代入によるコピー禁止
+        StreamBuffer& operator=(const StreamBuffer& org) = delete;
+
+    public:
+        //! フレームを開始
+        void beginFrame();
+        //! フレームを終了
+        void endFrame();
+        //! 複数のデータを続けて書き込めるか判定（first:サイズ[byte], second:アライメント[byte]）
+        bool fits(const std::initializer_list<std::pair<GLsizeiptr, GLsizeiptr>> blocks) const;
+        //! データを書き込み
+        GLintptr write(const void* data, const GLsizeiptr size, const GLsizeiptr align);
+
+    public:
+        //! バッファオブジェクトを取得
+        GLuint getBuffer() const;
+        //! フレーム番号を取得
+        std::uint32_t getFrame() const;
+    };
+}
+
+#endif //INCLUDED_STREAMBUFFER_HPP
@@ -0,0 +1,191 @@
+﻿/**
+ * @file StripBatch.cpp
+ * @author kota-kota
+ * @brief 複数のストリップを1回の描画にまとめるクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "StripBatch.hpp"
+
+#include <iostream>
+
+namespace my {
+    const std::uint16_t StripBatch::RESTART16 = 0xFFFFU;
+    const std::uint32_t StripBatch::RESTART32 = 0xFFFFFFFFU;
+
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    StripBatch::StripBatch() :
+        m_vertexes(), m_indexes(), m_colors(), m_strips(0U)
+    {
+    }
+
+    /**
+     * @brief 頂点座標の並びを取得
+     * 
+     * @return const Vertexes& 頂点座標の並び
+     */
+    const Vertexes& StripBatch::vertexes() const { return this->m_vertexes; }
+
+    /**
+     * @brief 頂点インデックスの並びを取得
+     * 
+     * @return const Indexes& 頂点インデックスの並び（ストリップの間はRESTART32）
+     */
+    const Indexes& StripBatch::indexes() const { return this->m_indexes; }
+
+    /**
+     * @brief 頂点色の並びを取得
+     * 
+     * @return const Colors& 頂点色の並び
+     */
+    const Colors& StripBatch::colors() const { return this->m_colors; }
+
+    /**
+     * @brief ストリップ数を取得
+     * 
+     * @return std::size_t ストリップ数
+     */
+    std::size_t StripBatch::strips() const { return this->m_strips; }
+
+    /**
+     * @brief 全て削除
+     * 
+     */
+    void StripBatch::clear()
+    {
+        this->m_vertexes.clear();
+        this->m_indexes.clear();
+        this->m_colors.clear();
+        this->m_strips = 0U;
+    }
+
+    /**
+     * @brief 頂点の並びをそのまま1本のストリップとして追加
+     * 
+     * @param [in] vertexes 頂点座標の並び
+     * @param [in] colors 頂点色の並び（頂点座標と同数）
+     */
+    void StripBatch::add(const Vertexes& vertexes, const Colors& colors)
+    {
+        Indexes indexes;
+        indexes.reserve(vertexes.size());
+        for (std::size_t i = 0U; i < vertexes.size(); i++) {
+            indexes.push_back(static_cast<std::uint32_t>(i));
+        }
+        this->add(vertexes, colors, indexes);
+    }
+
+    /**
+     * @brief 頂点インデックス付きのストリップを追加
+     * 
+     * @param [in] vertexes 頂点座標の並び
+     * @param [in] colors 頂点色の並び（頂点座標と同数）
+     * @param [in] indexes 頂点インデックスの並び（頂点座標の並びの位置）
+     * 
+     * @par 詳細
+     *      頂点インデックスは、まとめた頂点データの位置に付け替える。
+     *      既にストリップがある場合は、前にリスタート値を挟む。
+     */
+    void StripBatch::add(const Vertexes& vertexes, const Colors& colors, const Indexes& indexes)
+    {
+        if (indexes.empty() || (vertexes.size() != colors.size())) {
+            std::cerr << "[StripBatch::add()] invalid strip vertexes:" << vertexes.size() << " colors:" << colors.size() << " indexes:" << indexes.size() << std::endl;
+            return;
+        }
+        const std::uint32_t base = static_cast<std::uint32_t>(this->m_vertexes.size());
+        this->m_vertexes.insert(this->m_vertexes.end(), vertexes.begin(), vertexes.end());
+        this->m_colors.insert(this->m_colors.end(), colors.begin(), colors.end());
+        if (this->m_strips > 0U) {
+            this->m_indexes.push_back(RESTART32);
+        }
+        for (const Index& i : indexes) {
+            this->m_indexes.push_back(base + i.idx());
+        }
+        this->m_strips++;
+    }
+
+    /**
+     * @brief 太線の三角形ストリップを追加
+     * 
+     * @param [in] stroke 太線の形状
+     * 
+     * @par 詳細
+     *      太線の中の縮退三角形による連結はそのまま残す。
+     */
+    void StripBatch::add(const Stroke& stroke)
+    {
+        this->add(stroke.vertexes(), stroke.colors(), stroke.indexes());
+    }
+
+    /**
+     * @brief 16bitの頂点インデックスで描画できるか判定
+     * 
+     * @param [in] vertex_num 頂点数
+     * 
+     * @retval true 16bitで描画できる（リスタート値と重ならない）
+     * @retval false 32bitが必要
+     */
+    bool StripBatch::fits16(const std::size_t vertex_num)
+    {
+        return vertex_num <= static_cast<std::size_t>(RESTART16);
+    }
+
+    /**
+     * @brief 頂点インデックスを16bitに変換
+     * 
+     * @param [in] indexes 頂点インデックスの並び（全てRESTART16未満またはRESTART32）
+     * 
+     * @return Indexes16 16bitの頂点インデックスの並び
+     */
+    Indexes16 StripBatch::narrow(const Indexes& indexes)
+    {
+        Indexes16 out;
+        out.reserve(indexes.size());
+        for (const Index& i : indexes) {
+            out.push_back((i.idx() == RESTART32) ? RESTART16 : static_cast<std::uint16_t>(i.idx()));
+        }
+        return out;
+    }
+}
+
+namespace my {
+    /**
+     * @brief StripBatchクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     */
+    bool testcode_StripBatch()
+    {
+        std::cout << "[testcode_StripBatch()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const char* name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+        const Color c(0, 0, 0, 255);
+
+        StripBatch batch;
+        batch.add({ { 0.0F, 0.0F }, { 1.0F, 0.0F }, { 2.0F, 0.0F } }, { c, c, c });
+        batch.add({ { 0.0F, 1.0F }, { 1.0F, 1.0F } }, { c, c }, { 1U, 0U });
+        batch.add({ { 0.0F, 2.0F } }, {});
+        check("strips", (batch.strips() == 2U) && (batch.vertexes().size() == 5U) && (batch.colors().size() == 5U));
+
+        const std::uint32_t expected[] = { 0U, 1U, 2U, StripBatch::RESTART32, 4U, 3U };
+        bool same = (batch.indexes().size() == 6U);
+        for (std::size_t i = 0U; same && (i < 6U); i++) {
+            same = (batch.indexes()[i].idx() == expected[i]);
+        }
+        check("indexes", same);
+
+        const Indexes16 narrow = StripBatch::narrow(batch.indexes());
+        check("narrow", (narrow.size() == 6U) && (narrow[3] == StripBatch::RESTART16) && (narrow[5] == 3U));
+        check("fits16", StripBatch::fits16(0xFFFFU) && !StripBatch::fits16(0x10000U));
+        return ok;
+    }
+}
@@ -0,0 +1,85 @@
+﻿/**
+ * @file StripBatch.hpp
+ * @author kota-kota
+ * @brief 複数のストリップを1回の描画にまとめるクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_STRIPBATCH_HPP
+#define INCLUDED_STRIPBATCH_HPP
+
+#include "Vertex.hpp"
+#include "Stroke.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @brief 16bitの頂点インデックスの並び
+     * 
+     */
+    using Indexes16 = std::vector<std::uint16_t>;
+
+    /**
+     * @class StripBatch
+     * @brief 複数のストリップ（GL_LINE_STRIP/GL_TRIANGLE_STRIPなど）を1つの頂点データにまとめるクラス
+     * 
+     * @par 詳細
+     *      ストリップの間にプリミティブリスタートの頂点インデックス（型の最大値）を挟んで連結する。
+     *      描画時はGL_PRIMITIVE_RESTART_FIXED_INDEXを有効にし、1回のglDrawElements()で全ストリップを描画する。
+     *      頂点インデックスは32bit（RESTART32）で保持し、頂点数が少ない場合は16bit（RESTART16）に変換できる。
+     */
+    class StripBatch {
+    public:
+        //! 16bitの頂点インデックスのリスタート値
+        static const std::uint16_t RESTART16;
+        //! 32bitの頂点インデックスのリスタート値
+        static const std::uint32_t RESTART32;
+
+    private:
+        Vertexes        m_vertexes;     //!< 頂点座標の並び
+        Indexes         m_indexes;      //!< 頂点インデックスの並び（ストリップの間はRESTART32）
+        Colors          m_colors;       //!< 頂点色の並び
+        std::size_t     m_strips;       //!< ストリップ数
+
+    public:
+        //! デフォルトコンストラクタ
+        StripBatch();
+
+    public:
+        //! 頂点座標の並びを取得
+        const Vertexes& vertexes() const;
+        //! 頂点インデックスの並びを取得
+        const Indexes& indexes() const;
+        //! 頂点色の並びを取得
+        const Colors& colors() const;
+        //! ストリップ数を取得
+        std::size_t strips() const;
+
+    public:
+        //! 全て削除
+        void clear();
+        //! 頂点の並びをそのまま1本のストリップとして追加
+        void add(const Vertexes& vertexes, const Colors& colors);
+        //! 頂点インデックス付きのストリップを追加
+        void add(const Vertexes& vertexes, const Colors& colors, const Indexes& indexes);
+        //! 太線の三角形ストリップを追加
+        void add(const Stroke& stroke);
+
+    public:
+        //! 16bitの頂点インデックスで描画できるか判定
+        static bool fits16(const std::size_t vertex_num);
+        //! 頂点インデックスを16bitに変換（RESTART32はRESTART16に変換）
+        static Indexes16 narrow(const Indexes& indexes);
+    };
+}
+
+namespace my {
+    //! StripBatchクラスのテストコードを実行
+    bool testcode_StripBatch();
+}
+
+#endif //INCLUDED_STRIPBATCH_HPP
@@ -0,0 +1,535 @@
+﻿/**
+ * @file Stroke.cpp
+ * @author kota-kota
+ * @brief 太線を三角形ストリップに分割するクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Stroke.hpp"
+#include "Matrix.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    //! 同一点とみなす距離の2乗
+    constexpr float STROKE_EPS2 = 1.0e-12F;
+    //! 直線とみなす外積の大きさ
+    constexpr float STROKE_COLLINEAR = 1.0e-6F;
+
+    //! 2次元の点またはベクトル
+    struct Point2 {
+        float   x;  //!< X座標
+        float   y;  //!< Y座標
+    };
+
+    /**
+     * @brief 線分の単位法線ベクトルを一括計算
+     * 
+     * @param [in] xs 点のX座標の並び（count + 1個）
+     * @param [in] ys 点のY座標の並び（count + 1個）
+     * @param [in] count 線分数
+     * @param [out] nxs 線分の単位法線ベクトルのX成分の並び（count個）
+     * @param [out] nys 線分の単位法線ベクトルのY成分の並び（count個）
+     * 
+     * @par 詳細
+     *      線分i（点iから点i+1）の進行方向を左に90度回転した単位ベクトルを求める。
+     *      SIMD命令が使用可能な場合は4線分ずつ計算する。
+     */
+    void computeNormals(const float* xs, const float* ys, const std::size_t count, float* nxs, float* nys)
+    {
+        std::size_t i = 0U;
+#if defined(MY_SIMD_SSE2)
+        for (; (i + 4U) <= count; i += 4U) {
+            const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&xs[i + 1U]), _mm_loadu_ps(&xs[i]));
+            const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&ys[i + 1U]), _mm_loadu_ps(&ys[i]));
+            const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+            const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0F), len);
+            _mm_storeu_ps(&nxs[i], _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(dy, inv)));
+            _mm_storeu_ps(&nys[i], _mm_mul_ps(dx, inv));
+        }
+#elif defined(MY_SIMD_NEON)
+        for (; (i + 4U) <= count; i += 4U) {
+            const float32x4_t dx = vsubq_f32(vld1q_f32(&xs[i + 1U]), vld1q_f32(&xs[i]));
+            const float32x4_t dy = vsubq_f32(vld1q_f32(&ys[i + 1U]), vld1q_f32(&ys[i]));
+            const float32x4_t len = vsqrtq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)));
+            const float32x4_t inv = vdivq_f32(vdupq_n_f32(1.0F), len);
+            vst1q_f32(&nxs[i], vnegq_f32(vmulq_f32(dy, inv)));
+            vst1q_f32(&nys[i], vmulq_f32(dx, inv));
+        }
+#endif
+        for (; i < count; i++) {
+            const float dx = xs[i + 1U] - xs[i];
+            const float dy = ys[i + 1U] - ys[i];
+            const float inv = 1.0F / std::sqrt((dx * dx) + (dy * dy));
+            nxs[i] = -dy * inv;
+            nys[i] = dx * inv;
+        }
+    }
+
+    /**
+     * @class StrokeBuilder
+     * @brief 1本の線を三角形ストリップとして出力する作業用クラス
+     * 
+     * @par 詳細
+     *      ストリップには常に(左側, 右側)の順で頂点を出力する。
+     */
+    class StrokeBuilder {
+        my::Stroke&     m_out;      //!< 出力先
+        float           m_hw;       //!< 線幅の半分
+        float           m_limit;    //!< マイター長の上限（線幅の半分に対する倍率）
+        std::int32_t    m_div;      //!< 半円あたりの分割数
+
+    public:
+        //! コンストラクタ
+        StrokeBuilder(my::Stroke& out, const float hw, const float limit, const std::int32_t div) :
+            m_out(out), m_hw(hw), m_limit(limit), m_div(div)
+        {
+        }
+        //! コピーコンストラクタによるコピー禁止
+        StrokeBuilder(const StrokeBuilder& org) = delete;
+        //! 代入によるコピー禁止
+        StrokeBuilder& operator=(const StrokeBuilder& org) = delete;
+
+    public:
+        //! 左右の頂点の組を出力
+        void pair(const Point2& l, const Point2& r, const my::Color& c, const float z)
+        {
+            const std::uint32_t li = this->m_out.addVertex(my::Vertex(l.x, l.y, z), c);
+            const std::uint32_t ri = this->m_out.addVertex(my::Vertex(r.x, r.y, z), c);
+            this->m_out.addIndex(li);
+            this->m_out.addIndex(ri);
+        }
+
+        //! 片側の頂点を共有して頂点の組を出力
+        void pairShared(const std::uint32_t shared, const bool shared_left, const Point2& p, const my::Color& c, const float z)
+        {
+            const std::uint32_t pi = this->m_out.addVertex(my::Vertex(p.x, p.y, z), c);
+            this->m_out.addIndex(shared_left ? shared : pi);
+            this->m_out.addIndex(shared_left ? pi : shared);
+        }
+
+        //! 端点を出力（start:始点の場合true）
+        void cap(const my::Stroker::CAP type, const Point2& p, const Point2& n, const bool start, const my::Color& c, const float z)
+        {
+            const float hw = this->m_hw;
+            // 進行方向（始点では線の外側＝後方へ向ける）
+            const Point2 d = start ? Point2{ -n.y, n.x } : Point2{ n.y, -n.x };
+            switch (type) {
+            case my::Stroker::CAP::SQUARE:
+                this->pair({ p.x + ((n.x + d.x) * hw), p.y + ((n.y + d.y) * hw) }, { p.x + ((d.x - n.x) * hw), p.y + ((d.y - n.y) * hw) }, c, z);
+                break;
+            case my::Stroker::CAP::ROUND: {
+                // 先端から側面へ（終点では側面から先端へ）左右対称に出力する
+                const std::int32_t div = std::max(this->m_div / 2, 1);
+                for (std::int32_t k = 0; k <= div; k++) {
+                    const std::int32_t j = start ? k : (div - k);
+                    const float t = (my::MATRIX_PI / 2.0F) * static_cast<float>(j) / static_cast<float>(div);
+                    const float cs = std::cos(t) * hw;
+                    const float sn = std::sin(t) * hw;
+                    this->pair({ p.x + (d.x * cs) + (n.x * sn), p.y + (d.y * cs) + (n.y * sn) }, { p.x + (d.x * cs) - (n.x * sn), p.y + (d.y * cs) - (n.y * sn) }, c, z);
+                }
+                break;
+            }
+            case my::Stroker::CAP::BUTT:
+            default:
+                this->pair({ p.x + (n.x * hw), p.y + (n.y * hw) }, { p.x - (n.x * hw), p.y - (n.y * hw) }, c, z);
+                break;
+            }
+        }
+
+        //! 接続部を出力（na:入る線分の法線 nb:出る線分の法線 lmin:前後の線分の短い方の長さ）
+        void join(const my::Stroker::JOIN type, const Point2& p, const Point2& na, const Point2& nb, const float lmin, const my::Color& c, const float z)
+        {
+            const float hw = this->m_hw;
+            const float cross = (na.x * nb.y) - (na.y * nb.x);
+            const float dot = (na.x * nb.x) + (na.y * nb.y);
+            // マイター方向と、法線方向に対する倍率
+            Point2 m = { na.x + nb.x, na.y + nb.y };
+            const float mlen = std::sqrt((m.x * m.x) + (m.y * m.y));
+            if ((std::fabs(cross) < STROKE_COLLINEAR) && (dot > 0.0F)) {
+                // ほぼ直線
+                this->pair({ p.x + (na.x * hw), p.y + (na.y * hw) }, { p.x - (na.x * hw), p.y - (na.y * hw) }, c, z);
+                return;
+            }
+            float ratio = this->m_limit + 1.0F;
+            if (mlen > 0.0F) {
+                m = { m.x / mlen, m.y / mlen };
+                ratio = 1.0F / ((m.x * na.x) + (m.y * na.y));
+            }
+            if ((type == my::Stroker::JOIN::MITER) && (ratio <= this->m_limit)) {
+                this->pair({ p.x + (m.x * hw * ratio), p.y + (m.y * hw * ratio) }, { p.x - (m.x * hw * ratio), p.y - (m.y * hw * ratio) }, c, z);
+                return;
+            }
+
+            // 内側はマイターの交点（前後の線分を越えないよう制限する）、外側はベベルまたは円弧
+            const bool left_turn = (cross > 0.0F);
+            const float side = left_turn ? 1.0F : -1.0F;
+            const float inner_len = (mlen > 0.0F) ? std::min(hw * ratio, std::sqrt((lmin * lmin) + (hw * hw))) : 0.0F;
+            const Point2 inner = { p.x + (m.x * inner_len * side), p.y + (m.y * inner_len * side) };
+            const std::uint32_t ii = this->m_out.addVertex(my::Vertex(inner.x, inner.y, z), c);
+            // 左折の場合は右側、右折の場合は左側が外側
+            const Point2 oa = { p.x - (na.x * hw * side), p.y - (na.y * hw * side) };
+            const Point2 ob = { p.x - (nb.x * hw * side), p.y - (nb.y * hw * side) };
+            this->pairShared(ii, left_turn, oa, c, z);
+            if (type == my::Stroker::JOIN::ROUND) {
+                const float angle = std::atan2(std::fabs(cross), dot);
+                const std::int32_t div = static_cast<std::int32_t>(std::ceil(angle / my::MATRIX_PI * static_cast<float>(this->m_div)));
+                // 外側の法線を一定角度ずつ回転させて円弧を出力する
+                const float step = side * angle / static_cast<float>(std::max(div, 1));
+                const float cs = std::cos(step);
+                const float sn = std::sin(step);
+                Point2 r = { -na.x * side * hw, -na.y * side * hw };
+                for (std::int32_t k = 1; k < div; k++) {
+                    r = { (r.x * cs) - (r.y * sn), (r.x * sn) + (r.y * cs) };
+                    this->pairShared(ii, left_turn, { p.x + r.x, p.y + r.y }, c, z);
+                }
+            }
+            this->pairShared(ii, left_turn, ob, c, z);
+        }
+    };
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    Stroke::Stroke() :
+        m_vertexes(), m_indexes(), m_colors()
+    {
+    }
+
+    /**
+     * @brief 頂点座標の並びを取得
+     * 
+     * @return const Vertexes& 頂点座標の並び
+     */
+    const Vertexes& Stroke::vertexes() const { return this->m_vertexes; }
+    /**
+     * @brief 頂点インデックスの並びを取得
+     * 
+     * @return const Indexes& 頂点インデックスの並び（GL_TRIANGLE_STRIP）
+     */
+    const Indexes& Stroke::indexes() const { return this->m_indexes; }
+    /**
+     * @brief 頂点色の並びを取得
+     * 
+     * @return const Colors& 頂点色の並び
+     */
+    const Colors& Stroke::colors() const { return this->m_colors; }
+
+    /**
+     * @brief 全て削除
+     * 
+     */
+    void Stroke::clear()
+    {
+        this->m_vertexes.clear();
+        this->m_indexes.clear();
+        this->m_colors.clear();
+    }
+
+    /**
+     * @brief 頂点を追加
+     * 
+     * @param [in] v 頂点座標
+     * @param [in] c 頂点色
+     * 
+     * @return std::uint32_t 追加した頂点のインデックス
+     */
+    std::uint32_t Stroke::addVertex(const Vertex& v, const Color& c)
+    {
+        this->m_vertexes.push_back(v);
+        this->m_colors.push_back(c);
+        return static_cast<std::uint32_t>(this->m_vertexes.size() - 1U);
+    }
+
+    /**
+     * @brief 領域を予約
+     * 
+     * @param [in] vnum 頂点数
+     * @param [in] inum 頂点インデックス数
+     */
+    void Stroke::reserve(const std::size_t vnum, const std::size_t inum)
+    {
+        this->m_vertexes.reserve(vnum);
+        this->m_colors.reserve(vnum);
+        this->m_indexes.reserve(inum);
+    }
+
+    /**
+     * @brief 頂点インデックスを追加
+     * 
+     * @param [in] idx 頂点インデックス
+     */
+    void Stroke::addIndex(const std::uint32_t idx)
+    {
+        this->m_indexes.push_back(Index(idx));
+    }
+
+    /**
+     * @brief 前後のストリップを連結
+     * 
+     * @param [in] pos 後ろのストリップの先頭の頂点インデックスの位置
+     * 
+     * @par 詳細
+     *      前のストリップの末尾と後ろのストリップの先頭を繰り返し、面積0の三角形で繋ぐ。
+     *      後ろのストリップの先頭が偶数番目となるよう調整し、三角形の向きを保つ。
+     */
+    void Stroke::link(const std::size_t pos)
+    {
+        if ((pos == 0U) || (pos >= this->m_indexes.size())) {
+            return;
+        }
+        const Index tail = this->m_indexes[pos - 1U];
+        const Index head = this->m_indexes[pos];
+        Indexes bridge = { tail, head };
+        if ((pos % 2U) != 0U) {
+            bridge.push_back(head);
+        }
+        (void)this->m_indexes.insert(this->m_indexes.begin() + static_cast<std::ptrdiff_t>(pos), bridge.begin(), bridge.end());
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] width 線幅
+     * @param [in] join 接続部の形状
+     * @param [in] cap 端点の形状
+     */
+    Stroker::Stroker(const float width, const JOIN join, const CAP cap) :
+        m_width(width), m_join(join), m_cap(cap), m_miter_limit(4.0F), m_round_div(16)
+    {
+    }
+
+    /**
+     * @brief マイター長の上限を設定
+     * 
+     * @param [in] limit マイター長の上限（線幅の半分に対する倍率）
+     * 
+     * @par 詳細
+     *      鋭角の接続部でマイター長が上限を超える場合は、ベベルで接続する。
+     */
+    void Stroker::setMiterLimit(const float limit) { this->m_miter_limit = limit; }
+
+    /**
+     * @brief 半円あたりの分割数を設定
+     * 
+     * @param [in] div 半円あたりの分割数（ROUNDの接続部および端点に使用する）
+     */
+    void Stroker::setRoundDivision(const std::int32_t div) { this->m_round_div = std::max(div, 2); }
+
+    /**
+     * @brief 線を太線に変換して追加
+     * 
+     * @param [in] polyline 線の頂点座標の並び
+     * @param [in] colors 線の頂点色の並び（空の場合は黒）
+     * @param [in] closed 始点と終点を接続する場合はtrue
+     * @param [in,out] out 出力先
+     * 
+     * @par 詳細
+     *      連続する同一点は1点にまとめる。
+     *      出力先に既に頂点がある場合は、縮退三角形で連結する。
+     *      Z座標は各頂点の値を引き継ぐ。
+     */
+    void Stroker::stroke(const Vertexes& polyline, const Colors& colors, const bool closed, Stroke& out) const
+    {
+        // 連続する同一点を除いた点の並び（元の頂点番号を保持）
+        std::vector<std::size_t> src;
+        src.reserve(polyline.size() + 1U);
+        for (std::size_t i = 0U; i < polyline.size(); i++) {
+            if (!src.empty()) {
+                const Vertex& q = polyline[src.back()];
+                const float dx = polyline[i].x() - q.x();
+                const float dy = polyline[i].y() - q.y();
+                if (((dx * dx) + (dy * dy)) <= STROKE_EPS2) {
+                    continue;
+                }
+            }
+            src.push_back(i);
+        }
+        if (closed && (src.size() > 2U)) {
+            const Vertex& f = polyline[src.front()];
+            const Vertex& l = polyline[src.back()];
+            const float dx = f.x() - l.x();
+            const float dy = f.y() - l.y();
+            if (((dx * dx) + (dy * dy)) <= STROKE_EPS2) {
+                src.pop_back();
+            }
+        }
+        const bool loop = closed && (src.size() > 2U);
+        if (src.size() < 2U) {
+            return;
+        }
+
+        // 点の並びをSoAに詰め替え、線分の法線を一括計算する（閉じる場合は始点を末尾に追加）
+        const std::size_t pnum = src.size();
+        const std::size_t snum = loop ? pnum : (pnum - 1U);
+        std::vector<float> xs(snum + 1U), ys(snum + 1U), nxs(snum), nys(snum);
+        for (std::size_t i = 0U; i <= snum; i++) {
+            const Vertex& v = polyline[src[i % pnum]];
+            xs[i] = v.x();
+            ys[i] = v.y();
+        }
+        computeNormals(&xs[0], &ys[0], snum, &nxs[0], &nys[0]);
+
+        auto point = [&](const std::size_t i) { return Point2{ xs[i], ys[i] }; };
+        auto normal = [&](const std::size_t s) { return Point2{ nxs[s], nys[s] }; };
+        auto length = [&](const std::size_t s) {
+            const float dx = xs[s + 1U] - xs[s];
+            const float dy = ys[s + 1U] - ys[s];
+            return std::sqrt((dx * dx) + (dy * dy));
+        };
+        auto color = [&](const std::size_t i) { return (src[i] < colors.size()) ? colors[src[i]] : Color(0, 0, 0, 255); };
+        auto depth = [&](const std::size_t i) { return polyline[src[i]].z(); };
+
+        const std::size_t first_index = out.indexes().size();
+        out.reserve(out.vertexes().size() + (pnum * 3U), first_index + (pnum * 4U));
+        StrokeBuilder builder(out, this->m_width / 2.0F, this->m_miter_limit, this->m_round_div);
+        if (loop) {
+            // 始点の接続部から一周し、最後に始点の入側の組を再度出力して閉じる
+            builder.join(this->m_join, point(0U), normal(snum - 1U), normal(0U), std::min(length(snum - 1U), length(0U)), color(0U), depth(0U));
+            for (std::size_t i = 1U; i < pnum; i++) {
+                builder.join(this->m_join, point(i), normal(i - 1U), normal(i), std::min(length(i - 1U), length(i)), color(i), depth(i));
+            }
+            const std::uint32_t l = out.indexes()[first_index].idx();
+            const std::uint32_t r = out.indexes()[first_index + 1U].idx();
+            out.addIndex(l);
+            out.addIndex(r);
+        }
+        else {
+            builder.cap(this->m_cap, point(0U), normal(0U), true, color(0U), depth(0U));
+            for (std::size_t i = 1U; i < (pnum - 1U); i++) {
+                builder.join(this->m_join, point(i), normal(i - 1U), normal(i), std::min(length(i - 1U), length(i)), color(i), depth(i));
+            }
+            builder.cap(this->m_cap, point(pnum - 1U), normal(snum - 1U), false, color(pnum - 1U), depth(pnum - 1U));
+        }
+
+        // 既存のストリップと縮退三角形で連結する
+        out.link(first_index);
+    }
+}
+
+namespace {
+    //! 三角形ストリップの面積の合計を計算（縮退三角形は面積0）
+    float stripArea(const my::Stroke& s)
+    {
+        float area = 0.0F;
+        const my::Indexes& idx = s.indexes();
+        for (std::size_t i = 2U; i < idx.size(); i++) {
+            const my::Vertex& a = s.vertexes()[idx[i - 2U].idx()];
+            const my::Vertex& b = s.vertexes()[idx[i - 1U].idx()];
+            const my::Vertex& c = s.vertexes()[idx[i].idx()];
+            area += std::fabs(((b.x() - a.x()) * (c.y() - a.y())) - ((c.x() - a.x()) * (b.y() - a.y()))) / 2.0F;
+        }
+        return area;
+    }
+
+    //! 期待値との比較結果を出力
+    bool expectNear(const char* name, const float actual, const float expected, const float tolerance)
+    {
+        const bool ok = (std::fabs(actual - expected) <= tolerance);
+        std::cout << "* " << name << " actual:" << actual << " expected:" << expected << (ok ? " .. OK" : " .. NG") << std::endl;
+        return ok;
+    }
+}
+
+namespace my {
+    /**
+     * @brief Strokerクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     * 
+     * @par 詳細
+     *      生成した三角形ストリップの面積を、線幅から求めた理論値と比較する。
+     */
+    bool testcode_Stroker()
+    {
+        std::cout << "[testcode_Stroker()] call" << std::endl;
+        bool ok = true;
+        const Vertexes line = { { 0.0F, 0.0F }, { 50.0F, 0.0F }, { 100.0F, 0.0F } };
+        const Vertexes square = { { 0.0F, 0.0F }, { 100.0F, 0.0F }, { 100.0F, 100.0F }, { 0.0F, 100.0F } };
+        const Vertexes corner = { { 0.0F, 0.0F }, { 100.0F, 0.0F }, { 100.0F, 100.0F } };
+
+        // 直線：幅10、長さ100
+        Stroke s1;
+        Stroker(10.0F, Stroker::JOIN::MITER, Stroker::CAP::BUTT).stroke(line, Colors(), false, s1);
+        ok = expectNear("line butt", stripArea(s1), 1000.0F, 0.01F) && ok;
+        Stroke s2;
+        Stroker(10.0F, Stroker::JOIN::MITER, Stroker::CAP::SQUARE).stroke(line, Colors(), false, s2);
+        ok = expectNear("line square", stripArea(s2), 1100.0F, 0.01F) && ok;
+        Stroke s3;
+        Stroker(10.0F, Stroker::JOIN::MITER, Stroker::CAP::ROUND).stroke(line, Colors(), false, s3);
+        ok = expectNear("line round", stripArea(s3), 1000.0F + (MATRIX_PI * 25.0F), 2.0F) && ok;
+
+        // 閉じた正方形：外形110x110から内形90x90を除いた面積
+        Stroke s4;
+        Stroker(10.0F, Stroker::JOIN::MITER, Stroker::CAP::BUTT).stroke(square, Colors(), true, s4);
+        ok = expectNear("square miter", stripArea(s4), 4000.0F, 0.1F) && ok;
+
+        // 直角の接続部：マイターは角の正方形25、ベベルは三角形12.5、ラウンドは四分円
+        Stroke s5;
+        Stroker(10.0F, Stroker::JOIN::MITER, Stroker::CAP::BUTT).stroke(corner, Colors(), false, s5);
+        ok = expectNear("corner miter", stripArea(s5), 2000.0F, 0.1F) && ok;
+        Stroke s6;
+        Stroker(10.0F, Stroker::JOIN::BEVEL, Stroker::CAP::BUTT).stroke(corner, Colors(), false, s6);
+        ok = expectNear("corner bevel", stripArea(s6), 2000.0F - 12.5F, 0.1F) && ok;
+        Stroke s7;
+        Stroker(10.0F, Stroker::JOIN::ROUND, Stroker::CAP::BUTT).stroke(corner, Colors(), false, s7);
+        ok = expectNear("corner round", stripArea(s7), 2000.0F - 25.0F + (MATRIX_PI * 25.0F / 4.0F), 0.5F) && ok;
+
+        // 2本の線の連結：縮退三角形は面積に影響しない
+        Stroke s8;
+        const Stroker stroker(10.0F, Stroker::JOIN::MITER, Stroker::CAP::BUTT);
+        stroker.stroke(line, Colors(), false, s8);
+        stroker.stroke({ { 0.0F, 50.0F }, { 100.0F, 50.0F } }, Colors(), false, s8);
+        ok = expectNear("linked lines", stripArea(s8), 2000.0F, 0.01F) && ok;
+
+        return ok;
+    }
+
+    /**
+     * @brief Strokerクラスの処理性能を計測
+     * 
+     * @par 詳細
+     *      ランダムな折れ線を各接続部の形状で変換し、1秒あたりの線分数を出力する。
+     */
+    void benchcode_Stroker()
+    {
+        std::cout << "[benchcode_Stroker()] call" << std::endl;
+        const std::size_t num = 1000000U;
+        Vertexes polyline;
+        polyline.reserve(num);
+        std::uint32_t seed = 1U;
+        float x = 0.0F, y = 0.0F;
+        for (std::size_t i = 0U; i < num; i++) {
+            seed = (seed * 1664525U) + 1013904223U;
+            const float a = static_cast<float>(seed >> 8) / 16777216.0F * 2.0F * MATRIX_PI;
+            x += std::cos(a) * 10.0F;
+            y += std::sin(a) * 10.0F;
+            polyline.push_back({ x, y });
+        }
+
+        const Stroker::JOIN joins[] = { Stroker::JOIN::MITER, Stroker::JOIN::BEVEL, Stroker::JOIN::ROUND };
+        const char* names[] = { "miter", "bevel", "round" };
+        for (std::size_t j = 0U; j < 3U; j++) {
+            Stroke out;
+            const Stroker stroker(5.0F, joins[j], Stroker::CAP::BUTT);
+            const auto start = std::chrono::steady_clock::now();
+            stroker.stroke(polyline, Colors(), false, out);
+            const auto end = std::chrono::steady_clock::now();
+            const double sec = std::chrono::duration<double>(end - start).count();
+            std::cout << "* " << names[j] << " segments:" << (num - 1U) << " time:" << (sec * 1000.0) << "[msec] "
+                << (static_cast<double>(num - 1U) / sec / 1000000.0) << "[Msegments/sec] vertexes:" << out.vertexes().size() << std::endl;
+        }
+    }
+}
@@ -0,0 +1,101 @@
+﻿/**
+ * @file Stroke.hpp
+ * @author kota-kota
+ * @brief 太線を三角形ストリップに分割するクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_STROKE_HPP
+#define INCLUDED_STROKE_HPP
+
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class Stroke
+     * @brief 太線の形状（GL_TRIANGLE_STRIPで描画する頂点の並び）を扱うクラス
+     */
+    class Stroke {
+        Vertexes    m_vertexes;     //!< 頂点座標の並び
+        Indexes     m_indexes;      //!< 頂点インデックスの並び（GL_TRIANGLE_STRIP）
+        Colors      m_colors;       //!< 頂点色の並び
+
+    public:
+        //! デフォルトコンストラクタ
+        Stroke();
+
+    public:
+        //! 頂点座標の並びを取得
+        const Vertexes& vertexes() const;
+        //! 頂点インデックスの並びを取得
+        const Indexes& indexes() const;
+        //! 頂点色の並びを取得
+        const Colors& colors() const;
+
+    public:
+        //! 全て削除
+        void clear();
+        //! 領域を予約
+        void reserve(const std::size_t vnum, const std::size_t inum);
+        //! 頂点を追加
+        std::uint32_t addVertex(const Vertex& v, const Color& c);
+        //! 頂点インデックスを追加
+        void addIndex(const std::uint32_t idx);
+        //! 前後のストリップを連結
+        void link(const std::size_t pos);
+    };
+}
+
+namespace my {
+    /**
+     * @class Stroker
+     * @brief 線（頂点の並び）を指定した幅の太線に変換するクラス
+     * 
+     * @par 詳細
+     *      glLineWidth()に依存せず、任意の幅の線を三角形ストリップとして生成する。
+     *      線の接続部（ジョイン）と端点（キャップ）の形状を指定できる。
+     *      複数の線を同じStrokeに追加した場合は、縮退三角形で1つのストリップに連結する。
+     */
+    class Stroker {
+    public:
+        //! 接続部の形状
+        enum class JOIN { MITER, BEVEL, ROUND };
+        //! 端点の形状
+        enum class CAP { BUTT, SQUARE, ROUND };
+
+    private:
+        float           m_width;        //!< 線幅
+        JOIN            m_join;         //!< 接続部の形状
+        CAP             m_cap;          //!< 端点の形状
+        float           m_miter_limit;  //!< マイター長の上限（線幅の半分に対する倍率）
+        std::int32_t    m_round_div;    //!< 半円あたりの分割数
+
+    public:
+        //! コンストラクタ
+        Stroker(const float width, const JOIN join, const CAP cap);
+
+    public:
+        //! マイター長の上限を設定
+        void setMiterLimit(const float limit);
+        //! 半円あたりの分割数を設定
+        void setRoundDivision(const std::int32_t div);
+
+    public:
+        //! 線を太線に変換して追加
+        void stroke(const Vertexes& polyline, const Colors& colors, const bool closed, Stroke& out) const;
+    };
+}
+
+namespace my {
+    //! Strokerクラスのテストコードを実行
+    bool testcode_Stroker();
+    //! Strokerクラスの処理性能を計測
+    void benchcode_Stroker();
+}
+
+#endif //INCLUDED_STROKE_HPP
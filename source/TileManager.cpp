@@ -0,0 +1,724 @@
+﻿/**
+ * @file TileManager.cpp
+ * @author kota-kota
+ * @brief 四分木のタイルに分割したシーンの読み込み・破棄を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "TileManager.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <utility>
+
+namespace {
+    //! 段の上限（列・行の数が32bitに収まる範囲）
+    constexpr std::uint32_t LEVEL_LIMIT = 16U;
+
+    //! 座標をタイルの列・行に変換（範囲外は端のタイルとする）
+    std::uint32_t tileIndex(const float v, const float min, const float size, const std::uint32_t n)
+    {
+        const float i = std::floor((v - min) / size);
+        if (i < 0.0F) {
+            return 0U;
+        }
+        if (!(i < static_cast<float>(n))) {
+            return n - 1U;
+        }
+        return static_cast<std::uint32_t>(i);
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    TileKey::TileKey() :
+        m_level(0U), m_x(0U), m_y(0U)
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] level 段
+     * @param [in] x 列
+     * @param [in] y 行
+     */
+    TileKey::TileKey(const std::uint32_t level, const std::uint32_t x, const std::uint32_t y) :
+        m_level(level), m_x(x), m_y(y)
+    {
+    }
+
+    /**
+     * @brief 段を取得
+     * 
+     * @return std::uint32_t 段
+     */
+    std::uint32_t TileKey::level() const { return this->m_level; }
+
+    /**
+     * @brief 列を取得
+     * 
+     * @return std::uint32_t 列
+     */
+    std::uint32_t TileKey::x() const { return this->m_x; }
+
+    /**
+     * @brief 行を取得
+     * 
+     * @return std::uint32_t 行
+     */
+    std::uint32_t TileKey::y() const { return this->m_y; }
+
+    /**
+     * @brief 親のタイルを取得（段0の場合は自身）
+     * 
+     * @return TileKey 親のタイル
+     */
+    TileKey TileKey::parent() const
+    {
+        if (this->m_level == 0U) {
+            return *this;
+        }
+        return TileKey(this->m_level - 1U, this->m_x / 2U, this->m_y / 2U);
+    }
+
+    /**
+     * @brief ワールドの範囲に対するタイルの範囲を取得
+     * 
+     * @param [in] world ワールドの範囲
+     * 
+     * @return Aabb タイルの範囲
+     */
+    Aabb TileKey::bounds(const Aabb& world) const
+    {
+        const float n = static_cast<float>(1U << this->m_level);
+        const float w = (world.maxx() - world.minx()) / n;
+        const float h = (world.maxy() - world.miny()) / n;
+        const float x = world.minx() + (w * static_cast<float>(this->m_x));
+        const float y = world.miny() + (h * static_cast<float>(this->m_y));
+        return Aabb(x, y, x + w, y + h);
+    }
+
+    /**
+     * @brief 等しいか判定
+     * 
+     * @param [in] key 比較するタイル
+     * 
+     * @return true 等しい
+     * @return false 等しくない
+     */
+    bool TileKey::operator==(const TileKey& key) const
+    {
+        return (this->m_level == key.m_level) && (this->m_x == key.m_x) && (this->m_y == key.m_y);
+    }
+
+    /**
+     * @brief 並び順（段・行・列の順）で小さいか判定
+     * 
+     * @param [in] key 比較するタイル
+     * 
+     * @return true 小さい
+     * @return false 小さくない
+     */
+    bool TileKey::operator<(const TileKey& key) const
+    {
+        if (this->m_level != key.m_level) {
+            return this->m_level < key.m_level;
+        }
+        if (this->m_y != key.m_y) {
+            return this->m_y < key.m_y;
+        }
+        return this->m_x < key.m_x;
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] world ワールドの範囲
+     * @param [in] max_level 最も細かい段（LEVEL_LIMITまで）
+     * @param [in] tile_pixels 段を選ぶ際のタイルの表示サイズの上限[pixel]
+     * @param [in] budget GPUメモリの使用量の上限[byte]
+     * @param [in] loader 読み込み関数
+     * @param [in] uploader 転送関数
+     * @param [in] releaser 破棄関数
+     * 
+     * @par 詳細
+     *      ワーカースレッドを開始する。
+     */
+    TileManager::TileManager(const Aabb& world, const std::uint32_t max_level, const float tile_pixels, const std::size_t budget,
+                             const Loader& loader, const Uploader& uploader, const Releaser& releaser) :
+        m_world(world), m_max_level(std::min(max_level, LEVEL_LIMIT)), m_tile_pixels(tile_pixels), m_budget(budget), m_upload_limit(0U),
+        m_loader(loader), m_uploader(uploader), m_releaser(releaser),
+        m_tiles(), m_queue(), m_mutex(), m_cond(), m_quit(false), m_frame(0U), m_used(0U), m_visibles(), m_wanted(), m_dropped(), m_worker()
+    {
+        this->m_worker = std::thread(&TileManager::work, this);
+    }
+
+    /**
+     * @brief デストラクタ
+     * 
+     * @par 詳細
+     *      読み込み中のタイルの完了を待ってワーカースレッドを終了する。
+     *      転送済みのタイルに対して破棄関数は呼ばない。
+     */
+    TileManager::~TileManager()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            this->m_quit = true;
+        }
+        this->m_cond.notify_all();
+        this->m_worker.join();
+    }
+
+    /**
+     * @brief タイルのファイルのパスを取得
+     * 
+     * @param [in] dir ディレクトリ
+     * @param [in] key タイル
+     * 
+     * @return std::string パス（<dir>/tile_<段>_<列>_<行>.mysc）
+     */
+    std::string TileManager::path(const std::string& dir, const TileKey& key)
+    {
+        return dir + "/tile_" + std::to_string(key.level()) + "_" + std::to_string(key.x()) + "_" + std::to_string(key.y()) + ".mysc";
+    }
+
+    /**
+     * @brief ディレクトリからタイルのファイルを読み込む読み込み関数を作成
+     * 
+     * @param [in] dir ディレクトリ
+     * 
+     * @return Loader 読み込み関数
+     * 
+     * @par 詳細
+     *      ファイルがないタイルは空のタイルとして扱うため、エラーを出力しない。
+     */
+    TileManager::Loader TileManager::fileLoader(const std::string& dir)
+    {
+        return [dir](const TileKey& key, SceneFile& file) {
+            const std::string p = TileManager::path(dir, key);
+            if (!std::ifstream(p, std::ios::binary)) {
+                return false;
+            }
+            return file.open(p);
+        };
+    }
+
+    /**
+     * @brief GPUメモリの使用量の上限を設定
+     * 
+     * @param [in] budget 上限[byte]
+     */
+    void TileManager::setBudget(const std::size_t budget) { this->m_budget = budget; }
+
+    /**
+     * @brief 1フレームで転送するGPUメモリの上限を設定（0は制限なし）
+     * 
+     * @param [in] limit 上限[byte]
+     * 
+     * @par 詳細
+     *      上限に関わらず、1フレームで最低1タイルは転送する。
+     */
+    void TileManager::setUploadLimit(const std::size_t limit) { this->m_upload_limit = limit; }
+
+    /**
+     * @brief タイルの範囲を取得
+     * 
+     * @param [in] key タイル
+     * 
+     * @return Aabb タイルの範囲
+     */
+    Aabb TileManager::bounds(const TileKey& key) const { return key.bounds(this->m_world); }
+
+    /**
+     * @brief 拡大率に応じた段を取得
+     * 
+     * @param [in] scale 拡大率（ワールド座標1あたりのピクセル数）
+     * 
+     * @return std::uint32_t タイルの表示サイズが上限以下となる最も粗い段（最も細かい段まで）
+     */
+    std::uint32_t TileManager::level(const float scale) const
+    {
+        float pixels = (this->m_world.maxx() - this->m_world.minx()) * scale;
+        std::uint32_t level = 0U;
+        while ((level < this->m_max_level) && (pixels > this->m_tile_pixels)) {
+            pixels /= 2.0F;
+            level++;
+        }
+        return level;
+    }
+
+    /**
+     * @brief 矩形と交差する段levelのタイルを取得
+     * 
+     * @param [in] box 矩形
+     * @param [in] level 段
+     * @param [out] out タイルの並び（末尾に追加する）
+     */
+    void TileManager::cover(const Aabb& box, const std::uint32_t level, std::vector<TileKey>& out) const
+    {
+        if (!box.intersects(this->m_world)) {
+            return;
+        }
+        const std::uint32_t n = 1U << level;
+        const float w = (this->m_world.maxx() - this->m_world.minx()) / static_cast<float>(n);
+        const float h = (this->m_world.maxy() - this->m_world.miny()) / static_cast<float>(n);
+        const std::uint32_t x0 = tileIndex(box.minx(), this->m_world.minx(), w, n);
+        const std::uint32_t x1 = tileIndex(box.maxx(), this->m_world.minx(), w, n);
+        const std::uint32_t y0 = tileIndex(box.miny(), this->m_world.miny(), h, n);
+        const std::uint32_t y1 = tileIndex(box.maxy(), this->m_world.miny(), h, n);
+        for (std::uint32_t y = y0; y <= y1; y++) {
+            for (std::uint32_t x = x0; x <= x1; x++) {
+                out.push_back(TileKey(level, x, y));
+            }
+        }
+    }
+
+    /**
+     * @brief 表示範囲に応じてタイルを読み込み・転送・破棄（描画スレッドから毎フレーム呼ぶ）
+     * 
+     * @param [in] viewbox 表示範囲（ワールド座標系）
+     * @param [in] scale 拡大率（ワールド座標1あたりのピクセル数）
+     * 
+     * @par 詳細
+     *      表示範囲と交差するタイルを、表示範囲の中心に近い順に読み込む。
+     *      続けて、表示範囲を1タイル分広げた範囲のタイルを先読みする。
+     *      上限により破棄した先読みのタイルは、読み込み対象が変わるまで読み込まない（静止した表示で読み込み・破棄を繰り返さない）。
+     */
+    void TileManager::update(const Aabb& viewbox, const float scale)
+    {
+        this->m_frame++;
+        const std::uint32_t lv = this->level(scale);
+        std::vector<TileKey> covers;
+        this->cover(viewbox, lv, covers);
+        const Aabb tile = this->bounds(TileKey(lv, 0U, 0U));
+        const float tw = tile.maxx() - tile.minx();
+        const float th = tile.maxy() - tile.miny();
+        std::vector<TileKey> nears;
+        this->cover(Aabb(viewbox.minx() - tw, viewbox.miny() - th, viewbox.maxx() + tw, viewbox.maxy() + th), lv, nears);
+
+        // 表示範囲の中心に近い順に並べる（表示範囲と交差するタイルを先にする）
+        const float cx = (viewbox.minx() + viewbox.maxx()) / 2.0F;
+        const float cy = (viewbox.miny() + viewbox.maxy()) / 2.0F;
+        const auto distance = [&](const TileKey& key) {
+            const Aabb b = this->bounds(key);
+            const float dx = ((b.minx() + b.maxx()) / 2.0F) - cx;
+            const float dy = ((b.miny() + b.maxy()) / 2.0F) - cy;
+            return (dx * dx) + (dy * dy);
+        };
+        const auto closer = [&](const TileKey& a, const TileKey& b) { return distance(a) < distance(b); };
+        std::vector<TileKey> wanted = covers;
+        std::sort(wanted.begin(), wanted.end(), closer);
+        std::sort(nears.begin(), nears.end(), closer);
+        for (const TileKey& key : nears) {
+            if (std::find(covers.begin(), covers.end(), key) == covers.end()) {
+                wanted.push_back(key);
+            }
+        }
+        if (wanted != this->m_wanted) {
+            this->m_wanted = wanted;
+            this->m_dropped.clear();
+        }
+        wanted.erase(std::remove_if(wanted.begin(), wanted.end(), [this](const TileKey& key) { return this->m_dropped.count(key) != 0U; }), wanted.end());
+
+        this->request(wanted);
+        this->upload();
+        this->select(covers);
+        this->evict();
+    }
+
+    /**
+     * @brief 描画するタイルを取得（段の昇順、粗い段を先に描画する）
+     * 
+     * @return const std::vector<TileKey>& タイルの並び
+     */
+    const std::vector<TileKey>& TileManager::visibles() const { return this->m_visibles; }
+
+    /**
+     * @brief GPUメモリの使用量を取得
+     * 
+     * @return std::size_t 使用量[byte]
+     */
+    std::size_t TileManager::used() const { return this->m_used; }
+
+    /**
+     * @brief 転送済みのタイルの数を取得
+     * 
+     * @return std::size_t タイルの数
+     */
+    std::size_t TileManager::residentNum() const
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        return static_cast<std::size_t>(std::count_if(this->m_tiles.begin(), this->m_tiles.end(),
+                                                       [](const std::pair<const TileKey, Tile>& t) { return t.second.state == STATE::RESIDENT; }));
+    }
+
+    /**
+     * @brief 読み込み待ち・読み込み中・転送待ちのタイルの数を取得
+     * 
+     * @return std::size_t タイルの数
+     */
+    std::size_t TileManager::pendingNum() const
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        return static_cast<std::size_t>(std::count_if(this->m_tiles.begin(), this->m_tiles.end(), [](const std::pair<const TileKey, Tile>& t) {
+            return (t.second.state == STATE::QUEUED) || (t.second.state == STATE::LOADING) || (t.second.state == STATE::LOADED);
+        }));
+    }
+
+    /**
+     * @brief 読み込み対象のタイルを登録し、不要になった読み込み待ちのタイルを取り消し
+     * 
+     * @param [in] wanted 読み込み対象のタイル（優先度の高い順）
+     * 
+     * @par 詳細
+     *      読み込み中のタイルは取り消さない（読み込み後、転送せずに破棄する）。
+     */
+    void TileManager::request(const std::vector<TileKey>& wanted)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            for (std::size_t i = 0U; i < wanted.size(); i++) {
+                const std::uint32_t priority = static_cast<std::uint32_t>(i);
+                const auto it = this->m_tiles.find(wanted[i]);
+                if (it == this->m_tiles.end()) {
+                    this->m_tiles.emplace(wanted[i], Tile{ STATE::QUEUED, nullptr, 0U, this->m_frame, 0U, priority });
+                }
+                else {
+                    it->second.wanted = this->m_frame;
+                    it->second.priority = priority;
+                }
+            }
+            // 不要になったタイルを取り消す（転送済みのタイルはevict()で破棄する）
+            for (auto it = this->m_tiles.begin(); it != this->m_tiles.end();) {
+                const STATE state = it->second.state;
+                const bool cancel = (it->second.wanted != this->m_frame) && ((state == STATE::QUEUED) || (state == STATE::LOADED) || (state == STATE::MISSING));
+                it = cancel ? this->m_tiles.erase(it) : std::next(it);
+            }
+            // 読み込み待ちの並びを優先度の降順で作り直す（末尾から取り出す）
+            this->m_queue.clear();
+            for (const auto& t : this->m_tiles) {
+                if (t.second.state == STATE::QUEUED) {
+                    this->m_queue.push_back(t.first);
+                }
+            }
+            std::sort(this->m_queue.begin(), this->m_queue.end(), [this](const TileKey& a, const TileKey& b) {
+                return this->m_tiles.at(a).priority > this->m_tiles.at(b).priority;
+            });
+        }
+        this->m_cond.notify_one();
+    }
+
+    /**
+     * @brief 転送待ちのタイルを転送
+     * 
+     * @par 詳細
+     *      優先度の高い順に、1フレームの転送量の上限まで転送する。
+     *      転送中はワーカースレッドを止めないよう、ファイルを管理情報から取り出して転送する。
+     */
+    void TileManager::upload()
+    {
+        std::vector<std::pair<TileKey, std::unique_ptr<SceneFile>>> ready;
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            std::vector<TileKey> keys;
+            for (const auto& t : this->m_tiles) {
+                if (t.second.state == STATE::LOADED) {
+                    keys.push_back(t.first);
+                }
+            }
+            std::sort(keys.begin(), keys.end(), [this](const TileKey& a, const TileKey& b) {
+                return this->m_tiles.at(a).priority < this->m_tiles.at(b).priority;
+            });
+            for (const TileKey& key : keys) {
+                ready.emplace_back(key, std::move(this->m_tiles.at(key).file));
+            }
+        }
+
+        std::vector<std::pair<TileKey, std::size_t>> uploaded;
+        std::size_t sent = 0U;
+        for (auto& r : ready) {
+            if ((this->m_upload_limit != 0U) && (sent >= this->m_upload_limit)) {
+                break;
+            }
+            const std::size_t bytes = this->m_uploader(r.first, *r.second);
+            uploaded.emplace_back(r.first, bytes);
+            r.second.reset();
+            sent += bytes;
+        }
+
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        for (const auto& u : uploaded) {
+            Tile& tile = this->m_tiles.at(u.first);
+            tile.state = STATE::RESIDENT;
+            tile.bytes = u.second;
+            this->m_used += u.second;
+        }
+        // 転送しなかったファイルは次のフレームへ持ち越す
+        for (auto& r : ready) {
+            if (r.second) {
+                this->m_tiles.at(r.first).file = std::move(r.second);
+            }
+        }
+    }
+
+    /**
+     * @brief 描画するタイルを選択
+     * 
+     * @param [in] covers 表示範囲と交差するタイル
+     * 
+     * @par 詳細
+     *      転送済みでないタイルは、転送済みの最も近い祖先のタイルで代替する。
+     *      ファイルがないタイルは空のタイルとして何も描画しない。
+     */
+    void TileManager::select(const std::vector<TileKey>& covers)
+    {
+        this->m_visibles.clear();
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        for (const TileKey& cover : covers) {
+            TileKey key = cover;
+            for (;;) {
+                const auto it = this->m_tiles.find(key);
+                if (it != this->m_tiles.end()) {
+                    if (it->second.state == STATE::RESIDENT) {
+                        it->second.visible = this->m_frame;
+                        this->m_visibles.push_back(key);
+                        break;
+                    }
+                    if ((it->second.state == STATE::MISSING) && (key == cover)) {
+                        break;
+                    }
+                }
+                if (key.level() == 0U) {
+                    break;
+                }
+                key = key.parent();
+            }
+        }
+        std::sort(this->m_visibles.begin(), this->m_visibles.end());
+        this->m_visibles.erase(std::unique(this->m_visibles.begin(), this->m_visibles.end()), this->m_visibles.end());
+    }
+
+    /**
+     * @brief 上限を超えたGPUメモリを解放
+     * 
+     * @par 詳細
+     *      今フレームに描画するタイルは破棄しない。
+     *      読み込み対象でないタイルを、最後に表示したフレームが古い順に破棄する。
+     *      足りない場合は、先読みしたタイルも同じ順に破棄し、読み込み対象が変わるまで読み込まないよう記録する。
+     */
+    void TileManager::evict()
+    {
+        std::vector<TileKey> victims;
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            while (this->m_used > this->m_budget) {
+                auto victim = this->m_tiles.end();
+                for (auto it = this->m_tiles.begin(); it != this->m_tiles.end(); ++it) {
+                    const Tile& t = it->second;
+                    if ((t.state != STATE::RESIDENT) || (t.visible == this->m_frame)) {
+                        continue;
+                    }
+                    if (victim == this->m_tiles.end()) {
+                        victim = it;
+                        continue;
+                    }
+                    const Tile& v = victim->second;
+                    const bool t_wanted = (t.wanted == this->m_frame);
+                    const bool v_wanted = (v.wanted == this->m_frame);
+                    if ((t_wanted != v_wanted) ? !t_wanted : (t.visible < v.visible)) {
+                        victim = it;
+                    }
+                }
+                if (victim == this->m_tiles.end()) {
+                    // 今フレームに描画するタイルだけで上限を超えている
+                    break;
+                }
+                this->m_used -= victim->second.bytes;
+                if (victim->second.wanted == this->m_frame) {
+                    this->m_dropped.insert(victim->first);
+                }
+                victims.push_back(victim->first);
+                this->m_tiles.erase(victim);
+            }
+        }
+        for (const TileKey& key : victims) {
+            this->m_releaser(key);
+        }
+    }
+
+    /**
+     * @brief ワーカースレッドの処理
+     * 
+     * @par 詳細
+     *      読み込み待ちのタイルを優先度の高い順に取り出して読み込む。
+     *      読み込んだファイルは全ページを読み込み、転送時に描画スレッドでページフォルトが発生しないようにする。
+     */
+    void TileManager::work()
+    {
+        for (;;) {
+            TileKey key;
+            {
+                std::unique_lock<std::mutex> lock(this->m_mutex);
+                this->m_cond.wait(lock, [this]() { return this->m_quit || !this->m_queue.empty(); });
+                if (this->m_quit) {
+                    return;
+                }
+                key = this->m_queue.back();
+                this->m_queue.pop_back();
+                this->m_tiles.at(key).state = STATE::LOADING;
+            }
+
+            std::unique_ptr<SceneFile> file(new SceneFile());
+            const bool ok = this->m_loader(key, *file);
+            if (ok) {
+                file->prefetch();
+            }
+
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            Tile& tile = this->m_tiles.at(key);
+            if (ok) {
+                tile.state = STATE::LOADED;
+                tile.file = std::move(file);
+            }
+            else {
+                tile.state = STATE::MISSING;
+            }
+        }
+    }
+}
+
+namespace my {
+    /**
+     * @brief TileManagerクラスのテストコードを実行
+     * 
+     * @return true 成功
+     * @return false 失敗
+     */
+    bool testcode_TileManager()
+    {
+        std::cout << "[testcode_TileManager()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const char* name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+
+        // ワールド(0,0)-(256,256)を段2まで分割したタイルを書き込む（タイル(2,3,3)はファイルなし）
+        const Aabb world(0.0F, 0.0F, 256.0F, 256.0F);
+        const std::string dir = ".";
+        const TileKey missing(2U, 3U, 3U);
+        std::vector<std::string> paths;
+        {
+            const TileManager grid(world, 2U, 64.0F, 0U, TileManager::Loader(), TileManager::Uploader(), TileManager::Releaser());
+            for (std::uint32_t level = 0U; level <= 2U; level++) {
+                for (std::uint32_t y = 0U; y < (1U << level); y++) {
+                    for (std::uint32_t x = 0U; x < (1U << level); x++) {
+                        const TileKey key(level, x, y);
+                        if (key == missing) {
+                            continue;
+                        }
+                        const Aabb b = key.bounds(world);
+                        SceneWriter writer;
+                        (void)writer.add("tile", 4U, { { b.minx(), b.miny() }, { b.maxx(), b.miny() }, { b.minx(), b.maxy() }, { b.maxx(), b.maxy() } },
+                                         { 0U, 1U, 2U, 2U, 1U, 3U }, Colors(4U, Color(0, 0, 0, 255)), { 0.0F, 0.0F, 0.0F });
+                        paths.push_back(TileManager::path(dir, key));
+                        ok = writer.write(paths.back()) && ok;
+                    }
+                }
+            }
+            check("level", (grid.level(0.25F) == 0U) && (grid.level(0.5F) == 1U) && (grid.level(1.0F) == 2U) && (grid.level(100.0F) == 2U));
+            std::vector<TileKey> keys;
+            grid.cover(Aabb(10.0F, 10.0F, 100.0F, 70.0F), 2U, keys);
+            check("cover", (keys.size() == 4U) && (keys[0] == TileKey(2U, 0U, 0U)) && (keys[3] == TileKey(2U, 1U, 1U)));
+        }
+
+        // 転送済みのタイルを記録する転送・破棄関数（1タイルあたり1000byteとする）
+        constexpr std::size_t TILE_BYTES = 1000U;
+        std::set<TileKey> resident;
+        const auto uploader = [&](const TileKey& key, const SceneFile& file) {
+            resident.insert(key);
+            return (file.size() == 1U) ? TILE_BYTES : 0U;
+        };
+        const auto releaser = [&](const TileKey& key) { resident.erase(key); };
+        // 読み込み・転送の回数を数える読み込み関数・転送関数
+        const TileManager::Loader files = TileManager::fileLoader(dir);
+        std::atomic<std::size_t> loads(0U);
+        std::size_t uploads = 0U;
+        const auto counter = [&](const TileKey& key, SceneFile& file) {
+            loads++;
+            return files(key, file);
+        };
+        const auto counted = [&](const TileKey& key, const SceneFile& file) {
+            uploads++;
+            return uploader(key, file);
+        };
+        // 読み込み待ちがなくなるまで更新する
+        const auto settle = [](TileManager& tm, const Aabb& viewbox, const float scale) {
+            for (std::int32_t i = 0; i < 5000; i++) {
+                tm.update(viewbox, scale);
+                if (tm.pendingNum() == 0U) {
+                    tm.update(viewbox, scale);
+                    return true;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return false;
+        };
+
+        {
+            TileManager tm(world, 2U, 64.0F, 100U * TILE_BYTES, counter, counted, releaser);
+            // 表示範囲の4タイルと、周囲の先読みの5タイル
+            const Aabb view1(0.0F, 0.0F, 100.0F, 100.0F);
+            check("settle", settle(tm, view1, 1.0F));
+            check("load", (tm.visibles().size() == 4U) && (tm.residentNum() == 9U) && (tm.used() == (9U * TILE_BYTES)) && (resident.size() == 9U));
+
+            // 上限を超えた分は、表示範囲外のタイルから破棄する（ファイルのないタイルは描画しない）
+            tm.setBudget(5U * TILE_BYTES);
+            const Aabb view2(150.0F, 150.0F, 250.0F, 250.0F);
+            check("settle budget", settle(tm, view2, 1.0F));
+            const std::vector<TileKey>& v = tm.visibles();
+            check("budget", (tm.used() <= (5U * TILE_BYTES)) && (resident.size() == tm.residentNum()) && (v.size() == 3U) &&
+                            (std::find(v.begin(), v.end(), missing) == v.end()) && (resident.count(TileKey(2U, 2U, 2U)) == 1U));
+
+            // 表示範囲が変わらない間は、上限により破棄した先読みのタイルを読み込み・転送し直さない
+            const std::size_t loaded = loads;
+            const std::size_t sent = uploads;
+            for (std::int32_t i = 0; i < 200; i++) {
+                tm.update(view2, 1.0F);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            check("budget static", (loads == loaded) && (uploads == sent) && (tm.used() <= (5U * TILE_BYTES)) && (tm.pendingNum() == 0U));
+        }
+
+        {
+            // 細かい段のタイルが未転送の間は、転送済みの祖先のタイルで代替する
+            resident.clear();
+            TileManager tm(world, 2U, 64.0F, 100U * TILE_BYTES, TileManager::fileLoader(dir), uploader, releaser);
+            tm.setUploadLimit(1U);
+            check("settle coarse", settle(tm, world, 0.25F));
+            tm.update(Aabb(0.0F, 0.0F, 100.0F, 100.0F), 1.0F);
+            const std::vector<TileKey>& v = tm.visibles();
+            check("fallback", !v.empty() && (v.front() == TileKey(0U, 0U, 0U)));
+        }
+
+        for (const std::string& p : paths) {
+            std::remove(p.c_str());
+        }
+        return ok;
+    }
+}
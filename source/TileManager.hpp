@@ -0,0 +1,186 @@
+﻿/**
+ * @file TileManager.hpp
+ * @author kota-kota
+ * @brief 四分木のタイルに分割したシーンの読み込み・破棄を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_TILEMANAGER_HPP
+#define INCLUDED_TILEMANAGER_HPP
+
+#include "SpatialIndex.hpp"
+#include "SceneFile.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace my {
+    /**
+     * @class TileKey
+     * @brief 四分木のタイルの位置（段・列・行）を扱うクラス
+     * 
+     * @par 詳細
+     *      段levelのタイルは、ワールドをX・Y方向にそれぞれ2^level個に分割した1つ。
+     *      列・行はワールドの最小座標側から数える。
+     */
+    class TileKey {
+        std::uint32_t   m_level;    //!< 段（0が最も粗い）
+        std::uint32_t   m_x;        //!< 列
+        std::uint32_t   m_y;        //!< 行
+
+    public:
+        //! デフォルトコンストラクタ
+        TileKey();
+        //! コンストラクタ
+        TileKey(const std::uint32_t level, const std::uint32_t x, const std::uint32_t y);
+
+    public:
+        //! 段を取得
+        std::uint32_t level() const;
+        //! 列を取得
+        std::uint32_t x() const;
+        //! 行を取得
+        std::uint32_t y() const;
+        //! 親のタイルを取得（段0の場合は自身）
+        TileKey parent() const;
+        //! ワールドの範囲に対するタイルの範囲を取得
+        Aabb bounds(const Aabb& world) const;
+        //! 等しいか判定
+        bool operator==(const TileKey& key) const;
+        //! 並び順（段・行・列の順）で小さいか判定
+        bool operator<(const TileKey& key) const;
+    };
+}
+
+namespace my {
+    /**
+     * @class TileManager
+     * @brief 四分木のタイルに分割したシーンを、表示範囲に応じて読み込み・破棄するクラス
+     * 
+     * @par 詳細
+     *      表示範囲と拡大率から段を選び、表示範囲と交差するタイルと、その周囲1タイル分を先読みする。
+     *      ファイルの読み込みはワーカースレッドで行い、GPUへの転送は描画スレッドのupdate()で行う。
+     *      1フレームで転送する量を制限し、パン・ズーム中の描画の引っかかりを抑える。
+     *      GPUメモリの使用量が上限を超えた場合は、最後に表示したフレームが古いタイルから破棄する。
+     *      上限により破棄した先読みのタイルは、表示範囲・段が変わるまで再び読み込まない。
+     *      表示すべきタイルが未転送の場合は、転送済みの祖先のタイルで代替する。
+     *      転送・破棄の関数は描画スレッドから呼ぶ。デストラクタでは破棄の関数を呼ばない。
+     */
+    class TileManager {
+    public:
+        //! 読み込み関数（ワーカースレッドから呼ぶ、タイルのファイルがない場合はfalse）
+        using Loader = std::function<bool(const TileKey& key, SceneFile& file)>;
+        //! 転送関数（戻り値はGPUメモリの使用量[byte]）
+        using Uploader = std::function<std::size_t(const TileKey& key, const SceneFile& file)>;
+        //! 破棄関数
+        using Releaser = std::function<void(const TileKey& key)>;
+
+    private:
+        //! タイルの状態
+        //! QUEUED:読み込み待ち LOADING:読み込み中 LOADED:転送待ち RESIDENT:転送済み MISSING:ファイルなし
+        enum class STATE { QUEUED, LOADING, LOADED, RESIDENT, MISSING };
+
+        /**
+         * @struct Tile
+         * @brief タイルの管理情報
+         */
+        struct Tile {
+            STATE                       state;      //!< 状態
+            std::unique_ptr<SceneFile>  file;       //!< 読み込んだファイル（STATE::LOADEDのみ）
+            std::size_t                 bytes;      //!< GPUメモリの使用量[byte]（STATE::RESIDENTのみ）
+            std::uint64_t               wanted;     //!< 最後に読み込み対象としたフレーム番号
+            std::uint64_t               visible;    //!< 最後に表示したフレーム番号
+            std::uint32_t               priority;   //!< 読み込みの優先度（小さいほど優先）
+        };
+
+        Aabb                    m_world;        //!< ワールドの範囲
+        std::uint32_t           m_max_level;    //!< 最も細かい段
+        float                   m_tile_pixels;  //!< 段を選ぶ際のタイルの表示サイズの上限[pixel]
+        std::size_t             m_budget;       //!< GPUメモリの使用量の上限[byte]
+        std::size_t             m_upload_limit; //!< 1フレームで転送するGPUメモリの上限[byte]
+        Loader                  m_loader;       //!< 読み込み関数
+        Uploader                m_uploader;     //!< 転送関数
+        Releaser                m_releaser;     //!< 破棄関数
+        std::map<TileKey, Tile> m_tiles;        //!< タイルの管理情報（m_mutexで保護）
+        std::vector<TileKey>    m_queue;        //!< 読み込み待ちのタイル（優先度の降順、m_mutexで保護）
+        mutable std::mutex      m_mutex;        //!< 排他制御
+        std::condition_variable m_cond;         //!< 読み込み待ちのタイルの追加・終了の通知
+        bool                    m_quit;         //!< ワーカースレッドの終了要求（m_mutexで保護）
+        std::uint64_t           m_frame;        //!< フレーム番号
+        std::size_t             m_used;         //!< GPUメモリの使用量[byte]
+        std::vector<TileKey>    m_visibles;     //!< 描画するタイル（段の昇順）
+        std::vector<TileKey>    m_wanted;       //!< 前フレームの読み込み対象のタイル
+        std::set<TileKey>       m_dropped;      //!< 上限により破棄した先読みのタイル（読み込み対象が変わるまで読み込まない）
+        std::thread             m_worker;       //!< ワーカースレッド
+
+    public:
+        //! コンストラクタ
+        TileManager(const Aabb& world, const std::uint32_t max_level, const float tile_pixels, const std::size_t budget,
+                    const Loader& loader, const Uploader& uploader, const Releaser& releaser);
+        //! デストラクタ
+        ~TileManager();
+        //! コピーコンストラクタによるコピー禁止
+        TileManager(const TileManager& org) = delete;
+        //! 代入によるコピー禁止
+        TileManager& operator=(const TileManager& org) = delete;
+
+    public:
+        //! タイルのファイルのパスを取得
+        static std::string path(const std::string& dir, const TileKey& key);
+        //! ディレクトリからタイルのファイルを読み込む読み込み関数を作成
+        static Loader fileLoader(const std::string& dir);
+
+    public:
+        //! GPUメモリの使用量の上限を設定
+        void setBudget(const std::size_t budget);
+        //! 1フレームで転送するGPUメモリの上限を設定（0は制限なし）
+        void setUploadLimit(const std::size_t limit);
+        //! タイルの範囲を取得
+        Aabb bounds(const TileKey& key) const;
+        //! 拡大率に応じた段を取得
+        std::uint32_t level(const float scale) const;
+        //! 矩形と交差する段levelのタイルを取得
+        void cover(const Aabb& box, const std::uint32_t level, std::vector<TileKey>& out) const;
+
+    public:
+        //! 表示範囲に応じてタイルを読み込み・転送・破棄（描画スレッドから毎フレーム呼ぶ）
+        void update(const Aabb& viewbox, const float scale);
+        //! 描画するタイルを取得（段の昇順、粗い段を先に描画する）
+        const std::vector<TileKey>& visibles() const;
+        //! GPUメモリの使用量を取得
+        std::size_t used() const;
+        //! 転送済みのタイルの数を取得
+        std::size_t residentNum() const;
+        //! 読み込み待ち・読み込み中・転送待ちのタイルの数を取得
+        std::size_t pendingNum() const;
+
+    private:
+        //! 読み込み対象のタイルを登録し、不要になった読み込み待ちのタイルを取り消し
+        void request(const std::vector<TileKey>& wanted);
+        //! 転送待ちのタイルを転送
+        void upload();
+        //! 描画するタイルを選択
+        void select(const std::vector<TileKey>& covers);
+        //! 上限を超えたGPUメモリを解放
+        void evict();
+        //! ワーカースレッドの処理
+        void work();
+    };
+}
+
+namespace my {
+    //! TileManagerクラスのテストコードを実行
+    bool testcode_TileManager();
+}
+
+#endif //INCLUDED_TILEMANAGER_HPP
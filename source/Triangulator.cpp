@@ -0,0 +1,922 @@
+﻿/**
+ * @file Triangulator.cpp
+ * @author kota-kota
+ * @brief 多角形を三角形に分割するクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "Triangulator.hpp"
+#include "Matrix.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace {
+    //! Zオーダーの索引付けを行う頂点数の閾値
+    constexpr std::size_t HASH_THRESHOLD = 80U;
+
+    //! 浮動小数点数が厳密に一致するか判定（頂点座標の一致判定は誤差を許容しない）
+    inline bool same(const double a, const double b)
+    {
+        return (!(a < b)) && (!(a > b));
+    }
+
+    /**
+     * @struct Node
+     * @brief 多角形の頂点の双方向循環リストの要素
+     */
+    struct Node {
+        std::uint32_t   i;          //!< 頂点番号
+        double          x;          //!< X座標
+        double          y;          //!< Y座標
+        Node*           prev;       //!< 前の頂点
+        Node*           next;       //!< 次の頂点
+        std::int32_t    z;          //!< Zオーダー値
+        Node*           prevZ;      //!< Zオーダーで前の頂点
+        Node*           nextZ;      //!< Zオーダーで次の頂点
+        bool            steiner;    //!< 穴が1点のみの場合true
+    };
+
+    /**
+     * @class EarClipper
+     * @brief 1つの多角形を耳刈り取り法で分割する作業用クラス
+     */
+    class EarClipper {
+        std::deque<Node>    m_nodes;    //!< 頂点リストの要素の実体
+        my::Indexes&        m_out;      //!< 出力先の頂点インデックス
+        double              m_minx;     //!< 外接矩形の最小X座標
+        double              m_miny;     //!< 外接矩形の最小Y座標
+        double              m_invsize;  //!< Zオーダー計算用の倍率（0の場合は索引付けなし）
+
+    public:
+        //! コンストラクタ
+        explicit EarClipper(my::Indexes& out) :
+            m_nodes(), m_out(out), m_minx(0.0), m_miny(0.0), m_invsize(0.0)
+        {
+        }
+        //! コピーコンストラクタによるコピー禁止
+        EarClipper(const EarClipper& org) = delete;
+        //! 代入によるコピー禁止
+        EarClipper& operator=(const EarClipper& org) = delete;
+
+    public:
+        //! 多角形を分割
+        void run(const my::Polygon& polygon)
+        {
+            std::uint32_t base = 0U;
+            Node* outer = this->linkedList(polygon.outer(), base, true);
+            base += static_cast<std::uint32_t>(polygon.outer().size());
+            if ((outer == nullptr) || (outer->next == outer->prev)) {
+                return;
+            }
+
+            // 穴を外周に連結する
+            if (!polygon.holes().empty()) {
+                std::vector<Node*> queue;
+                for (const my::Vertexes& hole : polygon.holes()) {
+                    Node* list = this->linkedList(hole, base, false);
+                    base += static_cast<std::uint32_t>(hole.size());
+                    if (list != nullptr) {
+                        if (list == list->next) {
+                            list->steiner = true;
+                        }
+                        queue.push_back(leftmost(list));
+                    }
+                }
+                std::sort(queue.begin(), queue.end(), [](const Node* a, const Node* b) {
+                    return (a->x < b->x) || (same(a->x, b->x) && (a->y < b->y));
+                });
+                for (Node* hole : queue) {
+                    outer = this->eliminateHole(hole, outer);
+                }
+            }
+
+            // 頂点数が多い場合はZオーダーで索引付けする
+            if (polygon.size() > HASH_THRESHOLD) {
+                double maxx = outer->x, maxy = outer->y;
+                this->m_minx = outer->x;
+                this->m_miny = outer->y;
+                Node* p = outer;
+                do {
+                    this->m_minx = std::min(this->m_minx, p->x);
+                    this->m_miny = std::min(this->m_miny, p->y);
+                    maxx = std::max(maxx, p->x);
+                    maxy = std::max(maxy, p->y);
+                    p = p->next;
+                } while (p != outer);
+                const double size = std::max(maxx - this->m_minx, maxy - this->m_miny);
+                this->m_invsize = (size > 0.0) ? (32767.0 / size) : 0.0;
+            }
+
+            this->earcutLinked(outer, 0);
+        }
+
+    private:
+        //! 頂点リストの要素を作成
+        Node* createNode(const std::uint32_t i, const double x, const double y)
+        {
+            this->m_nodes.push_back(Node{ i, x, y, nullptr, nullptr, 0, nullptr, nullptr, false });
+            return &this->m_nodes.back();
+        }
+
+        //! 頂点を挿入
+        Node* insertNode(const std::uint32_t i, const my::Vertex& v, Node* last)
+        {
+            Node* p = this->createNode(i, static_cast<double>(v.x()), static_cast<double>(v.y()));
+            if (last == nullptr) {
+                p->prev = p;
+                p->next = p;
+            }
+            else {
+                p->next = last->next;
+                p->prev = last;
+                last->next->prev = p;
+                last->next = p;
+            }
+            return p;
+        }
+
+        //! 頂点の並びから指定の向きの循環リストを作成
+        Node* linkedList(const my::Vertexes& ring, const std::uint32_t base, const bool clockwise)
+        {
+            if (ring.empty()) {
+                return nullptr;
+            }
+            double sum = 0.0;
+            for (std::size_t i = 0U, j = ring.size() - 1U; i < ring.size(); j = i++) {
+                sum += static_cast<double>(ring[j].x() - ring[i].x()) * static_cast<double>(ring[i].y() + ring[j].y());
+            }
+            Node* last = nullptr;
+            if (clockwise == (sum > 0.0)) {
+                for (std::size_t i = 0U; i < ring.size(); i++) {
+                    last = this->insertNode(base + static_cast<std::uint32_t>(i), ring[i], last);
+                }
+            }
+            else {
+                for (std::size_t i = ring.size(); i > 0U; i--) {
+                    last = this->insertNode(base + static_cast<std::uint32_t>(i - 1U), ring[i - 1U], last);
+                }
+            }
+            if ((last != nullptr) && equals(last, last->next)) {
+                removeNode(last);
+                last = last->next;
+            }
+            return last;
+        }
+
+        //! 重複点および直線上の点を除去
+        static Node* filterPoints(Node* start, Node* end = nullptr)
+        {
+            if (start == nullptr) {
+                return start;
+            }
+            if (end == nullptr) {
+                end = start;
+            }
+            Node* p = start;
+            bool again = false;
+            do {
+                again = false;
+                if ((!p->steiner) && (equals(p, p->next) || same(area(p->prev, p, p->next), 0.0))) {
+                    removeNode(p);
+                    p = end = p->prev;
+                    if (p == p->next) {
+                        break;
+                    }
+                    again = true;
+                }
+                else {
+                    p = p->next;
+                }
+            } while (again || (p != end));
+            return end;
+        }
+
+        //! 耳を刈り取って三角形を出力
+        void earcutLinked(Node* ear, const std::int32_t pass)
+        {
+            if (ear == nullptr) {
+                return;
+            }
+            if ((pass == 0) && (this->m_invsize > 0.0)) {
+                this->indexCurve(ear);
+            }
+            Node* stop = ear;
+            while (ear->prev != ear->next) {
+                Node* prev = ear->prev;
+                Node* next = ear->next;
+                if ((this->m_invsize > 0.0) ? this->isEarHashed(ear) : isEar(ear)) {
+                    this->emit(prev, ear, next);
+                    removeNode(ear);
+                    ear = next->next;
+                    stop = next->next;
+                    continue;
+                }
+                ear = next;
+                if (ear == stop) {
+                    // 耳が見つからない場合は、段階的に修復を試みる
+                    if (pass == 0) {
+                        this->earcutLinked(filterPoints(ear), 1);
+                    }
+                    else if (pass == 1) {
+                        ear = this->cureLocalIntersections(filterPoints(ear));
+                        this->earcutLinked(ear, 2);
+                    }
+                    else {
+                        this->splitEarcut(ear);
+                    }
+                    break;
+                }
+            }
+        }
+
+        //! 三角形を出力
+        void emit(const Node* a, const Node* b, const Node* c)
+        {
+            this->m_out.push_back(my::Index(a->i));
+            this->m_out.push_back(my::Index(b->i));
+            this->m_out.push_back(my::Index(c->i));
+        }
+
+        //! 耳か判定
+        static bool isEar(const Node* ear)
+        {
+            const Node* a = ear->prev;
+            const Node* b = ear;
+            const Node* c = ear->next;
+            if (area(a, b, c) >= 0.0) {
+                return false;
+            }
+            const Node* p = ear->next->next;
+            while (p != ear->prev) {
+                if (pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && (area(p->prev, p, p->next) >= 0.0)) {
+                    return false;
+                }
+                p = p->next;
+            }
+            return true;
+        }
+
+        //! 耳か判定（Zオーダーの索引を使用）
+        bool isEarHashed(const Node* ear) const
+        {
+            const Node* a = ear->prev;
+            const Node* b = ear;
+            const Node* c = ear->next;
+            if (area(a, b, c) >= 0.0) {
+                return false;
+            }
+            // 三角形の外接矩形に対応するZオーダーの範囲内の頂点のみ調べる
+            const double minTX = std::min(a->x, std::min(b->x, c->x));
+            const double minTY = std::min(a->y, std::min(b->y, c->y));
+            const double maxTX = std::max(a->x, std::max(b->x, c->x));
+            const double maxTY = std::max(a->y, std::max(b->y, c->y));
+            const std::int32_t minZ = this->zOrder(minTX, minTY);
+            const std::int32_t maxZ = this->zOrder(maxTX, maxTY);
+
+            auto blocks = [&](const Node* p) {
+                return (p != ear->prev) && (p != ear->next) &&
+                    pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && (area(p->prev, p, p->next) >= 0.0);
+            };
+            const Node* p = ear->prevZ;
+            const Node* n = ear->nextZ;
+            while ((p != nullptr) && (p->z >= minZ) && (n != nullptr) && (n->z <= maxZ)) {
+                if (blocks(p)) { return false; }
+                p = p->prevZ;
+                if (blocks(n)) { return false; }
+                n = n->nextZ;
+            }
+            while ((p != nullptr) && (p->z >= minZ)) {
+                if (blocks(p)) { return false; }
+                p = p->prevZ;
+            }
+            while ((n != nullptr) && (n->z <= maxZ)) {
+                if (blocks(n)) { return false; }
+                n = n->nextZ;
+            }
+            return true;
+        }
+
+        //! 局所的な自己交差を解消
+        Node* cureLocalIntersections(Node* start)
+        {
+            Node* p = start;
+            do {
+                Node* a = p->prev;
+                Node* b = p->next->next;
+                if ((!equals(a, b)) && intersects(a, p, p->next, b) && locallyInside(a, b) && locallyInside(b, a)) {
+                    this->emit(a, p, b);
+                    removeNode(p);
+                    removeNode(p->next);
+                    p = start = b;
+                }
+                p = p->next;
+            } while (p != start);
+            return filterPoints(p);
+        }
+
+        //! 対角線で2つの多角形に分割してそれぞれ分割
+        void splitEarcut(Node* start)
+        {
+            Node* a = start;
+            do {
+                Node* b = a->next->next;
+                while (b != a->prev) {
+                    if ((a->i != b->i) && isValidDiagonal(a, b)) {
+                        Node* c = this->splitPolygon(a, b);
+                        a = filterPoints(a, a->next);
+                        c = filterPoints(c, c->next);
+                        this->earcutLinked(a, 0);
+                        this->earcutLinked(c, 0);
+                        return;
+                    }
+                    b = b->next;
+                }
+                a = a->next;
+            } while (a != start);
+        }
+
+        //! 穴を外周に連結
+        Node* eliminateHole(Node* hole, Node* outer)
+        {
+            Node* bridge = findHoleBridge(hole, outer);
+            if (bridge == nullptr) {
+                return outer;
+            }
+            Node* bridge_reverse = this->splitPolygon(bridge, hole);
+            (void)filterPoints(bridge_reverse, bridge_reverse->next);
+            return filterPoints(bridge, bridge->next);
+        }
+
+        //! 穴と連結する外周の頂点を探す
+        static Node* findHoleBridge(const Node* hole, Node* outer)
+        {
+            Node* p = outer;
+            const double hx = hole->x;
+            const double hy = hole->y;
+            double qx = -std::numeric_limits<double>::infinity();
+            Node* m = nullptr;
+
+            // 穴の最左点から左へ伸ばした水平線と交差する、最も近い外周の辺を探す
+            do {
+                if ((hy <= p->y) && (hy >= p->next->y) && (!same(p->next->y, p->y))) {
+                    const double x = p->x + ((hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y));
+                    if ((x <= hx) && (x > qx)) {
+                        qx = x;
+                        m = (p->x < p->next->x) ? p : p->next;
+                        if (same(x, hx)) {
+                            return m;
+                        }
+                    }
+                }
+                p = p->next;
+            } while (p != outer);
+            if (m == nullptr) {
+                return nullptr;
+            }
+
+            // 交点と辺の端点と穴の点で作る三角形の内側に頂点があれば、その中で最も角度の小さい頂点を選ぶ
+            const Node* stop = m;
+            const double mx = m->x;
+            const double my = m->y;
+            double tan_min = std::numeric_limits<double>::infinity();
+            p = m;
+            do {
+                if ((hx >= p->x) && (p->x >= mx) && (!same(hx, p->x)) &&
+                    pointInTriangle((hy < my) ? hx : qx, hy, mx, my, (hy < my) ? qx : hx, hy, p->x, p->y)) {
+                    const double tan = std::fabs(hy - p->y) / (hx - p->x);
+                    if (locallyInside(p, hole) &&
+                        ((tan < tan_min) || (same(tan, tan_min) && ((p->x > m->x) || (same(p->x, m->x) && sectorContainsSector(m, p)))))) {
+                        m = p;
+                        tan_min = tan;
+                    }
+                }
+                p = p->next;
+            } while (p != stop);
+            return m;
+        }
+
+        //! 頂点mの角の内側に頂点pの角が含まれるか判定
+        static bool sectorContainsSector(const Node* m, const Node* p)
+        {
+            return (area(m->prev, m, p->prev) < 0.0) && (area(p->next, m, m->next) < 0.0);
+        }
+
+        //! Zオーダーで索引付け
+        void indexCurve(Node* start)
+        {
+            Node* p = start;
+            do {
+                if (p->z == 0) {
+                    p->z = this->zOrder(p->x, p->y);
+                }
+                p->prevZ = p->prev;
+                p->nextZ = p->next;
+                p = p->next;
+            } while (p != start);
+            p->prevZ->nextZ = nullptr;
+            p->prevZ = nullptr;
+            (void)sortLinked(p);
+        }
+
+        //! Zオーダーのリストをマージソート
+        static Node* sortLinked(Node* list)
+        {
+            std::int32_t in_size = 1;
+            std::int32_t merges = 0;
+            do {
+                Node* p = list;
+                Node* tail = nullptr;
+                list = nullptr;
+                merges = 0;
+                while (p != nullptr) {
+                    merges++;
+                    Node* q = p;
+                    std::int32_t psize = 0;
+                    for (std::int32_t i = 0; i < in_size; i++) {
+                        psize++;
+                        q = q->nextZ;
+                        if (q == nullptr) {
+                            break;
+                        }
+                    }
+                    std::int32_t qsize = in_size;
+                    while ((psize > 0) || ((qsize > 0) && (q != nullptr))) {
+                        Node* e = nullptr;
+                        if ((psize != 0) && ((qsize == 0) || (q == nullptr) || (p->z <= q->z))) {
+                            e = p;
+                            p = p->nextZ;
+                            psize--;
+                        }
+                        else {
+                            e = q;
+                            q = q->nextZ;
+                            qsize--;
+                        }
+                        if (tail != nullptr) {
+                            tail->nextZ = e;
+                        }
+                        else {
+                            list = e;
+                        }
+                        e->prevZ = tail;
+                        tail = e;
+                    }
+                    p = q;
+                }
+                tail->nextZ = nullptr;
+                in_size *= 2;
+            } while (merges > 1);
+            return list;
+        }
+
+        //! Zオーダー値を計算
+        std::int32_t zOrder(const double x, const double y) const
+        {
+            std::uint32_t ix = static_cast<std::uint32_t>((x - this->m_minx) * this->m_invsize);
+            std::uint32_t iy = static_cast<std::uint32_t>((y - this->m_miny) * this->m_invsize);
+            ix = (ix | (ix << 8U)) & 0x00FF00FFU;
+            ix = (ix | (ix << 4U)) & 0x0F0F0F0FU;
+            ix = (ix | (ix << 2U)) & 0x33333333U;
+            ix = (ix | (ix << 1U)) & 0x55555555U;
+            iy = (iy | (iy << 8U)) & 0x00FF00FFU;
+            iy = (iy | (iy << 4U)) & 0x0F0F0F0FU;
+            iy = (iy | (iy << 2U)) & 0x33333333U;
+            iy = (iy | (iy << 1U)) & 0x55555555U;
+            return static_cast<std::int32_t>(ix | (iy << 1U));
+        }
+
+        //! 最も左の頂点を取得
+        static Node* leftmost(Node* start)
+        {
+            Node* p = start;
+            Node* left = start;
+            do {
+                if ((p->x < left->x) || (same(p->x, left->x) && (p->y < left->y))) {
+                    left = p;
+                }
+                p = p->next;
+            } while (p != start);
+            return left;
+        }
+
+        //! 点が三角形の内側（辺上を含む）にあるか判定
+        static bool pointInTriangle(const double ax, const double ay, const double bx, const double by, const double cx, const double cy, const double px, const double py)
+        {
+            return (((cx - px) * (ay - py)) >= ((ax - px) * (cy - py))) &&
+                (((ax - px) * (by - py)) >= ((bx - px) * (ay - py))) &&
+                (((bx - px) * (cy - py)) >= ((cx - px) * (by - py)));
+        }
+
+        //! 頂点aと頂点bを結ぶ対角線が多角形の内側を通るか判定
+        static bool isValidDiagonal(const Node* a, const Node* b)
+        {
+            return (a->next->i != b->i) && (a->prev->i != b->i) && (!intersectsPolygon(a, b)) &&
+                ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b) &&
+                    ((!same(area(a->prev, a, b->prev), 0.0)) || (!same(area(a, b->prev, b), 0.0)))) ||
+                 (equals(a, b) && (area(a->prev, a, a->next) > 0.0) && (area(b->prev, b, b->next) > 0.0)));
+        }
+
+        //! 三角形の符号付き面積（の2倍）
+        static double area(const Node* p, const Node* q, const Node* r)
+        {
+            return ((q->y - p->y) * (r->x - q->x)) - ((q->x - p->x) * (r->y - q->y));
+        }
+
+        //! 同一点か判定
+        static bool equals(const Node* a, const Node* b)
+        {
+            return same(a->x, b->x) && same(a->y, b->y);
+        }
+
+        //! 符号を取得
+        static std::int32_t sign(const double v)
+        {
+            return (v > 0.0) ? 1 : ((v < 0.0) ? -1 : 0);
+        }
+
+        //! 同一直線上の3点で、点qが線分pr上にあるか判定
+        static bool onSegment(const Node* p, const Node* q, const Node* r)
+        {
+            return (q->x <= std::max(p->x, r->x)) && (q->x >= std::min(p->x, r->x)) &&
+                (q->y <= std::max(p->y, r->y)) && (q->y >= std::min(p->y, r->y));
+        }
+
+        //! 線分p1q1と線分p2q2が交差するか判定
+        static bool intersects(const Node* p1, const Node* q1, const Node* p2, const Node* q2)
+        {
+            const std::int32_t o1 = sign(area(p1, q1, p2));
+            const std::int32_t o2 = sign(area(p1, q1, q2));
+            const std::int32_t o3 = sign(area(p2, q2, p1));
+            const std::int32_t o4 = sign(area(p2, q2, q1));
+            if ((o1 != o2) && (o3 != o4)) { return true; }
+            if ((o1 == 0) && onSegment(p1, p2, q1)) { return true; }
+            if ((o2 == 0) && onSegment(p1, q2, q1)) { return true; }
+            if ((o3 == 0) && onSegment(p2, p1, q2)) { return true; }
+            if ((o4 == 0) && onSegment(p2, q1, q2)) { return true; }
+            return false;
+        }
+
+        //! 線分abが多角形の辺と交差するか判定
+        static bool intersectsPolygon(const Node* a, const Node* b)
+        {
+            const Node* p = a;
+            do {
+                if ((p->i != a->i) && (p->next->i != a->i) && (p->i != b->i) && (p->next->i != b->i) && intersects(p, p->next, a, b)) {
+                    return true;
+                }
+                p = p->next;
+            } while (p != a);
+            return false;
+        }
+
+        //! 線分abが頂点aの近傍で多角形の内側にあるか判定
+        static bool locallyInside(const Node* a, const Node* b)
+        {
+            return (area(a->prev, a, a->next) < 0.0) ?
+                ((area(a, b, a->next) >= 0.0) && (area(a, a->prev, b) >= 0.0)) :
+                ((area(a, b, a->prev) < 0.0) || (area(a, a->next, b) < 0.0));
+        }
+
+        //! 線分abの中点が多角形の内側にあるか判定
+        static bool middleInside(const Node* a, const Node* b)
+        {
+            const Node* p = a;
+            bool inside = false;
+            const double px = (a->x + b->x) / 2.0;
+            const double py = (a->y + b->y) / 2.0;
+            do {
+                if (((p->y > py) != (p->next->y > py)) && (!same(p->next->y, p->y)) &&
+                    (px < ((((p->next->x - p->x) * (py - p->y)) / (p->next->y - p->y)) + p->x))) {
+                    inside = !inside;
+                }
+                p = p->next;
+            } while (p != a);
+            return inside;
+        }
+
+        //! 頂点aと頂点bを結ぶ対角線で多角形を2つに分割
+        Node* splitPolygon(Node* a, Node* b)
+        {
+            Node* a2 = this->createNode(a->i, a->x, a->y);
+            Node* b2 = this->createNode(b->i, b->x, b->y);
+            Node* an = a->next;
+            Node* bp = b->prev;
+            a->next = b;
+            b->prev = a;
+            a2->next = an;
+            an->prev = a2;
+            b2->next = a2;
+            a2->prev = b2;
+            bp->next = b2;
+            b2->prev = bp;
+            return b2;
+        }
+
+        //! 頂点をリストから外す
+        static void removeNode(Node* p)
+        {
+            p->next->prev = p->prev;
+            p->prev->next = p->next;
+            if (p->prevZ != nullptr) {
+                p->prevZ->nextZ = p->nextZ;
+            }
+            if (p->nextZ != nullptr) {
+                p->nextZ->prevZ = p->prevZ;
+            }
+        }
+    };
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    Polygon::Polygon() :
+        m_outer(), m_holes()
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] outer 外周の頂点座標の並び
+     * @param [in] holes 穴の頂点座標の並び
+     */
+    Polygon::Polygon(const Vertexes& outer, const std::vector<Vertexes>& holes) :
+        m_outer(outer), m_holes(holes)
+    {
+    }
+
+    /**
+     * @brief 外周の頂点座標の並びを取得
+     * 
+     * @return const Vertexes& 外周の頂点座標の並び
+     */
+    const Vertexes& Polygon::outer() const { return this->m_outer; }
+
+    /**
+     * @brief 穴の頂点座標の並びを取得
+     * 
+     * @return const std::vector<Vertexes>& 穴の頂点座標の並び
+     */
+    const std::vector<Vertexes>& Polygon::holes() const { return this->m_holes; }
+
+    /**
+     * @brief 外周、穴の順に連結した頂点座標の並びを取得
+     * 
+     * @return Vertexes 連結した頂点座標の並び（Triangulatorが出力する頂点インデックスの参照先）
+     */
+    Vertexes Polygon::vertexes() const
+    {
+        Vertexes vertexes;
+        vertexes.reserve(this->size());
+        vertexes.insert(vertexes.end(), this->m_outer.begin(), this->m_outer.end());
+        for (const Vertexes& hole : this->m_holes) {
+            vertexes.insert(vertexes.end(), hole.begin(), hole.end());
+        }
+        return vertexes;
+    }
+
+    /**
+     * @brief 頂点数を取得
+     * 
+     * @return std::size_t 外周と穴の頂点数の合計
+     */
+    std::size_t Polygon::size() const
+    {
+        std::size_t size = this->m_outer.size();
+        for (const Vertexes& hole : this->m_holes) {
+            size += hole.size();
+        }
+        return size;
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] threads 複数の多角形を分割する際に使用するスレッド数（0の場合はハードウェアのスレッド数）
+     */
+    Triangulator::Triangulator(const std::uint32_t threads) :
+        m_threads((threads > 0U) ? threads : std::max(std::thread::hardware_concurrency(), 1U))
+    {
+    }
+
+    /**
+     * @brief 多角形を三角形に分割
+     * 
+     * @param [in] polygon 多角形
+     * 
+     * @return Indexes GL_TRIANGLESで描画する頂点インデックス（polygon.vertexes()の頂点番号）
+     */
+    Indexes Triangulator::triangulate(const Polygon& polygon) const
+    {
+        Indexes indexes;
+        if (polygon.outer().size() < 3U) {
+            return indexes;
+        }
+        indexes.reserve((polygon.size() + (polygon.holes().size() * 2U)) * 3U);
+        EarClipper clipper(indexes);
+        clipper.run(polygon);
+        return indexes;
+    }
+
+    /**
+     * @brief 複数の多角形を三角形に分割（多角形毎の頂点インデックス）
+     * 
+     * @param [in] polygons 多角形の並び
+     * 
+     * @return std::vector<Indexes> 多角形毎の頂点インデックス
+     * 
+     * @par 詳細
+     *      多角形を1つずつ各スレッドに割り当てて分割する。
+     */
+    std::vector<Indexes> Triangulator::triangulate(const std::vector<Polygon>& polygons) const
+    {
+        std::vector<Indexes> results(polygons.size());
+        std::atomic<std::size_t> next(0U);
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < polygons.size(); i = next++) {
+                results[i] = this->triangulate(polygons[i]);
+            }
+        };
+
+        const std::size_t num = std::min(static_cast<std::size_t>(this->m_threads), polygons.size());
+        std::vector<std::thread> threads;
+        for (std::size_t t = 1U; t < num; t++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& t : threads) {
+            t.join();
+        }
+        return results;
+    }
+
+    /**
+     * @brief 複数の多角形を三角形に分割し、1つの頂点の並びにまとめる
+     * 
+     * @param [in] polygons 多角形の並び
+     * @param [out] vertexes 全多角形の頂点座標の並び
+     * @param [out] indexes GL_TRIANGLESで描画する頂点インデックス
+     */
+    void Triangulator::triangulate(const std::vector<Polygon>& polygons, Vertexes& vertexes, Indexes& indexes) const
+    {
+        const std::vector<Indexes> results = this->triangulate(polygons);
+        std::size_t vnum = 0U, inum = 0U;
+        for (std::size_t i = 0U; i < polygons.size(); i++) {
+            vnum += polygons[i].size();
+            inum += results[i].size();
+        }
+        vertexes.clear();
+        indexes.clear();
+        vertexes.reserve(vnum);
+        indexes.reserve(inum);
+        for (std::size_t i = 0U; i < polygons.size(); i++) {
+            const std::uint32_t base = static_cast<std::uint32_t>(vertexes.size());
+            const Vertexes v = polygons[i].vertexes();
+            vertexes.insert(vertexes.end(), v.begin(), v.end());
+            for (const Index& idx : results[i]) {
+                indexes.push_back(Index(base + idx.idx()));
+            }
+        }
+    }
+}
+
+namespace {
+    //! 頂点インデックスが表す三角形の面積の合計を計算
+    double trianglesArea(const my::Vertexes& v, const my::Indexes& idx)
+    {
+        double area = 0.0;
+        for (std::size_t i = 2U; i < idx.size(); i += 3U) {
+            const my::Vertex& a = v[idx[i - 2U].idx()];
+            const my::Vertex& b = v[idx[i - 1U].idx()];
+            const my::Vertex& c = v[idx[i].idx()];
+            area += std::fabs((static_cast<double>(b.x() - a.x()) * static_cast<double>(c.y() - a.y())) -
+                (static_cast<double>(c.x() - a.x()) * static_cast<double>(b.y() - a.y()))) / 2.0;
+        }
+        return area;
+    }
+
+    //! 頂点の並びが表す多角形の面積を計算
+    double ringArea(const my::Vertexes& ring)
+    {
+        double sum = 0.0;
+        for (std::size_t i = 0U, j = ring.size() - 1U; i < ring.size(); j = i++) {
+            sum += (static_cast<double>(ring[j].x()) * static_cast<double>(ring[i].y())) - (static_cast<double>(ring[i].x()) * static_cast<double>(ring[j].y()));
+        }
+        return std::fabs(sum) / 2.0;
+    }
+
+    //! 多角形の面積と分割結果の面積を比較
+    bool expectArea(const char* name, const my::Polygon& polygon, const my::Indexes& indexes)
+    {
+        double expected = ringArea(polygon.outer());
+        for (const my::Vertexes& hole : polygon.holes()) {
+            expected -= ringArea(hole);
+        }
+        const double actual = trianglesArea(polygon.vertexes(), indexes);
+        const bool ok = (std::fabs(actual - expected) <= (expected * 1.0e-6));
+        std::cout << "* " << name << " triangles:" << (indexes.size() / 3U) << " area:" << actual << " expected:" << expected << (ok ? " .. OK" : " .. NG") << std::endl;
+        return ok;
+    }
+
+    //! 正多角形に近い凹多角形（星形）の頂点の並びを作成
+    my::Vertexes makeStar(const float cx, const float cy, const float r0, const float r1, const std::size_t num)
+    {
+        my::Vertexes ring;
+        for (std::size_t i = 0U; i < (num * 2U); i++) {
+            const double a = static_cast<double>(my::MATRIX_PI) * static_cast<double>(i) / static_cast<double>(num);
+            const float r = ((i % 2U) == 0U) ? r0 : r1;
+            ring.push_back({ cx + (r * static_cast<float>(std::cos(a))), cy + (r * static_cast<float>(std::sin(a))) });
+        }
+        return ring;
+    }
+}
+
+namespace my {
+    /**
+     * @brief Triangulatorクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     * 
+     * @par 詳細
+     *      分割した三角形の面積の合計を、多角形の面積と比較する。
+     */
+    bool testcode_Triangulator()
+    {
+        std::cout << "[testcode_Triangulator()] call" << std::endl;
+        bool ok = true;
+        const Triangulator triangulator;
+
+        const Polygon square({ { 0.0F, 0.0F }, { 10.0F, 0.0F }, { 10.0F, 10.0F }, { 0.0F, 10.0F } });
+        const Indexes i1 = triangulator.triangulate(square);
+        ok = expectArea("square", square, i1) && (i1.size() == 6U) && ok;
+
+        const Polygon holed({ { 0.0F, 0.0F }, { 10.0F, 0.0F }, { 10.0F, 10.0F }, { 0.0F, 10.0F } },
+            { { { 2.0F, 2.0F }, { 4.0F, 2.0F }, { 4.0F, 4.0F }, { 2.0F, 4.0F } }, { { 6.0F, 6.0F }, { 8.0F, 6.0F }, { 8.0F, 8.0F } } });
+        ok = expectArea("square with holes", holed, triangulator.triangulate(holed)) && ok;
+
+        const Polygon star(makeStar(0.0F, 0.0F, 100.0F, 40.0F, 5U));
+        ok = expectArea("star", star, triangulator.triangulate(star)) && ok;
+
+        // Zオーダーの索引付けを行う頂点数
+        const Polygon big(makeStar(0.0F, 0.0F, 1000.0F, 900.0F, 500U), { makeStar(0.0F, 0.0F, 300.0F, 200.0F, 50U) });
+        ok = expectArea("hashed star with hole", big, triangulator.triangulate(big)) && ok;
+
+        // 複数の多角形（並列）
+        std::vector<Polygon> polygons(64U, big);
+        const std::vector<Indexes> results = triangulator.triangulate(polygons);
+        bool same = true;
+        const Indexes single = triangulator.triangulate(big);
+        for (const Indexes& r : results) {
+            same = same && (r.size() == single.size());
+        }
+        std::cout << "* parallel results:" << results.size() << (same ? " .. OK" : " .. NG") << std::endl;
+        ok = same && ok;
+        return ok;
+    }
+
+    /**
+     * @brief Triangulatorクラスの処理性能を計測
+     * 
+     * @par 詳細
+     *      建物形状を想定した小さな多角形を多数分割し、1秒あたりの多角形数を出力する。
+     */
+    void benchcode_Triangulator()
+    {
+        std::cout << "[benchcode_Triangulator()] call" << std::endl;
+        std::vector<Polygon> polygons;
+        const std::size_t num = 100000U;
+        polygons.reserve(num);
+        for (std::size_t i = 0U; i < num; i++) {
+            const float x = static_cast<float>(i % 1000U) * 30.0F;
+            const float y = static_cast<float>(i / 1000U) * 30.0F;
+            polygons.push_back(Polygon(makeStar(x, y, 12.0F, 8.0F, 4U + (i % 8U)), { makeStar(x, y, 4.0F, 3.0F, 3U) }));
+        }
+        const std::uint32_t threads[] = { 1U, 0U };
+        for (const std::uint32_t t : threads) {
+            const Triangulator triangulator(t);
+            Vertexes vertexes;
+            Indexes indexes;
+            const auto start = std::chrono::steady_clock::now();
+            triangulator.triangulate(polygons, vertexes, indexes);
+            const auto end = std::chrono::steady_clock::now();
+            const double sec = std::chrono::duration<double>(end - start).count();
+            std::cout << "* threads:" << ((t > 0U) ? t : std::thread::hardware_concurrency()) << " polygons:" << num << " time:" << (sec * 1000.0) << "[msec] "
+                << (static_cast<double>(num) / sec) << "[polygons/sec] triangles:" << (indexes.size() / 3U) << std::endl;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+﻿/**
+ * @file Triangulator.hpp
+ * @author kota-kota
+ * @brief 多角形を三角形に分割するクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_TRIANGULATOR_HPP
+#define INCLUDED_TRIANGULATOR_HPP
+
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class Polygon
+     * @brief 穴を持つ単純多角形を扱うクラス
+     * 
+     * @par 詳細
+     *      外周と穴の頂点の並びを保持する。頂点の並びの向きは問わない。
+     *      頂点番号は、外周、穴の順に連結した頂点の並び（vertexes()）の番号とする。
+     */
+    class Polygon {
+        Vertexes                m_outer;    //!< 外周の頂点座標の並び
+        std::vector<Vertexes>   m_holes;    //!< 穴の頂点座標の並び
+
+    public:
+        //! デフォルトコンストラクタ
+        Polygon();
+        //! コンストラクタ
+        Polygon(const Vertexes& outer, const std::vector<Vertexes>& holes = std::vector<Vertexes>());
+
+    public:
+        //! 外周の頂点座標の並びを取得
+        const Vertexes& outer() const;
+        //! 穴の頂点座標の並びを取得
+        const std::vector<Vertexes>& holes() const;
+        //! 外周、穴の順に連結した頂点座標の並びを取得
+        Vertexes vertexes() const;
+        //! 頂点数を取得
+        std::size_t size() const;
+    };
+}
+
+namespace my {
+    /**
+     * @class Triangulator
+     * @brief 多角形をGL_TRIANGLESで描画する頂点インデックスに分割するクラス
+     * 
+     * @par 詳細
+     *      耳刈り取り法で三角形に分割する。穴は外周と橋渡しして1つの多角形として扱う。
+     *      頂点数が多い多角形は、頂点をZオーダーで索引付けして耳の判定を高速化する。
+     *      複数の多角形は、多角形単位で複数スレッドに分担して分割する。
+     */
+    class Triangulator {
+        std::uint32_t   m_threads;  //!< 使用するスレッド数
+
+    public:
+        //! コンストラクタ
+        explicit Triangulator(const std::uint32_t threads = 0U);
+
+    public:
+        //! 多角形を三角形に分割
+        Indexes triangulate(const Polygon& polygon) const;
+        //! 複数の多角形を三角形に分割（多角形毎の頂点インデックス）
+        std::vector<Indexes> triangulate(const std::vector<Polygon>& polygons) const;
+        //! 複数の多角形を三角形に分割し、1つの頂点の並びにまとめる
+        void triangulate(const std::vector<Polygon>& polygons, Vertexes& vertexes, Indexes& indexes) const;
+    };
+}
+
+namespace my {
+    //! Triangulatorクラスのテストコードを実行
+    bool testcode_Triangulator();
+    //! Triangulatorクラスの処理性能を計測
+    void benchcode_Triangulator();
+}
+
+#endif //INCLUDED_TRIANGULATOR_HPP
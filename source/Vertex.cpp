@@ -10,6 +10,11 @@
 
 #include "Vertex.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
 namespace my {
     /**
      * @brief デフォルトコンストラクタ
@@ -126,6 +131,141 @@ namespace my {
     float Vertex::z() const { return this->m_z; }
 }
 
+namespace {
+    //! 量子化後の最大値
+    constexpr float QUANTIZE_MAX = 65535.0F;
+
+    //! 1座標を量子化
+    std::uint16_t quantize(const float v, const float min, const float step)
+    {
+        if (step <= 0.0F) {
+            return 0U;
+        }
+        const float q = std::floor(((v - min) / step) + 0.5F);
+        return static_cast<std::uint16_t>(std::min(std::max(q, 0.0F), QUANTIZE_MAX));
+    }
+}
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ
+     * 
+     */
+    QuantizedVertexes::QuantizedVertexes() :
+        m_min(), m_step(), m_data()
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] vertexes 量子化する頂点の並び
+     */
+    QuantizedVertexes::QuantizedVertexes(const Vertexes& vertexes) :
+        m_min(), m_step(), m_data()
+    {
+        this->encode(vertexes);
+    }
+
+    /**
+     * @brief 頂点数を取得
+     * 
+     * @return std::size_t 頂点数
+     */
+    std::size_t QuantizedVertexes::size() const { return this->m_data.size() / 3U; }
+
+    /**
+     * @brief 頂点を復元して取得
+     * 
+     * @param [in] i 頂点番号
+     * 
+     * @return Vertex 復元した頂点
+     */
+    Vertex QuantizedVertexes::at(const std::size_t i) const
+    {
+        const std::uint16_t* q = &this->m_data[i * 3U];
+        return Vertex(
+            this->m_min.x() + (static_cast<float>(q[0]) * this->m_step.x()),
+            this->m_min.y() + (static_cast<float>(q[1]) * this->m_step.y()),
+            this->m_min.z() + (static_cast<float>(q[2]) * this->m_step.z()));
+    }
+
+    /**
+     * @brief 頂点を設定
+     * 
+     * @param [in] i 頂点番号
+     * @param [in] v 設定する頂点
+     * 
+     * @par 詳細
+     *      設定する頂点が外接直方体の範囲外の場合は、範囲を広げて全頂点を量子化し直す。
+     */
+    void QuantizedVertexes::set(const std::size_t i, const Vertex& v)
+    {
+        const float xmax = this->m_min.x() + (this->m_step.x() * QUANTIZE_MAX);
+        const float ymax = this->m_min.y() + (this->m_step.y() * QUANTIZE_MAX);
+        const float zmax = this->m_min.z() + (this->m_step.z() * QUANTIZE_MAX);
+        const bool inside =
+            (v.x() >= this->m_min.x()) && (v.x() <= xmax) &&
+            (v.y() >= this->m_min.y()) && (v.y() <= ymax) &&
+            (v.z() >= this->m_min.z()) && (v.z() <= zmax);
+        if (!inside) {
+            Vertexes vertexes = this->decode();
+            vertexes[i] = v;
+            this->encode(vertexes);
+            return;
+        }
+        std::uint16_t* q = &this->m_data[i * 3U];
+        q[0] = quantize(v.x(), this->m_min.x(), this->m_step.x());
+        q[1] = quantize(v.y(), this->m_min.y(), this->m_step.y());
+        q[2] = quantize(v.z(), this->m_min.z(), this->m_step.z());
+    }
+
+    /**
+     * @brief 全頂点を復元して取得
+     * 
+     * @return Vertexes 復元した頂点の並び
+     */
+    Vertexes QuantizedVertexes::decode() const
+    {
+        Vertexes vertexes;
+        vertexes.reserve(this->size());
+        for (std::size_t i = 0U; i < this->size(); i++) {
+            vertexes.push_back(this->at(i));
+        }
+        return vertexes;
+    }
+
+    /**
+     * @brief 頂点の並びを量子化
+     * 
+     * @param [in] vertexes 量子化する頂点の並び
+     */
+    void QuantizedVertexes::encode(const Vertexes& vertexes)
+    {
+        this->m_data.clear();
+        if (vertexes.empty()) {
+            this->m_min = Vertex();
+            this->m_step = Vertex();
+            return;
+        }
+        Vertex min = vertexes[0];
+        Vertex max = vertexes[0];
+        for (const Vertex& v : vertexes) {
+            min = Vertex(std::min(min.x(), v.x()), std::min(min.y(), v.y()), std::min(min.z(), v.z()));
+            max = Vertex(std::max(max.x(), v.x()), std::max(max.y(), v.y()), std::max(max.z(), v.z()));
+        }
+        this->m_min = min;
+        this->m_step = Vertex((max.x() - min.x()) / QUANTIZE_MAX, (max.y() - min.y()) / QUANTIZE_MAX, (max.z() - min.z()) / QUANTIZE_MAX);
+
+        this->m_data.reserve(vertexes.size() * 3U);
+        for (const Vertex& v : vertexes) {
+            this->m_data.push_back(quantize(v.x(), this->m_min.x(), this->m_step.x()));
+            this->m_data.push_back(quantize(v.y(), this->m_min.y(), this->m_step.y()));
+            this->m_data.push_back(quantize(v.z(), this->m_min.z(), this->m_step.z()));
+        }
+    }
+}
+
 namespace my {
     /**
      * @brief デフォルトコンストラクタ
@@ -153,3 +293,79 @@ namespace my {
      */
     std::uint32_t Index::idx() const { return this->m_idx; }
 }
+
+namespace {
+    //! 各座標の誤差が外接直方体の各辺の長さ（size）の1/65535以内か判定
+    bool withinStep(const my::Vertex& actual, const my::Vertex& expect, const my::Vertex& size, const float scale)
+    {
+        const float eps = 1.0e-6F;
+        return (std::fabs(actual.x() - expect.x()) <= ((size.x() * scale / QUANTIZE_MAX) + eps)) &&
+               (std::fabs(actual.y() - expect.y()) <= ((size.y() * scale / QUANTIZE_MAX) + eps)) &&
+               (std::fabs(actual.z() - expect.z()) <= ((size.z() * scale / QUANTIZE_MAX) + eps));
+    }
+}
+
+namespace my {
+    /**
+     * @brief QuantizedVertexesクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     */
+    bool testcode_QuantizedVertexes()
+    {
+        std::cout << "[testcode_QuantizedVertexes()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const char* name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+
+        // 外接直方体(-100,-20,0)-(300,60,0)の乱数の頂点（Zは一定）
+        Vertexes vertexes;
+        std::uint32_t seed = 7U;
+        for (std::int32_t i = 0; i < 1000; i++) {
+            seed = (seed * 1664525U) + 1013904223U;
+            const float x = (static_cast<float>(seed >> 8) / 16777216.0F * 400.0F) - 100.0F;
+            seed = (seed * 1664525U) + 1013904223U;
+            const float y = (static_cast<float>(seed >> 8) / 16777216.0F * 80.0F) - 20.0F;
+            vertexes.push_back({ x, y });
+        }
+        vertexes[0] = { -100.0F, -20.0F };
+        vertexes[1] = { 300.0F, 60.0F };
+        const Vertex size(400.0F, 80.0F, 0.0F);
+
+        // 復元した座標の誤差は外接直方体の各辺の長さの1/65535以内
+        QuantizedVertexes q(vertexes);
+        const Vertexes decoded = q.decode();
+        bool roundtrip = (q.size() == vertexes.size()) && (decoded.size() == vertexes.size());
+        for (std::size_t i = 0U; roundtrip && (i < vertexes.size()); i++) {
+            roundtrip = withinStep(decoded[i], vertexes[i], size, 1.0F) && withinStep(q.at(i), vertexes[i], size, 1.0F);
+        }
+        check("roundtrip", roundtrip);
+
+        // 範囲内の設定は設定した頂点のみ変わる
+        q.set(5U, { 0.0F, 0.0F });
+        bool inside = withinStep(q.at(5U), { 0.0F, 0.0F }, size, 1.0F) && withinStep(q.at(0U), vertexes[0], size, 1.0F) &&
+                      withinStep(q.at(1U), vertexes[1], size, 1.0F);
+        for (std::size_t i = 6U; inside && (i < vertexes.size()); i++) {
+            inside = withinStep(q.at(i), decoded[i], size, 0.0F);
+        }
+        check("set inside", inside);
+
+        // 範囲外の設定は範囲を広げて全頂点を量子化し直す（誤差は量子化し直す前後の刻み幅の和以内）
+        q.set(7U, { 500.0F, -60.0F, 10.0F });
+        const Vertex wide(600.0F, 120.0F, 10.0F);
+        bool outside = (q.size() == vertexes.size()) && withinStep(q.at(7U), { 500.0F, -60.0F, 10.0F }, wide, 1.0F) &&
+                       withinStep(q.at(5U), { 0.0F, 0.0F }, wide, 2.0F);
+        for (std::size_t i = 8U; outside && (i < vertexes.size()); i++) {
+            outside = withinStep(q.at(i), vertexes[i], wide, 2.0F);
+        }
+        check("set outside", outside);
+
+        // 空の頂点の並び
+        const QuantizedVertexes empty((Vertexes()));
+        check("empty", (empty.size() == 0U) && empty.decode().empty() && (QuantizedVertexes().size() == 0U));
+        return ok;
+    }
+}
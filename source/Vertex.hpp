@@ -90,6 +90,43 @@ namespace my {
     using Vertexes = std::vector<Vertex>;
 }
 
+namespace my {
+    /**
+     * @class QuantizedVertexes
+     * @brief 量子化して保持する頂点の並びを扱うクラス
+     * 
+     * @par 詳細
+     *      頂点の並びを外接直方体の範囲で各座標16bitに量子化して保持する。
+     *      floatの頂点に対して半分のサイズで、任意の頂点を個別に復元できる。
+     *      復元した座標の誤差は、外接直方体の各辺の長さの1/65535以内となる。
+     */
+    class QuantizedVertexes {
+        Vertex                      m_min;      //!< 外接直方体の最小座標
+        Vertex                      m_step;     //!< 量子化の刻み幅
+        std::vector<std::uint16_t>  m_data;     //!< 量子化した座標の並び(x,y,zの順)
+
+    public:
+        //! デフォルトコンストラクタ
+        QuantizedVertexes();
+        //! コンストラクタ
+        explicit QuantizedVertexes(const Vertexes& vertexes);
+
+    public:
+        //! 頂点数を取得
+        std::size_t size() const;
+        //! 頂点を復元して取得
+        Vertex at(const std::size_t i) const;
+        //! 頂点を設定
+        void set(const std::size_t i, const Vertex& v);
+        //! 全頂点を復元して取得
+        Vertexes decode() const;
+
+    private:
+        //! 頂点の並びを量子化
+        void encode(const Vertexes& vertexes);
+    };
+}
+
 namespace my {
     /**
      * @class Index
@@ -116,4 +153,9 @@ namespace my {
     using Indexes = std::vector<Index>;
 }
 
+namespace my {
+    //! QuantizedVertexesクラスのテストコードを実行
+    bool testcode_QuantizedVertexes();
+}
+
 #endif //INCLUDED_VERTEX_HPP
@@ -0,0 +1,860 @@
+﻿/**
+ * @file VertexCodec.cpp
+ * @author kota-kota
+ * @brief 頂点データ・頂点インデックスの圧縮を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "VertexCodec.hpp"
+#include "MeshOptimizer.hpp"
+#include "StripBatch.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+/*
+ * 頂点座標の形式
+ * 
+ *  float x3    : 外接直方体の最小座標
+ *  float x3    : 量子化の刻み幅
+ *  可変長整数の並び x 頂点数 x 3 : X座標・Y座標・Z座標の順に、量子化した値の差分
+ * 
+ * 頂点色の形式（R・G・B・Aの順に成分毎）
+ * 
+ *  16個毎に、モード(1byte) + 0/4/8/16byte の値（モード0:全て0 1:2bit 2:4bit 3:8bit）
+ * 
+ * 三角形の並びの形式（三角形毎）
+ * 
+ *  符号(1byte) : 上位4bitが辺のFIFOの位置（15は共有する辺なし）、下位4bitが3番目の頂点の符号
+ *  共有する辺なしの場合は、1番目・2番目の頂点の符号(1byte、上位4bit・下位4bit)が続く
+ *  頂点の符号が差分の場合は、頂点の順に可変長整数が続く
+ */
+namespace {
+    //! 頂点色を詰める単位（個）
+    constexpr std::size_t COLOR_GROUP = 16U;
+    //! 辺のFIFOの大きさ
+    constexpr std::uint32_t EDGE_FIFO = 16U;
+    //! 辺のFIFOの位置で共有する辺なし（使用する位置は0～14）
+    constexpr std::uint32_t EDGE_NONE = 15U;
+    //! 頂点のFIFOの大きさ
+    constexpr std::uint32_t VERTEX_FIFO = 16U;
+    //! 頂点の符号：次の新しい頂点
+    constexpr std::uint32_t CODE_NEXT = 0U;
+    //! 頂点の符号：頂点のFIFOの位置（1～13が位置0～12）
+    constexpr std::uint32_t CODE_FIFO = 1U;
+    //! 頂点の符号で使用する頂点のFIFOの位置の数
+    constexpr std::uint32_t CODE_FIFO_NUM = 13U;
+    //! 頂点の符号：前の頂点との差分
+    constexpr std::uint32_t CODE_DELTA = 14U;
+    //! FIFOの空き
+    constexpr std::uint32_t FIFO_EMPTY = 0xFFFFFFFFU;
+
+    //! 可変長整数を追加（下位から7bitずつ、続きがある場合は最上位bitを1とする）
+    void putVarint(std::uint32_t v, std::vector<std::uint8_t>& out)
+    {
+        while (v >= 0x80U) {
+            out.push_back(static_cast<std::uint8_t>(v | 0x80U));
+            v >>= 7U;
+        }
+        out.push_back(static_cast<std::uint8_t>(v));
+    }
+
+    //! 可変長整数を取得（範囲外・5byteを超える場合はnullptr）
+    const std::uint8_t* getVarint(const std::uint8_t* p, const std::uint8_t* last, std::uint32_t& v)
+    {
+        // 1byteに収まる値が大半のため先に判定する
+        if ((p != last) && (*p < 0x80U)) {
+            v = *p;
+            return p + 1;
+        }
+        std::uint32_t value = 0U;
+        for (std::uint32_t shift = 0U; shift < 35U; shift += 7U) {
+            if (p == last) {
+                return nullptr;
+            }
+            const std::uint32_t b = *p++;
+            value |= (b & 0x7FU) << shift;
+            if (b < 0x80U) {
+                v = value;
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    //! ジグザグ符号化（0,-1,1,-2,...を0,1,2,3,...に対応させる）
+    std::uint32_t zigzag(const std::int32_t v)
+    {
+        return (static_cast<std::uint32_t>(v) << 1U) ^ static_cast<std::uint32_t>(v >> 31);
+    }
+
+    //! ジグザグ符号化の復号
+    std::int32_t unzigzag(const std::uint32_t v)
+    {
+        return static_cast<std::int32_t>((v >> 1U) ^ (0U - (v & 1U)));
+    }
+
+    //! 8bitのジグザグ符号化
+    std::uint8_t zigzag8(const std::uint8_t delta)
+    {
+        const std::uint32_t d = delta;
+        return static_cast<std::uint8_t>((d << 1U) ^ (((d & 0x80U) != 0U) ? 0xFFU : 0U));
+    }
+
+    //! 8bitのジグザグ符号化の復号
+    std::uint8_t unzigzag8(const std::uint8_t v)
+    {
+        const std::uint32_t z = v;
+        return static_cast<std::uint8_t>((z >> 1U) ^ (0U - (z & 1U)));
+    }
+
+    //! 座標を[0, max]の整数に量子化
+    std::int32_t quantize(const float v, const float min, const float step, const std::uint32_t max)
+    {
+        if (!(step > 0.0F)) {
+            return 0;
+        }
+        const float q = std::floor(((v - min) / step) + 0.5F);
+        return static_cast<std::int32_t>(std::min(std::max(q, 0.0F), static_cast<float>(max)));
+    }
+
+    /**
+     * @brief 差分の並びを累積（先頭からの総和）に置き換え
+     * 
+     * @param [in,out] p 差分の並び
+     * @param [in] n 要素数
+     * 
+     * @par 詳細
+     *      SIMD命令が使用可能な場合は、4要素ずつレジスタ内で累積し、前の4要素の末尾の値を加える。
+     */
+    void prefixSum(std::int32_t* p, const std::size_t n)
+    {
+        std::size_t i = 0U;
+        std::int32_t sum = 0;
+#if defined(MY_SIMD_SSE2)
+        __m128i carry = _mm_setzero_si128();
+        for (; (i + 4U) <= n; i += 4U) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi32(x, carry);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), x);
+            carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        sum = _mm_cvtsi128_si32(carry);
+#elif defined(MY_SIMD_NEON)
+        const int32x4_t zero = vdupq_n_s32(0);
+        int32x4_t carry = zero;
+        for (; (i + 4U) <= n; i += 4U) {
+            int32x4_t x = vld1q_s32(p + i);
+            x = vaddq_s32(x, vextq_s32(zero, x, 3));
+            x = vaddq_s32(x, vextq_s32(zero, x, 2));
+            x = vaddq_s32(x, carry);
+            vst1q_s32(p + i, x);
+            carry = vdupq_n_s32(vgetq_lane_s32(x, 3));
+        }
+        sum = vgetq_lane_s32(carry, 0);
+#endif
+        for (; i < n; i++) {
+            sum += p[i];
+            p[i] = sum;
+        }
+    }
+
+    /**
+     * @brief 量子化した座標を浮動小数点に戻し、頂点単位(x,y,z)に並べ替え
+     * 
+     * @param [in] qx 量子化したX座標の並び
+     * @param [in] qy 量子化したY座標の並び
+     * @param [in] qz 量子化したZ座標の並び
+     * @param [in] n 頂点数
+     * @param [in] min 外接直方体の最小座標(x,y,z)
+     * @param [in] step 量子化の刻み幅(x,y,z)
+     * @param [out] out 頂点の並び（n * 3個のfloat）
+     * 
+     * @par 詳細
+     *      SIMD命令が使用可能な場合は、4頂点分の座標毎の値を変換し、12個のfloatに並べ替えて書き込む。
+     */
+    void dequantize(const std::int32_t* qx, const std::int32_t* qy, const std::int32_t* qz, const std::size_t n,
+                    const float* min, const float* step, float* out)
+    {
+        std::size_t i = 0U;
+#if defined(MY_SIMD_SSE2)
+        const __m128 minx = _mm_set1_ps(min[0]), miny = _mm_set1_ps(min[1]), minz = _mm_set1_ps(min[2]);
+        const __m128 stepx = _mm_set1_ps(step[0]), stepy = _mm_set1_ps(step[1]), stepz = _mm_set1_ps(step[2]);
+        for (; (i + 4U) <= n; i += 4U) {
+            const __m128 x = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(qx + i))), stepx), minx);
+            const __m128 y = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(qy + i))), stepy), miny);
+            const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(qz + i))), stepz), minz);
+            // (x0 x1 x2 x3)(y0 y1 y2 y3)(z0 z1 z2 z3) -> (x0 y0 z0 x1)(y1 z1 x2 y2)(z2 x3 y3 z3)
+            const __m128 xy_lo = _mm_unpacklo_ps(x, y);     // x0 y0 x1 y1
+            const __m128 xy_hi = _mm_unpackhi_ps(x, y);     // x2 y2 x3 y3
+            const __m128 zx = _mm_unpacklo_ps(z, x);        // z0 x0 z1 x1
+            const __m128 yz = _mm_unpacklo_ps(y, z);        // y0 z0 y1 z1
+            const __m128 zz = _mm_shuffle_ps(z, xy_hi, _MM_SHUFFLE(3, 2, 3, 2));    // z2 z3 x3 y3
+            _mm_storeu_ps(out + (i * 3U), _mm_shuffle_ps(xy_lo, zx, _MM_SHUFFLE(3, 0, 1, 0)));
+            _mm_storeu_ps(out + (i * 3U) + 4U, _mm_shuffle_ps(yz, xy_hi, _MM_SHUFFLE(1, 0, 3, 2)));
+            _mm_storeu_ps(out + (i * 3U) + 8U, _mm_shuffle_ps(zz, zz, _MM_SHUFFLE(1, 3, 2, 0)));
+        }
+#elif defined(MY_SIMD_NEON)
+        const float32x4_t minx = vdupq_n_f32(min[0]), miny = vdupq_n_f32(min[1]), minz = vdupq_n_f32(min[2]);
+        for (; (i + 4U) <= n; i += 4U) {
+            float32x4x3_t v;
+            v.val[0] = vmlaq_n_f32(minx, vcvtq_f32_s32(vld1q_s32(qx + i)), step[0]);
+            v.val[1] = vmlaq_n_f32(miny, vcvtq_f32_s32(vld1q_s32(qy + i)), step[1]);
+            v.val[2] = vmlaq_n_f32(minz, vcvtq_f32_s32(vld1q_s32(qz + i)), step[2]);
+            vst3q_f32(out + (i * 3U), v);
+        }
+#endif
+        for (; i < n; i++) {
+            out[(i * 3U) + 0U] = (static_cast<float>(qx[i]) * step[0]) + min[0];
+            out[(i * 3U) + 1U] = (static_cast<float>(qy[i]) * step[1]) + min[1];
+            out[(i * 3U) + 2U] = (static_cast<float>(qz[i]) * step[2]) + min[2];
+        }
+    }
+
+    //! 頂点インデックスを2byteまたは4byteで書き込み（2byteの場合、リスタート値は0xFFFFとなる）
+    void storeIndex(void* out, const std::size_t i, const std::uint32_t v, const std::uint32_t index_size)
+    {
+        if (index_size == 2U) {
+            static_cast<std::uint16_t*>(out)[i] = static_cast<std::uint16_t>((v == my::StripBatch::RESTART32) ? my::StripBatch::RESTART16 : v);
+        }
+        else {
+            static_cast<std::uint32_t*>(out)[i] = v;
+        }
+    }
+
+    /**
+     * @struct TriangleState
+     * @brief 三角形の並びの圧縮・復号で共通の状態
+     */
+    struct TriangleState {
+        std::uint32_t   edges[EDGE_FIFO][2];        //!< 辺のFIFO（直前の三角形の辺を逆向きに保持する）
+        std::uint32_t   edge_head;                  //!< 辺のFIFOの次に書き込む位置
+        std::uint32_t   vertexes[VERTEX_FIFO];      //!< 頂点のFIFO
+        std::uint32_t   vertex_head;                //!< 頂点のFIFOの次に書き込む位置
+        std::uint32_t   next;                       //!< 次の新しい頂点
+        std::uint32_t   last;                       //!< 前の頂点
+
+        //! 初期状態にする
+        void reset()
+        {
+            std::fill(&this->edges[0][0], &this->edges[0][0] + (EDGE_FIFO * 2U), FIFO_EMPTY);
+            std::fill(&this->vertexes[0], &this->vertexes[0] + VERTEX_FIFO, FIFO_EMPTY);
+            this->edge_head = 0U;
+            this->vertex_head = 0U;
+            this->next = 0U;
+            this->last = 0U;
+        }
+        //! 辺を追加
+        void pushEdge(const std::uint32_t a, const std::uint32_t b)
+        {
+            this->edges[this->edge_head % EDGE_FIFO][0] = a;
+            this->edges[this->edge_head % EDGE_FIFO][1] = b;
+            this->edge_head++;
+        }
+        //! 辺を取得（0が最新）
+        const std::uint32_t* edge(const std::uint32_t pos) const
+        {
+            return this->edges[(this->edge_head + EDGE_FIFO - 1U - pos) % EDGE_FIFO];
+        }
+        //! 頂点を追加
+        void pushVertex(const std::uint32_t v)
+        {
+            this->vertexes[this->vertex_head % VERTEX_FIFO] = v;
+            this->vertex_head++;
+        }
+        //! 頂点を取得（0が最新）
+        std::uint32_t vertex(const std::uint32_t pos) const
+        {
+            return this->vertexes[(this->vertex_head + VERTEX_FIFO - 1U - pos) % VERTEX_FIFO];
+        }
+        //! 三角形の辺を逆向きに追加（skipの辺は除く）
+        void pushTriangle(const std::uint32_t a, const std::uint32_t b, const std::uint32_t c, const bool skip_ab)
+        {
+            if (!skip_ab) {
+                this->pushEdge(b, a);
+            }
+            this->pushEdge(c, b);
+            this->pushEdge(a, c);
+        }
+    };
+
+    //! 頂点を符号化し、符号を取得（差分の場合は可変長整数を追加）
+    std::uint32_t encodeVertex(TriangleState& s, const std::uint32_t v, std::vector<std::uint32_t>& deltas)
+    {
+        std::uint32_t code = CODE_DELTA;
+        if (v == s.next) {
+            code = CODE_NEXT;
+            s.next++;
+            s.pushVertex(v);
+        }
+        else {
+            for (std::uint32_t pos = 0U; pos < CODE_FIFO_NUM; pos++) {
+                if (s.vertex(pos) == v) {
+                    code = CODE_FIFO + pos;
+                    break;
+                }
+            }
+            if (code == CODE_DELTA) {
+                deltas.push_back(zigzag(static_cast<std::int32_t>(v - s.last)));
+                s.pushVertex(v);
+            }
+        }
+        s.last = v;
+        return code;
+    }
+
+    //! 符号から頂点を復号（範囲外・不正な符号の場合はnullptr）
+    const std::uint8_t* decodeVertex(TriangleState& s, const std::uint32_t code, const std::uint8_t* p, const std::uint8_t* last, std::uint32_t& v)
+    {
+        if (code == CODE_NEXT) {
+            v = s.next++;
+            s.pushVertex(v);
+        }
+        else if (code < (CODE_FIFO + CODE_FIFO_NUM)) {
+            v = s.vertex(code - CODE_FIFO);
+        }
+        else if (code == CODE_DELTA) {
+            std::uint32_t d = 0U;
+            p = getVarint(p, last, d);
+            v = s.last + static_cast<std::uint32_t>(unzigzag(d));
+            s.pushVertex(v);
+        }
+        else {
+            return nullptr;
+        }
+        s.last = v;
+        return p;
+    }
+}
+
+namespace my {
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] bits 量子化のビット数（1～24の範囲に丸める）
+     */
+    VertexCodec::VertexCodec(const std::uint32_t bits) :
+        m_bits(std::min(std::max(bits, 1U), 24U))
+    {
+    }
+
+    /**
+     * @brief 頂点座標を圧縮（末尾に追加）
+     * 
+     * @param [in] vertexes 頂点座標の並び
+     * @param [out] out 圧縮したデータ（末尾に追加する）
+     */
+    void VertexCodec::encode(const Vertexes& vertexes, std::vector<std::uint8_t>& out) const
+    {
+        const std::uint32_t max = (1U << this->m_bits) - 1U;
+        float min[3] = { 0.0F, 0.0F, 0.0F };
+        float step[3] = { 0.0F, 0.0F, 0.0F };
+        if (!vertexes.empty()) {
+            float hi[3] = { vertexes[0].x(), vertexes[0].y(), vertexes[0].z() };
+            std::copy(&hi[0], &hi[0] + 3, &min[0]);
+            for (const Vertex& v : vertexes) {
+                const float c[3] = { v.x(), v.y(), v.z() };
+                for (std::size_t a = 0U; a < 3U; a++) {
+                    min[a] = std::min(min[a], c[a]);
+                    hi[a] = std::max(hi[a], c[a]);
+                }
+            }
+            for (std::size_t a = 0U; a < 3U; a++) {
+                step[a] = (hi[a] - min[a]) / static_cast<float>(max);
+            }
+        }
+        const std::size_t head = out.size();
+        out.resize(head + sizeof(min) + sizeof(step));
+        std::memcpy(&out[head], min, sizeof(min));
+        std::memcpy(&out[head + sizeof(min)], step, sizeof(step));
+
+        // 座標毎に、前の頂点との差分を並べる
+        out.reserve(out.size() + (vertexes.size() * 3U * 2U));
+        for (std::size_t a = 0U; a < 3U; a++) {
+            std::int32_t prev = 0;
+            for (const Vertex& v : vertexes) {
+                const float c = (a == 0U) ? v.x() : ((a == 1U) ? v.y() : v.z());
+                const std::int32_t q = quantize(c, min[a], step[a], max);
+                putVarint(zigzag(q - prev), out);
+                prev = q;
+            }
+        }
+    }
+
+    /**
+     * @brief 頂点座標を復号
+     * 
+     * @param [in] first 圧縮したデータの先頭
+     * @param [in] last 圧縮したデータの末尾の次
+     * @param [out] out 頂点座標の並び（num個）
+     * @param [in] num 頂点数
+     * 
+     * @return const std::uint8_t* 読み込んだデータの次の位置（データが壊れている場合はnullptr）
+     */
+    const std::uint8_t* VertexCodec::decode(const std::uint8_t* first, const std::uint8_t* last, Vertex* out, const std::size_t num)
+    {
+        static_assert(sizeof(Vertex) == (sizeof(float) * 3U), "Vertex must be 3 floats");
+        float min[3];
+        float step[3];
+        if (static_cast<std::size_t>(last - first) < (sizeof(min) + sizeof(step))) {
+            return nullptr;
+        }
+        std::memcpy(min, first, sizeof(min));
+        std::memcpy(step, first + sizeof(min), sizeof(step));
+        const std::uint8_t* p = first + sizeof(min) + sizeof(step);
+
+        std::vector<std::int32_t> q(num * 3U);
+        for (std::size_t a = 0U; a < 3U; a++) {
+            std::int32_t* dst = q.data() + (a * num);
+            for (std::size_t i = 0U; i < num; i++) {
+                std::uint32_t v = 0U;
+                p = getVarint(p, last, v);
+                if (p == nullptr) {
+                    return nullptr;
+                }
+                dst[i] = unzigzag(v);
+            }
+            prefixSum(dst, num);
+        }
+        dequantize(q.data(), q.data() + num, q.data() + (num * 2U), num, min, step, reinterpret_cast<float*>(out));
+        return p;
+    }
+
+    /**
+     * @brief 頂点色を圧縮（末尾に追加）
+     * 
+     * @param [in] colors 頂点色の並び
+     * @param [out] out 圧縮したデータ（末尾に追加する）
+     */
+    void VertexCodec::encodeColors(const Colors& colors, std::vector<std::uint8_t>& out)
+    {
+        const std::size_t n = colors.size();
+        std::vector<std::uint8_t> deltas(n);
+        for (std::size_t ch = 0U; ch < 4U; ch++) {
+            std::uint8_t prev = 0U;
+            for (std::size_t i = 0U; i < n; i++) {
+                const Color& c = colors[i];
+                const std::uint8_t v = (ch == 0U) ? c.r() : ((ch == 1U) ? c.g() : ((ch == 2U) ? c.b() : c.a()));
+                deltas[i] = zigzag8(static_cast<std::uint8_t>(v - prev));
+                prev = v;
+            }
+            for (std::size_t g = 0U; g < n; g += COLOR_GROUP) {
+                std::uint8_t values[COLOR_GROUP] = {};
+                const std::size_t count = std::min(COLOR_GROUP, n - g);
+                std::copy(deltas.begin() + static_cast<std::ptrdiff_t>(g), deltas.begin() + static_cast<std::ptrdiff_t>(g + count), &values[0]);
+                const std::uint8_t top = *std::max_element(&values[0], &values[0] + COLOR_GROUP);
+                const std::uint8_t mode = (top == 0U) ? 0U : ((top < 4U) ? 1U : ((top < 16U) ? 2U : 3U));
+                out.push_back(mode);
+                if (mode == 0U) {
+                    continue;
+                }
+                const std::uint32_t bits = 1U << mode;     // 2, 4, 8
+                const std::uint32_t per_byte = 8U / bits;
+                for (std::size_t k = 0U; k < COLOR_GROUP; k += per_byte) {
+                    std::uint32_t b = 0U;
+                    for (std::uint32_t t = 0U; t < per_byte; t++) {
+                        b |= static_cast<std::uint32_t>(values[k + t]) << (t * bits);
+                    }
+                    out.push_back(static_cast<std::uint8_t>(b));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 頂点色を復号
+     * 
+     * @param [in] first 圧縮したデータの先頭
+     * @param [in] last 圧縮したデータの末尾の次
+     * @param [out] out 頂点色の並び（num個）
+     * @param [in] num 頂点数
+     * 
+     * @return const std::uint8_t* 読み込んだデータの次の位置（データが壊れている場合はnullptr）
+     */
+    const std::uint8_t* VertexCodec::decodeColors(const std::uint8_t* first, const std::uint8_t* last, Color* out, const std::size_t num)
+    {
+        std::vector<std::uint8_t> channels(num * 4U);
+        const std::uint8_t* p = first;
+        for (std::size_t ch = 0U; ch < 4U; ch++) {
+            std::uint8_t* dst = channels.data() + (ch * num);
+            std::uint8_t prev = 0U;
+            for (std::size_t g = 0U; g < num; g += COLOR_GROUP) {
+                if (p == last) {
+                    return nullptr;
+                }
+                const std::uint32_t mode = *p++;
+                std::uint8_t values[COLOR_GROUP] = {};
+                if (mode > 3U) {
+                    return nullptr;
+                }
+                if (mode != 0U) {
+                    const std::uint32_t bits = 1U << mode;
+                    const std::uint32_t per_byte = 8U / bits;
+                    const std::uint32_t mask = (1U << bits) - 1U;
+                    if (static_cast<std::size_t>(last - p) < (COLOR_GROUP / per_byte)) {
+                        return nullptr;
+                    }
+                    for (std::size_t k = 0U; k < COLOR_GROUP; k += per_byte) {
+                        const std::uint32_t b = *p++;
+                        for (std::uint32_t t = 0U; t < per_byte; t++) {
+                            values[k + t] = static_cast<std::uint8_t>((b >> (t * bits)) & mask);
+                        }
+                    }
+                }
+                const std::size_t count = std::min(COLOR_GROUP, num - g);
+                for (std::size_t k = 0U; k < count; k++) {
+                    prev = static_cast<std::uint8_t>(prev + unzigzag8(values[k]));
+                    dst[g + k] = prev;
+                }
+            }
+        }
+        for (std::size_t i = 0U; i < num; i++) {
+            out[i] = Color(channels[i], channels[num + i], channels[(num * 2U) + i], channels[(num * 3U) + i]);
+        }
+        return p;
+    }
+}
+
+namespace my {
+    /**
+     * @brief 三角形の並びを圧縮（末尾に追加）
+     * 
+     * @param [in] indexes 三角形の頂点インデックスの並び
+     * @param [out] out 圧縮したデータ（末尾に追加する）
+     * 
+     * @retval true 成功
+     * @retval false 失敗（3の倍数でない、リスタート値を含む）
+     * 
+     * @par 詳細
+     *      頂点を参照順に並べ替えた（MeshOptimizer::optimizeFetch()）形状で圧縮率が高くなる。
+     */
+    bool IndexCodec::encodeTriangles(const Indexes& indexes, std::vector<std::uint8_t>& out)
+    {
+        if ((indexes.size() % 3U) != 0U) {
+            return false;
+        }
+        for (const Index& i : indexes) {
+            if (i.idx() == StripBatch::RESTART32) {
+                return false;
+            }
+        }
+        TriangleState s;
+        s.reset();
+        std::vector<std::uint32_t> deltas;
+        for (std::size_t t = 0U; t < indexes.size(); t += 3U) {
+            const std::uint32_t tri[3] = { indexes[t].idx(), indexes[t + 1U].idx(), indexes[t + 2U].idx() };
+            deltas.clear();
+            // 直前の三角形と共有する辺を探す（頂点の開始位置を巡回させて向きを保つ）
+            std::uint32_t hit = EDGE_NONE;
+            std::uint32_t rot = 0U;
+            for (std::uint32_t pos = 0U; (pos < EDGE_NONE) && (hit == EDGE_NONE); pos++) {
+                const std::uint32_t* e = s.edge(pos);
+                for (std::uint32_t r = 0U; r < 3U; r++) {
+                    if ((e[0] == tri[r]) && (e[1] == tri[(r + 1U) % 3U])) {
+                        hit = pos;
+                        rot = r;
+                        break;
+                    }
+                }
+            }
+            if (hit != EDGE_NONE) {
+                const std::uint32_t a = tri[rot], b = tri[(rot + 1U) % 3U], c = tri[(rot + 2U) % 3U];
+                const std::uint32_t code = encodeVertex(s, c, deltas);
+                out.push_back(static_cast<std::uint8_t>((hit << 4U) | code));
+                s.pushTriangle(a, b, c, true);
+            }
+            else {
+                const std::uint32_t code_a = encodeVertex(s, tri[0], deltas);
+                const std::uint32_t code_b = encodeVertex(s, tri[1], deltas);
+                const std::uint32_t code_c = encodeVertex(s, tri[2], deltas);
+                out.push_back(static_cast<std::uint8_t>((EDGE_NONE << 4U) | code_c));
+                out.push_back(static_cast<std::uint8_t>((code_a << 4U) | code_b));
+                s.pushTriangle(tri[0], tri[1], tri[2], false);
+            }
+            for (const std::uint32_t d : deltas) {
+                putVarint(d, out);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 三角形の並びを復号
+     * 
+     * @param [in] first 圧縮したデータの先頭
+     * @param [in] last 圧縮したデータの末尾の次
+     * @param [out] out 頂点インデックスの並び（num個、index_sizeバイトずつ）
+     * @param [in] num 頂点インデックス数
+     * @param [in] index_size 頂点インデックス1個のバイト数（2または4）
+     * @param [in] vertex_num 頂点数
+     * 
+     * @return const std::uint8_t* 読み込んだデータの次の位置（データが壊れている・頂点インデックスが範囲外の場合はnullptr）
+     */
+    const std::uint8_t* IndexCodec::decodeTriangles(const std::uint8_t* first, const std::uint8_t* last, void* out, const std::size_t num,
+                                                    const std::uint32_t index_size, const std::size_t vertex_num)
+    {
+        if ((num % 3U) != 0U) {
+            return nullptr;
+        }
+        TriangleState s;
+        s.reset();
+        const std::uint8_t* p = first;
+        for (std::size_t t = 0U; t < num; t += 3U) {
+            if (p == last) {
+                return nullptr;
+            }
+            const std::uint32_t code = *p++;
+            const std::uint32_t hit = code >> 4U;
+            std::uint32_t tri[3] = { 0U, 0U, 0U };
+            if (hit != EDGE_NONE) {
+                const std::uint32_t* e = s.edge(hit);
+                tri[0] = e[0];
+                tri[1] = e[1];
+                p = decodeVertex(s, code & 0x0FU, p, last, tri[2]);
+                if ((p == nullptr) || (tri[0] == FIFO_EMPTY)) {
+                    return nullptr;
+                }
+                s.pushTriangle(tri[0], tri[1], tri[2], true);
+            }
+            else {
+                if (p == last) {
+                    return nullptr;
+                }
+                const std::uint32_t codes = *p++;
+                p = decodeVertex(s, codes >> 4U, p, last, tri[0]);
+                p = (p == nullptr) ? nullptr : decodeVertex(s, codes & 0x0FU, p, last, tri[1]);
+                p = (p == nullptr) ? nullptr : decodeVertex(s, code & 0x0FU, p, last, tri[2]);
+                if (p == nullptr) {
+                    return nullptr;
+                }
+                s.pushTriangle(tri[0], tri[1], tri[2], false);
+            }
+            for (std::size_t k = 0U; k < 3U; k++) {
+                if (tri[k] >= vertex_num) {
+                    return nullptr;
+                }
+                storeIndex(out, t + k, tri[k], index_size);
+            }
+        }
+        return p;
+    }
+
+    /**
+     * @brief 頂点インデックスの並びを圧縮（末尾に追加）
+     * 
+     * @param [in] indexes 頂点インデックスの並び（リスタート値は0xFFFFFFFF）
+     * @param [out] out 圧縮したデータ（末尾に追加する）
+     * 
+     * @par 詳細
+     *      リスタート値を0、頂点インデックスiをi+1に対応させ、前の値との差分を並べる。
+     */
+    void IndexCodec::encodeSequence(const Indexes& indexes, std::vector<std::uint8_t>& out)
+    {
+        std::uint32_t prev = 0U;
+        for (const Index& i : indexes) {
+            const std::uint32_t v = (i.idx() == StripBatch::RESTART32) ? 0U : (i.idx() + 1U);
+            putVarint(zigzag(static_cast<std::int32_t>(v - prev)), out);
+            prev = v;
+        }
+    }
+
+    /**
+     * @brief 頂点インデックスの並びを復号
+     * 
+     * @param [in] first 圧縮したデータの先頭
+     * @param [in] last 圧縮したデータの末尾の次
+     * @param [out] out 頂点インデックスの並び（num個、index_sizeバイトずつ）
+     * @param [in] num 頂点インデックス数
+     * @param [in] index_size 頂点インデックス1個のバイト数（2または4）
+     * @param [in] vertex_num 頂点数
+     * 
+     * @return const std::uint8_t* 読み込んだデータの次の位置（データが壊れている・頂点インデックスが範囲外の場合はnullptr）
+     */
+    const std::uint8_t* IndexCodec::decodeSequence(const std::uint8_t* first, const std::uint8_t* last, void* out, const std::size_t num,
+                                                   const std::uint32_t index_size, const std::size_t vertex_num)
+    {
+        const std::uint8_t* p = first;
+        std::uint32_t prev = 0U;
+        for (std::size_t i = 0U; i < num; i++) {
+            std::uint32_t d = 0U;
+            p = getVarint(p, last, d);
+            if (p == nullptr) {
+                return nullptr;
+            }
+            prev += static_cast<std::uint32_t>(unzigzag(d));
+            if ((prev != 0U) && ((prev - 1U) >= vertex_num)) {
+                return nullptr;
+            }
+            storeIndex(out, i, (prev == 0U) ? StripBatch::RESTART32 : (prev - 1U), index_size);
+        }
+        return p;
+    }
+}
+
+namespace {
+    //! 格子状の三角形の並びを作成（頂点の並びと三角形の順序は最適化済み）
+    void makeOptimizedGrid(const std::int32_t n, my::Vertexes& vertexes, my::Colors& colors, my::Indexes& indexes)
+    {
+        for (std::int32_t y = 0; y <= n; y++) {
+            for (std::int32_t x = 0; x <= n; x++) {
+                const float fx = static_cast<float>(x) * 0.37F;
+                const float fy = static_cast<float>(y) * 0.37F;
+                vertexes.push_back({ fx, fy, std::sin(fx) * std::cos(fy) });
+                colors.push_back(my::Color(static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), 128, 255));
+            }
+        }
+        const std::uint32_t stride = static_cast<std::uint32_t>(n + 1);
+        for (std::uint32_t y = 0U; y < static_cast<std::uint32_t>(n); y++) {
+            for (std::uint32_t x = 0U; x < static_cast<std::uint32_t>(n); x++) {
+                const std::uint32_t v = (y * stride) + x;
+                indexes.insert(indexes.end(), { v, v + 1U, v + stride, v + 1U, v + stride + 1U, v + stride });
+            }
+        }
+        const my::MeshOptimizer optimizer;
+        optimizer.optimizeCache(indexes, vertexes.size());
+        optimizer.optimizeFetch(vertexes, colors, indexes);
+    }
+
+    //! 三角形の頂点を最小の頂点インデックスから始まるよう巡回させた並び（向きは保つ）
+    std::vector<std::uint32_t> canonicalTriangles(const std::uint32_t* indexes, const std::size_t num)
+    {
+        std::vector<std::uint32_t> out;
+        for (std::size_t t = 0U; t < num; t += 3U) {
+            const std::uint32_t* tri = indexes + t;
+            const std::size_t r = static_cast<std::size_t>(std::min_element(tri, tri + 3) - tri);
+            out.insert(out.end(), { tri[r], tri[(r + 1U) % 3U], tri[(r + 2U) % 3U] });
+        }
+        return out;
+    }
+}
+
+namespace my {
+    /**
+     * @brief VertexCodecクラス・IndexCodecクラスのテストコードを実行
+     * 
+     * @retval true 全て成功
+     * @retval false 失敗あり
+     */
+    bool testcode_VertexCodec()
+    {
+        std::cout << "[testcode_VertexCodec()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const char* name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+
+        Vertexes vertexes;
+        Colors colors;
+        Indexes indexes;
+        makeOptimizedGrid(40, vertexes, colors, indexes);
+        const std::size_t vnum = vertexes.size();
+        const std::size_t inum = indexes.size();
+
+        // 頂点座標：誤差は刻み幅の半分以内
+        std::vector<std::uint8_t> data;
+        VertexCodec(16U).encode(vertexes, data);
+        Vertexes decoded(vnum);
+        const std::uint8_t* end = VertexCodec::decode(data.data(), data.data() + data.size(), decoded.data(), vnum);
+        float error = 0.0F;
+        for (std::size_t i = 0U; i < vnum; i++) {
+            error = std::max(error, std::abs(decoded[i].x() - vertexes[i].x()));
+            error = std::max(error, std::abs(decoded[i].y() - vertexes[i].y()));
+            error = std::max(error, std::abs(decoded[i].z() - vertexes[i].z()));
+        }
+        std::cout << "* vertexes raw:" << (vnum * sizeof(Vertex)) << " encoded:" << data.size() << " error:" << error << std::endl;
+        check("vertexes", (end == (data.data() + data.size())) && (error < (14.8F / 65535.0F)) && ((data.size() * 3U) < (vnum * sizeof(Vertex) * 2U)));
+        check("vertexes broken", VertexCodec::decode(data.data(), data.data() + (data.size() / 2U), decoded.data(), vnum) == nullptr);
+
+        // 頂点色：可逆
+        data.clear();
+        Colors mixed = colors;
+        mixed[7] = Color(255, 0, 3, 17);
+        VertexCodec::encodeColors(mixed, data);
+        Colors decoded_c(vnum);
+        end = VertexCodec::decodeColors(data.data(), data.data() + data.size(), decoded_c.data(), vnum);
+        bool same = (end == (data.data() + data.size()));
+        for (std::size_t i = 0U; same && (i < vnum); i++) {
+            same = (decoded_c[i].r() == mixed[i].r()) && (decoded_c[i].g() == mixed[i].g()) && (decoded_c[i].b() == mixed[i].b()) && (decoded_c[i].a() == mixed[i].a());
+        }
+        std::cout << "* colors raw:" << (vnum * sizeof(Color)) << " encoded:" << data.size() << std::endl;
+        check("colors", same && (data.size() < (vnum * sizeof(Color))));
+
+        // 三角形：三角形の並び順と向きは保つ（開始位置は入れ替わる場合がある）
+        data.clear();
+        check("triangles encode", IndexCodec::encodeTriangles(indexes, data));
+        std::vector<std::uint32_t> decoded_i(inum);
+        end = IndexCodec::decodeTriangles(data.data(), data.data() + data.size(), decoded_i.data(), inum, 4U, vnum);
+        std::vector<std::uint32_t> original(inum);
+        for (std::size_t i = 0U; i < inum; i++) {
+            original[i] = indexes[i].idx();
+        }
+        std::cout << "* triangles:" << (inum / 3U) << " encoded:" << data.size() << "[byte] (" << (static_cast<double>(data.size()) * 3.0 / static_cast<double>(inum)) << "[byte/triangle])" << std::endl;
+        check("triangles", (end == (data.data() + data.size())) && (canonicalTriangles(decoded_i.data(), inum) == canonicalTriangles(original.data(), inum)) &&
+                           ((data.size() * 3U) < (inum * 2U)));
+        std::vector<std::uint16_t> decoded16(inum);
+        end = IndexCodec::decodeTriangles(data.data(), data.data() + data.size(), decoded16.data(), inum, 2U, vnum);
+        check("triangles 16bit", (end != nullptr) && (decoded16[5] == decoded_i[5]) && (decoded16[inum - 1U] == decoded_i[inum - 1U]));
+        check("triangles out of range", IndexCodec::decodeTriangles(data.data(), data.data() + data.size(), decoded_i.data(), inum, 4U, vnum / 2U) == nullptr);
+        check("triangles restart", !IndexCodec::encodeTriangles({ 0U, 1U, StripBatch::RESTART32 }, data) && !IndexCodec::encodeTriangles({ 0U, 1U }, data));
+
+        // 任意の並び：リスタート値を含めて可逆
+        data.clear();
+        const Indexes strips = { 0U, 1U, 2U, 3U, StripBatch::RESTART32, 9U, 8U, 7U, 0U };
+        IndexCodec::encodeSequence(strips, data);
+        std::vector<std::uint16_t> decoded_s(strips.size());
+        end = IndexCodec::decodeSequence(data.data(), data.data() + data.size(), decoded_s.data(), strips.size(), 2U, 10U);
+        check("sequence", (end == (data.data() + data.size())) && (decoded_s[4] == StripBatch::RESTART16) && (decoded_s[5] == 9U) && (decoded_s[8] == 0U));
+        check("sequence out of range", IndexCodec::decodeSequence(data.data(), data.data() + data.size(), decoded_s.data(), strips.size(), 2U, 9U) == nullptr);
+
+        // 空の並び
+        data.clear();
+        VertexCodec(16U).encode(Vertexes(), data);
+        check("empty", VertexCodec::decode(data.data(), data.data() + data.size(), nullptr, 0U) == (data.data() + data.size()));
+        return ok;
+    }
+
+    /**
+     * @brief VertexCodecクラス・IndexCodecクラスの処理性能を計測
+     * 
+     */
+    void benchcode_VertexCodec()
+    {
+        std::cout << "[benchcode_VertexCodec()] call" << std::endl;
+        Vertexes vertexes;
+        Colors colors;
+        Indexes indexes;
+        makeOptimizedGrid(1000, vertexes, colors, indexes);
+        const std::size_t vnum = vertexes.size();
+        const std::size_t inum = indexes.size();
+        std::vector<std::uint8_t> vdata, cdata, idata;
+        VertexCodec(16U).encode(vertexes, vdata);
+        VertexCodec::encodeColors(colors, cdata);
+        (void)IndexCodec::encodeTriangles(indexes, idata);
+        const std::size_t raw = (vnum * (sizeof(Vertex) + sizeof(Color))) + (inum * sizeof(std::uint32_t));
+        std::cout << "* vertexes:" << vnum << " triangles:" << (inum / 3U) << " raw:" << raw << "[byte] encoded:" << (vdata.size() + cdata.size() + idata.size())
+                  << "[byte] (vertex:" << vdata.size() << " color:" << cdata.size() << " index:" << idata.size() << ")" << std::endl;
+
+        Vertexes v(vnum);
+        Colors c(vnum);
+        std::vector<std::uint32_t> i(inum);
+        const auto measure = [](const char* name, const std::size_t bytes, const std::function<void()>& f) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "* decode " << name << " time:" << (sec * 1000.0) << "[msec] (" << (static_cast<double>(bytes) / sec / 1.0e6) << "[MB/s] output)" << std::endl;
+        };
+        measure("vertexes", vnum * sizeof(Vertex), [&]() { (void)VertexCodec::decode(vdata.data(), vdata.data() + vdata.size(), v.data(), vnum); });
+        measure("colors", vnum * sizeof(Color), [&]() { (void)VertexCodec::decodeColors(cdata.data(), cdata.data() + cdata.size(), c.data(), vnum); });
+        measure("triangles", inum * sizeof(std::uint32_t), [&]() { (void)IndexCodec::decodeTriangles(idata.data(), idata.data() + idata.size(), i.data(), inum, 4U, vnum); });
+    }
+}
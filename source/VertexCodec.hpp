@@ -0,0 +1,84 @@
+﻿/**
+ * @file VertexCodec.hpp
+ * @author kota-kota
+ * @brief 頂点データ・頂点インデックスの圧縮を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_VERTEXCODEC_HPP
+#define INCLUDED_VERTEXCODEC_HPP
+
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    /**
+     * @class VertexCodec
+     * @brief 頂点座標・頂点色を圧縮するクラス
+     * 
+     * @par 詳細
+     *      頂点座標は外接直方体の範囲で各座標を指定ビット数に量子化し、座標毎に
+     *      前の頂点との差分をジグザグ符号化した可変長整数（7bit毎）で並べる。
+     *      頂点色は成分毎に前の頂点との差分を16個ずつまとめ、0/2/4/8bitのうち収まる最小のビット数で詰める。
+     *      復元した座標の誤差は、外接直方体の各辺の長さの1/(2^ビット数-1)の半分以内となる。
+     *      復号では、差分の累積と浮動小数点への変換・頂点単位への並べ替えをSIMD命令で4頂点ずつ行う。
+     */
+    class VertexCodec {
+        std::uint32_t   m_bits;     //!< 量子化のビット数（1～24）
+
+    public:
+        //! コンストラクタ
+        explicit VertexCodec(const std::uint32_t bits);
+
+    public:
+        //! 頂点座標を圧縮（末尾に追加）
+        void encode(const Vertexes& vertexes, std::vector<std::uint8_t>& out) const;
+        //! 頂点座標を復号
+        static const std::uint8_t* decode(const std::uint8_t* first, const std::uint8_t* last, Vertex* out, const std::size_t num);
+        //! 頂点色を圧縮（末尾に追加）
+        static void encodeColors(const Colors& colors, std::vector<std::uint8_t>& out);
+        //! 頂点色を復号
+        static const std::uint8_t* decodeColors(const std::uint8_t* first, const std::uint8_t* last, Color* out, const std::size_t num);
+    };
+}
+
+namespace my {
+    /**
+     * @class IndexCodec
+     * @brief 頂点インデックスを圧縮するクラス
+     * 
+     * @par 詳細
+     *      三角形の並び（GL_TRIANGLES）は、直前の三角形と共有する辺を辺のFIFOの位置で、
+     *      残りの頂点を「次の新しい頂点」「頂点のFIFOの位置」「前の頂点との差分」のいずれかで表す。
+     *      頂点の並びを初出順に並べ替えた形状では、大半の三角形が1byteとなる。
+     *      三角形の並び順と向きは保つが、三角形内の頂点の開始位置は入れ替わる場合がある。
+     *      それ以外の並び（ストリップ・リスタート値を含む並び）は、前の値との差分をジグザグ符号化した可変長整数で並べる。
+     *      復号した頂点インデックスは2byte（リスタート値0xFFFF）または4byte（リスタート値0xFFFFFFFF）で出力し、そのまま転送できる。
+     */
+    class IndexCodec {
+    public:
+        //! 三角形の並びを圧縮（末尾に追加、3の倍数でない・リスタート値を含む場合はfalse）
+        static bool encodeTriangles(const Indexes& indexes, std::vector<std::uint8_t>& out);
+        //! 三角形の並びを復号
+        static const std::uint8_t* decodeTriangles(const std::uint8_t* first, const std::uint8_t* last, void* out, const std::size_t num,
+                                                   const std::uint32_t index_size, const std::size_t vertex_num);
+        //! 頂点インデックスの並びを圧縮（末尾に追加）
+        static void encodeSequence(const Indexes& indexes, std::vector<std::uint8_t>& out);
+        //! 頂点インデックスの並びを復号
+        static const std::uint8_t* decodeSequence(const std::uint8_t* first, const std::uint8_t* last, void* out, const std::size_t num,
+                                                  const std::uint32_t index_size, const std::size_t vertex_num);
+    };
+}
+
+namespace my {
+    //! VertexCodecクラス・IndexCodecクラスのテストコードを実行
+    bool testcode_VertexCodec();
+    //! VertexCodecクラス・IndexCodecクラスの処理性能を計測
+    void benchcode_VertexCodec();
+}
+
+#endif //INCLUDED_VERTEXCODEC_HPP
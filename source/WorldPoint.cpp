@@ -0,0 +1,169 @@
+﻿/**
+ * @file WorldPoint.cpp
+ * @author kota-kota
+ * @brief 倍精度のワールド座標を扱うクラスの実装
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#include "WorldPoint.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace my {
+    /**
+     * @brief デフォルトコンストラクタ（原点）
+     * 
+     */
+    WorldPoint::WorldPoint() :
+        m_x(0.0), m_y(0.0)
+    {
+    }
+
+    /**
+     * @brief コンストラクタ
+     * 
+     * @param [in] x X座標
+     * @param [in] y Y座標
+     */
+    WorldPoint::WorldPoint(const double x, const double y) :
+        m_x(x), m_y(y)
+    {
+    }
+
+    /**
+     * @brief コンストラクタ（単精度のベクトルのXY）
+     * 
+     * @param [in] v ベクトル（Zは使用しない）
+     */
+    WorldPoint::WorldPoint(const Vector& v) :
+        m_x(static_cast<double>(v.x())), m_y(static_cast<double>(v.y()))
+    {
+    }
+
+    /**
+     * @brief X座標を取得
+     * 
+     * @return double X座標
+     */
+    double WorldPoint::x() const { return this->m_x; }
+
+    /**
+     * @brief Y座標を取得
+     * 
+     * @return double Y座標
+     */
+    double WorldPoint::y() const { return this->m_y; }
+
+    /**
+     * @brief +演算子のオーバーロード（移動）
+     * 
+     * @param [in] v 移動量（Zは使用しない）
+     * @return WorldPoint 移動した座標
+     */
+    WorldPoint WorldPoint::operator+(const Vector& v) const
+    {
+        return WorldPoint(this->m_x + static_cast<double>(v.x()), this->m_y + static_cast<double>(v.y()));
+    }
+
+    /**
+     * @brief +=演算子のオーバーロード（移動）
+     * 
+     * @param [in] v 移動量（Zは使用しない）
+     * @return WorldPoint& 移動した座標
+     */
+    WorldPoint& WorldPoint::operator+=(const Vector& v)
+    {
+        *this = *this + v;
+        return *this;
+    }
+
+    /**
+     * @brief 基準点からの差（単精度）を取得
+     * 
+     * @param [in] eye 基準点（カメラの位置）
+     * @return Vector 基準点から自身までの差（Zは0）
+     * 
+     * @par 詳細
+     *      差は倍精度で求めてから単精度に変換するため、基準点の近くでは座標が大きくても精度を失わない。
+     */
+    Vector WorldPoint::relativeTo(const WorldPoint& eye) const
+    {
+        return Vector(static_cast<float>(this->m_x - eye.m_x), static_cast<float>(this->m_y - eye.m_y), 0.0F);
+    }
+
+    /**
+     * @brief 単精度に丸めた座標を取得（外接矩形・判定用）
+     * 
+     * @return Vertex 座標（Zは0）
+     */
+    Vertex WorldPoint::toVertex() const
+    {
+        return Vertex(static_cast<float>(this->m_x), static_cast<float>(this->m_y), 0.0F);
+    }
+
+    /**
+     * @brief 自身を基準点とする配置を、カメラを原点とする配置に変換
+     * 
+     * @param [in] local 自身を基準点とする配置
+     * @param [in] eye カメラの位置（原点を指定した場合はワールド座標系の配置）
+     * @return Affine2D カメラを原点とする配置（localの後に、基準点からカメラまでの差だけ移動する）
+     */
+    Affine2D WorldPoint::place(const Affine2D& local, const WorldPoint& eye) const
+    {
+        return local * Affine2D::translate(this->relativeTo(eye));
+    }
+}
+
+namespace my {
+    /**
+     * @brief WorldPointクラスのテストコードを実行
+     * 
+     * @par 詳細
+     *      原点から遠い座標で、単精度のワールド座標を経由する場合に失われる精度が、カメラ相対では保たれることを確認する。
+     */
+    bool testcode_WorldPoint()
+    {
+        std::cout << "[testcode_WorldPoint()] call" << std::endl;
+        bool ok = true;
+        const auto check = [&](const std::string& name, const bool result) {
+            std::cout << "* " << name << (result ? " .. OK" : " .. NG") << std::endl;
+            ok = result && ok;
+        };
+        const auto nearly = [](const Vertex& a, const float x, const float y) {
+            return (std::fabs(a.x() - x) <= 1.0e-5F) && (std::fabs(a.y() - y) <= 1.0e-5F);
+        };
+
+        // 原点から1e7離れた基準点（単精度の間隔は1）
+        const WorldPoint origin(1.0e7 + 0.25, -2.0e7 + 0.5);
+        const WorldPoint eye(1.0e7, -2.0e7);
+        const Vertex v(0.125F, 0.375F, 0.0F);
+        // 単精度のワールド座標を経由すると、基準点の端数と頂点の位置が失われる
+        const Vertex world = origin.place(Affine2D::identity(), WorldPoint()).apply(v);
+        const Vertex far(world.x() - eye.toVertex().x(), world.y() - eye.toVertex().y(), 0.0F);
+        check("float world loses precision", !nearly(far, 0.375F, 0.875F));
+        // カメラ相対では保たれる
+        check("relative", nearly(origin.place(Affine2D::identity(), eye).apply(v), 0.375F, 0.875F));
+        check("relative scaled", nearly(origin.place(Affine2D::scale({ 2.0F, 2.0F, 1.0F }), eye).apply(v), 0.5F, 1.25F));
+        // カメラを少しずつ移動しても、カメラ相対の位置は移動量どおりに変わる（揺れない）
+        bool steady = true;
+        WorldPoint moving = eye;
+        for (std::int32_t i = 1; i <= 100; i++) {
+            moving += Vector(0.01F, -0.01F, 0.0F);
+            const Vertex p = origin.place(Affine2D::identity(), moving).apply(v);
+            const double ex = (origin.x() + 0.125) - moving.x();
+            const double ey = (origin.y() + 0.375) - moving.y();
+            steady = steady && (std::fabs(static_cast<double>(p.x()) - ex) <= 1.0e-5) && (std::fabs(static_cast<double>(p.y()) - ey) <= 1.0e-5);
+        }
+        check("steady camera move", steady);
+        // 差を加えると元の座標に戻る
+        const WorldPoint back = eye + origin.relativeTo(eye);
+        check("round trip", (std::fabs(back.x() - origin.x()) <= 1.0e-6) && (std::fabs(back.y() - origin.y()) <= 1.0e-6));
+        check("vector", (std::fabs(WorldPoint(Vector(3.0F, -4.0F, 5.0F)).y() + 4.0) <= 1.0e-12));
+        return ok;
+    }
+}
@@ -0,0 +1,64 @@
+﻿/**
+ * @file WorldPoint.hpp
+ * @author kota-kota
+ * @brief 倍精度のワールド座標を扱うクラスの定義
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2020
+ */
+#ifndef INCLUDED_WORLDPOINT_HPP
+#define INCLUDED_WORLDPOINT_HPP
+
+#include "Matrix.hpp"
+#include "Vertex.hpp"
+#include "Affine2D.hpp"
+
+namespace my {
+    /**
+     * @class WorldPoint
+     * @brief XY平面上の倍精度のワールド座標（描画物の基準点・カメラの位置）を扱うクラス
+     * 
+     * @par 詳細
+     *      原点から遠い座標を単精度で扱うと、頂点が丸められて重なり、カメラの移動で揺れる。
+     *      基準点・カメラの位置は倍精度で保持し、基準点からカメラまでの差を倍精度で求めてから単精度に変換する。
+     *      GPUには、カメラを原点とした小さな単精度の座標のみを渡す（カメラ相対の描画）。
+     */
+    class WorldPoint {
+        double  m_x;    //!< X座標
+        double  m_y;    //!< Y座標
+
+    public:
+        //! デフォルトコンストラクタ（原点）
+        WorldPoint();
+        //! コンストラクタ
+        WorldPoint(const double x, const double y);
+        //! コンストラクタ（単精度のベクトルのXY）
+        explicit WorldPoint(const Vector& v);
+
+    public:
+        //! X座標を取得
+        double x() const;
+        //! Y座標を取得
+        double y() const;
+        //! +演算子のオーバーロード（移動）
+        WorldPoint operator+(const Vector& v) const;
+        //! +=演算子のオーバーロード（移動）
+        WorldPoint& operator+=(const Vector& v);
+
+    public:
+        //! 基準点からの差（単精度）を取得
+        Vector relativeTo(const WorldPoint& eye) const;
+        //! 単精度に丸めた座標を取得（外接矩形・判定用）
+        Vertex toVertex() const;
+        //! 自身を基準点とする配置を、カメラを原点とする配置に変換
+        Affine2D place(const Affine2D& local, const WorldPoint& eye) const;
+    };
+}
+
+namespace my {
+    //! WorldPointクラスのテストコードを実行
+    bool testcode_WorldPoint();
+}
+
+#endif //INCLUDED_WORLDPOINT_HPP
@@ -1,14 +1,39 @@
 ﻿#include "Vertex.hpp"
 #include "Matrix.hpp"
+#include "Affine2D.hpp"
 #include "GlobalDrawer.hpp"
+#include "DirtyRange.hpp"
+#include "Stroke.hpp"
+#include "Triangulator.hpp"
+#include "Curve.hpp"
+#include "Lod.hpp"
+#include "SpatialIndex.hpp"
+#include "CullKernel.hpp"
+#include "Picker.hpp"
+#include "SceneGraph.hpp"
+#include "WorldPoint.hpp"
+#include "MeshOptimizer.hpp"
+#include "StripBatch.hpp"
+#include "SceneFile.hpp"
+#include "TileManager.hpp"
+#include "Primitive.hpp"
+#include "MatrixKernel.hpp"
+#include "VertexCodec.hpp"
 
 #include <GLFW/glfw3.h>
 #include <GL/glew.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
 
 namespace {
     //! ウインドウタイトル・幅・高さ
@@ -19,6 +44,14 @@ namespace {
     //! 初期拡大率
     //! 拡大率 = オブジェクトの座標系に対するデバイス座標系の拡大率
     constexpr float DEFSCALE = 1.0F;
+    //! 拡大率の範囲と、マウスホイール1段あたりの倍率
+    constexpr float MIN_SCALE = 0.25F;
+    constexpr float MAX_SCALE = 8.0F;
+    constexpr float ZOOM_STEP = 1.25F;
+
+    // ピッキング
+    constexpr float PICK_TOLERANCE = 4.0F;      //!< 点・線と一致とみなす画面上の距離[pixel]
+    constexpr std::uint32_t PICK_NONE = 0xFFFFFFFFU;    //!< 一致する描画物なし
 
     //! 初期クリア色(RGBA)
     constexpr std::uint8_t DEFCOLOR[4] = { 200, 200, 200, 255 };
@@ -27,9 +60,10 @@ namespace {
     constexpr double FPS = 30.0;
 
     //! 線描画
-    const my::Vector LINES_POS = {80.0F, 80.0F, 0.0F};
-    const my::Vector LINE_STRIP_POS = {220.0F, 80.0F, 0.0F};
-    const my::Vector LINE_LOOP_POS = {360.0F, 80.0F, 0.0F};
+    constexpr my::Vector LINES_POS = {80.0F, 80.0F, 0.0F};
+    constexpr my::Vector LINE_STRIP_POS = {220.0F, 80.0F, 0.0F};
+    constexpr my::Vector LINE_LOOP_POS = {360.0F, 80.0F, 0.0F};
+    constexpr float LINE_WIDTH = 5.0F;
     const my::Vertexes LINE_V = {
         { -40.0F, -40.0F },
         { -20.0F, 20.0F },
@@ -38,9 +72,6 @@ namespace {
         { 40.0F, -40.0F },
         { 60.0F, 20.0F }
     };
-    const my::Indexes LINE_I = {
-        0U, 1U, 2U, 3U, 4U, 5U
-    };
     const my::Colors LINE_C = {
         { 255, 0, 0, 255 },
         { 0, 255, 0, 255 },
@@ -51,9 +82,9 @@ namespace {
     };
 
     //! 面描画
-    const my::Vector TRIANGLES_POS = {500.0F, 80.0F, 0.0F};
-    const my::Vector TRIANGLE_STRIP_POS = {640.0F, 80.0F, 0.0F};
-    const my::Vector TRIANGLE_FAN_POS = {780.0F, 80.0F, 0.0F};
+    constexpr my::Vector TRIANGLES_POS = {500.0F, 80.0F, 0.0F};
+    constexpr my::Vector TRIANGLE_STRIP_POS = {640.0F, 80.0F, 0.0F};
+    constexpr my::Vector TRIANGLE_FAN_POS = {780.0F, 80.0F, 0.0F};
     const my::Vertexes TRIANGLE_V = {
         { -40.0F, -40.0F },
         { -20.0F, 20.0F },
@@ -75,7 +106,7 @@ namespace {
     };
 
     //! 点描画
-    const my::Vector POINTS_POS = {920.0F, 80.0F, 0.0F};
+    constexpr my::Vector POINTS_POS = {920.0F, 80.0F, 0.0F};
     const my::Vertexes POINT_V = {
         { -40.0F, -40.0F },
         { -20.0F, 20.0F },
@@ -87,6 +118,7 @@ namespace {
     const my::Indexes POINT_I = {
         0U, 1U, 2U, 3U, 4U, 5U
     };
+    constexpr std::size_t POINT_MOVE_IDX = 5U;  //!< 毎フレーム位置を更新する点
     const my::Colors POINT_C = {
         { 255, 0, 0, 255 },
         { 0, 255, 0, 255 },
@@ -96,42 +128,270 @@ namespace {
         { 255, 0, 255, 255 },
     };
 
+    //! ストリーム描画（毎フレーム頂点を更新する）
+    constexpr my::Vector WAVE_POS = {1060.0F, 80.0F, 0.0F};
+    constexpr std::int32_t WAVE_NUM = 64;
+    constexpr float WAVE_W = 120.0F;
+    constexpr float WAVE_H = 40.0F;
+    constexpr float WAVE_MITER_LIMIT = 1000.0F;  //!< 接続部を常にマイターとし、頂点数を一定に保つ
+
+    //! 多角形描画（穴あり）
+    constexpr my::Vector POLYGON_POS = {1200.0F, 80.0F, 0.0F};
+    const my::Vertexes POLYGON_OUTER = {
+        { -50.0F, -50.0F }, { 0.0F, -30.0F }, { 50.0F, -50.0F }, { 40.0F, 0.0F },
+        { 50.0F, 50.0F }, { 0.0F, 30.0F }, { -50.0F, 50.0F }, { -40.0F, 0.0F },
+    };
+    const my::Vertexes POLYGON_HOLE = {
+        { -15.0F, -15.0F }, { 15.0F, -15.0F }, { 15.0F, 15.0F }, { -15.0F, 15.0F },
+    };
+    const my::Color POLYGON_C = { 0, 128, 128, 255 };
+
+    //! 曲線描画（拡大率に応じて分割数を変える）
+    constexpr my::Vector CURVE_POS = {640.0F, 420.0F, 0.0F};
+    constexpr float CURVE_TOLERANCE = 0.25F;    //!< 曲線と折れ線の許容誤差[pixel]
+    const my::Color CURVE_C = { 128, 0, 128, 255 };
+    const my::Color RING_C = { 255, 128, 0, 255 };
+
+    //! 詳細度（LOD）付きの描画（拡大率に応じて描画する頂点インデックスの範囲を切り替える）
+    constexpr my::Vector COAST_POS = {1000.0F, 600.0F, 0.0F};
+    constexpr my::Vector ISLAND_POS = {1000.0F, 420.0F, 0.0F};
+    constexpr std::int32_t COAST_NUM = 4000;
+    constexpr std::int32_t ISLAND_NUM = 3000;
+    constexpr float LOD_TOLERANCE = 0.5F;       //!< 簡略化による画面上の許容誤差[pixel]
+    constexpr float LOD_BASE_TOLERANCE = 0.125F;    //!< 段1の許容誤差（オブジェクトの座標系）
+    constexpr float LOD_RATIO = 4.0F;           //!< 段毎の許容誤差の倍率
+    constexpr std::int32_t LOD_LEVELS = 5;      //!< 段数の上限
+    const my::Color COAST_C = { 0, 0, 128, 255 };
+
+    // 多数の短いストリップ（プリミティブリスタートで1回の描画にまとめる）
+    constexpr my::Vector CONTOUR_POS = {300.0F, 500.0F, 0.0F};
+    constexpr std::int32_t CONTOUR_COLS = 60;
+    constexpr std::int32_t CONTOUR_ROWS = 30;
+    constexpr std::int32_t CONTOUR_POINTS = 8;     //!< ストリップあたりの頂点数
+    constexpr float CONTOUR_PITCH = 6.0F;
+    const my::Color CONTOUR_C = { 96, 64, 32, 255 };
+    const my::Color ISLAND_C = { 0, 160, 0, 255 };
+
+    // 基本図形の多数配置（単位形状を共有し、インスタンス描画で種類毎に1回で描画する）
+    constexpr my::Vector BADGE_POS = {640.0F, 300.0F, 0.0F};
+    constexpr std::int32_t BADGE_COLS = 160;
+    constexpr float BADGE_PITCH = 7.0F;
+    constexpr float BADGE_TOLERANCE = 0.25F;    //!< 円周と折れ線の許容誤差[pixel]
+
+    // タイルに分割した背景（表示範囲に応じて読み込み・破棄する）
+    const my::Aabb TILE_WORLD(-8192.0F, -8192.0F, 8192.0F, 8192.0F);   //!< ワールドの範囲
+    constexpr std::uint32_t TILE_MAX_LEVEL = 5U;    //!< 最も細かい段
+    constexpr float TILE_PIXELS = 256.0F;           //!< 段を選ぶ際のタイルの表示サイズの上限[pixel]
+    constexpr std::uint32_t TILE_CELLS = 16U;       //!< タイルあたりの列・行の区画数
+    constexpr std::size_t TILE_BUDGET_MB = 64U;     //!< GPUメモリの使用量の上限の初期値[MiB]
+    constexpr std::size_t TILE_UPLOAD_LIMIT = 1024U * 1024U;    //!< 1フレームで転送するGPUメモリの上限[byte]
+    constexpr std::uint32_t TILE_COMPRESSION_BITS = 16U;        //!< タイルの頂点座標の量子化ビット数
+
     //! テキスト描画
     const std::wstring TEXT_ASCII = L"abcdefghijklmnopqrstuvwxyz";
-    const my::Vector TEXT_ASCII_POS = { 350.0F, 160.0F, 0.0F };
+    constexpr my::Vector TEXT_ASCII_POS = { 350.0F, 160.0F, 0.0F };
     const my::Color TEXT_ASCII_C = { 255, 0, 0, 255 };
     const std::int32_t TEXT_ASCII_SZ = 32;
 
     const std::wstring TEXT_KANA = L"さんぷる　サンプル　ｻﾝﾌﾟﾙ";
-    const my::Vector TEXT_KANA_POS = { 180.0F, 200.0F, 0.0F };
+    constexpr my::Vector TEXT_KANA_POS = { 180.0F, 200.0F, 0.0F };
     const my::Color TEXT_KANA_C = { 255, 255, 0, 255 };
     const std::int32_t TEXT_KANA_SZ = 16;
 
     const std::wstring TEXT_BOLD = L"太字Bold";
-    const my::Vector TEXT_BOLD_POS = { 100.0F, 230.0F, 0.0F };
+    constexpr my::Vector TEXT_BOLD_POS = { 100.0F, 230.0F, 0.0F };
     const my::Color TEXT_BOLD_C = { 0, 0, 255, 255 };
     const std::int32_t TEXT_BOLD_SZ = 16;
 }
 
+namespace {
+    //! GL_LINES相当の太線（2頂点ずつ独立した線分）を作成
+    my::Stroke makeLinesStroke(const my::Vertexes& vertexes, const my::Colors& colors)
+    {
+        my::Stroke stroke;
+        const my::Stroker stroker(LINE_WIDTH, my::Stroker::JOIN::MITER, my::Stroker::CAP::BUTT);
+        for (std::size_t i = 1U; i < vertexes.size(); i += 2U) {
+            stroker.stroke({ vertexes[i - 1U], vertexes[i] }, { colors[i - 1U], colors[i] }, false, stroke);
+        }
+        return stroke;
+    }
+
+    //! GL_LINE_STRIP、GL_LINE_LOOP相当の太線を作成
+    my::Stroke makeLineStripStroke(const my::Vertexes& vertexes, const my::Colors& colors, const my::Stroker::JOIN join, const bool closed)
+    {
+        my::Stroke stroke;
+        my::Stroker(LINE_WIDTH, join, my::Stroker::CAP::ROUND).stroke(vertexes, colors, closed, stroke);
+        return stroke;
+    }
+
+    //! 線描画（太線）
+    const my::Stroke LINES_S = makeLinesStroke(LINE_V, LINE_C);
+    const my::Stroke LINE_STRIP_S = makeLineStripStroke(LINE_V, LINE_C, my::Stroker::JOIN::MITER, false);
+    const my::Stroke LINE_LOOP_S = makeLineStripStroke(LINE_V, LINE_C, my::Stroker::JOIN::ROUND, true);
+
+    //! 多角形描画（三角形分割）
+    const my::Polygon POLYGON = my::Polygon(POLYGON_OUTER, { POLYGON_HOLE });
+    const my::Vertexes POLYGON_V = POLYGON.vertexes();
+    const my::Indexes POLYGON_I = my::Triangulator(1U).triangulate(POLYGON);
+    const my::Colors POLYGON_CS = my::Colors(POLYGON_V.size(), POLYGON_C);
+
+    //! 詳細度付きの太線
+    struct LodStroke {
+        my::Stroke      stroke;     //!< 全段の太線
+        my::LodLevels   lods;       //!< 詳細度の段
+    };
+
+    //! 詳細度付きの多角形
+    struct LodPolygon {
+        my::Vertexes    vertexes;   //!< 頂点座標の並び（全段で共有）
+        my::Indexes     indexes;    //!< 全段の頂点インデックス
+        my::LodLevels   lods;       //!< 詳細度の段
+    };
+
+    //! 細かな凹凸のある値（海岸線の形状の代わり）
+    float roughness(const float t)
+    {
+        return (std::sin(t * 3.0F) * 0.5F) + (std::sin(t * 17.0F) * 0.2F) + (std::sin(t * 71.0F) * 0.08F) + (std::sin(t * 293.0F) * 0.03F);
+    }
+
+    //! 頂点数の多い線の詳細度付き太線を作成
+    LodStroke makeCoastStroke()
+    {
+        my::Vertexes vertexes;
+        for (std::int32_t i = 0; i < COAST_NUM; i++) {
+            const float t = static_cast<float>(i) / static_cast<float>(COAST_NUM - 1);
+            vertexes.push_back({ (t - 0.5F) * 240.0F, roughness(t * 6.0F) * 40.0F });
+        }
+        my::Stroke stroke;
+        const my::LodBuilder builder(LOD_BASE_TOLERANCE, LOD_RATIO, LOD_LEVELS);
+        const my::LodLevels lods = builder.stroke(vertexes, my::Colors(vertexes.size(), COAST_C), false, my::Stroker(2.0F, my::Stroker::JOIN::BEVEL, my::Stroker::CAP::BUTT), stroke);
+        return { stroke, lods };
+    }
+
+    //! 頂点数の多い多角形の詳細度付き頂点インデックスを作成
+    LodPolygon makeIsland()
+    {
+        my::Vertexes outer;
+        for (std::int32_t i = 0; i < ISLAND_NUM; i++) {
+            const float a = static_cast<float>(i) * 2.0F * my::MATRIX_PI / static_cast<float>(ISLAND_NUM);
+            const float r = 60.0F + (roughness(a * 2.0F) * 20.0F);
+            outer.push_back({ r * std::cos(a), r * std::sin(a) });
+        }
+        const my::Polygon polygon(outer);
+        my::Indexes indexes;
+        const my::LodBuilder builder(LOD_BASE_TOLERANCE, LOD_RATIO, LOD_LEVELS);
+        const my::LodLevels lods = builder.polygon(polygon, my::Triangulator(1U), indexes);
+
+        // 段毎に三角形を頂点キャッシュ順に並べ替え、頂点を参照順に並べ替える
+        my::Vertexes vertexes = polygon.vertexes();
+        const my::MeshOptimizer optimizer;
+        for (std::size_t i = 0U; i < lods.size(); i++) {
+            const my::Lod& lod = lods.at(i);
+            const float before = optimizer.acmr(indexes, vertexes.size(), lod.first(), lod.count());
+            optimizer.optimizeCache(indexes, vertexes.size(), lod.first(), lod.count());
+            std::cout << "[makeIsland()] lod:" << i << " acmr:" << before << " -> " << optimizer.acmr(indexes, vertexes.size(), lod.first(), lod.count()) << std::endl;
+        }
+        optimizer.optimizeFetch(vertexes, indexes);
+        return { vertexes, indexes, lods };
+    }
+
+    //! 多数の短い等高線をまとめたストリップを作成
+    my::StripBatch makeContours()
+    {
+        my::StripBatch batch;
+        const my::Colors colors(CONTOUR_POINTS, CONTOUR_C);
+        for (std::int32_t r = 0; r < CONTOUR_ROWS; r++) {
+            for (std::int32_t c = 0; c < CONTOUR_COLS; c++) {
+                const float cx = (static_cast<float>(c) - (static_cast<float>(CONTOUR_COLS) / 2.0F)) * CONTOUR_PITCH;
+                const float cy = (static_cast<float>(r) - (static_cast<float>(CONTOUR_ROWS) / 2.0F)) * CONTOUR_PITCH;
+                my::Vertexes vertexes;
+                for (std::int32_t i = 0; i < CONTOUR_POINTS; i++) {
+                    const float t = static_cast<float>(i) / static_cast<float>(CONTOUR_POINTS - 1);
+                    vertexes.push_back({ cx + (t * CONTOUR_PITCH * 0.8F), cy + (roughness(cx + cy + (t * 4.0F)) * CONTOUR_PITCH * 0.4F) });
+                }
+                batch.add(vertexes, colors);
+            }
+        }
+        return batch;
+    }
+
+    //! 詳細度付きの描画
+    const LodStroke COAST_S = makeCoastStroke();
+    const LodPolygon ISLAND_P = makeIsland();
+
+    //! 多数の短いストリップの描画
+    const my::StripBatch CONTOUR_B = makeContours();
+}
+
+namespace {
+    //! 描画物
+    class Drawable {
+    public:
+        //! デフォルトコンストラクタ
+        Drawable() = default;
+        //! デストラクタ
+        virtual ~Drawable() = default;
+        //! コピーコンストラクタによるコピー禁止
+        Drawable(const Drawable& org) = delete;
+        //! 代入によるコピー禁止
+        Drawable& operator=(const Drawable& org) = delete;
+
+    public:
+        //! 描画（カメラを原点とする座標系で描画する）
+        virtual void draw(const my::WorldPoint& eye, const my::GpuMatrix& view, const my::GpuMatrix& proj) = 0;
+        //! 配置の基準点（倍精度）と基準点からの配置を設定
+        virtual void setModel(const my::WorldPoint& origin, const my::Affine2D& model) = 0;
+        //! 配置を反映した外接矩形を取得
+        virtual my::Aabb bounds() const = 0;
+        //! 判定用の図形要素を追加
+        virtual void collect(my::Picker& picker, const std::uint32_t id) const = 0;
+    };
+}
+
 namespace {
     //! 形状
-    class Shape {
+    class Shape : public Drawable {
+    public:
+        //! 転送後の頂点データの保持方法
+        //! KEEP:そのまま保持する DROP:破棄する COMPRESS:量子化した頂点座標と頂点インデックスのみ保持する（ピッキング用）
+        enum class RESIDENCY { KEEP, DROP, COMPRESS };
+
+    private:
         GLuint          m_vao;          //!< 頂点配列オブジェクト
         GLuint          m_vertex_vbo;   //!< 頂点用のバッファオブジェクト
         GLuint          m_index_vbo;    //!< 頂点インデックス用のバッファオブジェクト
         GLenum          m_mode;         //!< 描画モード
-        my::Vertexes    m_vertexes;     //!< 頂点座標の並び
-        my::Indexes     m_indexes;      //!< 頂点インデックスの並び
-        my::Colors      m_colors;       //!< 頂点色の並び
-        my::Vector      m_pos;          //!< 描画位置
-        my::Vector      m_scale;        //!< 描画スケール
+        RESIDENCY       m_residency;    //!< 転送後の頂点データの保持方法
+        my::Vertexes    m_vertexes;     //!< 頂点座標の並び（RESIDENCY::KEEPのみ）
+        my::Indexes     m_indexes;      //!< 頂点インデックスの並び（RESIDENCY::DROP以外）
+        my::Colors      m_colors;       //!< 頂点色の並び（RESIDENCY::KEEPのみ）
+        my::QuantizedVertexes   m_quantized;    //!< 量子化した頂点座標の並び（RESIDENCY::COMPRESSのみ）
+        std::size_t     m_vertex_num;   //!< 頂点数
+        std::size_t     m_index_num;    //!< 頂点インデックス数
+        GLenum          m_index_type;   //!< 頂点インデックスの型（頂点数が16bitに収まる場合はGL_UNSIGNED_SHORT）
+        GLintptr        m_color_offset; //!< バッファオブジェクト内の色データのオフセット
+        my::WorldPoint  m_origin;       //!< 配置の基準点（ワールド座標系、倍精度）
+        my::Affine2D    m_model;        //!< 基準点からの配置
+        std::uint32_t   m_stream_frame; //!< リングバッファへ頂点を書き込んだフレーム番号
+        GLintptr        m_stream_voffset;   //!< リングバッファ内の頂点データのオフセット
+        GLintptr        m_stream_coffset;   //!< リングバッファ内の色データのオフセット
+        my::DirtyRanges m_dirty_vertexes;   //!< 未転送の頂点座標の更新範囲
+        my::DirtyRanges m_dirty_colors;     //!< 未転送の頂点色の更新範囲
+        my::LodLevels   m_lods;         //!< 詳細度の段（空の場合は頂点インデックス全体を描画）
+        std::size_t     m_draw_first;   //!< 描画する頂点インデックスの先頭位置
+        std::size_t     m_draw_count;   //!< 描画する頂点インデックス数
+        my::Aabb        m_bounds;       //!< 頂点座標の外接矩形
 
     public:
         //! コンストラクタ
-        Shape(const GLenum mode, const my::Vertexes& vertexes, const my::Indexes& indexes, const my::Colors& colors) :
+        Shape(const GLenum mode, const my::Vertexes& vertexes, const my::Indexes& indexes, const my::Colors& colors, const RESIDENCY residency = RESIDENCY::KEEP) :
             m_vao(0U), m_vertex_vbo(0U), m_index_vbo(0U),
-            m_mode(mode), m_vertexes(vertexes), m_indexes(indexes), m_colors(colors),
-            m_pos({0.0F, 0.0F, 0.0F}), m_scale({1.0F, 1.0F, 1.0F})
+            m_mode(mode), m_residency(residency), m_vertexes(), m_indexes(), m_colors(), m_quantized(),
+            m_vertex_num(vertexes.size()), m_index_num(indexes.size()), m_index_type(GL_UNSIGNED_INT),
+            m_color_offset(static_cast<GLintptr>(vertexes.size() * sizeof(my::Vertex))),
+            m_origin(), m_model(),
+            m_stream_frame(0U), m_stream_voffset(-1), m_stream_coffset(-1),
+            m_dirty_vertexes(), m_dirty_colors(), m_lods(), m_draw_first(0U), m_draw_count(indexes.size()), m_bounds()
         {
             std::cout << "[Shape::Shape()] call" << std::endl;
             // 頂点配列オブジェクトを作成する
@@ -141,28 +401,33 @@ namespace {
 
             // 頂点用のバッファオブジェクトを作成する
             glGenBuffers(1, &this->m_vertex_vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
-            const std::int32_t vsize = static_cast<std::int32_t>(vertexes.size() * sizeof(my::Vertex));
-            const std::int32_t csize = static_cast<std::int32_t>(colors.size() * sizeof(my::Color));
-            glBufferData(GL_ARRAY_BUFFER, vsize * csize, nullptr, GL_DYNAMIC_DRAW);
+            // 頂点インデックス用のバッファオブジェクトを作成する
+            glGenBuffers(1, &this->m_index_vbo);
+
             // 頂点データを転送する
-            glBufferSubData(GL_ARRAY_BUFFER, 0, vsize, &vertexes[0]);
-            // 色データを転送する
-            glBufferSubData(GL_ARRAY_BUFFER, vsize, csize, &colors[0]);
-            std::cout << "* VBO(Vertex) id:" << m_vertex_vbo << " vertex size:" << vsize << " color size:" << csize << std::endl;
+            this->upload(vertexes, indexes, colors);
+        }
 
-            // 頂点インデックス用のバッファオブジェクトを作成する
+        //! コンストラクタ（シーンファイルの形状の頂点データをコピーせずに転送し、CPU側には保持しない）
+        explicit Shape(const my::SceneShape& shape) :
+            m_vao(0U), m_vertex_vbo(0U), m_index_vbo(0U),
+            m_mode(static_cast<GLenum>(shape.mode())), m_residency(RESIDENCY::DROP), m_vertexes(), m_indexes(), m_colors(), m_quantized(),
+            m_vertex_num(shape.vertexNum()), m_index_num(shape.indexNum()), m_index_type(GL_UNSIGNED_INT),
+            m_color_offset(static_cast<GLintptr>(shape.vertexNum() * sizeof(my::Vertex))),
+            m_origin(shape.pos()), m_model(),
+            m_stream_frame(0U), m_stream_voffset(-1), m_stream_coffset(-1),
+            m_dirty_vertexes(), m_dirty_colors(), m_lods(), m_draw_first(0U), m_draw_count(shape.indexNum()), m_bounds()
+        {
+            std::cout << "[Shape::Shape()] scene shape:" << shape.name() << std::endl;
+            glGenVertexArrays(1, &this->m_vao);
+            glGenBuffers(1, &this->m_vertex_vbo);
             glGenBuffers(1, &this->m_index_vbo);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->m_index_vbo);
-            const std::int32_t isize = static_cast<std::int32_t>(indexes.size() * sizeof(GLuint));
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, isize, nullptr, GL_DYNAMIC_DRAW);
-            // 頂点インデックスデータを転送する
-            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, isize, &indexes[0]);
-            std::cout << "* VBO(Index) id:" << m_index_vbo << "index size:" << isize << std::endl;
+            const GLenum index_type = (shape.indexSize() == sizeof(GLushort)) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+            this->transfer(shape.vertexes(), shape.colors(), shape.vertexNum(), shape.indexes(), shape.indexNum(), index_type);
         }
 
         //! デストラクタ
-        ~Shape()
+        ~Shape() override
         {
             std::cout << "[Shape::~Shape()] call" << std::endl;
             // 頂点配列オブジェクトを破棄する
@@ -178,21 +443,282 @@ namespace {
         //! 代入によるコピー禁止
         Shape& operator=(const Shape& org) = delete;
 
+    private:
+        //! 頂点データを確保し直して転送
+        void transfer(const my::Vertex* vertexes, const my::Color* colors, const std::size_t vertex_num, const void* indexes, const std::size_t index_num, const GLenum index_type)
+        {
+            this->m_vertex_num = vertex_num;
+            this->m_index_num = index_num;
+            this->m_index_type = index_type;
+            this->m_color_offset = static_cast<GLintptr>(vertex_num * sizeof(my::Vertex));
+            this->m_stream_frame = 0U;
+            this->m_dirty_vertexes.clear();
+            this->m_dirty_colors.clear();
+            this->m_lods = my::LodLevels();
+            this->m_draw_first = 0U;
+            this->m_draw_count = index_num;
+            this->m_bounds = my::Aabb::of(vertexes, vertex_num);
+
+            glBindVertexArray(this->m_vao);
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
+            const std::int32_t vsize = static_cast<std::int32_t>(vertex_num * sizeof(my::Vertex));
+            const std::int32_t csize = static_cast<std::int32_t>(vertex_num * sizeof(my::Color));
+            glBufferData(GL_ARRAY_BUFFER, vsize + csize, nullptr, GL_DYNAMIC_DRAW);
+            // 頂点データを転送する
+            glBufferSubData(GL_ARRAY_BUFFER, 0, vsize, vertexes);
+            // 色データを転送する
+            glBufferSubData(GL_ARRAY_BUFFER, vsize, csize, colors);
+            std::cout << "* VBO(Vertex) id:" << m_vertex_vbo << " vertex size:" << vsize << " color size:" << csize << std::endl;
+
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->m_index_vbo);
+            const std::int32_t isize = static_cast<std::int32_t>(index_num * this->indexSize());
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, isize, nullptr, GL_DYNAMIC_DRAW);
+            // 頂点インデックスデータを転送する
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, isize, indexes);
+            std::cout << "* VBO(Index) id:" << m_index_vbo << "index size:" << isize << std::endl;
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+
+        //! 頂点データを確保し直して転送し、保持方法に従って保持
+        void upload(const my::Vertexes& vertexes, const my::Indexes& indexes, const my::Colors& colors)
+        {
+            // 頂点数が16bitに収まる場合は、頂点インデックスを16bitに変換して転送する（リスタート値も変換する）
+            if (my::StripBatch::fits16(vertexes.size())) {
+                const my::Indexes16 narrow = my::StripBatch::narrow(indexes);
+                this->transfer(&vertexes[0], &colors[0], vertexes.size(), &narrow[0], narrow.size(), GL_UNSIGNED_SHORT);
+            }
+            else {
+                this->transfer(&vertexes[0], &colors[0], vertexes.size(), &indexes[0], indexes.size(), GL_UNSIGNED_INT);
+            }
+
+            // 転送後の頂点データを保持方法に従って保持する
+            this->m_vertexes.clear();
+            this->m_indexes.clear();
+            this->m_colors.clear();
+            this->m_quantized = my::QuantizedVertexes();
+            switch (this->m_residency) {
+            case RESIDENCY::KEEP:
+                this->m_vertexes = vertexes;
+                this->m_indexes = indexes;
+                this->m_colors = colors;
+                break;
+            case RESIDENCY::COMPRESS:
+                this->m_quantized = my::QuantizedVertexes(vertexes);
+                this->m_indexes = indexes;
+                break;
+            case RESIDENCY::DROP:
+            default:
+                break;
+            }
+        }
+
+        //! 頂点インデックス1個のバイト数を取得
+        std::size_t indexSize() const { return (this->m_index_type == GL_UNSIGNED_SHORT) ? sizeof(GLushort) : sizeof(GLuint); }
+
+    public:
+        //! 頂点数の異なる頂点データに置き換え（バッファオブジェクトは確保し直す）
+        void assign(const my::Vertexes& vertexes, const my::Indexes& indexes, const my::Colors& colors)
+        {
+            std::cout << "[Shape::assign()] call" << std::endl;
+            this->upload(vertexes, indexes, colors);
+        }
+
+        //! GPUメモリの使用量を取得
+        std::size_t gpuSize() const
+        {
+            return (this->m_vertex_num * (sizeof(my::Vertex) + sizeof(my::Color))) + (this->m_index_num * this->indexSize());
+        }
+
     public:
-        //! 描画位置の設定
-        void setPosition(const my::Vector& pos) { this->m_pos = pos; }
+        //! 配置の基準点（倍精度）と基準点からの配置を設定
+        void setModel(const my::WorldPoint& origin, const my::Affine2D& model) override
+        {
+            this->m_origin = origin;
+            this->m_model = model;
+        }
+
+        //! 配置を反映した外接矩形を取得
+        my::Aabb bounds() const override { return this->m_bounds.transform(this->m_origin.place(this->m_model, my::WorldPoint())); }
+
+        //! 判定用の図形要素を追加（RESIDENCY::DROPの場合は頂点データがないため追加しない）
+        //! 詳細度の段がある場合は、選択中の段の頂点インデックスの範囲のみ追加する（段同士は連結していないため）
+        void collect(my::Picker& picker, const std::uint32_t id) const override
+        {
+            my::Picker::TOPOLOGY topology = my::Picker::TOPOLOGY::TRIANGLES;
+            switch (this->m_mode) {
+            case GL_POINTS:         topology = my::Picker::TOPOLOGY::POINTS; break;
+            case GL_LINES:          topology = my::Picker::TOPOLOGY::LINES; break;
+            case GL_LINE_STRIP:     topology = my::Picker::TOPOLOGY::LINE_STRIP; break;
+            case GL_LINE_LOOP:      topology = my::Picker::TOPOLOGY::LINE_LOOP; break;
+            case GL_TRIANGLE_STRIP: topology = my::Picker::TOPOLOGY::TRIANGLE_STRIP; break;
+            case GL_TRIANGLE_FAN:   topology = my::Picker::TOPOLOGY::TRIANGLE_FAN; break;
+            case GL_TRIANGLES:
+            default:
+                break;
+            }
+            const my::Affine2D world = this->m_origin.place(this->m_model, my::WorldPoint());
+            my::Indexes drawn;
+            if (!this->m_lods.empty()) {
+                const auto first = this->m_indexes.begin() + static_cast<std::ptrdiff_t>(this->m_draw_first);
+                drawn.assign(first, first + static_cast<std::ptrdiff_t>(this->m_draw_count));
+            }
+            const my::Indexes& indexes = this->m_lods.empty() ? this->m_indexes : drawn;
+            if (this->m_residency == RESIDENCY::KEEP) {
+                picker.add(id, topology, this->m_vertexes, indexes, world);
+            }
+            else if (this->m_residency == RESIDENCY::COMPRESS) {
+                picker.add(id, topology, this->m_quantized.decode(), indexes, world);
+            }
+            else {
+            }
+        }
+
+        //! 詳細度の段を設定（頂点インデックスは全段分を転送済みであること）
+        void setLods(const my::LodLevels& lods)
+        {
+            this->m_lods = lods;
+            (void)this->selectLod(1.0F);
+        }
+
+        //! 拡大率に応じて詳細度の段を選択（描画する頂点インデックスの範囲のみ変更し、変わった場合はtrueを返す）
+        bool selectLod(const float scale)
+        {
+            if (this->m_lods.empty()) {
+                return false;
+            }
+            const my::Lod& lod = this->m_lods.select(scale, LOD_TOLERANCE);
+            const bool changed = (this->m_draw_first != lod.first()) || (this->m_draw_count != lod.count());
+            this->m_draw_first = lod.first();
+            this->m_draw_count = lod.count();
+            return changed;
+        }
+
+        //! 頂点座標の一部を更新（RESIDENCY::KEEPの場合、転送は次の描画の直前にまとめて行う）
+        bool updateVertices(const std::size_t first, const my::Vertexes& vertexes)
+        {
+            if ((vertexes.empty()) || ((first + vertexes.size()) > this->m_vertex_num)) {
+                std::cerr << "[Shape::updateVertices()] out of range first:" << first << " num:" << vertexes.size() << std::endl;
+                return false;
+            }
+            // 外接矩形は縮めずに拡張のみ行う
+            this->m_bounds.extend(my::Aabb::of(vertexes));
+            if (this->m_residency == RESIDENCY::KEEP) {
+                std::copy(vertexes.begin(), vertexes.end(), this->m_vertexes.begin() + static_cast<std::ptrdiff_t>(first));
+                this->m_dirty_vertexes.add(first, vertexes.size());
+                return true;
+            }
+            if (this->m_residency == RESIDENCY::COMPRESS) {
+                for (std::size_t i = 0U; i < vertexes.size(); i++) {
+                    this->m_quantized.set(first + i, vertexes[i]);
+                }
+            }
+            // CPU側に頂点データを保持していないため、直ちに転送する
+            const GLintptr offset = static_cast<GLintptr>(first * sizeof(my::Vertex));
+            const GLsizeiptr size = static_cast<GLsizeiptr>(vertexes.size() * sizeof(my::Vertex));
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
+            glBufferSubData(GL_ARRAY_BUFFER, offset, size, &vertexes[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return true;
+        }
+
+        //! 頂点色の一部を更新（RESIDENCY::KEEPの場合、転送は次の描画の直前にまとめて行う）
+        bool updateColors(const std::size_t first, const my::Colors& colors)
+        {
+            if ((colors.empty()) || ((first + colors.size()) > this->m_vertex_num)) {
+                std::cerr << "[Shape::updateColors()] out of range first:" << first << " num:" << colors.size() << std::endl;
+                return false;
+            }
+            if (this->m_residency == RESIDENCY::KEEP) {
+                std::copy(colors.begin(), colors.end(), this->m_colors.begin() + static_cast<std::ptrdiff_t>(first));
+                this->m_dirty_colors.add(first, colors.size());
+                return true;
+            }
+            // CPU側に頂点データを保持していないため、直ちに転送する
+            const GLintptr offset = this->m_color_offset + static_cast<GLintptr>(first * sizeof(my::Color));
+            const GLsizeiptr size = static_cast<GLsizeiptr>(colors.size() * sizeof(my::Color));
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
+            glBufferSubData(GL_ARRAY_BUFFER, offset, size, &colors[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return true;
+        }
+
+        //! 今フレームの頂点データをリングバッファ経由で転送
+        //! 頂点数は生成時と同じであること（頂点インデックスは生成時のものを使用する）
+        bool stream(const my::Vertexes& vertexes, const my::Colors& colors)
+        {
+            if ((vertexes.size() != this->m_vertex_num) || (colors.size() != this->m_vertex_num)) {
+                std::cerr << "[Shape::stream()] size mismatch vertex:" << vertexes.size() << " color:" << colors.size() << std::endl;
+                return false;
+            }
+            if (vertexes.empty()) {
+                // 転送する頂点がない
+                this->m_stream_frame = 0U;
+                return true;
+            }
+            this->m_bounds = my::Aabb::of(vertexes);
+            my::StreamBuffer& sb = my::GlobalDrawer::instance().getStreamBuffer();
+            const GLsizeiptr vsize = static_cast<GLsizeiptr>(vertexes.size() * sizeof(my::Vertex));
+            const GLsizeiptr csize = static_cast<GLsizeiptr>(colors.size() * sizeof(my::Color));
+            const GLsizeiptr valign = static_cast<GLsizeiptr>(sizeof(float));
+            const GLsizeiptr calign = static_cast<GLsizeiptr>(sizeof(my::Color));
+            // 頂点と色の両方が収まる場合のみリングバッファへ書き込む（片方だけ書き込んで空きを無駄にしない）
+            const bool fits = sb.fits({ { vsize, valign }, { csize, calign } });
+            this->m_stream_voffset = fits ? sb.write(&vertexes[0], vsize, valign) : -1;
+            this->m_stream_coffset = fits ? sb.write(&colors[0], csize, calign) : -1;
+            if ((this->m_stream_voffset < 0) || (this->m_stream_coffset < 0)) {
+                // リングバッファに空きがない場合は、自身のバッファオブジェクトを更新する
+                glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, vsize, &vertexes[0]);
+                glBufferSubData(GL_ARRAY_BUFFER, vsize, csize, &colors[0]);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                this->m_stream_frame = 0U;
+                return true;
+            }
+            this->m_stream_frame = sb.getFrame();
+            return true;
+        }
 
-        //! 描画スケールの設定
-        void setScale(const my::Vector& scale) { this->m_scale = scale; }
+    private:
+        //! 未転送の更新範囲をバッファオブジェクトへ転送
+        void flush()
+        {
+            if (this->m_dirty_vertexes.empty() && this->m_dirty_colors.empty()) {
+                return;
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
+            // 頂点データを転送する（結合済みの範囲毎に1回）
+            for (const my::DirtyRange& r : this->m_dirty_vertexes.ranges()) {
+                const GLintptr offset = static_cast<GLintptr>(r.first() * sizeof(my::Vertex));
+                const GLsizeiptr size = static_cast<GLsizeiptr>(r.count() * sizeof(my::Vertex));
+                glBufferSubData(GL_ARRAY_BUFFER, offset, size, &this->m_vertexes[r.first()]);
+            }
+            // 色データを転送する（結合済みの範囲毎に1回）
+            for (const my::DirtyRange& r : this->m_dirty_colors.ranges()) {
+                const GLintptr offset = this->m_color_offset + static_cast<GLintptr>(r.first() * sizeof(my::Color));
+                const GLsizeiptr size = static_cast<GLsizeiptr>(r.count() * sizeof(my::Color));
+                glBufferSubData(GL_ARRAY_BUFFER, offset, size, &this->m_colors[r.first()]);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            this->m_dirty_vertexes.clear();
+            this->m_dirty_colors.clear();
+        }
 
-        //! 描画
-        void draw(const my::Matrix& view, const my::Matrix& proj)
+    public:
+        //! 描画（カメラを原点とする座標系で描画する）
+        void draw(const my::WorldPoint& eye, const my::GpuMatrix& view, const my::GpuMatrix& proj) override
         {
+            // 未転送の更新範囲を転送
+            this->flush();
+
             // シェーダ取得
             my::ShapeShader shader = my::GlobalDrawer::instance().getShaderBuilder().getShapeShader();
             const GLuint prog = shader.getProgram();
             const GLint modelview_loc = shader.getModelViewLocation();
             const GLint projection_loc = shader.getProjectionLocation();
+            const GLint model_loc = shader.getModelLocation();
+            const GLint translation_loc = shader.getTranslationLocation();
             const GLint pointsize_loc = shader.getPointSizeLocation();
             const GLint pos_loc = shader.getPositionLocation();
             const GLint col_loc = shader.getColorLocation();
@@ -200,34 +726,285 @@ namespace {
             // シェーダプログラムを指定
             glUseProgram(prog);
 
-            // モデルの配置（モデルビュー変換行列）
-            my::Matrix model = my::Matrix::translate(m_pos) * my::Matrix::scale(m_scale);
-            my::Matrix modelview = view * model;
-            modelview.transpose();
-            glUniformMatrix4fv(modelview_loc, 1, GL_FALSE, modelview.data());
+            // ビュー変換（モデルビュー変換行列）
+            glUniformMatrix4fv(modelview_loc, 1, GL_FALSE, view.data());
+
+            // モデルの配置（カメラを原点とする座標系へのアフィン変換、基準点からカメラまでの差は倍精度で求める）
+            const my::Affine2D model = this->m_origin.place(this->m_model, eye);
+            glUniform4fv(model_loc, 1, model.data());
+            glUniform2fv(translation_loc, 1, model.data() + 4);
 
             // 投影変換（プロジェクション変換行列）
-            my::Matrix projection = proj;
-            projection.transpose();
-            glUniformMatrix4fv(projection_loc, 1, GL_FALSE, projection.data());
+            glUniformMatrix4fv(projection_loc, 1, GL_FALSE, proj.data());
 
             // ポイントサイズ（固定）
             glUniform1f(pointsize_loc, 5.0F);
 
+            // 今フレームにリングバッファへ書き込んだ頂点データがあれば、そちらを参照する
+            const my::StreamBuffer& sb = my::GlobalDrawer::instance().getStreamBuffer();
+            const bool is_stream = ((this->m_stream_frame != 0U) && (this->m_stream_frame == sb.getFrame()));
+            const GLuint vbo = is_stream ? sb.getBuffer() : this->m_vertex_vbo;
+            const GLintptr voffset = is_stream ? this->m_stream_voffset : 0;
+            const GLintptr coffset = is_stream ? this->m_stream_coffset : this->m_color_offset;
+
             // 頂点配列オブジェクトの結合
             glBindVertexArray(this->m_vao);
-            glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, vbo);
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->m_index_vbo);
             // 頂点データを指定
-            glVertexAttribPointer(pos_loc, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+            glVertexAttribPointer(pos_loc, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<GLvoid*>(voffset));
             glEnableVertexAttribArray(pos_loc);
             // 色データを指定
-            glVertexAttribPointer(col_loc, 4, GL_UNSIGNED_BYTE, GL_FALSE, 0, (GLubyte*)(this->m_vertexes.size() * sizeof(my::Vertex)));
+            glVertexAttribPointer(col_loc, 4, GL_UNSIGNED_BYTE, GL_FALSE, 0, reinterpret_cast<GLvoid*>(coffset));
             glEnableVertexAttribArray(col_loc);
 
             // 描画実行
-            GLsizei icnt = static_cast<GLsizei>(this->m_indexes.size());
-            glDrawElements(this->m_mode, icnt, GL_UNSIGNED_INT, nullptr);
+            GLsizei icnt = static_cast<GLsizei>(this->m_draw_count);
+            const GLintptr ioffset = static_cast<GLintptr>(this->m_draw_first * this->indexSize());
+            glDrawElements(this->m_mode, icnt, this->m_index_type, reinterpret_cast<GLvoid*>(ioffset));
+
+            // 頂点配列オブジェクトの結合を解除
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            glBindVertexArray(0);
+        }
+    };
+}
+
+namespace {
+    //! 基本図形の配置（instanceシェーダの配置毎のattributeの並び）
+    struct Instance {
+        my::Affine2D    affine;     //!< 配置（線形部分の4要素と移動量の2要素）
+        my::Color       color;      //!< 色
+    };
+    static_assert(sizeof(my::Affine2D) == (sizeof(float) * 6U), "Affine2D must be six packed floats");
+
+    //! 基本図形の単位形状のバッファオブジェクト（全ての配置で共有する）
+    class PrimitiveBuffer {
+        const my::PrimitiveMesh&    m_mesh;         //!< 単位形状
+        GLuint                      m_vertex_vbo;   //!< 頂点用のバッファオブジェクト
+        GLuint                      m_index_vbo;    //!< 頂点インデックス用のバッファオブジェクト（16bit）
+        my::Aabb                    m_bounds;       //!< 単位形状の外接矩形
+
+    public:
+        //! コンストラクタ
+        explicit PrimitiveBuffer(const my::PrimitiveMesh& mesh) :
+            m_mesh(mesh), m_vertex_vbo(0U), m_index_vbo(0U), m_bounds(my::Aabb::of(mesh.vertexes()))
+        {
+            // 単位形状の頂点数は16bitに収まる
+            const my::Indexes16 narrow = my::StripBatch::narrow(mesh.indexes());
+            glGenBuffers(1, &this->m_vertex_vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(mesh.vertexes().size() * sizeof(my::Vertex)), &mesh.vertexes()[0], GL_STATIC_DRAW);
+            glGenBuffers(1, &this->m_index_vbo);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->m_index_vbo);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(narrow.size() * sizeof(GLushort)), &narrow[0], GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            std::cout << "[PrimitiveBuffer::PrimitiveBuffer()] vertex:" << mesh.vertexes().size() << " index:" << narrow.size() << std::endl;
+        }
+
+        //! デストラクタ
+        ~PrimitiveBuffer()
+        {
+            glDeleteBuffers(1, &this->m_vertex_vbo);
+            glDeleteBuffers(1, &this->m_index_vbo);
+        }
+
+        //! コピーコンストラクタによるコピー禁止
+        PrimitiveBuffer(const PrimitiveBuffer& org) = delete;
+        //! 代入によるコピー禁止
+        PrimitiveBuffer& operator=(const PrimitiveBuffer& org) = delete;
+
+    public:
+        //! 単位形状を取得
+        const my::PrimitiveMesh& mesh() const { return this->m_mesh; }
+        //! 頂点用のバッファオブジェクトを取得
+        GLuint vertexBuffer() const { return this->m_vertex_vbo; }
+        //! 頂点インデックス用のバッファオブジェクトを取得
+        GLuint indexBuffer() const { return this->m_index_vbo; }
+        //! 頂点インデックス数を取得
+        GLsizei indexNum() const { return static_cast<GLsizei>(this->m_mesh.indexes().size()); }
+        //! 単位形状の外接矩形を取得
+        const my::Aabb& bounds() const { return this->m_bounds; }
+    };
+
+    //! 基本図形の単位形状とバッファオブジェクトをキー毎に1つだけ作成して共有する
+    class PrimitiveBuffers {
+        my::PrimitiveCache  m_cache;    //!< 単位形状
+        std::map<const my::PrimitiveMesh*, std::unique_ptr<PrimitiveBuffer>>   m_buffers;  //!< 単位形状毎のバッファオブジェクト
+
+    public:
+        //! デフォルトコンストラクタ
+        PrimitiveBuffers() : m_cache(), m_buffers() {}
+
+    public:
+        //! 単位形状のバッファオブジェクトを取得（未作成の場合は生成・転送する）
+        const PrimitiveBuffer& get(const my::PrimitiveKey& key)
+        {
+            const my::PrimitiveMesh& mesh = this->m_cache.get(key);
+            std::unique_ptr<PrimitiveBuffer>& buffer = this->m_buffers[&mesh];
+            if (!buffer) {
+                buffer.reset(new PrimitiveBuffer(mesh));
+            }
+            return *buffer;
+        }
+    };
+}
+
+namespace {
+    //! 同じ基本図形の多数の配置（1回のインスタンス描画で描画する）
+    class Instances : public Drawable {
+        GLuint                  m_vao;          //!< 頂点配列オブジェクト
+        GLuint                  m_instance_vbo; //!< 配置用のバッファオブジェクト
+        std::size_t             m_capacity;     //!< 配置用のバッファオブジェクトに確保した配置数
+        my::PrimitiveKey        m_key;          //!< 基本図形のキー（分割段は拡大率に応じて選択する）
+        const PrimitiveBuffer*  m_mesh;         //!< 描画する単位形状
+        std::vector<Instance>   m_instances;    //!< 配置の並び（描画物の座標系）
+        std::vector<Instance>   m_placed;       //!< 転送する配置の並び（基準点の座標系、作業用）
+        my::WorldPoint          m_origin;       //!< 配置の基準点（ワールド座標系、倍精度）
+        my::Affine2D            m_model;        //!< 基準点からの配置
+        bool                    m_dirty;        //!< 配置が未転送の場合true
+        float                   m_radius;       //!< 配置の描画スケールの最大値（分割段の選択に使用する）
+
+    public:
+        //! コンストラクタ
+        Instances(PrimitiveBuffers& buffers, const my::PrimitiveKey& key) :
+            m_vao(0U), m_instance_vbo(0U), m_capacity(0U), m_key(key), m_mesh(&buffers.get(key)),
+            m_instances(), m_placed(), m_origin(), m_model(), m_dirty(false), m_radius(0.0F)
+        {
+            glGenVertexArrays(1, &this->m_vao);
+            glGenBuffers(1, &this->m_instance_vbo);
+        }
+
+        //! デストラクタ
+        ~Instances() override
+        {
+            glDeleteVertexArrays(1, &this->m_vao);
+            glDeleteBuffers(1, &this->m_instance_vbo);
+        }
+
+        //! コピーコンストラクタによるコピー禁止
+        Instances(const Instances& org) = delete;
+        //! 代入によるコピー禁止
+        Instances& operator=(const Instances& org) = delete;
+
+    public:
+        //! 配置を追加（転送は次の描画の直前にまとめて行う）
+        void add(const my::Vector& pos, const my::Vector& scale, const my::Radian angle, const my::Color& color)
+        {
+            this->m_instances.push_back({ my::Affine2D::scale(scale) * my::Affine2D::rotate(angle) * my::Affine2D::translate(pos), color });
+            this->m_radius = std::max(this->m_radius, std::max(std::fabs(scale.x()), std::fabs(scale.y())));
+            this->m_dirty = true;
+        }
+
+        //! 拡大率に応じて単位形状の分割段を選択（同じ分割段の単位形状は他の描画物と共有する）
+        void selectLevel(PrimitiveBuffers& buffers, const float scale)
+        {
+            const std::uint32_t level = my::PrimitiveKey::level(this->m_radius * scale, BADGE_TOLERANCE);
+            this->m_mesh = &buffers.get(this->m_key.withLevel(level));
+        }
+
+        //! 配置の基準点（倍精度）と基準点からの配置を設定（全ての配置を転送し直す）
+        void setModel(const my::WorldPoint& origin, const my::Affine2D& model) override
+        {
+            this->m_origin = origin;
+            this->m_model = model;
+            this->m_dirty = true;
+        }
+
+        //! 配置を反映した外接矩形を取得
+        my::Aabb bounds() const override
+        {
+            my::Aabb box;
+            for (const Instance& inst : this->m_instances) {
+                box.extend(this->m_mesh->bounds().transform(this->m_origin.place(inst.affine * this->m_model, my::WorldPoint())));
+            }
+            return box;
+        }
+
+        //! 判定用の図形要素を追加（配置毎に単位形状を配置した三角形を追加する）
+        void collect(my::Picker& picker, const std::uint32_t id) const override
+        {
+            const my::PrimitiveMesh& mesh = this->m_mesh->mesh();
+            my::Vertexes placed(mesh.vertexes().size());
+            for (const Instance& inst : this->m_instances) {
+                this->m_origin.place(inst.affine * this->m_model, my::WorldPoint()).apply(mesh.vertexes().data(), placed.data(), placed.size());
+                picker.add(id, my::Picker::TOPOLOGY::TRIANGLES, placed, mesh.indexes(), my::Affine2D::identity());
+            }
+        }
+
+    private:
+        //! 未転送の配置を基準点の座標系に変換してバッファオブジェクトへ転送（カメラの移動では転送し直さない）
+        void flush()
+        {
+            if ((!this->m_dirty) || this->m_instances.empty()) {
+                return;
+            }
+            this->m_placed.clear();
+            this->m_placed.reserve(this->m_instances.size());
+            for (const Instance& inst : this->m_instances) {
+                this->m_placed.push_back({ inst.affine * this->m_model, inst.color });
+            }
+            const GLsizeiptr size = static_cast<GLsizeiptr>(this->m_placed.size() * sizeof(Instance));
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_instance_vbo);
+            if (this->m_placed.size() > this->m_capacity) {
+                glBufferData(GL_ARRAY_BUFFER, size, &this->m_placed[0], GL_DYNAMIC_DRAW);
+                this->m_capacity = this->m_placed.size();
+            }
+            else {
+                glBufferSubData(GL_ARRAY_BUFFER, 0, size, &this->m_placed[0]);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            this->m_dirty = false;
+        }
+
+    public:
+        //! 描画（カメラを原点とする座標系で描画する）
+        void draw(const my::WorldPoint& eye, const my::GpuMatrix& view, const my::GpuMatrix& proj) override
+        {
+            if (this->m_instances.empty()) {
+                return;
+            }
+            // 未転送の配置を転送
+            this->flush();
+
+            // シェーダ取得
+            my::InstanceShader shader = my::GlobalDrawer::instance().getShaderBuilder().getInstanceShader();
+            const GLint pos_loc = shader.getPositionLocation();
+            const GLint model_loc = shader.getModelLocation();
+            const GLint translation_loc = shader.getTranslationLocation();
+            const GLint col_loc = shader.getColorLocation();
+            glUseProgram(shader.getProgram());
+
+            // モデルの配置は配置毎にシェーダで行うため、ビュー変換行列をそのまま指定する
+            glUniformMatrix4fv(shader.getModelViewLocation(), 1, GL_FALSE, view.data());
+            glUniformMatrix4fv(shader.getProjectionLocation(), 1, GL_FALSE, proj.data());
+            // 基準点のカメラからの位置（倍精度で求めた差）
+            const my::Vector offset = this->m_origin.relativeTo(eye);
+            glUniform2f(shader.getOffsetLocation(), offset.x(), offset.y());
+
+            glBindVertexArray(this->m_vao);
+            // 単位形状の頂点データを指定
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_mesh->vertexBuffer());
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->m_mesh->indexBuffer());
+            glVertexAttribPointer(pos_loc, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+            glEnableVertexAttribArray(pos_loc);
+            // 配置毎のデータを指定（1配置毎に進める）
+            const GLsizei stride = static_cast<GLsizei>(sizeof(Instance));
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_instance_vbo);
+            glVertexAttribPointer(model_loc, 4, GL_FLOAT, GL_FALSE, stride, nullptr);
+            glEnableVertexAttribArray(model_loc);
+            glVertexAttribDivisor(model_loc, 1);
+            glVertexAttribPointer(translation_loc, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(sizeof(float) * 4U));
+            glEnableVertexAttribArray(translation_loc);
+            glVertexAttribDivisor(translation_loc, 1);
+            glVertexAttribPointer(col_loc, 4, GL_UNSIGNED_BYTE, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(Instance, color)));
+            glEnableVertexAttribArray(col_loc);
+            glVertexAttribDivisor(col_loc, 1);
+
+            // 描画実行
+            glDrawElementsInstanced(GL_TRIANGLES, this->m_mesh->indexNum(), GL_UNSIGNED_SHORT, nullptr, static_cast<GLsizei>(this->m_instances.size()));
 
             // 頂点配列オブジェクトの結合を解除
             glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -239,7 +1016,7 @@ namespace {
 
 namespace {
     //! テキスト
-    class Text {
+    class Text : public Drawable {
     public:
         //! 太字
         enum class BOLD { NO, YES };
@@ -254,17 +1031,17 @@ namespace {
         my::Vertexes    m_vertexes;     //!< 頂点座標の並び
         my::Indexes     m_indexes;      //!< 頂点インデックスの並び
         my::Color       m_color;        //!< テキスト色
-        my::Vector      m_pos;          //!< 描画位置
-        my::Vector      m_scale;        //!< 描画スケール
+        my::WorldPoint  m_origin;       //!< 配置の基準点（ワールド座標系、倍精度）
+        my::Affine2D    m_model;        //!< 基準点からの配置
         std::int32_t    m_size;         //!< テキストサイズ
         BOLD            m_bold;         //!< 太字
 
     public:
         //! コンストラクタ
-        Text(const std::wstring& text) :
+        Text(const std::wstring& text, const std::int32_t size, const BOLD bold) :
             m_vao(0U), m_vertex_vbo(0U), m_index_vbo(0U), m_texid(0), m_image(),
             m_text(text), m_vertexes(), m_indexes({0U, 1U, 2U, 3U}), m_color({0, 0, 0, 255}),
-            m_pos({0.0F, 0.0F, 0.0F}), m_scale({1.0F, 1.0F, 1.0F}), m_size(8), m_bold(BOLD::NO)
+            m_origin(), m_model(), m_size(size), m_bold(bold)
         {
             std::cout << "[Text::Text()] call" << std::endl;
             std::cout << "* input text <" << text.c_str() << ">" << std::endl;
@@ -277,10 +1054,12 @@ namespace {
             // 頂点インデックス用のバッファオブジェクトを作成する
             glGenBuffers(1, &this->m_index_vbo);
             std::cout << "* VBO(Index) id:" << m_index_vbo << std::endl;
+            // テキスト画像を生成する（外接矩形を確定させる）
+            this->build();
         }
 
         //! デストラクタ
-        ~Text()
+        ~Text() override
         {
             std::cout << "[Image::~Image()] call" << std::endl;
             // 頂点配列オブジェクトを破棄する
@@ -301,23 +1080,46 @@ namespace {
         Text& operator=(const Text& org) = delete;
 
     public:
-        //! 描画位置の設定
-        void setPosition(const my::Vector& pos) { this->m_pos = pos; }
-
-        //! 描画スケールの設定
-        void setScale(const my::Vector& scale) { this->m_scale = scale; }
+        //! 配置の基準点（倍精度）と基準点からの配置を設定
+        void setModel(const my::WorldPoint& origin, const my::Affine2D& model) override
+        {
+            this->m_origin = origin;
+            this->m_model = model;
+        }
 
         //! テキスト色の設定
         void setColor(const my::Color& color) { this->m_color = color; }
 
-        //! 文字サイズの設定
-        void setSize(const std::int32_t size) { this->m_size = size; }
+        //! 文字サイズの設定（変更した場合はテキスト画像を生成し直す）
+        void setSize(const std::int32_t size)
+        {
+            if (this->m_size != size) {
+                this->m_size = size;
+                this->build();
+            }
+        }
+
+        //! 太字の設定（変更した場合はテキスト画像を生成し直す）
+        void setBold(const BOLD bold)
+        {
+            if (this->m_bold != bold) {
+                this->m_bold = bold;
+                this->build();
+            }
+        }
+
+        //! 配置を反映した外接矩形を取得
+        my::Aabb bounds() const override { return my::Aabb::of(this->m_vertexes).transform(this->m_origin.place(this->m_model, my::WorldPoint())); }
 
-        //! 太字の設定
-        void setBold(const BOLD bold) { this->m_bold = bold; }
+        //! 判定用の図形要素を追加
+        void collect(my::Picker& picker, const std::uint32_t id) const override
+        {
+            picker.add(id, my::Picker::TOPOLOGY::TRIANGLE_STRIP, this->m_vertexes, this->m_indexes, this->m_origin.place(this->m_model, my::WorldPoint()));
+        }
 
-        //! 描画
-        void draw(const my::Matrix& view, const my::Matrix& proj)
+    private:
+        //! テキスト画像を生成し、テクスチャと頂点データを転送
+        void build()
         {
             // UV座標
             const GLint pointNum = 4;
@@ -329,52 +1131,64 @@ namespace {
             };
 
             // テキスト画像の生成
-            if(m_texid == 0) {
-                bool isBold = (m_bold == BOLD::YES) ? true : false;
-                m_image = my::GlobalDrawer::instance().getTextBuilder().build(m_text, m_size, isBold);
-
-                // テクスチャ生成
-                glGenTextures(1, &m_texid);
-                // テクスチャロード
-                glBindTexture(GL_TEXTURE_2D, m_texid);
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, m_image.width(), m_image.height(), 0, GL_ALPHA, GL_UNSIGNED_BYTE, &m_image[0]);
-                glBindTexture(GL_TEXTURE_2D, 0);
-
-                const float xmin = -(static_cast<float>(m_image.width()) / 2.0F);
-                const float ymin = -(static_cast<float>(m_image.height()) / 2.0F);
-                const float xmax = (static_cast<float>(m_image.width()) / 2.0F);
-                const float ymax = (static_cast<float>(m_image.height()) / 2.0F);
-
-                m_vertexes = {
-                    { xmin, ymax, 0.0F },
-                    { xmax, ymax, 0.0F },
-                    { xmin, ymin, 0.0F },
-                    { xmax, ymin, 0.0F }
-                };
-
-                glBindVertexArray(this->m_vao);
-
-                // 頂点データを転送する
-                const std::int32_t vsize = static_cast<std::int32_t>(m_vertexes.size() * sizeof(my::Vertex));
-                const std::int32_t uvsize = static_cast<std::int32_t>(pointNum * 2 * sizeof(GLfloat));
-                glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
-                glBufferData(GL_ARRAY_BUFFER, vsize + uvsize, nullptr, GL_DYNAMIC_DRAW);
-                glBufferSubData(GL_ARRAY_BUFFER, 0, vsize, &m_vertexes[0]);
-                glBufferSubData(GL_ARRAY_BUFFER, vsize, uvsize, &uv[0]);
+            bool isBold = (m_bold == BOLD::YES) ? true : false;
+            m_image = my::GlobalDrawer::instance().getTextBuilder().build(m_text, m_size, isBold);
 
-                // 頂点インデックスデータを転送する
-                const std::int32_t isize = static_cast<std::int32_t>(m_indexes.size() * sizeof(GLuint));
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->m_index_vbo);
-                glBufferData(GL_ELEMENT_ARRAY_BUFFER, isize, nullptr, GL_DYNAMIC_DRAW);
-                glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, isize, &m_indexes[0]);
+            // テクスチャ生成
+            if(m_texid != 0) {
+                glDeleteTextures(1, &m_texid);
             }
+            glGenTextures(1, &m_texid);
+            // テクスチャロード
+            glBindTexture(GL_TEXTURE_2D, m_texid);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, m_image.width(), m_image.height(), 0, GL_ALPHA, GL_UNSIGNED_BYTE, &m_image[0]);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            const float xmin = -(static_cast<float>(m_image.width()) / 2.0F);
+            const float ymin = -(static_cast<float>(m_image.height()) / 2.0F);
+            const float xmax = (static_cast<float>(m_image.width()) / 2.0F);
+            const float ymax = (static_cast<float>(m_image.height()) / 2.0F);
+
+            m_vertexes = {
+                { xmin, ymax, 0.0F },
+                { xmax, ymax, 0.0F },
+                { xmin, ymin, 0.0F },
+                { xmax, ymin, 0.0F }
+            };
+
+            glBindVertexArray(this->m_vao);
+
+            // 頂点データを転送する
+            const std::int32_t vsize = static_cast<std::int32_t>(m_vertexes.size() * sizeof(my::Vertex));
+            const std::int32_t uvsize = static_cast<std::int32_t>(pointNum * 2 * sizeof(GLfloat));
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_vertex_vbo);
+            glBufferData(GL_ARRAY_BUFFER, vsize + uvsize, nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, vsize, &m_vertexes[0]);
+            glBufferSubData(GL_ARRAY_BUFFER, vsize, uvsize, &uv[0]);
+
+            // 頂点インデックスデータを転送する
+            const std::int32_t isize = static_cast<std::int32_t>(m_indexes.size() * sizeof(GLuint));
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->m_index_vbo);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, isize, nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, isize, &m_indexes[0]);
+
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
 
+    public:
+        //! 描画（カメラを原点とする座標系で描画する）
+        void draw(const my::WorldPoint& eye, const my::GpuMatrix& view, const my::GpuMatrix& proj) override
+        {
             // シェーダ取得
             my::TextShader shader = my::GlobalDrawer::instance().getShaderBuilder().getTextShader();
             const GLuint prog = shader.getProgram();
             const GLint modelview_loc = shader.getModelViewLocation();
             const GLint projection_loc = shader.getProjectionLocation();
+            const GLint model_loc = shader.getModelLocation();
+            const GLint translation_loc = shader.getTranslationLocation();
             const GLint texture_loc = shader.getTextureLocation();
             const GLint texcolor_loc = shader.getTexColorLocation();
             const GLint pos_loc = shader.getPositionLocation();
@@ -383,16 +1197,16 @@ namespace {
             // シェーダプログラムを指定
             glUseProgram(prog);
 
-            // モデルの配置（モデルビュー変換行列）
-            my::Matrix model = my::Matrix::translate(m_pos) * my::Matrix::scale(m_scale);
-            my::Matrix modelview = view * model;
-            modelview.transpose();
-            glUniformMatrix4fv(modelview_loc, 1, GL_FALSE, modelview.data());
+            // ビュー変換（モデルビュー変換行列）
+            glUniformMatrix4fv(modelview_loc, 1, GL_FALSE, view.data());
+
+            // モデルの配置（カメラを原点とする座標系へのアフィン変換、基準点からカメラまでの差は倍精度で求める）
+            const my::Affine2D model = this->m_origin.place(this->m_model, eye);
+            glUniform4fv(model_loc, 1, model.data());
+            glUniform2fv(translation_loc, 1, model.data() + 4);
 
             // 投影変換（プロジェクション変換行列）
-            my::Matrix projection = proj;
-            projection.transpose();
-            glUniformMatrix4fv(projection_loc, 1, GL_FALSE, projection.data());
+            glUniformMatrix4fv(projection_loc, 1, GL_FALSE, proj.data());
 
             // GL描画設定
             glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -494,6 +1308,10 @@ namespace {
         std::int32_t    m_fbWidth;          //!< フレームバッファ幅[pixel]
         std::int32_t    m_fbHeight;         //!< フレームバッファ高さ[pixel]
         float           m_scale;            //!< 拡大率
+        my::WorldPoint  m_pan;              //!< 画面中央からのカメラの移動量（ワールド座標系、倍精度）
+        bool            m_drag;             //!< ドラッグ中の場合true
+        double          m_drag_x;           //!< 直前のドラッグ位置X[pixel]
+        double          m_drag_y;           //!< 直前のドラッグ位置Y[pixel]
         my::Color       m_bgcolor;          //!< 背景色
         Shape           m_lines;            //!< 線：ライン
         Shape           m_line_strip;       //!< 線：ラインストリップ
@@ -502,34 +1320,406 @@ namespace {
         Shape           m_triangle_strip;   //!< 面：ストリップ
         Shape           m_triangle_fan;     //!< 面：ファン
         Shape           m_points;           //!< 点
+        Shape           m_polygon;          //!< 面：穴あり多角形
+        my::Stroke      m_curve_stroke;     //!< 線：曲線を分割した太線の形状
+        Shape           m_curve;            //!< 線：曲線
+        my::Polygon     m_ring_polygon;     //!< 面：円を分割した多角形
+        Shape           m_ring;             //!< 面：円環
+        Shape           m_coast;            //!< 線：詳細度付きの太線
+        Shape           m_island;           //!< 面：詳細度付きの多角形
+        my::Stroke      m_wave_stroke;      //!< 線：毎フレーム更新する太線の形状
+        Shape           m_wave;             //!< 線：毎フレーム頂点を更新するラインストリップ
+        Shape           m_contours;         //!< 線：プリミティブリスタートでまとめた多数のラインストリップ
         Text            m_text_ascii;       //!< テキスト
         Text            m_text_kana;        //!< テキスト
         Text            m_text_bold;        //!< テキスト
+        std::vector<Drawable*>      m_drawables;    //!< 描画物の並び（描画順）
+        std::vector<Drawable*>      m_dynamics;     //!< 毎フレーム形状が変わる描画物の並び（m_drawablesの並び順によらない）
+        my::SpatialIndex            m_index;        //!< 形状が変わらない描画物の空間索引
+        std::vector<std::uint32_t>  m_visibles;     //!< 表示範囲と交差する描画物の番号の並び（作業用）
+        my::Picker                  m_picker;       //!< 形状が変わらない描画物の判定
+        std::vector<std::unique_ptr<Shape>> m_scene;    //!< シーンファイルから読み込んだ形状
+        PrimitiveBuffers            m_primitives;   //!< 基本図形の単位形状（配置で共有する）
+        std::vector<std::unique_ptr<Instances>> m_badges;   //!< 基本図形の多数配置（種類毎）
+        std::uint32_t               m_hover;        //!< マウスカーソルの位置にある描画物の番号
+        std::map<my::TileKey, std::vector<std::unique_ptr<Shape>>> m_tile_shapes;  //!< 転送済みのタイルの形状
+        std::unique_ptr<my::TileManager>    m_tiles;    //!< タイルの読み込み・破棄（タイルを使用しない場合はnullptr）
+        my::SceneGraph              m_graph;        //!< 描画物の配置の階層
+        std::vector<Drawable*>      m_nodes;        //!< 節点の番号毎の描画物（描画物のない節点はnullptr）
+        std::vector<my::WorldPoint> m_origins;      //!< 節点の番号毎の配置の基準点（根の子の位置、子孫は根の子と共有する）
+        std::vector<std::uint32_t>  m_changed;      //!< 配置を計算し直した節点の番号の並び（作業用）
 
     public:
         //! コンストラクタ
-        Screen(GLFWwindow* window) :
+        Screen(GLFWwindow* window, const std::string& scene_path, const std::string& tile_dir, const std::size_t tile_budget) :
             m_window(window), m_width(0), m_height(0), m_fbWidth(0), m_fbHeight(0), m_scale(DEFSCALE),
+            m_pan(), m_drag(false), m_drag_x(0.0), m_drag_y(0.0),
             m_bgcolor(DEFCOLOR[0], DEFCOLOR[1], DEFCOLOR[2], DEFCOLOR[3]),
-            m_lines(GL_LINES, LINE_V, LINE_I, LINE_C),
-            m_line_strip(GL_LINE_STRIP, LINE_V, LINE_I, LINE_C),
-            m_line_loop(GL_LINE_LOOP, LINE_V, LINE_I, LINE_C),
-            m_triangles(GL_TRIANGLES, TRIANGLE_V, TRIANGLE_I, TRIANGLE_C),
-            m_triangle_strip(GL_TRIANGLE_STRIP, TRIANGLE_V, TRIANGLE_I, TRIANGLE_C),
-            m_triangle_fan(GL_TRIANGLE_FAN, TRIANGLE_V, TRIANGLE_I, TRIANGLE_C),
+            m_lines(GL_TRIANGLE_STRIP, LINES_S.vertexes(), LINES_S.indexes(), LINES_S.colors(), Shape::RESIDENCY::COMPRESS),
+            m_line_strip(GL_TRIANGLE_STRIP, LINE_STRIP_S.vertexes(), LINE_STRIP_S.indexes(), LINE_STRIP_S.colors(), Shape::RESIDENCY::COMPRESS),
+            m_line_loop(GL_TRIANGLE_STRIP, LINE_LOOP_S.vertexes(), LINE_LOOP_S.indexes(), LINE_LOOP_S.colors(), Shape::RESIDENCY::COMPRESS),
+            m_triangles(GL_TRIANGLES, TRIANGLE_V, TRIANGLE_I, TRIANGLE_C, Shape::RESIDENCY::COMPRESS),
+            m_triangle_strip(GL_TRIANGLE_STRIP, TRIANGLE_V, TRIANGLE_I, TRIANGLE_C, Shape::RESIDENCY::COMPRESS),
+            m_triangle_fan(GL_TRIANGLE_FAN, TRIANGLE_V, TRIANGLE_I, TRIANGLE_C, Shape::RESIDENCY::COMPRESS),
             m_points(GL_POINTS, POINT_V, POINT_I, POINT_C),
-            m_text_ascii(TEXT_ASCII),
-            m_text_kana(TEXT_KANA),
-            m_text_bold(TEXT_BOLD)
+            m_polygon(GL_TRIANGLES, POLYGON_V, POLYGON_I, POLYGON_CS, Shape::RESIDENCY::COMPRESS),
+            m_curve_stroke(makeCurveStroke(DEFSCALE)),
+            m_curve(GL_TRIANGLE_STRIP, m_curve_stroke.vertexes(), m_curve_stroke.indexes(), m_curve_stroke.colors(), Shape::RESIDENCY::COMPRESS),
+            m_ring_polygon(makeRingPolygon(DEFSCALE)),
+            m_ring(GL_TRIANGLES, m_ring_polygon.vertexes(), my::Triangulator(1U).triangulate(m_ring_polygon), my::Colors(m_ring_polygon.size(), RING_C), Shape::RESIDENCY::COMPRESS),
+            m_coast(GL_TRIANGLE_STRIP, COAST_S.stroke.vertexes(), COAST_S.stroke.indexes(), COAST_S.stroke.colors(), Shape::RESIDENCY::COMPRESS),
+            m_island(GL_TRIANGLES, ISLAND_P.vertexes, ISLAND_P.indexes, my::Colors(ISLAND_P.vertexes.size(), ISLAND_C), Shape::RESIDENCY::COMPRESS),
+            m_wave_stroke(makeWaveStroke(0.0)),
+            m_wave(GL_TRIANGLE_STRIP, m_wave_stroke.vertexes(), m_wave_stroke.indexes(), m_wave_stroke.colors()),
+            m_contours(GL_LINE_STRIP, CONTOUR_B.vertexes(), CONTOUR_B.indexes(), CONTOUR_B.colors(), Shape::RESIDENCY::COMPRESS),
+            m_text_ascii(TEXT_ASCII, TEXT_ASCII_SZ, Text::BOLD::NO),
+            m_text_kana(TEXT_KANA, TEXT_KANA_SZ, Text::BOLD::NO),
+            m_text_bold(TEXT_BOLD, TEXT_BOLD_SZ, Text::BOLD::YES),
+            m_drawables({ &m_lines, &m_line_strip, &m_line_loop, &m_triangles, &m_triangle_strip, &m_triangle_fan,
+                          &m_points, &m_polygon, &m_curve, &m_ring, &m_coast, &m_island, &m_wave, &m_contours,
+                          &m_text_ascii, &m_text_kana, &m_text_bold }),
+            m_dynamics({ &m_points, &m_wave }), m_index(), m_visibles(),
+            m_picker(), m_scene(), m_primitives(), m_badges(), m_hover(PICK_NONE), m_tile_shapes(), m_tiles(),
+            m_graph(), m_nodes(), m_origins(), m_changed()
         {
             std::cout << "[Screen::Screen()] call" << std::endl;
             // 画面サイズを取得する
             glfwGetWindowSize(m_window, &m_width, &m_height);
             // フレームバッファサイズを取得する
             glfwGetFramebufferSize(m_window, &m_fbWidth, &m_fbHeight);
+            // 型の最大値の頂点インデックスでストリップを区切る
+            glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+            // 詳細度の段を設定する
+            m_coast.setLods(COAST_S.lods);
+            m_island.setLods(ISLAND_P.lods);
+            // 描画位置（階層の節点）・色を設定する
+            const std::uint32_t root = my::SceneGraph::ROOT;
+            (void)this->attach(root, &m_lines, LINES_POS);
+            (void)this->attach(root, &m_line_strip, LINE_STRIP_POS);
+            (void)this->attach(root, &m_line_loop, LINE_LOOP_POS);
+            (void)this->attach(root, &m_triangles, TRIANGLES_POS);
+            (void)this->attach(root, &m_triangle_strip, TRIANGLE_STRIP_POS);
+            (void)this->attach(root, &m_triangle_fan, TRIANGLE_FAN_POS);
+            (void)this->attach(root, &m_points, POINTS_POS);
+            (void)this->attach(root, &m_polygon, POLYGON_POS);
+            (void)this->attach(root, &m_curve, CURVE_POS);
+            (void)this->attach(root, &m_ring, CURVE_POS);
+            (void)this->attach(root, &m_coast, COAST_POS);
+            (void)this->attach(root, &m_island, ISLAND_POS);
+            (void)this->attach(root, &m_wave, WAVE_POS);
+            (void)this->attach(root, &m_contours, CONTOUR_POS);
+            (void)this->attach(root, &m_text_ascii, TEXT_ASCII_POS);
+            m_text_ascii.setColor(TEXT_ASCII_C);
+            (void)this->attach(root, &m_text_kana, TEXT_KANA_POS);
+            m_text_kana.setColor(TEXT_KANA_C);
+            (void)this->attach(root, &m_text_bold, TEXT_BOLD_POS);
+            m_text_bold.setColor(TEXT_BOLD_C);
+            // 基本図形を配置する（テキストより前に描画する）
+            this->makeBadges();
+            // シーンファイルの形状を読み込む（テキストより前に描画する）
+            this->load(scene_path);
+            // 階層の配置を反映し、空間索引を構築する
+            (void)this->updateGraph();
+            this->rebuildIndex();
+            // タイルの読み込みを開始する
+            this->openTiles(tile_dir, tile_budget);
+        }
+
+    private:
+        //! 波形の頂点座標を作成
+        static my::Vertexes makeWaveVertexes(const double time)
+        {
+            my::Vertexes vertexes;
+            vertexes.reserve(WAVE_NUM);
+            for (std::int32_t i = 0; i < WAVE_NUM; i++) {
+                const float t = static_cast<float>(i) / static_cast<float>(WAVE_NUM - 1);
+                const float phase = (t * 4.0F * my::MATRIX_PI) + static_cast<float>(time * 3.0);
+                vertexes.push_back({ (t - 0.5F) * WAVE_W, std::sin(phase) * WAVE_H / 2.0F });
+            }
+            return vertexes;
+        }
+
+        //! 波形の頂点色を作成
+        static my::Colors makeWaveColors(const double time)
+        {
+            my::Colors colors;
+            colors.reserve(WAVE_NUM);
+            for (std::int32_t i = 0; i < WAVE_NUM; i++) {
+                const double phase = (static_cast<double>(i) / WAVE_NUM) + time;
+                const std::uint8_t v = static_cast<std::uint8_t>(127.0 + (127.0 * std::sin(phase * 2.0 * static_cast<double>(my::MATRIX_PI))));
+                colors.push_back({ v, 0, static_cast<std::uint8_t>(255 - v), 255 });
+            }
+            return colors;
+        }
+
+        //! 波形の太線を作成
+        static my::Stroke makeWaveStroke(const double time)
+        {
+            my::Stroke stroke;
+            my::Stroker stroker(LINE_WIDTH, my::Stroker::JOIN::MITER, my::Stroker::CAP::BUTT);
+            stroker.setMiterLimit(WAVE_MITER_LIMIT);
+            stroker.stroke(makeWaveVertexes(time), makeWaveColors(time), false, stroke);
+            return stroke;
+        }
+
+        //! 曲線の太線を作成
+        static my::Stroke makeCurveStroke(const float scale)
+        {
+            const my::Flattener flattener(CURVE_TOLERANCE, scale);
+            const my::Stroker stroker(LINE_WIDTH, my::Stroker::JOIN::ROUND, my::Stroker::CAP::ROUND);
+            my::Stroke stroke;
+            my::Vertexes vertexes;
+            flattener.cubic(my::CubicBezier({ -200.0F, 0.0F }, { -150.0F, 80.0F }, { -100.0F, -80.0F }, { -50.0F, 0.0F }), vertexes);
+            stroker.stroke(vertexes, my::Colors(vertexes.size(), CURVE_C), false, stroke);
+            vertexes.clear();
+            flattener.quadratic({ -30.0F, -30.0F }, { 0.0F, 60.0F }, { 30.0F, -30.0F }, vertexes);
+            stroker.stroke(vertexes, my::Colors(vertexes.size(), CURVE_C), false, stroke);
+            vertexes.clear();
+            flattener.arc({ 0.0F, 0.0F }, 50.0F, 20.0F, my::Radian(0.3F), my::Radian(0.0F), my::Radian(my::Degree(270.0F)), vertexes);
+            stroker.stroke(vertexes, my::Colors(vertexes.size(), CURVE_C), false, stroke);
+            return stroke;
+        }
+
+        //! 円環の多角形を作成
+        static my::Polygon makeRingPolygon(const float scale)
+        {
+            const my::Flattener flattener(CURVE_TOLERANCE, scale);
+            my::Vertexes outer, hole;
+            flattener.circle({ 120.0F, 0.0F }, 40.0F, outer);
+            flattener.circle({ 120.0F, 0.0F }, 20.0F, hole);
+            return my::Polygon(outer, { hole });
+        }
+
+        //! 描画物（描画物がない場合はnullptr）を親からposだけ移動した階層の節点として追加
+        std::uint32_t attach(const std::uint32_t parent, Drawable* drawable, const my::Vector& pos)
+        {
+            // 根の子は位置を倍精度の基準点とし、子孫は基準点からの配置を単精度で扱う
+            const bool top = (parent == my::SceneGraph::ROOT);
+            const std::uint32_t node = m_graph.add(parent, top ? my::Affine2D::identity() : my::Affine2D::translate(pos));
+            m_nodes.resize(m_graph.size(), nullptr);
+            m_origins.resize(m_graph.size());
+            m_nodes[node] = drawable;
+            m_origins[node] = top ? my::WorldPoint(pos) : m_origins[parent];
+            return node;
+        }
+
+        //! 階層の配置を計算し直し、ワールド座標系の配置が変わった描画物に反映
+        bool updateGraph()
+        {
+            m_changed.clear();
+            m_graph.update(m_changed);
+            bool moved = false;
+            for (const std::uint32_t node : m_changed) {
+                if (m_nodes[node] != nullptr) {
+                    m_nodes[node]->setModel(m_origins[node], m_graph.world(node));
+                    moved = true;
+                }
+            }
+            return moved;
+        }
+
+        //! 形状が変わらない描画物の空間索引・判定用の格子を構築
+        void rebuildIndex()
+        {
+            // 毎フレーム形状が変わる描画物は空の矩形とし、索引から外す
+            std::vector<my::Aabb> boxes(m_drawables.size());
+            m_picker.clear();
+            for (std::size_t i = 0U; i < m_drawables.size(); i++) {
+                if (std::find(m_dynamics.begin(), m_dynamics.end(), m_drawables[i]) == m_dynamics.end()) {
+                    boxes[i] = m_drawables[i]->bounds();
+                    m_drawables[i]->collect(m_picker, static_cast<std::uint32_t>(i));
+                }
+            }
+            m_index.build(boxes);
+            m_picker.build();
+        }
+
+        //! 基本図形を種類毎に多数配置
+        void makeBadges()
+        {
+            // 行毎に種類を変える（円・楕円・円環・角丸矩形・矢印・星形）
+            const my::PrimitiveKey keys[] = {
+                my::PrimitiveKey::circle(0U), my::PrimitiveKey::ellipse(0U), my::PrimitiveKey::ring(0.5F, 0U),
+                my::PrimitiveKey::roundedRect(1.5F, 0.5F, 0U), my::PrimitiveKey::arrow(0.4F, 0.8F), my::PrimitiveKey::star(5U, 0.45F),
+            };
+            const my::Vector scales[] = { { 3.0F, 3.0F, 1.0F }, { 3.0F, 1.8F, 1.0F }, { 3.0F, 3.0F, 1.0F }, { 2.2F, 2.2F, 1.0F }, { 3.0F, 1.8F, 1.0F }, { 3.0F, 3.0F, 1.0F } };
+            const std::size_t rows = sizeof(keys) / sizeof(keys[0]);
+            std::vector<Drawable*> badges;
+            // 全ての行をまとめた節点の子として、行毎の節点を追加する（配置はまとめた節点からの相対位置とする）
+            const std::uint32_t group = this->attach(my::SceneGraph::ROOT, nullptr, BADGE_POS);
+            for (std::size_t r = 0U; r < rows; r++) {
+                std::unique_ptr<Instances> instances(new Instances(m_primitives, keys[r]));
+                (void)this->attach(group, instances.get(), { 0.0F, 0.0F, 0.0F });
+                const float y = (static_cast<float>(r) - (static_cast<float>(rows - 1U) / 2.0F)) * BADGE_PITCH;
+                for (std::int32_t c = 0; c < BADGE_COLS; c++) {
+                    const float x = (static_cast<float>(c) - (static_cast<float>(BADGE_COLS) / 2.0F)) * BADGE_PITCH;
+                    // 矢印・星形は列毎に回転させる
+                    const my::Radian angle((r >= 4U) ? (static_cast<float>(c) * my::MATRIX_PI / 16.0F) : 0.0F);
+                    const std::uint8_t v = static_cast<std::uint8_t>((c * 255) / (BADGE_COLS - 1));
+                    instances->add({ x, y, 0.0F }, scales[r], angle, { v, static_cast<std::uint8_t>(255 - v), static_cast<std::uint8_t>(r * 40U), 255 });
+                }
+                instances->selectLevel(m_primitives, m_scale);
+                badges.push_back(instances.get());
+                m_badges.push_back(std::move(instances));
+            }
+            const auto pos = std::find(m_drawables.begin(), m_drawables.end(), &m_text_ascii);
+            m_drawables.insert(pos, badges.begin(), badges.end());
+        }
+
+        //! シーンファイルの形状を読み込み
+        void load(const std::string& scene_path)
+        {
+            if (scene_path.empty()) {
+                return;
+            }
+            // マッピングしたファイルから直接転送するため、転送後はファイルを閉じてよい
+            my::SceneFile scene;
+            if (!scene.open(scene_path)) {
+                return;
+            }
+            std::cout << "[Screen::load()] " << scene_path << " shapes:" << scene.size() << std::endl;
+            std::vector<Drawable*> shapes;
+            for (std::size_t i = 0U; i < scene.size(); i++) {
+                m_scene.emplace_back(new Shape(scene.at(i)));
+                shapes.push_back(m_scene.back().get());
+            }
+            const auto pos = std::find(m_drawables.begin(), m_drawables.end(), &m_text_ascii);
+            m_drawables.insert(pos, shapes.begin(), shapes.end());
+        }
+
+        //! タイルの読み込みを開始
+        void openTiles(const std::string& tile_dir, const std::size_t tile_budget)
+        {
+            if (tile_dir.empty()) {
+                return;
+            }
+            std::cout << "[Screen::openTiles()] " << tile_dir << " budget:" << tile_budget << std::endl;
+            // 転送：タイル内の形状を転送し、GPUメモリの使用量を返す
+            const auto uploader = [this](const my::TileKey& key, const my::SceneFile& file) {
+                std::vector<std::unique_ptr<Shape>>& shapes = m_tile_shapes[key];
+                std::size_t bytes = 0U;
+                for (std::size_t i = 0U; i < file.size(); i++) {
+                    shapes.emplace_back(new Shape(file.at(i)));
+                    bytes += shapes.back()->gpuSize();
+                }
+                return bytes;
+            };
+            // 破棄：タイル内の形状を破棄する
+            const auto releaser = [this](const my::TileKey& key) { m_tile_shapes.erase(key); };
+            m_tiles.reset(new my::TileManager(TILE_WORLD, TILE_MAX_LEVEL, TILE_PIXELS, tile_budget, my::TileManager::fileLoader(tile_dir), uploader, releaser));
+            m_tiles->setUploadLimit(TILE_UPLOAD_LIMIT);
+        }
+
+        //! カメラの位置（ワールド座標系、倍精度）を取得
+        my::WorldPoint eye() const
+        {
+            return my::WorldPoint((static_cast<double>(m_fbWidth) / 2.0) + m_pan.x(), (static_cast<double>(m_fbHeight) / 2.0) + m_pan.y());
+        }
+
+        //! 表示範囲（ワールド座標系）を取得
+        my::Aabb viewbox() const
+        {
+            const my::Vertex c = this->eye().toVertex();
+            const float w = static_cast<float>(m_fbWidth) / m_scale / 2.0F;
+            const float h = static_cast<float>(m_fbHeight) / m_scale / 2.0F;
+            return my::Aabb(c.x() - w, c.y() - h, c.x() + w, c.y() + h);
+        }
+
+        //! カメラの設定（ビュー変換行列・投影変換行列）を取得
+        void camera(my::Matrix& view, my::Matrix& proj) const
+        {
+            // カメラを原点とする座標系で描画するため、ビュー変換はカメラの位置によらない
+            const my::Vector CAMERA_EYE = {0.0F, 0.0F, 5.0f};
+            const my::Vector CAMERA_CENTER = {0.0F, 0.0F, 0.0F};
+            const my::Vector CAMERA_UP = {0.0F, 1.0F, 0.0F};
+            view = my::Matrix::lookat(CAMERA_EYE, CAMERA_CENTER, CAMERA_UP);
+            const float w = static_cast<float>(m_fbWidth) / m_scale / 2.0F;
+            const float h = static_cast<float>(m_fbHeight) / m_scale / 2.0F;
+            proj = my::Matrix::orthogonal(-w, w, -h, h, 1.0F, 10.0F);
+        }
+
+        //! ウィンドウ座標の位置をワールド座標に変換
+        my::WorldPoint unproject(const double x, const double y) const
+        {
+            my::Matrix view, proj;
+            this->camera(view, proj);
+            const my::Vertex v = my::Picker::unproject(view, proj, static_cast<float>(x), static_cast<float>(y), static_cast<float>(m_width), static_cast<float>(m_height));
+            return this->eye() + my::Vector(v.x(), v.y(), 0.0F);
+        }
+
+        //! ウィンドウ座標の位置にある描画物を判定
+        bool pick(const double x, const double y, std::uint32_t& id) const
+        {
+            return m_picker.pick(this->unproject(x, y).toVertex(), PICK_TOLERANCE / m_scale, id);
         }
 
     public:
+        //! ウィンドウ座標の位置を中心に拡大率を変更（曲線は新しい拡大率の許容誤差で分割し直す）
+        void zoom(const double steps, const double x, const double y)
+        {
+            // 拡大率の変更前後で、カーソル位置のワールド座標が変わらないようカメラを移動する
+            const my::WorldPoint before = this->unproject(x, y);
+            const float scale = m_scale * std::pow(ZOOM_STEP, static_cast<float>(steps));
+            m_scale = std::min(std::max(scale, MIN_SCALE), MAX_SCALE);
+            const my::WorldPoint after = this->unproject(x, y);
+            m_pan += before.relativeTo(after);
+            std::cout << "[Screen::zoom()] scale:" << m_scale << std::endl;
+            m_curve_stroke = makeCurveStroke(m_scale);
+            m_curve.assign(m_curve_stroke.vertexes(), m_curve_stroke.indexes(), m_curve_stroke.colors());
+            m_ring_polygon = makeRingPolygon(m_scale);
+            m_ring.assign(m_ring_polygon.vertexes(), my::Triangulator(1U).triangulate(m_ring_polygon), my::Colors(m_ring_polygon.size(), RING_C));
+            for (const std::unique_ptr<Instances>& badge : m_badges) {
+                badge->selectLevel(m_primitives, m_scale);
+            }
+            // 形状が変わったため空間索引を構築し直す
+            this->rebuildIndex();
+        }
+
+        //! ドラッグを開始・終了
+        void drag(const bool start, const double x, const double y)
+        {
+            m_drag = start;
+            m_drag_x = x;
+            m_drag_y = y;
+        }
+
+        //! ドラッグ中の場合、ドラッグした分だけカメラを移動
+        void pan(const double x, const double y)
+        {
+            if (!m_drag) {
+                return;
+            }
+            // ウィンドウ座標は下向きが正のため、Y方向は符号を反転する
+            const float dx = static_cast<float>(x - m_drag_x) * static_cast<float>(m_fbWidth) / static_cast<float>(m_width) / m_scale;
+            const float dy = static_cast<float>(y - m_drag_y) * static_cast<float>(m_fbHeight) / static_cast<float>(m_height) / m_scale;
+            m_pan += my::Vector(-dx, dy, 0.0F);
+            m_drag_x = x;
+            m_drag_y = y;
+        }
+
+        //! マウスカーソルの位置にある描画物を更新
+        void hover(const double x, const double y)
+        {
+            std::uint32_t id = PICK_NONE;
+            (void)this->pick(x, y, id);
+            if (id != m_hover) {
+                std::cout << "[Screen::hover()] drawable:" << static_cast<std::int32_t>(id) << std::endl;
+                m_hover = id;
+            }
+        }
+
+        //! クリックした位置にある描画物を選択
+        void click(const double x, const double y)
+        {
+            std::uint32_t id = PICK_NONE;
+            if (this->pick(x, y, id)) {
+                std::cout << "[Screen::click()] drawable:" << id << std::endl;
+            }
+            else {
+                std::cout << "[Screen::click()] no drawable" << std::endl;
+            }
+        }
+
         //! 画面サイズを変更
         void resize(const std::int32_t w, const std::int32_t h)
         {
@@ -544,62 +1734,71 @@ namespace {
         //! 描画実行
         void draw()
         {
-            const float w_f = static_cast<float>(m_fbWidth);
-            const float h_f = static_cast<float>(m_fbHeight);
+            // リングバッファのフレーム開始
+            my::StreamBuffer& sb = my::GlobalDrawer::instance().getStreamBuffer();
+            sb.beginFrame();
 
             // 画面クリア
             glClearColor(m_bgcolor.clamp_r(), m_bgcolor.clamp_g(), m_bgcolor.clamp_b(), m_bgcolor.clamp_a());
             glClear(GL_COLOR_BUFFER_BIT);
             // ビューポートの設定
             glViewport(0, 0, m_fbWidth, m_fbHeight);
-            // カメラの設定（ビュー変換行列）
-            const my::Vector CAMERA_EYE = {w_f / 2.0F, h_f / 2.0F, 5.0f};
-            const my::Vector CAMERA_CENTER = {w_f / 2.0F, h_f / 2.0F, 0.0F};
-            const my::Vector CAMERA_UP = {0.0F, 1.0F, 0.0F};
-            my::Matrix view = my::Matrix::lookat(CAMERA_EYE, CAMERA_CENTER, CAMERA_UP);
-            // 投影変換
-            const float w = m_fbWidth / m_scale / 2.0F;
-            const float h = m_fbHeight / m_scale / 2.0F;
-            my::Matrix proj = my::Matrix::orthogonal(-w, w, -h, h, 1.0F, 10.0F);
-            // 線：ライン描画
-            glLineWidth(5.0F);
-            m_lines.setPosition(LINES_POS);
-            m_lines.draw(view, proj);
-            // 線：ラインストリップ描画
-            m_line_strip.setPosition(LINE_STRIP_POS);
-            m_line_strip.draw(view, proj);
-            // 線：ラインループ描画
-            m_line_loop.setPosition(LINE_LOOP_POS);
-            m_line_loop.draw(view, proj);
-            // 面：ポリゴン描画
-            m_triangles.setPosition(TRIANGLES_POS);
-            m_triangles.draw(view, proj);
-            // 面：ポリゴン描画
-            m_triangle_strip.setPosition(TRIANGLE_STRIP_POS);
-            m_triangle_strip.draw(view, proj);
-            // 面：ポリゴン描画
-            m_triangle_fan.setPosition(TRIANGLE_FAN_POS);
-            m_triangle_fan.draw(view, proj);
-            // 点
+            // カメラの設定（カメラの位置・ビュー変換行列・投影変換行列）
+            const my::WorldPoint eye = this->eye();
+            my::Matrix view, proj;
+            this->camera(view, proj);
+            // 階層の配置が変わった場合は描画物に反映し、空間索引を構築し直す
+            if (this->updateGraph()) {
+                this->rebuildIndex();
+            }
+            // GPUへ転送する列優先の行列（描画物毎に転置しないようフレーム毎に1回だけ作成）
+            const my::GpuMatrix gpu_view(view);
+            const my::GpuMatrix gpu_proj(proj);
+            // 表示範囲（ワールド座標系）
+            const my::Aabb viewbox = this->viewbox();
+
+            // 点：1点を円運動させる
+            const float angle = static_cast<float>(glfwGetTime() * 2.0);
+            (void)m_points.updateVertices(POINT_MOVE_IDX, { { POINT_V[POINT_MOVE_IDX].x() + (std::cos(angle) * 10.0F), POINT_V[POINT_MOVE_IDX].y() + (std::sin(angle) * 10.0F) } });
+            // 線：毎フレーム頂点を更新する
+            const double time = glfwGetTime();
+            m_wave_stroke = makeWaveStroke(time);
+            (void)m_wave.stream(m_wave_stroke.vertexes(), m_wave_stroke.colors());
+            // 線・面：拡大率に応じた詳細度を選択（段が変わった場合は判定用の図形要素も選択した段にする）
+            bool lod_changed = m_coast.selectLod(m_scale);
+            lod_changed = m_island.selectLod(m_scale) || lod_changed;
+            if (lod_changed) {
+                this->rebuildIndex();
+            }
+
+            // 表示範囲と交差する描画物を抽出（形状が変わる描画物は外接矩形を直接判定）
+            m_visibles.clear();
+            m_index.query(viewbox, m_visibles);
+            for (Drawable* const dynamic : m_dynamics) {
+                const auto it = std::find(m_drawables.begin(), m_drawables.end(), dynamic);
+                if ((it != m_drawables.end()) && dynamic->bounds().intersects(viewbox)) {
+                    m_visibles.push_back(static_cast<std::uint32_t>(it - m_drawables.begin()));
+                }
+            }
+            // 描画順を保つ
+            std::sort(m_visibles.begin(), m_visibles.end());
+
+            // 描画
             glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
-            m_points.setPosition(POINTS_POS);
-            m_points.draw(view, proj);
-            // テキスト
-            m_text_ascii.setPosition(TEXT_ASCII_POS);
-            m_text_ascii.setSize(TEXT_ASCII_SZ);
-            m_text_ascii.setColor(TEXT_ASCII_C);
-            m_text_ascii.draw(view, proj);
-            // テキスト
-            m_text_kana.setPosition(TEXT_KANA_POS);
-            m_text_kana.setSize(TEXT_KANA_SZ);
-            m_text_kana.setColor(TEXT_KANA_C);
-            m_text_kana.draw(view, proj);
-            // テキスト
-            m_text_bold.setPosition(TEXT_BOLD_POS);
-            m_text_bold.setSize(TEXT_BOLD_SZ);
-            m_text_bold.setBold(Text::BOLD::YES);
-            m_text_bold.setColor(TEXT_BOLD_C);
-            m_text_bold.draw(view, proj);
+            // 背景：表示範囲のタイルを読み込み・転送し、粗い段から描画する
+            if (m_tiles) {
+                m_tiles->update(viewbox, m_scale);
+                for (const my::TileKey& key : m_tiles->visibles()) {
+                    for (const std::unique_ptr<Shape>& shape : m_tile_shapes[key]) {
+                        shape->draw(eye, gpu_view, gpu_proj);
+                    }
+                }
+            }
+            for (const std::uint32_t id : m_visibles) {
+                m_drawables[id]->draw(eye, gpu_view, gpu_proj);
+            }
+            // リングバッファのフレーム終了
+            sb.endFrame();
             // 画面更新
             glfwSwapBuffers(m_window);
         }
@@ -632,14 +1831,24 @@ namespace {
         std::cout << "[GLFW MOUSE_BTN] button:" << button << " action:" << action << " mods:" << mods << " (" << window << ")" << std::endl;
         if (button == GLFW_MOUSE_BUTTON_LEFT) {
             if (action == GLFW_PRESS) {
+                // クリックした位置にある描画物を選択
+                Screen* screen = static_cast<Screen*>(glfwGetWindowUserPointer(window));
+                if (screen != nullptr) {
+                    double x = 0.0, y = 0.0;
+                    glfwGetCursorPos(window, &x, &y);
+                    screen->click(x, y);
+                }
             }
             else {
             }
         }
         else if (button == GLFW_MOUSE_BUTTON_RIGHT) {
-            if (action == GLFW_PRESS) {
-            }
-            else {
+            // 右釦を押している間はドラッグでカメラを移動する
+            Screen* screen = static_cast<Screen*>(glfwGetWindowUserPointer(window));
+            if (screen != nullptr) {
+                double x = 0.0, y = 0.0;
+                glfwGetCursorPos(window, &x, &y);
+                screen->drag(action == GLFW_PRESS, x, y);
             }
         }
         else if (button == GLFW_MOUSE_BUTTON_MIDDLE) {
@@ -656,12 +1865,29 @@ namespace {
     static void glfw_window_mouse_position_callback(GLFWwindow *window, double x, double y)
     {
         //std::cout << "[GLFW MOUSE_POS] x:" << x << " y:" << y << " (" << window << ")" << std::endl;
+        // 画面インスタンスのポインタを取得する
+        Screen* screen = static_cast<Screen*>(glfwGetWindowUserPointer(window));
+        if (screen != nullptr) {
+            // ドラッグ中の場合はカメラを移動する
+            screen->pan(x, y);
+            // マウスカーソルの位置にある描画物を更新
+            screen->hover(x, y);
+        }
     }
 
     //! GLFWでマウスホイールを動かしたときに呼ばれるコールバック関数
     static void glfw_window_mouse_scroll_callback(GLFWwindow *window, double x, double y)
     {
         std::cout << "[GLFW MOUSE_SCRL] x:" << x << " y:" << y << " (" << window << ")" << std::endl;
+        // 画面インスタンスのポインタを取得する
+        Screen* screen = static_cast<Screen*>(glfwGetWindowUserPointer(window));
+        if (screen != nullptr) {
+            // マウスカーソルの位置を中心に拡大率を変更して描画
+            double cursor_x = 0.0, cursor_y = 0.0;
+            glfwGetCursorPos(window, &cursor_x, &cursor_y);
+            screen->zoom(y, cursor_x, cursor_y);
+            screen->draw();
+        }
     }
 
     //! GLFWでキーが入力されたときに呼ばれるコールバック関数
@@ -671,9 +1897,150 @@ namespace {
     }
 }
 
-int main()
+namespace {
+    //! 組み込みの形状の一部をシーンファイルに書き込み
+    bool exportScene(const std::string& path)
+    {
+        std::cout << "[exportScene()] " << path << std::endl;
+        const my::Lod& lod = ISLAND_P.lods.at(0U);
+        const auto first = ISLAND_P.indexes.begin() + static_cast<std::ptrdiff_t>(lod.first());
+        const my::Indexes island_i(first, first + static_cast<std::ptrdiff_t>(lod.count()));
+        my::SceneWriter writer;
+        bool ok = writer.add("polygon", GL_TRIANGLES, POLYGON_V, POLYGON_I, POLYGON_CS, POLYGON_POS);
+        ok = writer.add("island", GL_TRIANGLES, ISLAND_P.vertexes, island_i, my::Colors(ISLAND_P.vertexes.size(), ISLAND_C), ISLAND_POS) && ok;
+        ok = writer.add("contours", GL_LINE_STRIP, CONTOUR_B.vertexes(), CONTOUR_B.indexes(), CONTOUR_B.colors(), CONTOUR_POS) && ok;
+        return ok && writer.write(path);
+    }
+
+    //! 背景の地形の高さ（-1.75～1.75）
+    float terrain(const float x, const float y)
+    {
+        return (std::sin(x * 0.0011F) * std::cos(y * 0.0017F)) + (0.5F * std::sin((x - y) * 0.0031F)) + (0.25F * std::cos((x + y) * 0.0093F));
+    }
+
+    //! 背景の地形の色（高さが負の場合は水面とする）
+    my::Color terrainColor(const float height)
+    {
+        if (height < 0.0F) {
+            const std::uint8_t v = static_cast<std::uint8_t>(40.0F * (2.0F + height));
+            return my::Color(static_cast<std::uint8_t>(v / 2U), v, static_cast<std::uint8_t>(v + 60U), 255);
+        }
+        const std::uint8_t v = static_cast<std::uint8_t>(60.0F * height);
+        return my::Color(static_cast<std::uint8_t>(70U + v), static_cast<std::uint8_t>(110U + (v / 2U)), 60, 255);
+    }
+
+    //! 背景のタイルを全段分ディレクトリに書き込み
+    //! タイル毎に、タイルの範囲をTILE_CELLS x TILE_CELLSの区画に分けた地形の面を書き込む（粗い段ほど区画が大きい）
+    bool exportTiles(const std::string& dir)
+    {
+        std::cout << "[exportTiles()] " << dir << std::endl;
+        constexpr std::uint32_t n = TILE_CELLS + 1U;
+        my::Indexes indexes;
+        for (std::uint32_t y = 0U; y < TILE_CELLS; y++) {
+            for (std::uint32_t x = 0U; x < TILE_CELLS; x++) {
+                const std::uint32_t i = (y * n) + x;
+                indexes.insert(indexes.end(), { i, i + 1U, i + n, i + n, i + 1U, i + n + 1U });
+            }
+        }
+        bool ok = true;
+        for (std::uint32_t level = 0U; level <= TILE_MAX_LEVEL; level++) {
+            for (std::uint32_t ty = 0U; ty < (1U << level); ty++) {
+                for (std::uint32_t tx = 0U; tx < (1U << level); tx++) {
+                    // 頂点座標はタイルの最小座標を原点とし、描画位置で配置する（ワールドの端でも精度を保つ）
+                    const my::TileKey key(level, tx, ty);
+                    const my::Aabb b = key.bounds(TILE_WORLD);
+                    const float cw = (b.maxx() - b.minx()) / static_cast<float>(TILE_CELLS);
+                    const float ch = (b.maxy() - b.miny()) / static_cast<float>(TILE_CELLS);
+                    my::Vertexes vertexes;
+                    my::Colors colors;
+                    for (std::uint32_t y = 0U; y < n; y++) {
+                        for (std::uint32_t x = 0U; x < n; x++) {
+                            const float lx = cw * static_cast<float>(x);
+                            const float ly = ch * static_cast<float>(y);
+                            vertexes.push_back({ lx, ly });
+                            colors.push_back(terrainColor(terrain(b.minx() + lx, b.miny() + ly)));
+                        }
+                    }
+                    my::SceneWriter writer;
+                    writer.setCompression(TILE_COMPRESSION_BITS);
+                    ok = writer.add("tile", GL_TRIANGLES, vertexes, indexes, colors, { b.minx(), b.miny(), 0.0F }) && ok;
+                    ok = writer.write(my::TileManager::path(dir, key)) && ok;
+                }
+            }
+        }
+        return ok;
+    }
+
+    //! 全てのテストコードを実行（途中で失敗しても全て実行する）
+    bool runTests()
+    {
+        std::cout << "[runTests()] call" << std::endl;
+        bool (* const tests[])() = {
+            // 演算の基盤
+            my::testcode_Matrix, my::testcode_GpuMatrix, my::testcode_MatrixKernel, my::testcode_Affine2D, my::testcode_WorldPoint,
+            my::testcode_DirtyRange, my::testcode_QuantizedVertexes,
+            // 形状の作成・加工
+            my::testcode_Flattener, my::testcode_Stroker, my::testcode_Triangulator, my::testcode_LodBuilder,
+            my::testcode_MeshOptimizer, my::testcode_StripBatch, my::testcode_VertexCodec, my::testcode_Primitive,
+            // 配置・判定・読み込み
+            my::testcode_SceneGraph, my::testcode_SpatialIndex, my::testcode_CullKernel, my::testcode_Picker, my::testcode_SceneFile, my::testcode_TileManager,
+        };
+        std::int32_t failed = 0;
+        for (const auto test : tests) {
+            failed += test() ? 0 : 1;
+        }
+        std::cout << "[runTests()] " << (failed == 0 ? "OK" : "NG") << " (failed:" << failed << ")" << std::endl;
+        return failed == 0;
+    }
+
+    //! 全ての処理性能の計測を実行
+    void runBenches()
+    {
+        std::cout << "[runBenches()] call" << std::endl;
+        void (* const benches[])() = {
+            my::benchcode_Matrix, my::benchcode_MatrixKernel,
+            my::benchcode_Flattener, my::benchcode_Stroker, my::benchcode_Triangulator,
+            my::benchcode_MeshOptimizer, my::benchcode_VertexCodec,
+            my::benchcode_SceneGraph, my::benchcode_SpatialIndex, my::benchcode_CullKernel, my::benchcode_Picker,
+        };
+        for (const auto bench : benches) {
+            bench();
+        }
+    }
+}
+
+int main(int argc, char* argv[])
 {
     std::cout << "[main] app start" << std::endl;
+    // 引数：[--test] [--bench] [--export <シーンファイル>] [--export-tiles <ディレクトリ>] [--tiles <ディレクトリ>] [--tile-budget <MiB>] [<シーンファイル>]
+    std::string scene_path;
+    std::string tile_dir;
+    std::size_t tile_budget = TILE_BUDGET_MB * 1024U * 1024U;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--test") {
+            return runTests() ? 0 : 1;
+        }
+        if (arg == "--bench") {
+            runBenches();
+            return 0;
+        }
+        if ((arg == "--export") && ((i + 1) < argc)) {
+            return exportScene(argv[i + 1]) ? 0 : 1;
+        }
+        if ((arg == "--export-tiles") && ((i + 1) < argc)) {
+            return exportTiles(argv[i + 1]) ? 0 : 1;
+        }
+        if ((arg == "--tiles") && ((i + 1) < argc)) {
+            tile_dir = argv[++i];
+            continue;
+        }
+        if ((arg == "--tile-budget") && ((i + 1) < argc)) {
+            tile_budget = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10)) * 1024U * 1024U;
+            continue;
+        }
+        scene_path = arg;
+    }
     // GLFWでエラーが発生したときにコールされる関数を登録する
     glfwSetErrorCallback(glfw_error_callback);
 
@@ -732,7 +2099,7 @@ int main()
     std::cout << "* OpenGL Ver. : " << glGetString(GL_VERSION) << std::endl;
 
     // 画面の生成
-    Screen screen(window);
+    Screen screen(window, scene_path, tile_dir, tile_budget);
 
     // 画面インスタンスのポインタを保持する
     glfwSetWindowUserPointer(window, &screen);
@@ -0,0 +1,17 @@
+#version 100
+
+uniform mat4 modelview;
+uniform mat4 projection;
+uniform vec2 offset;
+in vec3 position;
+in vec4 model;
+in vec2 translation;
+in vec4 color;
+out vec4 vertex_color;
+
+void main()
+{
+  vec2 p = (mat2(model) * position.xy) + translation + offset;
+  vertex_color = color / 255.0;
+  gl_Position = projection * modelview * vec4(p, position.z, 1.0);
+}
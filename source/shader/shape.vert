@@ -2,6 +2,8 @@
 
 uniform mat4 modelview;
 uniform mat4 projection;
+uniform vec4 model;
+uniform vec2 translation;
 uniform float pointSize;
 in vec3 position;
 in vec4 color;
@@ -10,6 +12,7 @@ out vec4 vertex_color;
 void main()
 {
   vertex_color = color / 255.0;
-  gl_Position = projection * modelview * vec4(position, 1.0);
+  vec2 p = (mat2(model) * position.xy) + translation;
+  gl_Position = projection * modelview * vec4(p, position.z, 1.0);
   gl_PointSize = pointSize;
 }
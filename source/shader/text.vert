@@ -2,6 +2,8 @@
 
 uniform mat4 modelview;
 uniform mat4 projection;
+uniform vec4 model;
+uniform vec2 translation;
 in vec3 position;
 in vec2 uv;
 out vec2 vertex_uv;
@@ -9,5 +11,6 @@ out vec2 vertex_uv;
 void main()
 {
   vertex_uv = uv;
-  gl_Position = projection * modelview * vec4(position, 1.0);
+  vec2 p = (mat2(model) * position.xy) + translation;
+  gl_Position = projection * modelview * vec4(p, position.z, 1.0);
 }